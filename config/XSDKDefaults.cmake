@@ -200,6 +200,10 @@ IF (DEFINED TPL_ENABLE_ZLIB)
   SET(MFEM_USE_ZLIB ${TPL_ENABLE_ZLIB} CACHE BOOL "Enable zlib for compressed data streams." FORCE)
 ENDIF()
 
+IF (DEFINED TPL_ENABLE_THREADS)
+  SET(MFEM_USE_THREADS ${TPL_ENABLE_THREADS} CACHE BOOL "Enable C++ threads for AsyncDataCollection" FORCE)
+ENDIF()
+
 IF (DEFINED TPL_ENABLE_LIBUNWIND)
   SET(MFEM_USE_LIBUNWIND ${TPL_ENABLE_LIBUNWIND} CACHE BOOL "Enable backtrace for errors." FORCE)
 ENDIF()
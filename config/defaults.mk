@@ -120,6 +120,7 @@ MFEM_USE_METIS_5       = NO
 MFEM_DEBUG             = NO
 MFEM_USE_EXCEPTIONS    = NO
 MFEM_USE_ZLIB          = NO
+MFEM_USE_THREADS       = NO
 MFEM_USE_LIBUNWIND     = NO
 MFEM_USE_LAPACK        = NO
 MFEM_THREAD_SAFE       = NO
@@ -243,6 +244,10 @@ OPENMP_LIB =
 # Used when MFEM_TIMER_TYPE = 2
 POSIX_CLOCKS_LIB = -lrt
 
+# Threads library configuration, used by AsyncDataCollection
+THREADS_OPT =
+THREADS_LIB = -lpthread
+
 # SUNDIALS library configuration
 # For sundials_nvecmpiplusx and nvecparallel remember to build with MPI_ENABLE=ON
 # and modify cmake variables for hypre for sundials
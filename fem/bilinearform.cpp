@@ -13,6 +13,7 @@
 
 #include "fem.hpp"
 #include "../general/device.hpp"
+#include "../general/annotation.hpp"
 #include <cmath>
 
 namespace mfem
@@ -78,6 +79,7 @@ BilinearForm::BilinearForm(FiniteElementSpace * f)
 
    assembly = AssemblyLevel::LEGACY;
    batch = 1;
+   fused_pa = false;
    ext = NULL;
 }
 
@@ -96,6 +98,7 @@ BilinearForm::BilinearForm (FiniteElementSpace * f, BilinearForm * bf, int ps)
 
    assembly = AssemblyLevel::LEGACY;
    batch = 1;
+   fused_pa = false;
    ext = NULL;
 
    // Copy the pointers to the integrators
@@ -384,6 +387,8 @@ void BilinearForm::AssembleBdrElementMatrix(
 
 void BilinearForm::Assemble(int skip_zeros)
 {
+   MFEM_PERF_FUNCTION;
+
    if (ext)
    {
       ext->Assemble();
@@ -705,6 +710,8 @@ void BilinearForm::FormLinearSystem(const Array<int> &ess_tdof_list, Vector &x,
                                     Vector &b, OperatorHandle &A, Vector &X,
                                     Vector &B, int copy_interior)
 {
+   MFEM_PERF_FUNCTION;
+
    if (ext)
    {
       ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
@@ -1337,6 +1344,8 @@ void MixedBilinearForm::AddBdrTraceFaceIntegrator(BilinearFormIntegrator *bfi,
 
 void MixedBilinearForm::Assemble (int skip_zeros)
 {
+   MFEM_PERF_FUNCTION;
+
    if (ext)
    {
       ext->Assemble();
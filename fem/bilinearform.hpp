@@ -76,6 +76,8 @@ protected:
    AssemblyLevel assembly;
    /// Element batch size used in the form action (1, 8, num_elems, etc.)
    int batch;
+   /// Use the fused partial assembly action, see EnableFusedPA().
+   bool fused_pa;
    /** @brief Extension for supporting Full Assembly (FA), Element Assembly (EA),
        Partial Assembly (PA), or Matrix Free assembly (MF). */
    BilinearFormExtension *ext;
@@ -138,6 +140,7 @@ protected:
       diag_policy = DIAG_KEEP;
       assembly = AssemblyLevel::LEGACY;
       batch = 1;
+      fused_pa = false;
       ext = NULL;
    }
 
@@ -183,6 +186,20 @@ public:
    /// Returns the assembly level
    AssemblyLevel GetAssemblyLevel() const { return assembly; }
 
+   /** @brief Enable the fused action of the partially assembled form.
+
+       With AssemblyLevel::PARTIAL, the element restriction, the integrator
+       kernels and the transpose of the element restriction are applied in a
+       single pass over the elements, without storing E-vectors. This is
+       currently done for scalar H1 spaces with tensor-product elements and a
+       MassIntegrator and/or a (symmetric) DiffusionIntegrator; in all other
+       cases the regular action is used. This method should be called before
+       assembly. */
+   void EnableFusedPA(bool enable = true) { fused_pa = enable; }
+
+   /// Return true if the fused partial assembly action was requested.
+   bool FusedPAEnabled() const { return fused_pa; }
+
    Hybridization *GetHybridization() const { return hybridization; }
 
    /** @brief Enable the use of static condensation. For details see the
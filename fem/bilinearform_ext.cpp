@@ -125,6 +125,8 @@ void MFBilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
 
 void MFBilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
+
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -247,6 +249,9 @@ PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    elem_restrict = NULL;
    int_face_restrict_lex = NULL;
    bdr_face_restrict_lex = NULL;
+   fused_mass = NULL;
+   fused_diffusion = NULL;
+   fused = false;
 }
 
 void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
@@ -288,6 +293,8 @@ void PABilinearFormExtension::SetupRestrictionOperators(const L2FaceValues m)
 
 void PABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_FUNCTION;
+
    SetupRestrictionOperators(L2FaceValues::DoubleValued);
 
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -313,6 +320,8 @@ void PABilinearFormExtension::Assemble()
    {
       bdrFaceIntegrators[i]->AssemblePABoundaryFaces(*a->FESpace());
    }
+
+   SetupFusedMult();
 }
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
@@ -359,12 +368,20 @@ void PABilinearFormExtension::Update()
    elem_restrict = nullptr;
    int_face_restrict_lex = nullptr;
    bdr_face_restrict_lex = nullptr;
+   fused = false;
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
                                                OperatorHandle &A)
 {
    Operator *oper;
+#ifdef MFEM_USE_MPI
+   if (Operator *rap = NewParFusedOperator())
+   {
+      A.Reset(new ConstrainedOperator(rap, ess_tdof_list, true));
+      return;
+   }
+#endif
    Operator::FormSystemOperator(ess_tdof_list, oper);
    A.Reset(oper); // A will own oper
 }
@@ -376,12 +393,29 @@ void PABilinearFormExtension::FormLinearSystem(const Array<int> &ess_tdof_list,
                                                int copy_interior)
 {
    Operator *oper;
+#ifdef MFEM_USE_MPI
+   if (Operator *rap = NewParFusedOperator())
+   {
+      const Operator *P = GetProlongation();
+      InitTVectors(P, GetRestriction(), P, x, b, X, B);
+      if (!copy_interior) { X.SetSubVectorComplement(ess_tdof_list, 0.0); }
+      ConstrainedOperator *constrainedA =
+         new ConstrainedOperator(rap, ess_tdof_list, true);
+      constrainedA->EliminateRHS(X, B);
+      A.Reset(constrainedA);
+      return;
+   }
+#endif
    Operator::FormLinearSystem(ess_tdof_list, x, b, oper, X, B, copy_interior);
    A.Reset(oper); // A will own oper
 }
 
 void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
+
+   if (fused) { return FusedMult(x, y); }
+
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
 
    const int iSz = integrators.Size();
@@ -440,6 +474,11 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
 
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
+   MFEM_PERF_FUNCTION;
+
+   // The fused action is only used with symmetric integrators
+   if (fused) { return FusedMult(x, y); }
+
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int iSz = integrators.Size();
    if (elem_restrict)
@@ -508,6 +547,8 @@ EABilinearFormExtension::EABilinearFormExtension(BilinearForm *form)
 
 void EABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_FUNCTION;
+
    SetupRestrictionOperators(L2FaceValues::SingleValued);
 
    ne = trial_fes->GetMesh()->GetNE();
@@ -848,6 +889,8 @@ FABilinearFormExtension::FABilinearFormExtension(BilinearForm *form)
 
 void FABilinearFormExtension::Assemble()
 {
+   MFEM_PERF_FUNCTION;
+
    EABilinearFormExtension::Assemble();
    FiniteElementSpace &fes = *a->FESpace();
    int width = fes.GetVSize();
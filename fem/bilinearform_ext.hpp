@@ -22,6 +22,8 @@ namespace mfem
 class BilinearForm;
 class MixedBilinearForm;
 class DiscreteLinearOperator;
+class MassIntegrator;
+class DiffusionIntegrator;
 
 /// Class extending the BilinearForm class to support different AssemblyLevels.
 /**  FA - Full Assembly
@@ -74,6 +76,10 @@ protected:
    const Operator *elem_restrict; // Not owned
    const FaceRestriction *int_face_restrict_lex; // Not owned
    const FaceRestriction *bdr_face_restrict_lex; // Not owned
+   // Integrators applied by the fused action, see SetupFusedMult()
+   const MassIntegrator *fused_mass; // Not owned
+   const DiffusionIntegrator *fused_diffusion; // Not owned
+   bool fused;
 
 public:
    PABilinearFormExtension(BilinearForm*);
@@ -91,6 +97,28 @@ public:
 
 protected:
    void SetupRestrictionOperators(const L2FaceValues m);
+
+   /** @brief Check if the fused action, see BilinearForm::EnableFusedPA(), can
+       be used with the integrators of the form. */
+   void SetupFusedMult();
+
+   /** @brief Apply the element restriction, the integrator kernels and the
+       transpose of the element restriction in a single pass. */
+   void FusedMult(const Vector &x, Vector &y) const;
+
+   /** @brief Add the fused action of the given @a elements, or of all the
+       elements if NULL, to @a y. */
+   void FusedAddMult(const Vector &x, Vector &y,
+                     const Array<int> *elements = NULL) const;
+
+#ifdef MFEM_USE_MPI
+   /** @brief Return a new operator computing P^T A P with the fused action,
+       overlapping the communication of the shared dofs with the computations
+       on the elements that do not need it, or NULL if it is not supported. */
+   Operator *NewParFusedOperator() const;
+
+   friend class ParFusedPAOperator;
+#endif
 };
 
 /// Data and methods for element-assembled bilinear forms
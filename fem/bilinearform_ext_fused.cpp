@@ -0,0 +1,734 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../general/forall.hpp"
+#include "bilinearform.hpp"
+#include "pfespace.hpp"
+#include <typeinfo>
+
+namespace mfem
+{
+
+// Fused partial assembly action of the mass and diffusion integrators. Each
+// element gathers its dofs from the input L-vector, applies the sum-factorized
+// element operators on local arrays, and adds the result to the output
+// L-vector, so the E-vectors are never stored in memory.
+
+// Element action of the 2D mass operator: y += B^T D B x
+template<int MAX_D1D, int MAX_Q1D> MFEM_HOST_DEVICE inline
+void FusedMassApply2D(const int D1D, const int Q1D, const double *b,
+                      const double *d, const double *x, double *y)
+{
+   const auto B = Reshape(b, Q1D, D1D);
+   const auto D = Reshape(d, Q1D, Q1D);
+   const auto X = Reshape(x, D1D, D1D);
+   auto Y = Reshape(y, D1D, D1D);
+   double sol_xy[MAX_Q1D][MAX_Q1D];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         sol_xy[qy][qx] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      double sol_x[MAX_Q1D];
+      for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx] = 0.0; }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const double s = X(dx,dy);
+         for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx] += B(qx,dx) * s; }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy = B(qy,dy);
+         for (int qx = 0; qx < Q1D; ++qx) { sol_xy[qy][qx] += wy * sol_x[qx]; }
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      double sol_x[MAX_D1D];
+      for (int dx = 0; dx < D1D; ++dx) { sol_x[dx] = 0.0; }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const double s = sol_xy[qy][qx] * D(qx,qy);
+         for (int dx = 0; dx < D1D; ++dx) { sol_x[dx] += B(qx,dx) * s; }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy = B(qy,dy);
+         for (int dx = 0; dx < D1D; ++dx) { Y(dx,dy) += wy * sol_x[dx]; }
+      }
+   }
+}
+
+// Element action of the 3D mass operator: y += B^T D B x
+template<int MAX_D1D, int MAX_Q1D> MFEM_HOST_DEVICE inline
+void FusedMassApply3D(const int D1D, const int Q1D, const double *b,
+                      const double *d, const double *x, double *y)
+{
+   const auto B = Reshape(b, Q1D, D1D);
+   const auto D = Reshape(d, Q1D, Q1D, Q1D);
+   const auto X = Reshape(x, D1D, D1D, D1D);
+   auto Y = Reshape(y, D1D, D1D, D1D);
+   double sol_xyz[MAX_Q1D][MAX_Q1D][MAX_Q1D];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            sol_xyz[qz][qy][qx] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      double sol_xy[MAX_Q1D][MAX_Q1D];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx) { sol_xy[qy][qx] = 0.0; }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double sol_x[MAX_Q1D];
+         for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx] = 0.0; }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X(dx,dy,dz);
+            for (int qx = 0; qx < Q1D; ++qx) { sol_x[qx] += B(qx,dx) * s; }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy = B(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xy[qy][qx] += wy * sol_x[qx];
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz = B(qz,dz);
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               sol_xyz[qz][qy][qx] += wz * sol_xy[qy][qx];
+            }
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      double sol_xy[MAX_D1D][MAX_D1D];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx) { sol_xy[dy][dx] = 0.0; }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double sol_x[MAX_D1D];
+         for (int dx = 0; dx < D1D; ++dx) { sol_x[dx] = 0.0; }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double s = sol_xyz[qz][qy][qx] * D(qx,qy,qz);
+            for (int dx = 0; dx < D1D; ++dx) { sol_x[dx] += B(qx,dx) * s; }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy = B(qy,dy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               sol_xy[dy][dx] += wy * sol_x[dx];
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz = B(qz,dz);
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,dz) += wz * sol_xy[dy][dx];
+            }
+         }
+      }
+   }
+}
+
+// Element action of the 2D diffusion operator: y += G^T D G x, with symmetric
+// quadrature data D, stored as (1,1), (1,2), (2,2)
+template<int MAX_D1D, int MAX_Q1D> MFEM_HOST_DEVICE inline
+void FusedDiffusionApply2D(const int D1D, const int Q1D, const double *b,
+                           const double *g, const double *d, const double *x,
+                           double *y)
+{
+   const auto B = Reshape(b, Q1D, D1D);
+   const auto G = Reshape(g, Q1D, D1D);
+   const auto D = Reshape(d, Q1D*Q1D, 3);
+   const auto X = Reshape(x, D1D, D1D);
+   auto Y = Reshape(y, D1D, D1D);
+   double grad[MAX_Q1D][MAX_Q1D][2];
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         grad[qy][qx][0] = 0.0;
+         grad[qy][qx][1] = 0.0;
+      }
+   }
+   for (int dy = 0; dy < D1D; ++dy)
+   {
+      double gradX[MAX_Q1D][2];
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         gradX[qx][0] = 0.0;
+         gradX[qx][1] = 0.0;
+      }
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         const double s = X(dx,dy);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] += s * B(qx,dx);
+            gradX[qx][1] += s * G(qx,dx);
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         const double wy  = B(qy,dy);
+         const double wDy = G(qy,dy);
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qy][qx][0] += gradX[qx][1] * wy;
+            grad[qy][qx][1] += gradX[qx][0] * wDy;
+         }
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const int q = qx + qy * Q1D;
+         const double O11 = D(q,0);
+         const double O12 = D(q,1);
+         const double O22 = D(q,2);
+         const double gX = grad[qy][qx][0];
+         const double gY = grad[qy][qx][1];
+         grad[qy][qx][0] = (O11 * gX) + (O12 * gY);
+         grad[qy][qx][1] = (O12 * gX) + (O22 * gY);
+      }
+   }
+   for (int qy = 0; qy < Q1D; ++qy)
+   {
+      double gradX[MAX_D1D][2];
+      for (int dx = 0; dx < D1D; ++dx)
+      {
+         gradX[dx][0] = 0.0;
+         gradX[dx][1] = 0.0;
+      }
+      for (int qx = 0; qx < Q1D; ++qx)
+      {
+         const double gX = grad[qy][qx][0];
+         const double gY = grad[qy][qx][1];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] += gX * G(qx,dx);
+            gradX[dx][1] += gY * B(qx,dx);
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         const double wy  = B(qy,dy);
+         const double wDy = G(qy,dy);
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            Y(dx,dy) += (gradX[dx][0] * wy) + (gradX[dx][1] * wDy);
+         }
+      }
+   }
+}
+
+// Element action of the 3D diffusion operator: y += G^T D G x, with symmetric
+// quadrature data D, stored as (1,1), (1,2), (1,3), (2,2), (2,3), (3,3)
+template<int MAX_D1D, int MAX_Q1D> MFEM_HOST_DEVICE inline
+void FusedDiffusionApply3D(const int D1D, const int Q1D, const double *b,
+                           const double *g, const double *d, const double *x,
+                           double *y)
+{
+   const auto B = Reshape(b, Q1D, D1D);
+   const auto G = Reshape(g, Q1D, D1D);
+   const auto D = Reshape(d, Q1D*Q1D*Q1D, 6);
+   const auto X = Reshape(x, D1D, D1D, D1D);
+   auto Y = Reshape(y, D1D, D1D, D1D);
+   double grad[MAX_Q1D][MAX_Q1D][MAX_Q1D][3];
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            grad[qz][qy][qx][0] = 0.0;
+            grad[qz][qy][qx][1] = 0.0;
+            grad[qz][qy][qx][2] = 0.0;
+         }
+      }
+   }
+   for (int dz = 0; dz < D1D; ++dz)
+   {
+      double gradXY[MAX_Q1D][MAX_Q1D][3];
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradXY[qy][qx][0] = 0.0;
+            gradXY[qy][qx][1] = 0.0;
+            gradXY[qy][qx][2] = 0.0;
+         }
+      }
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         double gradX[MAX_Q1D][2];
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            gradX[qx][0] = 0.0;
+            gradX[qx][1] = 0.0;
+         }
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            const double s = X(dx,dy,dz);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               gradX[qx][0] += s * B(qx,dx);
+               gradX[qx][1] += s * G(qx,dx);
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double wx  = gradX[qx][0];
+               const double wDx = gradX[qx][1];
+               gradXY[qy][qx][0] += wDx * wy;
+               gradXY[qy][qx][1] += wx  * wDy;
+               gradXY[qy][qx][2] += wx  * wy;
+            }
+         }
+      }
+      for (int qz = 0; qz < Q1D; ++qz)
+      {
+         const double wz  = B(qz,dz);
+         const double wDz = G(qz,dz);
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               grad[qz][qy][qx][0] += gradXY[qy][qx][0] * wz;
+               grad[qz][qy][qx][1] += gradXY[qy][qx][1] * wz;
+               grad[qz][qy][qx][2] += gradXY[qy][qx][2] * wDz;
+            }
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const int q = qx + (qy + qz * Q1D) * Q1D;
+            const double O11 = D(q,0);
+            const double O12 = D(q,1);
+            const double O13 = D(q,2);
+            const double O22 = D(q,3);
+            const double O23 = D(q,4);
+            const double O33 = D(q,5);
+            const double gX = grad[qz][qy][qx][0];
+            const double gY = grad[qz][qy][qx][1];
+            const double gZ = grad[qz][qy][qx][2];
+            grad[qz][qy][qx][0] = (O11 * gX) + (O12 * gY) + (O13 * gZ);
+            grad[qz][qy][qx][1] = (O12 * gX) + (O22 * gY) + (O23 * gZ);
+            grad[qz][qy][qx][2] = (O13 * gX) + (O23 * gY) + (O33 * gZ);
+         }
+      }
+   }
+   for (int qz = 0; qz < Q1D; ++qz)
+   {
+      double gradXY[MAX_D1D][MAX_D1D][3];
+      for (int dy = 0; dy < D1D; ++dy)
+      {
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradXY[dy][dx][0] = 0.0;
+            gradXY[dy][dx][1] = 0.0;
+            gradXY[dy][dx][2] = 0.0;
+         }
+      }
+      for (int qy = 0; qy < Q1D; ++qy)
+      {
+         double gradX[MAX_D1D][3];
+         for (int dx = 0; dx < D1D; ++dx)
+         {
+            gradX[dx][0] = 0.0;
+            gradX[dx][1] = 0.0;
+            gradX[dx][2] = 0.0;
+         }
+         for (int qx = 0; qx < Q1D; ++qx)
+         {
+            const double gX = grad[qz][qy][qx][0];
+            const double gY = grad[qz][qy][qx][1];
+            const double gZ = grad[qz][qy][qx][2];
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               const double wx  = B(qx,dx);
+               const double wDx = G(qx,dx);
+               gradX[dx][0] += gX * wDx;
+               gradX[dx][1] += gY * wx;
+               gradX[dx][2] += gZ * wx;
+            }
+         }
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            const double wy  = B(qy,dy);
+            const double wDy = G(qy,dy);
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               gradXY[dy][dx][0] += gradX[dx][0] * wy;
+               gradXY[dy][dx][1] += gradX[dx][1] * wDy;
+               gradXY[dy][dx][2] += gradX[dx][2] * wy;
+            }
+         }
+      }
+      for (int dz = 0; dz < D1D; ++dz)
+      {
+         const double wz  = B(qz,dz);
+         const double wDz = G(qz,dz);
+         for (int dy = 0; dy < D1D; ++dy)
+         {
+            for (int dx = 0; dx < D1D; ++dx)
+            {
+               Y(dx,dy,dz) += (gradXY[dy][dx][0] * wz) +
+                              (gradXY[dy][dx][1] * wz) +
+                              (gradXY[dy][dx][2] * wDz);
+            }
+         }
+      }
+   }
+}
+
+// Fused action y += R^T (A_mass + A_diffusion) R x, where R is the element
+// restriction given by its gather map. The mass (mq1d > 0) and diffusion
+// (dq1d > 0) operators may use different quadrature rules; when they share
+// the same one, T_Q1D can be used for both. The action is restricted to the
+// NE elements given by the device array 'elems', or to the first NE elements
+// when it is NULL.
+template<int DIM, int T_D1D = 0, int T_Q1D = 0>
+static void PAFusedApply(const int NE,
+                         const int *elems,
+                         const Array<int> &gather_map,
+                         const Array<double> &mb,
+                         const Vector &md,
+                         const Array<double> &db,
+                         const Array<double> &dg,
+                         const Vector &dd,
+                         const Vector &x_,
+                         Vector &y_,
+                         const int d1d = 0,
+                         const int mq1d = 0,
+                         const int dq1d = 0)
+{
+   const int D1D = T_D1D ? T_D1D : d1d;
+   const int ND = (DIM == 2) ? D1D*D1D : D1D*D1D*D1D;
+   const bool mass = mq1d > 0, diffusion = dq1d > 0;
+   const int MNQ = (DIM == 2) ? mq1d*mq1d : mq1d*mq1d*mq1d;
+   const int DNQ = (DIM == 2) ? dq1d*dq1d : dq1d*dq1d*dq1d;
+   const int DNC = (DIM == 2) ? 3 : 6;
+   MFEM_VERIFY(D1D <= MAX_D1D, "");
+   MFEM_VERIFY(mq1d <= MAX_Q1D && dq1d <= MAX_Q1D, "");
+   const auto map = Reshape(gather_map.Read(), ND, gather_map.Size()/ND);
+   const double *MB = mass ? mb.Read() : nullptr;
+   const double *MD = mass ? md.Read() : nullptr;
+   const double *DB = diffusion ? db.Read() : nullptr;
+   const double *DG = diffusion ? dg.Read() : nullptr;
+   const double *DD = diffusion ? dd.Read() : nullptr;
+   const double *X = x_.Read();
+   double *Y = y_.ReadWrite();
+   MFEM_FORALL(i, NE,
+   {
+      const int e = elems ? elems[i] : i;
+      const int D1D = T_D1D ? T_D1D : d1d;
+      const int MQ1D = T_Q1D ? T_Q1D : mq1d;
+      const int DQ1D = T_Q1D ? T_Q1D : dq1d;
+      constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
+      constexpr int max_Q1D = T_Q1D ? T_Q1D : MAX_Q1D;
+      constexpr int max_ND = (DIM == 2) ? max_D1D*max_D1D :
+                             max_D1D*max_D1D*max_D1D;
+      double Xe[max_ND], Ye[max_ND];
+      for (int k = 0; k < ND; k++)
+      {
+         const int gid = map(k,e);
+         const int j = gid >= 0 ? gid : -1-gid;
+         Xe[k] = gid >= 0 ? X[j] : -X[j];
+         Ye[k] = 0.0;
+      }
+      if (DIM == 2)
+      {
+         if (mass)
+         {
+            FusedMassApply2D<max_D1D,max_Q1D>(D1D, MQ1D, MB, MD + MNQ*e,
+                                              Xe, Ye);
+         }
+         if (diffusion)
+         {
+            FusedDiffusionApply2D<max_D1D,max_Q1D>(D1D, DQ1D, DB, DG,
+                                                   DD + DNQ*DNC*e, Xe, Ye);
+         }
+      }
+      else
+      {
+         if (mass)
+         {
+            FusedMassApply3D<max_D1D,max_Q1D>(D1D, MQ1D, MB, MD + MNQ*e,
+                                              Xe, Ye);
+         }
+         if (diffusion)
+         {
+            FusedDiffusionApply3D<max_D1D,max_Q1D>(D1D, DQ1D, DB, DG,
+                                                   DD + DNQ*DNC*e, Xe, Ye);
+         }
+      }
+      for (int k = 0; k < ND; k++)
+      {
+         const int gid = map(k,e);
+         const int j = gid >= 0 ? gid : -1-gid;
+         AtomicAdd(Y[j], gid >= 0 ? Ye[k] : -Ye[k]);
+      }
+   });
+}
+
+template<int DIM>
+static void PAFusedApply(const int NE,
+                         const int *E,
+                         const int D1D,
+                         const int MQ1D,
+                         const int DQ1D,
+                         const Array<int> &M,
+                         const Array<double> &MB,
+                         const Vector &MD,
+                         const Array<double> &DB,
+                         const Array<double> &DG,
+                         const Vector &DD,
+                         const Vector &X,
+                         Vector &Y)
+{
+   // Use the specialized kernels when both operators use the same rule
+   const bool same = MQ1D == 0 || DQ1D == 0 || MQ1D == DQ1D;
+   const int Q1D = same ? (MQ1D > 0 ? MQ1D : DQ1D) : 0;
+   const int MQ = MQ1D > 0 ? Q1D : 0, DQ = DQ1D > 0 ? Q1D : 0;
+   switch (same ? ((D1D << 4) | Q1D) : 0)
+   {
+      case 0x22: return PAFusedApply<DIM,2,2>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x23: return PAFusedApply<DIM,2,3>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x33: return PAFusedApply<DIM,3,3>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x34: return PAFusedApply<DIM,3,4>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x44: return PAFusedApply<DIM,4,4>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x45: return PAFusedApply<DIM,4,5>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x55: return PAFusedApply<DIM,5,5>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x56: return PAFusedApply<DIM,5,6>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x66: return PAFusedApply<DIM,6,6>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      case 0x67: return PAFusedApply<DIM,6,7>(NE,E,M,MB,MD,DB,DG,DD,X,Y,0,MQ,DQ);
+      default:
+         return PAFusedApply<DIM>(NE,E,M,MB,MD,DB,DG,DD,X,Y,D1D,MQ1D,DQ1D);
+   }
+}
+
+void PABilinearFormExtension::SetupFusedMult()
+{
+   fused = false;
+   fused_mass = NULL;
+   fused_diffusion = NULL;
+   if (!a->FusedPAEnabled() || DeviceCanUseCeed()) { return; }
+
+   const FiniteElementSpace &fes = *a->FESpace();
+   const int dim = fes.GetMesh()->Dimension();
+   if (fes.GetNE() == 0 || fes.GetVDim() != 1 || !UsesTensorBasis(fes) ||
+       (dim != 2 && dim != 3) ||
+       !dynamic_cast<const ElementRestriction*>(elem_restrict) ||
+       a->GetFBFI()->Size() > 0 || a->GetBFBFI()->Size() > 0)
+   {
+      return;
+   }
+
+   // Derived classes may change the action, so the types must match exactly.
+   // The fused kernels only read double precision quadrature data.
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      const BilinearFormIntegrator *integ = integrators[i];
+      if (integ->GetPASinglePrecision())
+      {
+         fused_mass = NULL;
+         fused_diffusion = NULL;
+         return;
+      }
+      if (typeid(*integ) == typeid(MassIntegrator) && !fused_mass)
+      {
+         fused_mass = static_cast<const MassIntegrator*>(integ);
+      }
+      else if (typeid(*integ) == typeid(DiffusionIntegrator) &&
+               !fused_diffusion &&
+               static_cast<const DiffusionIntegrator*>(integ)->GetPASymmetric())
+      {
+         fused_diffusion = static_cast<const DiffusionIntegrator*>(integ);
+      }
+      else
+      {
+         fused_mass = NULL;
+         fused_diffusion = NULL;
+         return;
+      }
+   }
+   fused = fused_mass || fused_diffusion;
+}
+
+void PABilinearFormExtension::FusedMult(const Vector &x, Vector &y) const
+{
+   y.UseDevice(true); // typically this is a large vector, so store on device
+   y = 0.0;
+   FusedAddMult(x, y);
+}
+
+void PABilinearFormExtension::FusedAddMult(const Vector &x, Vector &y,
+                                           const Array<int> *elements) const
+{
+   const ElementRestriction *R =
+      static_cast<const ElementRestriction*>(elem_restrict);
+   const int dim = trial_fes->GetMesh()->Dimension();
+   const int NE = elements ? elements->Size() : trial_fes->GetNE();
+   if (NE == 0) { return; }
+   const int *E = elements ? elements->Read() : NULL;
+   const DofToQuad *mmaps = fused_mass ? fused_mass->GetPAMaps() : NULL;
+   const DofToQuad *dmaps =
+      fused_diffusion ? fused_diffusion->GetPAMaps() : NULL;
+   const DofToQuad *maps = mmaps ? mmaps : dmaps;
+   const int D1D = maps->ndof;
+   const int MQ1D = mmaps ? mmaps->nqpt : 0;
+   const int DQ1D = dmaps ? dmaps->nqpt : 0;
+   const Array<double> &MB = mmaps ? mmaps->B : maps->B;
+   const Array<double> &DB = dmaps ? dmaps->B : maps->B;
+   const Array<double> &DG = dmaps ? dmaps->G : maps->G;
+   const Vector &MD = fused_mass ? fused_mass->GetPAData() :
+                      fused_diffusion->GetPAData();
+   const Vector &DD = fused_diffusion ? fused_diffusion->GetPAData() : MD;
+
+   if (dim == 2)
+   {
+      PAFusedApply<2>(NE, E, D1D, MQ1D, DQ1D, R->GatherMap(), MB, MD, DB, DG,
+                      DD, x, y);
+   }
+   else
+   {
+      PAFusedApply<3>(NE, E, D1D, MQ1D, DQ1D, R->GatherMap(), MB, MD, DB, DG,
+                      DD, x, y);
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+/** Parallel fused action P^T A P, where P is the conforming prolongation. The
+    elements are split into those that touch the ldofs owned by other ranks,
+    which need the exchanged values, and the interior ones. Half of the
+    interior elements are processed while the values of the shared dofs are
+    broadcast, and the other half while the contributions to the ldofs owned
+    by other ranks are sent back to their owners. */
+class ParFusedPAOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &ext;
+   const ConformingProlongationOperator &P;
+   // Interior elements processed during the broadcast and the reduction, and
+   // elements touching the ldofs owned by other ranks
+   Array<int> bcast_elems, reduce_elems, shared_elems;
+   mutable Vector x_l, y_l;
+
+public:
+   ParFusedPAOperator(const PABilinearFormExtension &ext_,
+                      const ParFiniteElementSpace &pfes,
+                      const ConformingProlongationOperator &P_)
+      : Operator(P_.Width()), ext(ext_), P(P_)
+   {
+      const int NE = pfes.GetNE();
+      const Array<int> &gather_map =
+         static_cast<const ElementRestriction*>(ext.elem_restrict)->GatherMap();
+      const int ND = gather_map.Size() / NE;
+      const int *map = gather_map.HostRead();
+
+      Array<int> interior;
+      interior.Reserve(NE);
+      for (int e = 0; e < NE; e++)
+      {
+         bool shared = false;
+         for (int i = 0; i < ND && !shared; i++)
+         {
+            const int gid = map[i + ND*e];
+            shared = pfes.GetLocalTDofNumber(gid >= 0 ? gid : -1-gid) < 0;
+         }
+         if (shared) { shared_elems.Append(e); }
+         else { interior.Append(e); }
+      }
+      const int half = interior.Size() / 2;
+      interior.GetSubArray(0, half, bcast_elems);
+      interior.GetSubArray(half, interior.Size() - half, reduce_elems);
+
+      x_l.SetSize(P.Height(), Device::GetDeviceMemoryType());
+      y_l.SetSize(P.Height(), Device::GetDeviceMemoryType());
+      x_l.UseDevice(true);
+      y_l.UseDevice(true);
+   }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   {
+      P.MultBegin(x, x_l);
+      y_l = 0.0;
+      ext.FusedAddMult(x_l, y_l, &bcast_elems);
+      P.MultEnd(x_l);
+      ext.FusedAddMult(x_l, y_l, &shared_elems);
+      P.MultTransposeBegin(y_l);
+      ext.FusedAddMult(x_l, y_l, &reduce_elems);
+      P.MultTransposeEnd(y_l, y);
+   }
+
+   // The fused mass and diffusion operators are symmetric
+   virtual void MultTranspose(const Vector &x, Vector &y) const
+   {
+      Mult(x, y);
+   }
+};
+
+Operator *PABilinearFormExtension::NewParFusedOperator() const
+{
+   if (!fused) { return NULL; }
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(trial_fes);
+   const ConformingProlongationOperator *P =
+      dynamic_cast<const ConformingProlongationOperator*>(GetProlongation());
+   if (!pfes || !P || !pfes->Conforming()) { return NULL; }
+   return new ParFusedPAOperator(*this, *pfes, *P);
+}
+
+#endif // MFEM_USE_MPI
+
+} // namespace mfem
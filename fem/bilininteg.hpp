@@ -2091,6 +2091,7 @@ private:
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, dofs1D, quad1D;
    Vector pa_data;
+   Array<float> pa_data_sp; ///< Single precision PA data, see ConvertPAData()
    bool symmetric = true; ///< False if using a nonsymmetric matrix coefficient
 
 public:
@@ -2162,6 +2163,15 @@ public:
 
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
+   /// Return the quadrature point data computed by AssemblePA().
+   const Vector &GetPAData() const { return pa_data; }
+
+   /// Return the DofToQuad maps used by AssemblePA().
+   const DofToQuad *GetPAMaps() const { return maps; }
+
+   /// Return true if the partial assembly data is symmetric.
+   bool GetPASymmetric() const { return symmetric; }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
 
@@ -2179,6 +2189,7 @@ protected:
    // PA extension
    const FiniteElementSpace *fespace;
    Vector pa_data;
+   Array<float> pa_data_sp; ///< Single precision PA data, see ConvertPAData()
    const DofToQuad *maps;         ///< Not owned
    const GeometricFactors *geom;  ///< Not owned
    int dim, ne, nq, dofs1D, quad1D;
@@ -2220,6 +2231,12 @@ public:
 
    virtual void AddMultTransposePA(const Vector&, Vector&) const;
 
+   /// Return the quadrature point data computed by AssemblePA().
+   const Vector &GetPAData() const { return pa_data; }
+
+   /// Return the DofToQuad maps used by AssemblePA().
+   const DofToQuad *GetPAMaps() const { return maps; }
+
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
                                          ElementTransformation &Trans);
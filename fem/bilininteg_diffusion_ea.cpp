@@ -242,12 +242,79 @@ static void EADiffusionAssemble3D(const int NE,
    });
 }
 
+// EA Diffusion Assemble kernel for non-tensor (simplex) elements. The entry
+// A(j,i,e) couples the trial dof j with the test dof i, as expected by the
+// element restriction; the quadrature data uses the ordering of the non-tensor
+// PA setup.
+template<int DIM>
+static void EADiffusionAssembleNonTensor(const int ND,
+                                         const int NQ,
+                                         const int NE,
+                                         const bool symmetric,
+                                         const Array<double> &gt,
+                                         const Vector &padata,
+                                         Vector &eadata,
+                                         const bool add)
+{
+   const int NC = symmetric ? DIM*(DIM+1)/2 : DIM*DIM;
+   const auto Gt = Reshape(gt.Read(), ND, NQ, DIM);
+   const auto D = Reshape(padata.Read(), NQ, NC, NE);
+   auto A = Reshape(eadata.ReadWrite(), ND, ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         for (int j = 0; j < ND; j++)
+         {
+            double val = 0.0;
+            for (int q = 0; q < NQ; q++)
+            {
+               for (int k = 0; k < DIM; k++)
+               {
+                  for (int l = 0; l < DIM; l++)
+                  {
+                     const int kl = symmetric ?
+                                    (k < l ? k*DIM - (k*(k-1))/2 + (l-k) :
+                                     l*DIM - (l*(l-1))/2 + (k-l)) :
+                                    k*DIM + l;
+                     val += Gt(i,q,k) * D(q,kl,e) * Gt(j,q,l);
+                  }
+               }
+            }
+            if (add)
+            {
+               A(j, i, e) += val;
+            }
+            else
+            {
+               A(j, i, e) = val;
+            }
+         }
+      }
+   });
+}
+
 void DiffusionIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                      Vector &ea_data,
                                      const bool add)
 {
+   // The element matrices are always formed from double precision data
+   const bool single = pa_single;
+   pa_single = false;
    AssemblePA(fes);
+   pa_single = single;
    ne = fes.GetMesh()->GetNE();
+   if (maps->mode == DofToQuad::FULL)
+   {
+      const int ND = maps->ndof, NQ = maps->nqpt;
+      if (dim == 2)
+      {
+         return EADiffusionAssembleNonTensor<2>(ND, NQ, ne, symmetric, maps->Gt,
+                                                pa_data, ea_data, add);
+      }
+      return EADiffusionAssembleNonTensor<3>(ND, NQ, ne, symmetric, maps->Gt,
+                                             pa_data, ea_data, add);
+   }
    const Array<double> &B = maps->B;
    const Array<double> &G = maps->G;
    if (dim == 1)
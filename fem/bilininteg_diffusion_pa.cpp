@@ -10,6 +10,7 @@
 // CONTRIBUTING.md for details.
 
 #include "../general/forall.hpp"
+#include "../linalg/kernels.hpp"
 #include "bilininteg.hpp"
 #include "gridfunc.hpp"
 #include "ceed/diffusion.hpp"
@@ -310,6 +311,100 @@ void PADiffusionSetup3D(const int Q1D,
    });
 }
 
+// PA Diffusion Assemble kernel for non-tensor (simplex) elements. The data
+// stored at each quadrature point is w/det(J) adj(J) M adj(J)^T, where M is the
+// coefficient, using the same component ordering as the tensor kernels.
+template<int DIM>
+static void PADiffusionSetupNonTensor(const int NQ,
+                                      const int coeffDim,
+                                      const int NE,
+                                      const Array<double> &w,
+                                      const Vector &j,
+                                      const Vector &c,
+                                      Vector &d)
+{
+   constexpr int SYM = DIM*(DIM+1)/2;
+   const bool symmetric = (coeffDim != DIM*DIM);
+   const bool const_c = c.Size() == 1;
+   MFEM_VERIFY(coeffDim < SYM || !const_c,
+               "Constant matrix coefficient not supported");
+   const auto W = Reshape(w.Read(), NQ);
+   const auto J = Reshape(j.Read(), NQ, DIM, DIM, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1,1) :
+                  Reshape(c.Read(), coeffDim, NQ, NE);
+   auto D = Reshape(d.Write(), NQ, symmetric ? SYM : DIM*DIM, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double Jq[DIM*DIM], A[DIM*DIM], M[DIM*DIM], R[DIM*DIM];
+      for (int col = 0; col < DIM; col++)
+      {
+         for (int row = 0; row < DIM; row++)
+         {
+            Jq[row + DIM*col] = J(q,row,col,e);
+            M[row + DIM*col] = 0.0;
+         }
+      }
+      kernels::CalcAdjugate<DIM>(Jq, A);
+      const double w_detJ = W(q) / kernels::Det<DIM>(Jq);
+      if (coeffDim == DIM*DIM) // Full matrix coefficient
+      {
+         for (int row = 0; row < DIM; row++)
+         {
+            for (int col = 0; col < DIM; col++)
+            {
+               M[row + DIM*col] = C(col + row*DIM, q, e);
+            }
+         }
+      }
+      else if (coeffDim == SYM) // Symmetric matrix coefficient
+      {
+         for (int row = 0, k = 0; row < DIM; row++)
+         {
+            for (int col = row; col < DIM; col++, k++)
+            {
+               M[row + DIM*col] = M[col + DIM*row] = C(k, q, e);
+            }
+         }
+      }
+      else // Vector or scalar coefficient
+      {
+         for (int k = 0; k < DIM; k++)
+         {
+            const int ck = (coeffDim == DIM) ? k : 0;
+            M[k + DIM*k] = const_c ? C(0,0,0) : C(ck, q, e);
+         }
+      }
+      // R = M adj(J)^T
+      for (int row = 0; row < DIM; row++)
+      {
+         for (int col = 0; col < DIM; col++)
+         {
+            double r = 0.0;
+            for (int k = 0; k < DIM; k++)
+            {
+               r += M[row + DIM*k] * A[col + DIM*k];
+            }
+            R[row + DIM*col] = r;
+         }
+      }
+      // D = w/det(J) adj(J) R
+      for (int row = 0, k = 0; row < DIM; row++)
+      {
+         for (int col = symmetric ? row : 0; col < DIM; col++, k++)
+         {
+            double r = 0.0;
+            for (int l = 0; l < DIM; l++)
+            {
+               r += A[row + DIM*l] * R[l + DIM*col];
+            }
+            D(q,k,e) = w_detJ * r;
+         }
+      }
+   });
+}
+
 static void PADiffusionSetup(const int dim,
                              const int sdim,
                              const int D1D,
@@ -375,7 +470,8 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    ne = fes.GetNE();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::JACOBIANS, mt);
    const int sdim = mesh->SpaceDimension();
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   const bool tensor = UsesTensorBasis(fes);
+   maps = &el.GetDofToQuad(*ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    int coeffDim = 1;
@@ -491,16 +587,34 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
       }
    }
    pa_data.SetSize((symmetric ? symmDims : MQfullDim) * nq * ne, mt);
+   if (!tensor)
+   {
+      MFEM_VERIFY(sdim == dim, "surface meshes are not supported with "
+                  "non-tensor elements");
+      if (dim == 2)
+      {
+         PADiffusionSetupNonTensor<2>(nq, coeffDim, ne, ir->GetWeights(),
+                                      geom->J, coeff, pa_data);
+      }
+      if (dim == 3)
+      {
+         PADiffusionSetupNonTensor<3>(nq, coeffDim, ne, ir->GetWeights(),
+                                      geom->J, coeff, pa_data);
+      }
+      ConvertPAData(pa_data, pa_data_sp);
+      return;
+   }
    PADiffusionSetup(dim, sdim, dofs1D, quad1D, coeffDim, ne, ir->GetWeights(),
                     geom->J, coeff, pa_data);
+   ConvertPAData(pa_data, pa_data_sp);
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PADiffusionDiagonal2D(const int NE,
                                   const bool symmetric,
                                   const Array<double> &b,
                                   const Array<double> &g,
-                                  const Vector &d,
+                                  const TD &d,
                                   Vector &y,
                                   const int d1d = 0,
                                   const int q1d = 0)
@@ -561,12 +675,12 @@ static void PADiffusionDiagonal2D(const int NE,
 }
 
 // Shared memory PA Diffusion Diagonal 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0, typename TD = Vector>
 static void SmemPADiffusionDiagonal2D(const int NE,
                                       const bool symmetric,
                                       const Array<double> &b_,
                                       const Array<double> &g_,
-                                      const Vector &d_,
+                                      const TD &d_,
                                       Vector &y_,
                                       const int d1d = 0,
                                       const int q1d = 0)
@@ -655,12 +769,12 @@ static void SmemPADiffusionDiagonal2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PADiffusionDiagonal3D(const int NE,
                                   const bool symmetric,
                                   const Array<double> &b,
                                   const Array<double> &g,
-                                  const Vector &d,
+                                  const TD &d,
                                   Vector &y,
                                   const int d1d = 0,
                                   const int q1d = 0)
@@ -756,12 +870,12 @@ static void PADiffusionDiagonal3D(const int NE,
 }
 
 // Shared memory PA Diffusion Diagonal 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void SmemPADiffusionDiagonal3D(const int NE,
                                       const bool symmetric,
                                       const Array<double> &b_,
                                       const Array<double> &g_,
-                                      const Vector &d_,
+                                      const TD &d_,
                                       Vector &y_,
                                       const int d1d = 0,
                                       const int q1d = 0)
@@ -874,6 +988,7 @@ static void SmemPADiffusionDiagonal3D(const int NE,
    });
 }
 
+template<typename TD>
 static void PADiffusionAssembleDiagonal(const int dim,
                                         const int D1D,
                                         const int Q1D,
@@ -881,7 +996,7 @@ static void PADiffusionAssembleDiagonal(const int dim,
                                         const bool symm,
                                         const Array<double> &B,
                                         const Array<double> &G,
-                                        const Vector &D,
+                                        const TD &D,
                                         Vector &Y)
 {
    if (dim == 2)
@@ -919,6 +1034,51 @@ static void PADiffusionAssembleDiagonal(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// Value of the quadrature data component (i,j), with the same ordering as in
+// PADiffusionSetupNonTensor.
+template<int DIM> MFEM_HOST_DEVICE inline
+int PADiffusionIndex(const bool symmetric, const int i, const int j)
+{
+   if (!symmetric) { return i*DIM + j; }
+   const int r = i < j ? i : j, c = i < j ? j : i;
+   return r*DIM - (r*(r-1))/2 + (c-r);
+}
+
+// PA Diffusion Diagonal kernel for non-tensor (simplex) elements
+template<int DIM, typename TD>
+static void PADiffusionDiagonalNonTensor(const int ND,
+                                         const int NQ,
+                                         const int NE,
+                                         const bool symmetric,
+                                         const Array<double> &gt,
+                                         const TD &d,
+                                         Vector &y)
+{
+   const int NC = symmetric ? DIM*(DIM+1)/2 : DIM*DIM;
+   const auto Gt = Reshape(gt.Read(), ND, NQ, DIM);
+   const auto D = Reshape(d.Read(), NQ, NC, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int dof = 0; dof < ND; ++dof)
+      {
+         double t = 0.0;
+         for (int q = 0; q < NQ; ++q)
+         {
+            for (int i = 0; i < DIM; i++)
+            {
+               for (int j = 0; j < DIM; j++)
+               {
+                  const int k = PADiffusionIndex<DIM>(symmetric, i, j);
+                  t += Gt(dof,q,i) * D(q,k,e) * Gt(dof,q,j);
+               }
+            }
+         }
+         Y(dof,e) += t;
+      }
+   });
+}
+
 void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (DeviceCanUseCeed())
@@ -927,7 +1087,35 @@ void DiffusionIntegrator::AssembleDiagonalPA(Vector &diag)
    }
    else
    {
-      if (pa_data.Size()==0) { AssemblePA(*fespace); }
+      if (pa_data.Size()==0 && pa_data_sp.Size()==0) { AssemblePA(*fespace); }
+      const bool single = pa_data_sp.Size() > 0;
+      if (maps->mode == DofToQuad::FULL)
+      {
+         const int ND = maps->ndof, NQ = maps->nqpt;
+         const Array<double> &Gt = maps->Gt;
+         if (dim == 2 && single)
+         {
+            return PADiffusionDiagonalNonTensor<2>(ND, NQ, ne, symmetric, Gt,
+                                                   pa_data_sp, diag);
+         }
+         if (dim == 2)
+         {
+            return PADiffusionDiagonalNonTensor<2>(ND, NQ, ne, symmetric, Gt,
+                                                   pa_data, diag);
+         }
+         if (single)
+         {
+            return PADiffusionDiagonalNonTensor<3>(ND, NQ, ne, symmetric, Gt,
+                                                   pa_data_sp, diag);
+         }
+         return PADiffusionDiagonalNonTensor<3>(ND, NQ, ne, symmetric, Gt,
+                                                pa_data, diag);
+      }
+      if (single)
+      {
+         return PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne, symmetric,
+                                            maps->B, maps->G, pa_data_sp, diag);
+      }
       PADiffusionAssembleDiagonal(dim, dofs1D, quad1D, ne, symmetric,
                                   maps->B, maps->G, pa_data, diag);
    }
@@ -1035,14 +1223,14 @@ static void OccaPADiffusionApply3D(const int D1D,
 #endif // MFEM_USE_OCCA
 
 // PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PADiffusionApply2D(const int NE,
                                const bool symmetric,
                                const Array<double> &b_,
                                const Array<double> &g_,
                                const Array<double> &bt_,
                                const Array<double> &gt_,
-                               const Vector &d_,
+                               const TD &d_,
                                const Vector &x_,
                                Vector &y_,
                                const int d1d = 0,
@@ -1157,12 +1345,12 @@ static void PADiffusionApply2D(const int NE,
 }
 
 // Shared memory PA Diffusion Apply 2D kernel
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0, typename TD = Vector>
 static void SmemPADiffusionApply2D(const int NE,
                                    const bool symmetric,
                                    const Array<double> &b_,
                                    const Array<double> &g_,
-                                   const Vector &d_,
+                                   const TD &d_,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
@@ -1315,14 +1503,14 @@ static void SmemPADiffusionApply2D(const int NE,
 }
 
 // PA Diffusion Apply 3D kernel
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PADiffusionApply3D(const int NE,
                                const bool symmetric,
                                const Array<double> &b,
                                const Array<double> &g,
                                const Array<double> &bt,
                                const Array<double> &gt,
-                               const Vector &d_,
+                               const TD &d_,
                                const Vector &x_,
                                Vector &y_,
                                int d1d = 0, int q1d = 0)
@@ -1507,12 +1695,12 @@ static void PADiffusionApply3D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void SmemPADiffusionApply3D(const int NE,
                                    const bool symmetric,
                                    const Array<double> &b_,
                                    const Array<double> &g_,
-                                   const Vector &d_,
+                                   const TD &d_,
                                    const Vector &x_,
                                    Vector &y_,
                                    const int d1d = 0,
@@ -1729,6 +1917,7 @@ static void SmemPADiffusionApply3D(const int NE,
    });
 }
 
+template<typename TD>
 static void PADiffusionApply(const int dim,
                              const int D1D,
                              const int Q1D,
@@ -1738,26 +1927,10 @@ static void PADiffusionApply(const int dim,
                              const Array<double> &G,
                              const Array<double> &Bt,
                              const Array<double> &Gt,
-                             const Vector &D,
+                             const TD &D,
                              const Vector &X,
                              Vector &Y)
 {
-#ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
-   {
-      if (dim == 2)
-      {
-         OccaPADiffusionApply2D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
-         return;
-      }
-      if (dim == 3)
-      {
-         OccaPADiffusionApply3D(D1D,Q1D,NE,B,G,Bt,Gt,D,X,Y);
-         return;
-      }
-      MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
-   }
-#endif // MFEM_USE_OCCA
    const int id = (D1D << 4) | Q1D;
 
    if (dim == 2)
@@ -1796,13 +1969,107 @@ static void PADiffusionApply(const int dim,
    MFEM_ABORT("Unknown kernel: 0x"<<std::hex << id << std::dec);
 }
 
+// PA Diffusion Apply kernel for non-tensor (simplex) elements: the element
+// operator G^T D G is applied with dense contractions, one element per thread.
+template<int DIM, typename TD>
+static void PADiffusionApplyNonTensor(const int ND,
+                                      const int NQ,
+                                      const int NE,
+                                      const bool symmetric,
+                                      const Array<double> &gt,
+                                      const TD &d,
+                                      const Vector &x,
+                                      Vector &y)
+{
+   const int NC = symmetric ? DIM*(DIM+1)/2 : DIM*DIM;
+   const auto Gt = Reshape(gt.Read(), ND, NQ, DIM);
+   const auto D = Reshape(d.Read(), NQ, NC, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double grad[DIM], flux[DIM];
+         for (int i = 0; i < DIM; i++)
+         {
+            double g = 0.0;
+            for (int dof = 0; dof < ND; ++dof) { g += Gt(dof,q,i) * X(dof,e); }
+            grad[i] = g;
+         }
+         for (int i = 0; i < DIM; i++)
+         {
+            double f = 0.0;
+            for (int j = 0; j < DIM; j++)
+            {
+               f += D(q, PADiffusionIndex<DIM>(symmetric, i, j), e) * grad[j];
+            }
+            flux[i] = f;
+         }
+         for (int i = 0; i < DIM; i++)
+         {
+            for (int dof = 0; dof < ND; ++dof)
+            {
+               Y(dof,e) += Gt(dof,q,i) * flux[i];
+            }
+         }
+      }
+   });
+}
+
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   const bool single = pa_data_sp.Size() > 0;
    if (DeviceCanUseCeed())
    {
       ceedOp->AddMult(x, y);
    }
+   else if (maps->mode == DofToQuad::FULL)
+   {
+      const int ND = maps->ndof, NQ = maps->nqpt;
+      const Array<double> &Gt = maps->Gt;
+      if (dim == 2 && single)
+      {
+         return PADiffusionApplyNonTensor<2>(ND, NQ, ne, symmetric, Gt,
+                                             pa_data_sp, x, y);
+      }
+      if (dim == 2)
+      {
+         return PADiffusionApplyNonTensor<2>(ND, NQ, ne, symmetric, Gt,
+                                             pa_data, x, y);
+      }
+      if (single)
+      {
+         return PADiffusionApplyNonTensor<3>(ND, NQ, ne, symmetric, Gt,
+                                             pa_data_sp, x, y);
+      }
+      PADiffusionApplyNonTensor<3>(ND, NQ, ne, symmetric, Gt, pa_data, x, y);
+   }
+#ifdef MFEM_USE_OCCA
+   else if (DeviceCanUseOcca())
+   {
+      const Array<double> &B = maps->B, &G = maps->G;
+      const Array<double> &Bt = maps->Bt, &Gt = maps->Gt;
+      if (dim == 2)
+      {
+         OccaPADiffusionApply2D(dofs1D,quad1D,ne,B,G,Bt,Gt,pa_data,x,y);
+         return;
+      }
+      if (dim == 3)
+      {
+         OccaPADiffusionApply3D(dofs1D,quad1D,ne,B,G,Bt,Gt,pa_data,x,y);
+         return;
+      }
+      MFEM_ABORT("OCCA PADiffusionApply unknown kernel!");
+   }
+#endif // MFEM_USE_OCCA
+   else if (single)
+   {
+      PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
+                       maps->B, maps->G, maps->Bt, maps->Gt,
+                       pa_data_sp, x, y);
+   }
    else
    {
       PADiffusionApply(dim, dofs1D, quad1D, ne, symmetric,
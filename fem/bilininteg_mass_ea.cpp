@@ -223,13 +223,59 @@ static void EAMassAssemble3D(const int NE,
    });
 }
 
+// EA Mass Assemble kernel for non-tensor (simplex) elements: the dense element
+// matrix Bt D B is formed directly, one element per thread.
+static void EAMassAssembleNonTensor(const int ND,
+                                    const int NQ,
+                                    const int NE,
+                                    const Array<double> &bt,
+                                    const Vector &padata,
+                                    Vector &eadata,
+                                    const bool add)
+{
+   const auto Bt = Reshape(bt.Read(), ND, NQ);
+   const auto D = Reshape(padata.Read(), NQ, NE);
+   auto M = Reshape(eadata.ReadWrite(), ND, ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < ND; i++)
+      {
+         for (int j = 0; j < ND; j++)
+         {
+            double val = 0.0;
+            for (int q = 0; q < NQ; q++)
+            {
+               val += Bt(i,q) * D(q,e) * Bt(j,q);
+            }
+            if (add)
+            {
+               M(i, j, e) += val;
+            }
+            else
+            {
+               M(i, j, e) = val;
+            }
+         }
+      }
+   });
+}
+
 void MassIntegrator::AssembleEA(const FiniteElementSpace &fes,
                                 Vector &ea_data,
                                 const bool add)
 {
+   // The element matrices are always formed from double precision data
+   const bool single = pa_single;
+   pa_single = false;
    AssemblePA(fes);
+   pa_single = single;
    ne = fes.GetMesh()->GetNE();
    const Array<double> &B = maps->B;
+   if (maps->mode == DofToQuad::FULL)
+   {
+      return EAMassAssembleNonTensor(maps->ndof, maps->nqpt, ne, maps->Bt,
+                                     pa_data, ea_data, add);
+   }
    if (dim == 1)
    {
       switch ((dofs1D << 4 ) | quad1D)
@@ -21,6 +21,42 @@ namespace mfem
 
 // PA Mass Integrator
 
+// PA Mass Assemble kernel for non-tensor (simplex) elements: the quadrature
+// points are not structured, so the data is stored as NQ x NE.
+static void PAMassSetupNonTensor(const int dim,
+                                 const int NQ,
+                                 const int NE,
+                                 const bool by_val,
+                                 const Array<double> &w,
+                                 const Vector &j,
+                                 const Vector &c,
+                                 Vector &d)
+{
+   const bool const_c = c.Size() == 1;
+   const auto W = Reshape(w.Read(), NQ);
+   const auto J = Reshape(j.Read(), NQ, dim, dim, NE);
+   const auto C = const_c ? Reshape(c.Read(), 1,1) : Reshape(c.Read(), NQ,NE);
+   auto v = Reshape(d.Write(), NQ, NE);
+   MFEM_FORALL(i, NQ*NE,
+   {
+      const int q = i % NQ;
+      const int e = i / NQ;
+      double detJ;
+      if (dim == 2)
+      {
+         detJ = J(q,0,0,e)*J(q,1,1,e) - J(q,0,1,e)*J(q,1,0,e);
+      }
+      else
+      {
+         detJ = J(q,0,0,e) * (J(q,1,1,e)*J(q,2,2,e) - J(q,2,1,e)*J(q,1,2,e)) -
+                J(q,1,0,e) * (J(q,0,1,e)*J(q,2,2,e) - J(q,2,1,e)*J(q,0,2,e)) +
+                J(q,2,0,e) * (J(q,0,1,e)*J(q,1,2,e) - J(q,1,1,e)*J(q,0,2,e));
+      }
+      const double coeff = const_c ? C(0,0) : C(q,e);
+      v(q,e) = W(q) * coeff * (by_val ? detJ : 1.0/detJ);
+   });
+}
+
 // PA Mass Assemble kernel
 
 void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
@@ -47,7 +83,8 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
    nq = ir->GetNPoints();
    geom = mesh->GetGeometricFactors(*ir, GeometricFactors::COORDINATES |
                                     GeometricFactors::JACOBIANS, mt);
-   maps = &el.GetDofToQuad(*ir, DofToQuad::TENSOR);
+   const bool tensor = UsesTensorBasis(fes);
+   maps = &el.GetDofToQuad(*ir, tensor ? DofToQuad::TENSOR : DofToQuad::FULL);
    dofs1D = maps->ndof;
    quad1D = maps->nqpt;
    pa_data.SetSize(ne*nq, mt);
@@ -89,6 +126,15 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
       }
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
+   if (!tensor)
+   {
+      MFEM_VERIFY(mesh->SpaceDimension() == dim, "surface meshes are not "
+                  "supported with non-tensor elements");
+      PAMassSetupNonTensor(dim, nq, ne, map_type == FiniteElement::VALUE,
+                           ir->GetWeights(), geom->J, coeff, pa_data);
+      ConvertPAData(pa_data, pa_data_sp);
+      return;
+   }
    if (dim==2)
    {
       const int NE = ne;
@@ -155,12 +201,13 @@ void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
          }
       });
    }
+   ConvertPAData(pa_data, pa_data_sp);
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PAMassAssembleDiagonal2D(const int NE,
                                      const Array<double> &b,
-                                     const Vector &d,
+                                     const TD &d,
                                      Vector &y,
                                      const int d1d = 0,
                                      const int q1d = 0)
@@ -203,10 +250,10 @@ static void PAMassAssembleDiagonal2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0, typename TD = Vector>
 static void SmemPAMassAssembleDiagonal2D(const int NE,
                                          const Array<double> &b_,
-                                         const Vector &d_,
+                                         const TD &d_,
                                          Vector &y_,
                                          const int d1d = 0,
                                          const int q1d = 0)
@@ -269,10 +316,10 @@ static void SmemPAMassAssembleDiagonal2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PAMassAssembleDiagonal3D(const int NE,
                                      const Array<double> &b,
-                                     const Vector &d,
+                                     const TD &d,
                                      Vector &y,
                                      const int d1d = 0,
                                      const int q1d = 0)
@@ -338,10 +385,10 @@ static void PAMassAssembleDiagonal3D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void SmemPAMassAssembleDiagonal3D(const int NE,
                                          const Array<double> &b_,
-                                         const Vector &d_,
+                                         const TD &d_,
                                          Vector &y_,
                                          const int d1d = 0,
                                          const int q1d = 0)
@@ -424,10 +471,11 @@ static void SmemPAMassAssembleDiagonal3D(const int NE,
    });
 }
 
+template<typename TD>
 static void PAMassAssembleDiagonal(const int dim, const int D1D,
                                    const int Q1D, const int NE,
                                    const Array<double> &B,
-                                   const Vector &D,
+                                   const TD &D,
                                    Vector &Y)
 {
    if (dim == 2)
@@ -466,12 +514,53 @@ static void PAMassAssembleDiagonal(const int dim, const int D1D,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Mass Diagonal kernel for non-tensor (simplex) elements
+template<typename TD>
+static void PAMassAssembleDiagonalNonTensor(const int ND,
+                                            const int NQ,
+                                            const int NE,
+                                            const Array<double> &bt,
+                                            const TD &d,
+                                            Vector &y)
+{
+   const auto Bt = Reshape(bt.Read(), ND, NQ);
+   const auto D = Reshape(d.Read(), NQ, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int dof = 0; dof < ND; ++dof)
+      {
+         double t = 0.0;
+         for (int q = 0; q < NQ; ++q)
+         {
+            t += Bt(dof,q) * Bt(dof,q) * D(q,e);
+         }
+         Y(dof,e) += t;
+      }
+   });
+}
+
 void MassIntegrator::AssembleDiagonalPA(Vector &diag)
 {
    if (DeviceCanUseCeed())
    {
       ceedOp->GetDiagonal(diag);
    }
+   else if (maps->mode == DofToQuad::FULL)
+   {
+      const int ND = maps->ndof, NQ = maps->nqpt;
+      if (pa_data_sp.Size() > 0)
+      {
+         return PAMassAssembleDiagonalNonTensor(ND, NQ, ne, maps->Bt,
+                                                pa_data_sp, diag);
+      }
+      PAMassAssembleDiagonalNonTensor(ND, NQ, ne, maps->Bt, pa_data, diag);
+   }
+   else if (pa_data_sp.Size() > 0)
+   {
+      PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data_sp,
+                             diag);
+   }
    else
    {
       PAMassAssembleDiagonal(dim, dofs1D, quad1D, ne, maps->B, pa_data, diag);
@@ -571,11 +660,11 @@ static void OccaPAMassApply3D(const int D1D,
 }
 #endif // MFEM_USE_OCCA
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PAMassApply2D(const int NE,
                           const Array<double> &b_,
                           const Array<double> &bt_,
-                          const Vector &d_,
+                          const TD &d_,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
@@ -663,11 +752,11 @@ static void PAMassApply2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0>
+template<int T_D1D = 0, int T_Q1D = 0, int T_NBZ = 0, typename TD = Vector>
 static void SmemPAMassApply2D(const int NE,
                               const Array<double> &b_,
                               const Array<double> &bt_,
-                              const Vector &d_,
+                              const TD &d_,
                               const Vector &x_,
                               Vector &y_,
                               const int d1d = 0,
@@ -786,11 +875,11 @@ static void SmemPAMassApply2D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void PAMassApply3D(const int NE,
                           const Array<double> &b_,
                           const Array<double> &bt_,
-                          const Vector &d_,
+                          const TD &d_,
                           const Vector &x_,
                           Vector &y_,
                           const int d1d = 0,
@@ -927,11 +1016,11 @@ static void PAMassApply3D(const int NE,
    });
 }
 
-template<int T_D1D = 0, int T_Q1D = 0>
+template<int T_D1D = 0, int T_Q1D = 0, typename TD = Vector>
 static void SmemPAMassApply3D(const int NE,
                               const Array<double> &b_,
                               const Array<double> &bt_,
-                              const Vector &d_,
+                              const TD &d_,
                               const Vector &x_,
                               Vector &y_,
                               const int d1d = 0,
@@ -1154,30 +1243,17 @@ static void SmemPAMassApply3D(const int NE,
    });
 }
 
+template<typename TD>
 static void PAMassApply(const int dim,
                         const int D1D,
                         const int Q1D,
                         const int NE,
                         const Array<double> &B,
                         const Array<double> &Bt,
-                        const Vector &D,
+                        const TD &D,
                         const Vector &X,
                         Vector &Y)
 {
-#ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
-   {
-      if (dim == 2)
-      {
-         return OccaPAMassApply2D(D1D,Q1D,NE,B,Bt,D,X,Y);
-      }
-      if (dim == 3)
-      {
-         return OccaPAMassApply3D(D1D,Q1D,NE,B,Bt,D,X,Y);
-      }
-      MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
-   }
-#endif // MFEM_USE_OCCA
    const int id = (D1D << 4) | Q1D;
 
    if (dim == 2)
@@ -1231,12 +1307,74 @@ static void PAMassApply(const int dim,
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Mass Apply kernel for non-tensor (simplex) elements: the element
+// operator B^T D B is applied with dense contractions, one element per thread.
+template<typename TD>
+static void PAMassApplyNonTensor(const int ND,
+                                 const int NQ,
+                                 const int NE,
+                                 const Array<double> &bt,
+                                 const TD &d,
+                                 const Vector &x,
+                                 Vector &y)
+{
+   const auto Bt = Reshape(bt.Read(), ND, NQ);
+   const auto D = Reshape(d.Read(), NQ, NE);
+   const auto X = Reshape(x.Read(), ND, NE);
+   auto Y = Reshape(y.ReadWrite(), ND, NE);
+   MFEM_FORALL(e, NE,
+   {
+      for (int q = 0; q < NQ; ++q)
+      {
+         double u = 0.0;
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            u += Bt(dof,q) * X(dof,e);
+         }
+         u *= D(q,e);
+         for (int dof = 0; dof < ND; ++dof)
+         {
+            Y(dof,e) += Bt(dof,q) * u;
+         }
+      }
+   });
+}
+
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
+   const bool single = pa_data_sp.Size() > 0;
    if (DeviceCanUseCeed())
    {
       ceedOp->AddMult(x, y);
    }
+   else if (maps->mode == DofToQuad::FULL)
+   {
+      const int ND = maps->ndof, NQ = maps->nqpt;
+      if (single)
+      {
+         return PAMassApplyNonTensor(ND, NQ, ne, maps->Bt, pa_data_sp, x, y);
+      }
+      PAMassApplyNonTensor(ND, NQ, ne, maps->Bt, pa_data, x, y);
+   }
+#ifdef MFEM_USE_OCCA
+   else if (DeviceCanUseOcca())
+   {
+      const Array<double> &B = maps->B, &Bt = maps->Bt;
+      if (dim == 2)
+      {
+         return OccaPAMassApply2D(dofs1D,quad1D,ne,B,Bt,pa_data,x,y);
+      }
+      if (dim == 3)
+      {
+         return OccaPAMassApply3D(dofs1D,quad1D,ne,B,Bt,pa_data,x,y);
+      }
+      MFEM_ABORT("OCCA PA Mass Apply unknown kernel!");
+   }
+#endif // MFEM_USE_OCCA
+   else if (single)
+   {
+      PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data_sp, x, y);
+   }
    else
    {
       PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y);
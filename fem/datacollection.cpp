@@ -30,6 +30,23 @@
 namespace mfem
 {
 
+// True on the I/O threads of AsyncDataCollection
+static thread_local bool on_io_thread = false;
+
+#ifdef MFEM_USE_MPI
+// Collective MPI calls on an I/O thread, while the main thread continues to
+// communicate, require MPI_THREAD_MULTIPLE
+static void VerifyIOThreadLevel()
+{
+   if (!on_io_thread) { return; }
+   int provided;
+   MPI_Query_thread(&provided);
+   MFEM_VERIFY(provided == MPI_THREAD_MULTIPLE,
+               "Shared files written by AsyncDataCollection require MPI to be "
+               "initialized with MPI_THREAD_MULTIPLE");
+}
+#endif
+
 // static method
 int DataCollection::create_directory(const std::string &dir_name,
                                      const Mesh *mesh, int myid)
@@ -39,7 +56,10 @@ int DataCollection::create_directory(const std::string &dir_name,
    std::string::size_type pos = 0;
    int err_flag;
 #ifdef MFEM_USE_MPI
-   const ParMesh *pmesh = dynamic_cast<const ParMesh*>(mesh);
+   // On an I/O thread, all the ranks create the directories, without
+   // communication
+   const ParMesh *pmesh =
+      on_io_thread ? NULL : dynamic_cast<const ParMesh*>(mesh);
 #endif
 
    do
@@ -70,6 +90,87 @@ int DataCollection::create_directory(const std::string &dir_name,
    return err_flag;
 }
 
+#ifdef MFEM_USE_MPI
+// Maximum number of bytes in one MPI-IO call, since the counts are int
+static const long long shared_file_chunk = 1LL << 30;
+
+// static method
+bool DataCollection::WriteSharedFile(MPI_Comm comm,
+                                     const std::string &file_name,
+                                     const std::string &data)
+{
+   VerifyIOThreadLevel();
+   int rank;
+   MPI_Comm_rank(comm, &rank);
+
+   // The offset of the local data is the prefix sum of the sizes on the lower
+   // ranks (MPI_Exscan leaves it undefined on rank 0)
+   long long size = data.size(), offset = 0, total, max_size;
+   MPI_Exscan(&size, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   if (rank == 0) { offset = 0; }
+   MPI_Allreduce(&size, &total, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   MPI_Allreduce(&size, &max_size, 1, MPI_LONG_LONG, MPI_MAX, comm);
+
+   MPI_File fh;
+   if (MPI_File_open(comm, file_name.c_str(),
+                     MPI_MODE_WRONLY | MPI_MODE_CREATE, MPI_INFO_NULL,
+                     &fh) != MPI_SUCCESS)
+   {
+      return false;
+   }
+   // truncate the previous contents of the file, if any
+   int ok = (MPI_File_set_size(fh, total) == MPI_SUCCESS);
+   for (long long pos = 0; pos < max_size; pos += shared_file_chunk)
+   {
+      const long long start = std::min(pos, size);
+      const int count = std::min(size - start, shared_file_chunk);
+      char *buf = const_cast<char*>(data.data()) + start;
+      ok &= (MPI_File_write_at_all(fh, offset + start, buf, count, MPI_BYTE,
+                                   MPI_STATUS_IGNORE) == MPI_SUCCESS);
+   }
+   ok &= (MPI_File_close(&fh) == MPI_SUCCESS);
+
+   int all_ok;
+   MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, comm);
+   return all_ok;
+}
+
+// static method
+bool DataCollection::ReadSharedFile(MPI_Comm comm,
+                                    const std::string &file_name,
+                                    long long offset, long long size,
+                                    std::string &data)
+{
+   long long max_size;
+   MPI_Allreduce(&size, &max_size, 1, MPI_LONG_LONG, MPI_MAX, comm);
+
+   MPI_File fh;
+   if (MPI_File_open(comm, file_name.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL,
+                     &fh) != MPI_SUCCESS)
+   {
+      return false;
+   }
+   data.resize(size);
+   int ok = 1;
+   for (long long pos = 0; pos < max_size; pos += shared_file_chunk)
+   {
+      const long long start = std::min(pos, size);
+      const int count = std::min(size - start, shared_file_chunk);
+      MPI_Status status;
+      ok &= (MPI_File_read_at_all(fh, offset + start, &data[0] + start, count,
+                                  MPI_BYTE, &status) == MPI_SUCCESS);
+      int read_count;
+      MPI_Get_count(&status, MPI_BYTE, &read_count);
+      ok &= (read_count == count);
+   }
+   ok &= (MPI_File_close(&fh) == MPI_SUCCESS);
+
+   int all_ok;
+   MPI_Allreduce(&ok, &all_ok, 1, MPI_INT, MPI_MIN, comm);
+   return all_ok;
+}
+#endif
+
 // class DataCollection implementation
 
 DataCollection::DataCollection(const std::string& collection_name, Mesh *mesh_)
@@ -765,7 +866,8 @@ ParaViewDataCollection::ParaViewDataCollection(const std::string&
      levels_of_detail(1),
      pv_data_format(VTKFormat::BINARY),
      high_order_output(false),
-     restart_mode(false)
+     restart_mode(false),
+     single_file(false)
 {
 #ifdef MFEM_USE_ZLIB
    compression = -1; // default zlib compression level, equivalent to 6
@@ -906,6 +1008,55 @@ void ParaViewDataCollection::Save()
 
    std::string vtu_prefix = col_path + "/" + GenerateVTUPath() + "/";
 
+   if (single_file)
+   {
+      // Save the mesh and grid functions, and each quadrature function field,
+      // to a VTU file with one piece per rank
+      {
+         std::ostringstream os;
+         os.precision(precision);
+         SaveDataVTU(os, levels_of_detail);
+         SaveSingleVTU(vtu_prefix + "data.vtu", os.str());
+      }
+      for (const auto &qfield : q_field_map)
+      {
+         std::ostringstream os;
+         qfield.second->SaveVTU(os, pv_data_format, compression);
+         SaveSingleVTU(vtu_prefix + qfield.first + ".vtu", os.str());
+      }
+
+      // Add the VTU files to the PVD file
+      if (myid == 0)
+      {
+         AddPVDDataSet(GenerateVTUPath() + "/data.vtu", "mesh");
+         for (const auto &qfield : q_field_map)
+         {
+            AddPVDDataSet(GenerateVTUPath() + "/" + qfield.first + ".vtu",
+                          qfield.first);
+         }
+      }
+   }
+   else
+   {
+      SaveVTUFiles(vtu_prefix);
+   }
+
+   if (myid == 0)
+   {
+      pvd_stream.flush();
+      // Move the insertion point before the closing collection tag, so that
+      // the PVD file is valid even when writing incrementally.
+      std::fstream::pos_type pos = pvd_stream.tellp();
+      pvd_stream << "</Collection>\n";
+      pvd_stream << "</VTKFile>" << std::endl;
+      pvd_stream.seekp(pos);
+   }
+}
+
+void ParaViewDataCollection::SaveVTUFiles(const std::string &vtu_prefix)
+{
+   std::string col_path = GenerateCollectionPath();
+
    // Save the local part of the mesh and grid functions fields to the local
    // VTU file
    {
@@ -954,10 +1105,8 @@ void ParaViewDataCollection::Save()
       }
 
       // Add the latest PVTU to the PVD
-      pvd_stream << "<DataSet timestep=\"" << GetTime()
-                 << "\" group=\"\" part=\"" << 0 << "\" file=\""
-                 << GeneratePVTUPath() + "/" + GeneratePVTUFileName("data")
-                 << "\" name=\"mesh\"/>\n";
+      AddPVDDataSet(GeneratePVTUPath() + "/" + GeneratePVTUFileName("data"),
+                    "mesh");
 
       // Create PVTU files for each quadrature field and add them to the PVD
       // file
@@ -978,20 +1127,49 @@ void ParaViewDataCollection::Save()
          pvtu_out << "</PPointData>\n";
          WritePVTUFooter(pvtu_out, q_field_name);
 
-         pvd_stream << "<DataSet timestep=\"" << GetTime()
-                    << "\" group=\"\" part=\"" << 0 << "\" file=\""
-                    << q_fname << "\" name=\"" << q_field_name << "\"/>\n";
+         AddPVDDataSet(q_fname, q_field_name);
       }
-      pvd_stream.flush();
-      // Move the insertion point before the closing collection tag, so that
-      // the PVD file is valid even when writing incrementally.
-      std::fstream::pos_type pos = pvd_stream.tellp();
-      pvd_stream << "</Collection>\n";
-      pvd_stream << "</VTKFile>" << std::endl;
-      pvd_stream.seekp(pos);
    }
 }
 
+void ParaViewDataCollection::AddPVDDataSet(const std::string &file_name,
+                                           const std::string &data_name)
+{
+   pvd_stream << "<DataSet timestep=\"" << GetTime()
+              << "\" group=\"\" part=\"" << 0 << "\" file=\""
+              << file_name << "\" name=\"" << data_name << "\"/>\n";
+}
+
+void ParaViewDataCollection::SaveSingleVTU(const std::string &file_name,
+                                           const std::string &vtu)
+{
+#ifdef MFEM_USE_MPI
+   if (!serial)
+   {
+      // Rank 0 writes the file header, the last rank the footer, and the
+      // pieces of all ranks are written in between, in rank order
+      const std::string piece_end = "</Piece>\n";
+      const std::string::size_type begin = vtu.find("<Piece");
+      const std::string::size_type end = vtu.rfind(piece_end) +
+                                         piece_end.size();
+      MFEM_ASSERT(begin != std::string::npos && end > begin,
+                  "invalid VTU data");
+      const std::string data =
+         (myid == 0 ? vtu.substr(0, begin) : std::string()) +
+         vtu.substr(begin, end - begin) +
+         (myid == num_procs-1 ? vtu.substr(end) : std::string());
+      if (!WriteSharedFile(m_comm, file_name, data))
+      {
+         error = WRITE_ERROR;
+         MFEM_WARNING("Error writing VTU file: " << file_name);
+      }
+      return;
+   }
+#endif
+   std::ofstream os(file_name);
+   os << vtu;
+}
+
 void ParaViewDataCollection::WritePVTUHeader(std::ostream &os)
 {
    os << "<?xml version=\"1.0\"?>\n";
@@ -1171,4 +1349,666 @@ const char *ParaViewDataCollection::GetDataTypeString() const
    }
 }
 
+
+// class CheckpointDataCollection implementation
+
+static const char *checkpoint_header = "MFEM checkpoint v1.0";
+
+CheckpointDataCollection::CheckpointDataCollection(
+   const std::string& collection_name, Mesh *mesh_)
+   : DataCollection(collection_name, mesh_),
+     num_files(0)
+{
+   appendRankToFileName = true; // always include rank in file names
+   cycle = 0;                   // always include cycle in directory names
+}
+
+#ifdef MFEM_USE_MPI
+CheckpointDataCollection::CheckpointDataCollection(
+   MPI_Comm comm, const std::string& collection_name, Mesh *mesh_)
+   : CheckpointDataCollection(collection_name, mesh_)
+{
+   m_comm = comm;
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &num_procs);
+}
+#endif
+
+double CheckpointDataCollection::GetState(const std::string &state_name) const
+{
+   auto it = state.find(state_name);
+   MFEM_VERIFY(it != state.end(), "unknown state value: " << state_name);
+   return it->second;
+}
+
+std::string CheckpointDataCollection::GetCheckpointFileName(int index) const
+{
+   std::string dir_name = prefix_path + name;
+   if (cycle != -1)
+   {
+      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+   }
+   return dir_name + "/checkpoint." + to_padded_string(index, pad_digits_rank);
+}
+
+#ifdef MFEM_USE_MPI
+static const char *checkpoint_index_header = "MFEM checkpoint index v1.0";
+
+int CheckpointDataCollection::GetFileIndex() const
+{
+   // consecutive ranks share a file
+   const int nfiles = std::min(num_files, num_procs);
+   return (int)((long long)myid * nfiles / num_procs);
+}
+
+void CheckpointDataCollection::SaveAggregated(const std::string &data)
+{
+   VerifyIOThreadLevel();
+   const std::string file_name = GetCheckpointFileName(GetFileIndex());
+   MPI_Comm file_comm;
+   MPI_Comm_split(m_comm, GetFileIndex(), myid, &file_comm);
+   int file_rank, file_size;
+   MPI_Comm_rank(file_comm, &file_rank);
+   MPI_Comm_size(file_comm, &file_size);
+
+   // The first rank of each file writes the index of the data offsets of all
+   // the ranks of the file in front of its own data
+   long long size = data.size();
+   std::vector<long long> sizes(file_rank == 0 ? file_size : 0);
+   MPI_Gather(&size, 1, MPI_LONG_LONG, sizes.data(), 1, MPI_LONG_LONG, 0,
+              file_comm);
+   std::string index_and_data;
+   if (file_rank == 0)
+   {
+      std::ostringstream index;
+      index << checkpoint_index_header << '\n';
+      bin_io::write<int64_t>(index, file_size);
+      int64_t offset = (int64_t)index.tellp() +
+                       (file_size + 1)*sizeof(int64_t);
+      for (int i = 0; i < file_size; i++)
+      {
+         bin_io::write<int64_t>(index, offset);
+         offset += sizes[i];
+      }
+      bin_io::write<int64_t>(index, offset);
+      index_and_data = index.str() + data;
+   }
+   const bool ok = WriteSharedFile(file_comm, file_name,
+                                   file_rank == 0 ? index_and_data : data);
+   MPI_Comm_free(&file_comm);
+
+   int all_ok = ok;
+   MPI_Allreduce(MPI_IN_PLACE, &all_ok, 1, MPI_INT, MPI_MIN, m_comm);
+   if (!all_ok)
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error writing checkpoint file: " << file_name);
+   }
+}
+
+bool CheckpointDataCollection::LoadAggregated(std::string &data)
+{
+   const std::string file_name = GetCheckpointFileName(GetFileIndex());
+   MPI_Comm file_comm;
+   MPI_Comm_split(m_comm, GetFileIndex(), myid, &file_comm);
+   int file_rank, file_size;
+   MPI_Comm_rank(file_comm, &file_rank);
+   MPI_Comm_size(file_comm, &file_size);
+
+   // The first rank of each file reads the index and sends to each rank the
+   // offset and size of its data, or a negative size if the index is invalid
+   std::vector<long long> index;
+   if (file_rank == 0)
+   {
+      index.assign(2*file_size, -1);
+      std::ifstream is(file_name, std::ios::binary);
+      std::string header;
+      getline(is, header);
+      if (is && header == checkpoint_index_header &&
+          bin_io::read<int64_t>(is) == file_size)
+      {
+         int64_t begin = bin_io::read<int64_t>(is);
+         for (int i = 0; i < file_size; i++)
+         {
+            const int64_t end = bin_io::read<int64_t>(is);
+            index[2*i] = begin;
+            index[2*i+1] = end - begin;
+            begin = end;
+         }
+         if (!is) { index.assign(2*file_size, -1); }
+      }
+   }
+   long long loc[2];
+   MPI_Scatter(index.data(), 2, MPI_LONG_LONG, loc, 2, MPI_LONG_LONG, 0,
+               file_comm);
+   const bool valid = (loc[1] >= 0);
+   const bool ok = ReadSharedFile(file_comm, file_name, valid ? loc[0] : 0,
+                                  valid ? loc[1] : 0, data) && valid;
+   MPI_Comm_free(&file_comm);
+
+   int all_ok = ok;
+   MPI_Allreduce(MPI_IN_PLACE, &all_ok, 1, MPI_INT, MPI_MIN, m_comm);
+   if (!all_ok)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Unable to read checkpoint file: " << file_name);
+   }
+   return all_ok;
+}
+#endif
+
+void CheckpointDataCollection::SaveCheckpoint(std::ostream &os)
+{
+   os << checkpoint_header << '\n';
+   bin_io::write<int>(os, num_procs);
+   bin_io::write<int>(os, myid);
+   bin_io::write<int>(os, serial ? 0 : 1);
+   bin_io::write<int>(os, cycle);
+   bin_io::write<double>(os, time);
+   bin_io::write<double>(os, time_step);
+
+   bin_io::write<int>(os, state.size());
+   for (const auto &it : state)
+   {
+      bin_io::WriteString(os, it.first);
+      bin_io::write<double>(os, it.second);
+   }
+
+   mesh->PrintBinary(os);
+
+   bin_io::write<int>(os, field_map.NumFields());
+   for (FieldMapIterator it = field_map.begin(); it != field_map.end(); ++it)
+   {
+      const GridFunction &gf = *it->second;
+      const FiniteElementSpace &fes = *gf.FESpace();
+      MFEM_VERIFY(!fes.IsVariableOrder(),
+                  "variable order spaces are not supported: " << it->first);
+      bin_io::WriteString(os, it->first);
+      bin_io::WriteString(os, fes.FEColl()->Name());
+      bin_io::write<int>(os, fes.GetVDim());
+      bin_io::write<int>(os, fes.GetOrdering());
+      bin_io::write<int>(os, gf.Size());
+      bin_io::write(os, gf.HostRead(), gf.Size());
+   }
+
+   bin_io::write<int>(os, q_field_map.NumFields());
+   for (QFieldMapIterator it = q_field_map.begin(); it != q_field_map.end();
+        ++it)
+   {
+      const QuadratureFunction &qf = *it->second;
+      bin_io::WriteString(os, it->first);
+      bin_io::write<int>(os, qf.GetSpace()->GetOrder());
+      bin_io::write<int>(os, qf.GetVDim());
+      bin_io::write<int>(os, qf.Size());
+      bin_io::write(os, qf.HostRead(), qf.Size());
+   }
+   os << checkpoint_header << '\n';
+}
+
+void CheckpointDataCollection::Save()
+{
+   std::string dir_name = prefix_path + name;
+   if (cycle != -1)
+   {
+      dir_name += "_" + to_padded_string(cycle, pad_digits_cycle);
+   }
+   if (create_directory(dir_name, mesh, myid))
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error creating directory: " << dir_name);
+      return;
+   }
+
+#ifdef MFEM_USE_MPI
+   if (Aggregated())
+   {
+      std::ostringstream os;
+      SaveCheckpoint(os);
+      SaveAggregated(os.str());
+      return;
+   }
+#endif
+
+   const std::string file_name = GetCheckpointFileName(myid);
+   mfem::ofgzstream os(file_name, compression);
+   SaveCheckpoint(os);
+   if (!os)
+   {
+      error = WRITE_ERROR;
+      MFEM_WARNING("Error writing checkpoint file: " << file_name);
+   }
+}
+
+void CheckpointDataCollection::LoadCheckpoint(std::istream &is,
+                                              const std::string &file_name)
+{
+   std::string header;
+   getline(is, header);
+   if (!is || header != checkpoint_header)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Unable to read checkpoint file: " << file_name);
+      return;
+   }
+   const int saved_procs = bin_io::read<int>(is);
+   const int saved_rank = bin_io::read<int>(is);
+   const bool parallel = bin_io::read<int>(is);
+   if (saved_procs != num_procs || saved_rank != myid)
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Processor number mismatch: checkpoint file: "
+                   << saved_procs << ", collection: " << num_procs);
+      return;
+   }
+   cycle = bin_io::read<int>(is);
+   time = bin_io::read<double>(is);
+   time_step = bin_io::read<double>(is);
+
+   const int num_state = bin_io::read<int>(is);
+   for (int i = 0; i < num_state; i++)
+   {
+      const std::string state_name = bin_io::ReadString(is);
+      state[state_name] = bin_io::read<double>(is);
+   }
+
+   if (parallel)
+   {
+#ifdef MFEM_USE_MPI
+      mesh = new ParMesh(ParMesh::LoadBinary(m_comm, is));
+      serial = false;
+#else
+      error = READ_ERROR;
+      MFEM_WARNING("Reading parallel format in serial is not supported");
+      return;
+#endif
+   }
+   else
+   {
+      mesh = new Mesh(Mesh::LoadBinary(is));
+      serial = true;
+   }
+   own_data = true;
+
+   const int num_fields = bin_io::read<int>(is);
+   for (int i = 0; i < num_fields && is; i++)
+   {
+      const std::string field_name = bin_io::ReadString(is);
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(bin_io::ReadString(is).c_str());
+      const int vdim = bin_io::read<int>(is);
+      const int ordering = bin_io::read<int>(is);
+      GridFunction *gf;
+#ifdef MFEM_USE_MPI
+      if (!serial)
+      {
+         ParMesh *pmesh = static_cast<ParMesh*>(mesh);
+         gf = new ParGridFunction(new ParFiniteElementSpace(pmesh, fec, vdim,
+                                                            ordering));
+      }
+      else
+#endif
+      {
+         gf = new GridFunction(new FiniteElementSpace(mesh, fec, vdim,
+                                                      ordering));
+      }
+      gf->MakeOwner(fec);
+      field_map.Register(field_name, gf, own_data);
+      if (bin_io::read<int>(is) != gf->Size())
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Invalid size of the field: " << field_name);
+         break;
+      }
+      bin_io::read(is, gf->HostWrite(), gf->Size());
+   }
+
+   const int num_q_fields = error ? 0 : bin_io::read<int>(is);
+   for (int i = 0; i < num_q_fields && is; i++)
+   {
+      const std::string q_field_name = bin_io::ReadString(is);
+      const int order = bin_io::read<int>(is);
+      const int vdim = bin_io::read<int>(is);
+      QuadratureFunction *qf =
+         new QuadratureFunction(new QuadratureSpace(mesh, order), vdim);
+      qf->SetOwnsSpace(true);
+      q_field_map.Register(q_field_name, qf, own_data);
+      if (bin_io::read<int>(is) != qf->Size())
+      {
+         error = READ_ERROR;
+         MFEM_WARNING("Invalid size of the q-field: " << q_field_name);
+         break;
+      }
+      bin_io::read(is, qf->HostWrite(), qf->Size());
+   }
+
+   getline(is, header);
+   if (!error && (!is || header != checkpoint_header))
+   {
+      error = READ_ERROR;
+      MFEM_WARNING("Error reading checkpoint file: " << file_name);
+   }
+   if (error)
+   {
+      DeleteAll();
+   }
+}
+
+void CheckpointDataCollection::Load(int cycle_)
+{
+   DeleteAll();
+   state.clear();
+   error = NO_ERROR;
+   cycle = cycle_;
+
+#ifdef MFEM_USE_MPI
+   if (Aggregated())
+   {
+      std::string data;
+      if (LoadAggregated(data))
+      {
+         std::istringstream is(data);
+         LoadCheckpoint(is, GetCheckpointFileName(GetFileIndex()));
+      }
+      return;
+   }
+#endif
+
+   const std::string file_name = GetCheckpointFileName(myid);
+   mfem::ifgzstream is(file_name);
+   LoadCheckpoint(is, file_name);
+}
+
+#ifdef MFEM_USE_THREADS
+
+// class AsyncDataCollection implementation
+
+// Copy the host data of @a src into @a dst, of the same size
+static void HostCopy(const Vector &src, Vector &dst)
+{
+   MFEM_ASSERT(src.Size() == dst.Size(), "incompatible sizes");
+   const double *d = src.HostRead();
+   std::copy(d, d + src.Size(), dst.GetData());
+}
+
+AsyncDataCollection::Snapshot::~Snapshot()
+{
+   for (auto &f : fields) { delete f.second; }
+   for (auto &qf : q_fields) { delete qf.second; }
+}
+
+AsyncDataCollection::AsyncDataCollection(DataCollection &dc, Mesh *mesh_,
+                                         int max_pending)
+   : DataCollection(dc.GetCollectionName(), mesh_),
+     io_dc(dc),
+     max_pending(max_pending),
+     io_mesh(NULL),
+     io_mesh_sequence(-1),
+     stop(false),
+     io_error(NO_ERROR)
+{
+   MFEM_VERIFY(max_pending > 0, "invalid max_pending = " << max_pending);
+   prefix_path = dc.GetPrefixPath();
+}
+
+void AsyncDataCollection::SetMesh(Mesh *new_mesh)
+{
+   WaitForSave();
+   DeleteIOCopies();
+   DataCollection::SetMesh(new_mesh);
+}
+
+#ifdef MFEM_USE_MPI
+void AsyncDataCollection::SetMesh(MPI_Comm comm, Mesh *new_mesh)
+{
+   // calls the virtual SetMesh(Mesh*) above
+   DataCollection::SetMesh(comm, new_mesh);
+}
+#endif
+
+bool AsyncDataCollection::IOCopiesOutdated() const
+{
+   if (io_mesh == NULL || io_mesh_sequence != mesh->GetSequence())
+   {
+      return true;
+   }
+   for (const auto &it : GetFieldMap())
+   {
+      const FiniteElementSpace *fes = it.second->FESpace();
+      auto seq = io_fes_sequence.find(fes);
+      if (seq == io_fes_sequence.end() || seq->second != fes->GetSequence())
+      {
+         return true;
+      }
+   }
+   for (const auto &it : GetQFieldMap())
+   {
+      if (io_qspace.find(it.second->GetSpace()) == io_qspace.end())
+      {
+         return true;
+      }
+   }
+   return false;
+}
+
+FiniteElementSpace *AsyncDataCollection::GetIOSpace(
+   const FiniteElementSpace *fes)
+{
+   auto it = io_fes.find(fes);
+   if (it != io_fes.end()) { return it->second; }
+
+   FiniteElementCollection *fec =
+      FiniteElementCollection::New(fes->FEColl()->Name());
+   io_fec.Append(fec);
+   FiniteElementSpace *copy;
+#ifdef MFEM_USE_MPI
+   const ParFiniteElementSpace *pfes =
+      dynamic_cast<const ParFiniteElementSpace*>(fes);
+   ParMesh *io_pmesh = dynamic_cast<ParMesh*>(io_mesh);
+   if (pfes && io_pmesh)
+   {
+      copy = new ParFiniteElementSpace(*pfes, io_pmesh, fec);
+   }
+   else
+#endif
+   {
+      copy = new FiniteElementSpace(*fes, io_mesh, fec);
+   }
+   io_fes[fes] = copy;
+   io_fes_sequence[fes] = fes->GetSequence();
+   return copy;
+}
+
+QuadratureSpace *AsyncDataCollection::GetIOSpace(const QuadratureSpace *qspace)
+{
+   auto it = io_qspace.find(qspace);
+   if (it != io_qspace.end()) { return it->second; }
+   QuadratureSpace *copy = new QuadratureSpace(io_mesh, qspace->GetOrder());
+   io_qspace[qspace] = copy;
+   return copy;
+}
+
+void AsyncDataCollection::CreateIOCopies()
+{
+   DeleteIOCopies();
+#ifdef MFEM_USE_MPI
+   ParMesh *pmesh = dynamic_cast<ParMesh*>(mesh);
+   io_mesh = pmesh ? new ParMesh(*pmesh, true) : new Mesh(*mesh, true);
+#else
+   io_mesh = new Mesh(*mesh, true);
+#endif
+   io_mesh_sequence = mesh->GetSequence();
+   for (const auto &it : GetFieldMap()) { GetIOSpace(it.second->FESpace()); }
+   for (const auto &it : GetQFieldMap()) { GetIOSpace(it.second->GetSpace()); }
+   io_dc.SetMesh(io_mesh);
+}
+
+void AsyncDataCollection::DeleteIOCopies()
+{
+   for (auto &it : io_qspace) { delete it.second; }
+   io_qspace.clear();
+   for (auto &it : io_fes) { delete it.second; }
+   io_fes.clear();
+   io_fes_sequence.clear();
+   for (int i = 0; i < io_fec.Size(); i++) { delete io_fec[i]; }
+   io_fec.DeleteAll();
+   delete io_mesh;
+   io_mesh = NULL;
+   io_mesh_sequence = -1;
+}
+
+void AsyncDataCollection::Save()
+{
+   MFEM_VERIFY(mesh != NULL, "the collection has no mesh");
+   {
+      // backpressure: wait for a free slot in the queue
+      std::unique_lock<std::mutex> lock(queue_mutex);
+      queue_cv.wait(lock, [this] { return (int)queue.size() < max_pending; });
+      if (io_error != NO_ERROR) { error = io_error; io_error = NO_ERROR; }
+   }
+
+   if (IOCopiesOutdated())
+   {
+      // the I/O thread uses the copies, update them when it is idle
+      WaitForSave();
+      CreateIOCopies();
+   }
+
+   // Take the snapshot
+   Snapshot *snapshot = new Snapshot;
+   snapshot->cycle = cycle;
+   snapshot->time = time;
+   snapshot->time_step = time_step;
+   if (mesh->GetNodes())
+   {
+      snapshot->nodes.SetSize(mesh->GetNodes()->Size());
+      HostCopy(*mesh->GetNodes(), snapshot->nodes);
+   }
+   else
+   {
+      mesh->GetVertices(snapshot->nodes);
+   }
+   for (const auto &it : GetFieldMap())
+   {
+      FiniteElementSpace *fes = GetIOSpace(it.second->FESpace());
+      GridFunction *gf;
+#ifdef MFEM_USE_MPI
+      ParFiniteElementSpace *pfes = dynamic_cast<ParFiniteElementSpace*>(fes);
+      if (pfes) { gf = new ParGridFunction(pfes); }
+      else
+#endif
+      {
+         gf = new GridFunction(fes);
+      }
+      HostCopy(*it.second, *gf);
+      snapshot->fields.emplace_back(it.first, gf);
+   }
+   for (const auto &it : GetQFieldMap())
+   {
+      QuadratureFunction *qf =
+         new QuadratureFunction(GetIOSpace(it.second->GetSpace()),
+                                it.second->GetVDim());
+      HostCopy(*it.second, *qf);
+      snapshot->q_fields.emplace_back(it.first, qf);
+   }
+
+   // Queue it for the I/O thread, started on the first save
+   {
+      std::lock_guard<std::mutex> lock(queue_mutex);
+      queue.push_back(snapshot);
+   }
+   queue_cv.notify_all();
+   if (!io_thread.joinable())
+   {
+      io_thread = std::thread(&AsyncDataCollection::IOLoop, this);
+   }
+}
+
+void AsyncDataCollection::WriteSnapshot(Snapshot &snapshot)
+{
+   if (io_mesh->GetNodes())
+   {
+      HostCopy(snapshot.nodes, *io_mesh->GetNodes());
+   }
+   else
+   {
+      io_mesh->SetVertices(snapshot.nodes);
+   }
+   for (auto &f : snapshot.fields) { io_dc.RegisterField(f.first, f.second); }
+   for (auto &qf : snapshot.q_fields)
+   {
+      io_dc.RegisterQField(qf.first, qf.second);
+   }
+   io_dc.SetCycle(snapshot.cycle);
+   io_dc.SetTime(snapshot.time);
+   io_dc.SetTimeStep(snapshot.time_step);
+
+   io_dc.Save();
+
+   for (auto &f : snapshot.fields) { io_dc.DeregisterField(f.first); }
+   for (auto &qf : snapshot.q_fields) { io_dc.DeregisterQField(qf.first); }
+}
+
+void AsyncDataCollection::IOLoop()
+{
+   on_io_thread = true;
+   std::unique_lock<std::mutex> lock(queue_mutex);
+   while (true)
+   {
+      queue_cv.wait(lock, [this] { return stop || !queue.empty(); });
+      if (queue.empty()) { break; }
+
+      // The snapshot stays in the queue while it is written, so that
+      // WaitForSave() and the backpressure account for it
+      Snapshot *snapshot = queue.front();
+      lock.unlock();
+      WriteSnapshot(*snapshot);
+      const int err = io_dc.Error();
+      io_dc.ResetError();
+      delete snapshot;
+      lock.lock();
+
+      if (err != NO_ERROR) { io_error = err; }
+      queue.pop_front();
+      queue_cv.notify_all();
+   }
+}
+
+void AsyncDataCollection::WaitForSave()
+{
+   std::unique_lock<std::mutex> lock(queue_mutex);
+   queue_cv.wait(lock, [this] { return queue.empty(); });
+   if (io_error != NO_ERROR) { error = io_error; io_error = NO_ERROR; }
+}
+
+int AsyncDataCollection::GetNumPending()
+{
+   std::lock_guard<std::mutex> lock(queue_mutex);
+   return (int)queue.size();
+}
+
+void AsyncDataCollection::Load(int)
+{
+   MFEM_WARNING("AsyncDataCollection::Load() is not implemented, use the "
+                "wrapped collection instead!");
+   error = READ_ERROR;
+}
+
+AsyncDataCollection::~AsyncDataCollection()
+{
+   if (io_thread.joinable())
+   {
+      {
+         std::lock_guard<std::mutex> lock(queue_mutex);
+         stop = true;
+      }
+      queue_cv.notify_all();
+      io_thread.join();
+   }
+   // the mesh of the wrapped collection is deleted with the copies
+   if (io_mesh) { io_dc.SetMesh(NULL); }
+   DeleteIOCopies();
+}
+
+#endif // MFEM_USE_THREADS
+
 }  // end namespace MFEM
@@ -20,6 +20,13 @@
 #include <string>
 #include <map>
 #include <fstream>
+#include <vector>
+#include <deque>
+#ifdef MFEM_USE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
 
 namespace mfem
 {
@@ -233,6 +240,23 @@ protected:
    static int create_directory(const std::string &dir_name,
                                const Mesh *mesh, int myid);
 
+#ifdef MFEM_USE_MPI
+   /** @brief Collectively write the @a data of all ranks in @a comm to the
+       file @a file_name with MPI-IO, in rank order. */
+   /** The offset of each rank in the file is the prefix sum of the data sizes
+       of the lower ranks. Returns false if the file could not be written on
+       any of the ranks. */
+   static bool WriteSharedFile(MPI_Comm comm, const std::string &file_name,
+                               const std::string &data);
+
+   /** @brief Collectively read @a size bytes at @a offset in the file
+       @a file_name with MPI-IO, on each rank of @a comm. */
+   /** Returns false if the file could not be read on any of the ranks. */
+   static bool ReadSharedFile(MPI_Comm comm, const std::string &file_name,
+                              long long offset, long long size,
+                              std::string &data);
+#endif
+
 public:
    /// Initialize the collection with its name and Mesh.
    /** When @a mesh_ is NULL, then the real mesh can be set with SetMesh(). */
@@ -489,8 +513,13 @@ private:
    VTKFormat pv_data_format;
    bool high_order_output;
    bool restart_mode;
+   bool single_file;
 
 protected:
+   void SaveVTUFiles(const std::string &vtu_prefix);
+   void SaveSingleVTU(const std::string &file_name, const std::string &vtu);
+   void AddPVDDataSet(const std::string &file_name,
+                      const std::string &data_name);
    void WritePVTUHeader(std::ostream &out);
    void WritePVTUFooter(std::ostream &out, const std::string &vtu_prefix);
    void SaveDataVTU(std::ostream &out, int ref);
@@ -552,9 +581,203 @@ public:
    /// defined time.
    void UseRestartMode(bool restart_mode_);
 
+   /// Enable or disable the output of a single VTU file per cycle.
+   /** If enabled, the data of all ranks is written to the file
+       "Cycle<cycle>/data.vtu" (and to one file per quadrature function field),
+       with one piece per rank, using collective MPI-IO writes, instead of one
+       VTU file per rank and a PVTU file. This reduces the number of files in
+       large parallel runs. Disabled by default. */
+   void UseSingleFile(bool single_file_) { single_file = single_file_; }
+
    /// Load the collection - not implemented in the ParaView writer
    virtual void Load(int cycle_ = 0) override;
 };
 
+
+/// Data collection for fast checkpoint and restart, in a binary format.
+/** Each rank writes a single file, "<name>_<cycle>/checkpoint.<rank>", or
+    its part of a shared file, see SetNumFiles(), with the cycle, time and
+    time step, the named state values set with SetState(), the mesh (see
+    Mesh::PrintBinary() and ParMesh::PrintBinary()), and the registered fields
+    and q-fields stored as raw arrays of doubles. Load()
+    restores all of them on the same number of ranks, reusing the saved mesh
+    partitioning, so the loaded fields have the same local data as the saved
+    ones. The files use the native endianness and are not portable across
+    different kinds of machines. */
+class CheckpointDataCollection : public DataCollection
+{
+protected:
+   /// Named scalar values saved with the collection
+   std::map<std::string, double> state;
+
+   /// Number of aggregated files in parallel, 0 for one file per rank
+   int num_files;
+
+   /// Name of the file of the given rank, or of the given aggregated file.
+   std::string GetCheckpointFileName(int index) const;
+
+   void SaveCheckpoint(std::ostream &os);
+   void LoadCheckpoint(std::istream &is, const std::string &file_name);
+
+#ifdef MFEM_USE_MPI
+   bool Aggregated() const
+   { return num_files > 0 && m_comm != MPI_COMM_NULL; }
+
+   /// Index of the aggregated file containing the data of this rank.
+   int GetFileIndex() const;
+
+   void SaveAggregated(const std::string &data);
+   bool LoadAggregated(std::string &data);
+#endif
+
+public:
+   /// Constructor. The collection name is used when saving the data.
+   CheckpointDataCollection(const std::string& collection_name,
+                            Mesh *mesh_ = NULL);
+
+#ifdef MFEM_USE_MPI
+   /// Construct a parallel collection, which can be loaded with Load().
+   CheckpointDataCollection(MPI_Comm comm, const std::string& collection_name,
+                            Mesh *mesh_ = NULL);
+#endif
+
+   /// Set a named value saved with the collection, e.g. time integrator data.
+   void SetState(const std::string &state_name, double value)
+   { state[state_name] = value; }
+
+   /// Check if the collection has a value named @a state_name.
+   bool HasState(const std::string &state_name) const
+   { return state.find(state_name) != state.end(); }
+
+   /// Get a named value set with SetState(), or loaded with Load().
+   double GetState(const std::string &state_name) const;
+
+   /// Set the number of files written by Save() in parallel (N-to-M output).
+   /** By default (@a nfiles = 0), each rank writes its own file with standard
+       file streams. With @a nfiles > 0, consecutive ranks are grouped into
+       @a nfiles files, "<name>_<cycle>/checkpoint.<file>", that are written
+       and read with collective MPI-IO operations. Each file starts with an
+       index of the offsets of the data of its ranks. Load() must use the same
+       number of files. In serial, this setting has no effect. */
+   void SetNumFiles(int nfiles) { num_files = nfiles; }
+
+   /// Save the mesh, fields and state in the binary checkpoint format.
+   void Save() override;
+
+   /// Load the collection saved for the given cycle.
+   /** In parallel, the collection must have been constructed with the same
+       number of ranks as the one that was saved. */
+   void Load(int cycle_ = 0) override;
+};
+
+#ifdef MFEM_USE_THREADS
+
+/// Asynchronous saving of the data of another DataCollection.
+/** The fields and q-fields are registered with this collection as usual.
+    Save() copies their data, together with the cycle, time, time step and the
+    mesh nodes, into a staging snapshot and returns, while the wrapped
+    collection, given to the constructor, writes the snapshot on a dedicated
+    I/O thread. At most @a max_pending snapshots are kept: when the queue is
+    full, Save() waits until the oldest one is written (backpressure).
+
+    The I/O thread only uses its own copies of the mesh, the finite element
+    collections and spaces, and the quadrature spaces, so the computation can
+    continue, and modify the registered fields, while the data is written. The
+    copies are created by Save() when needed, e.g. after the mesh or a space
+    is updated, in which case Save() first waits for the pending snapshots.
+
+    The wrapped collection should not be used directly while it is wrapped,
+    and it should not own its data. The registered fields are expected to be
+    valid on the host, see Vector::HostRead(). The I/O thread uses the global
+    GlobGeometryRefiner (ParaViewDataCollection), which should not be used
+    concurrently by the main thread.
+
+    In parallel, the I/O thread does not communicate, except when the wrapped
+    collection writes shared files (see CheckpointDataCollection::SetNumFiles()
+    and ParaViewDataCollection::UseSingleFile()), which requires MPI to be
+    initialized with MPI_THREAD_MULTIPLE.
+
+    Requires the build option MFEM_USE_THREADS. */
+class AsyncDataCollection : public DataCollection
+{
+protected:
+   /// Data saved by one call to Save().
+   struct Snapshot
+   {
+      int cycle;
+      double time, time_step;
+      Vector nodes;
+      std::vector<std::pair<std::string, GridFunction*>> fields;
+      std::vector<std::pair<std::string, QuadratureFunction*>> q_fields;
+      ~Snapshot();
+   };
+
+   /// The collection that writes the data, used only by the I/O thread
+   DataCollection &io_dc;
+   const int max_pending;
+
+   /// Copies of the mesh and of the spaces, used by the I/O thread
+   Mesh *io_mesh;
+   long io_mesh_sequence;
+   std::map<const FiniteElementSpace*, FiniteElementSpace*> io_fes;
+   std::map<const FiniteElementSpace*, long> io_fes_sequence;
+   std::map<const QuadratureSpace*, QuadratureSpace*> io_qspace;
+   Array<FiniteElementCollection*> io_fec;
+
+   /// Snapshots being written or waiting to be written, oldest first
+   std::deque<Snapshot*> queue;
+   std::mutex queue_mutex;
+   std::condition_variable queue_cv;
+   std::thread io_thread;
+   bool stop;
+   int io_error;
+
+   /// Return true if the copies of the mesh or of the spaces are outdated.
+   bool IOCopiesOutdated() const;
+   /// Copy the mesh and the spaces of the registered fields; no pending saves.
+   void CreateIOCopies();
+   void DeleteIOCopies();
+   FiniteElementSpace *GetIOSpace(const FiniteElementSpace *fes);
+   QuadratureSpace *GetIOSpace(const QuadratureSpace *qspace);
+
+   /// Main loop of the I/O thread.
+   void IOLoop();
+   void WriteSnapshot(Snapshot &snapshot);
+
+public:
+   /// Save the data of this collection with @a dc, on a background thread.
+   /** The mesh of @a dc is replaced by a copy of @a mesh_, which is deleted,
+       and reset to NULL, by the destructor. The name of the collection is the
+       one of @a dc. */
+   AsyncDataCollection(DataCollection &dc, Mesh *mesh_, int max_pending = 2);
+
+   /// Set/change the mesh, after waiting for the pending snapshots.
+   void SetMesh(Mesh *new_mesh) override;
+
+#ifdef MFEM_USE_MPI
+   /// Set/change the mesh, after waiting for the pending snapshots.
+   void SetMesh(MPI_Comm comm, Mesh *new_mesh) override;
+#endif
+
+   /// Take a snapshot of the data and queue it for writing.
+   /** Waits while @a max_pending snapshots are already queued. The errors of
+       the previous snapshots are reported by Error(). */
+   void Save() override;
+
+   /// Wait until all the queued snapshots are written.
+   void WaitForSave();
+
+   /// Return the number of snapshots that are not written yet.
+   int GetNumPending();
+
+   /// Load the collection - not implemented, use the wrapped collection
+   void Load(int cycle_ = 0) override;
+
+   /// Wait for the pending snapshots and stop the I/O thread.
+   virtual ~AsyncDataCollection();
+};
+
+#endif // MFEM_USE_THREADS
+
 }
 #endif
@@ -0,0 +1,375 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "eltrans_batch.hpp"
+#include "fe_coll.hpp"
+#include "../mesh/mesh.hpp"
+#include "../general/forall.hpp"
+#include "../linalg/dtensor.hpp"
+#include "../linalg/kernels.hpp"
+
+namespace mfem
+{
+
+BatchInverseElementTransformation::BatchInverseElementTransformation(
+   Mesh &mesh_)
+   : mesh(&mesh_),
+     sequence(-1),
+     dim(mesh_.Dimension()),
+     sdim(mesh_.SpaceDimension()),
+     max_iter(16),
+     ref_tol(1e-15),
+     phys_rtol(1e-15),
+     tensor(false),
+     d1d(0),
+     vert_fec(NULL),
+     vert_fes(NULL),
+     vert_nodes(NULL)
+{
+   Setup();
+}
+
+void BatchInverseElementTransformation::DeleteVertexNodes()
+{
+   delete vert_nodes;
+   delete vert_fes;
+   delete vert_fec;
+   vert_nodes = NULL;
+   vert_fes = NULL;
+   vert_fec = NULL;
+}
+
+void BatchInverseElementTransformation::Setup()
+{
+   DeleteVertexNodes();
+   sequence = mesh->GetSequence();
+   dim = mesh->Dimension();
+   sdim = mesh->SpaceDimension();
+   tensor = false;
+
+   // The kernels support only meshes of segments, quads or hexes
+   const int ne = mesh->GetNE();
+   if (ne == 0 || dim < 1) { return; }
+   const Geometry::Type geom = TensorBasisElement::GetTensorProductGeometry(dim);
+   for (int i = 0; i < ne; i++)
+   {
+      if (mesh->GetElementBaseGeometry(i) != geom) { return; }
+   }
+
+   const GridFunction *nodes = mesh->GetNodes();
+   if (nodes == NULL)
+   {
+      vert_fec = new H1_FECollection(1, dim);
+      vert_fes = new FiniteElementSpace(mesh, vert_fec, sdim);
+      vert_nodes = new GridFunction(vert_fes);
+      mesh->GetNodes(*vert_nodes);
+      nodes = vert_nodes;
+   }
+
+   // Nodal tensor product basis of a single order, e.g. not Bernstein
+   const FiniteElementSpace *fes = nodes->FESpace();
+   if (fes->IsVariableOrder()) { return; }
+   const NodalTensorFiniteElement *fe =
+      dynamic_cast<const NodalTensorFiniteElement*>(fes->GetFE(0));
+   if (fe == NULL || fe->GetBasis1D().IsIntegratedType()) { return; }
+   d1d = fe->GetOrder() + 1;
+   if (d1d > MAX_D1D) { return; }
+   const double *z = poly1d.GetPoints(d1d - 1, fe->GetBasisType());
+   if (z == NULL) { return; }
+
+   // Barycentric Lagrange interpolation: l_j(x) = w_j prod_{m!=j} (x - z_m)
+   z1d.SetSize(d1d);
+   w1d.SetSize(d1d);
+   for (int j = 0; j < d1d; j++)
+   {
+      double w = 1.0;
+      for (int m = 0; m < d1d; m++)
+      {
+         if (m != j) { w *= z[j] - z[m]; }
+      }
+      z1d(j) = z[j];
+      w1d(j) = 1.0/w;
+   }
+
+   const Operator *R =
+      fes->GetElementRestriction(ElementDofOrdering::LEXICOGRAPHIC);
+   enodes.SetSize(R->Height(), Device::GetDeviceMemoryType());
+   enodes.UseDevice(true);
+   R->Mult(*nodes, enodes);
+   tensor = true;
+}
+
+void BatchInverseElementTransformation::Update()
+{
+   Setup();
+}
+
+// Solve the DIM x DIM system A x = b
+template<int DIM> MFEM_HOST_DEVICE inline
+void SmallSolve(const double *A, const double *b, double *x)
+{
+   double Ainv[DIM*DIM];
+   kernels::CalcInverse<DIM>(A, Ainv);
+   kernels::Mult(DIM, DIM, Ainv, b, x);
+}
+
+template<> MFEM_HOST_DEVICE inline
+void SmallSolve<1>(const double *A, const double *b, double *x)
+{
+   x[0] = b[0]/A[0];
+}
+
+// Newton iteration of InverseElementTransformation::NewtonSolve(), with the
+// NewtonElementProject solver and the Center initial guess
+template<int DIM>
+static void TransformKernel(const int npts, const int sdim, const int d1d,
+                            const int ne, const bool byvdim, const int max_iter,
+                            const double ref_tol, const double phys_rtol,
+                            const Vector &z1d, const Vector &w1d,
+                            const Vector &enodes, const Vector &pts,
+                            const Array<int> &elems, Array<int> &types,
+                            Vector &refs)
+{
+   constexpr int MD1 = MAX_D1D;
+   const int nd = TensorBasisElement::Pow(d1d, DIM);
+   const auto Z = z1d.Read();
+   const auto W = w1d.Read();
+   const auto X = Reshape(enodes.Read(), nd, sdim, ne);
+   const auto E = elems.Read();
+   const auto P = pts.Read();
+   auto R = refs.Write();
+   auto T = types.Write();
+
+   MFEM_FORALL(k, npts,
+   {
+      const int e = E[k];
+      double pt[3], x[DIM], prev_x[DIM];
+      double pt_norm = 0.0;
+      for (int c = 0; c < sdim; c++)
+      {
+         pt[c] = P[byvdim ? sdim*k + c : k + npts*c];
+         pt_norm = fmax(pt_norm, fabs(pt[c]));
+      }
+      const double phys_tol = phys_rtol*pt_norm;
+      for (int d = 0; d < DIM; d++) { x[d] = prev_x[d] = 0.5; }
+
+      bool hit_bdr = false, prev_hit_bdr = false;
+      int type = InverseElementTransformation::Unknown;
+      for (int it = 0; true; )
+      {
+         // 1D basis functions and their derivatives at x
+         double B[DIM][MD1], G[DIM][MD1];
+         for (int d = 0; d < DIM; d++)
+         {
+            for (int j = 0; j < d1d; j++)
+            {
+               double val = 1.0, der = 0.0;
+               for (int m = 0; m < d1d; m++)
+               {
+                  if (m == j) { continue; }
+                  der = der*(x[d] - Z[m]) + val;
+                  val *= x[d] - Z[m];
+               }
+               B[d][j] = W[j]*val;
+               G[d][j] = W[j]*der;
+            }
+         }
+
+         // Physical point F and column-major Jacobian J at x
+         double F[3], J[3*DIM];
+         for (int c = 0; c < sdim; c++) { F[c] = 0.0; }
+         for (int c = 0; c < sdim*DIM; c++) { J[c] = 0.0; }
+         for (int i = 0; i < nd; i++)
+         {
+            int idx[DIM];
+            for (int d = 0, r = i; d < DIM; d++, r /= d1d) { idx[d] = r % d1d; }
+            double b = 1.0, g[DIM];
+            for (int d = 0; d < DIM; d++)
+            {
+               g[d] = G[d][idx[d]];
+               for (int d2 = 0; d2 < DIM; d2++)
+               {
+                  if (d2 != d) { g[d] *= B[d2][idx[d2]]; }
+               }
+               b *= B[d][idx[d]];
+            }
+            for (int c = 0; c < sdim; c++)
+            {
+               const double xn = X(i,c,e);
+               F[c] += b*xn;
+               for (int d = 0; d < DIM; d++) { J[c + sdim*d] += g[d]*xn; }
+            }
+         }
+
+         // Check for convergence in physical coordinates
+         double err_phys = 0.0;
+         for (int c = 0; c < sdim; c++)
+         {
+            F[c] = pt[c] - F[c];
+            err_phys = fmax(err_phys, fabs(F[c]));
+         }
+         if (err_phys < phys_tol)
+         {
+            type = InverseElementTransformation::Inside;
+            break;
+         }
+
+         // Stuck on the boundary of the reference element
+         if (hit_bdr && prev_hit_bdr)
+         {
+            double real_dx_norm = 0.0;
+            for (int d = 0; d < DIM; d++)
+            {
+               real_dx_norm = fmax(real_dx_norm, fabs(x[d] - prev_x[d]));
+            }
+            if (real_dx_norm < ref_tol)
+            {
+               type = InverseElementTransformation::Outside;
+               break;
+            }
+         }
+
+         if (it == max_iter) { break; }
+
+         // Newton step: dx = J^{-1} (pt - F), or the least squares solution
+         // dx = (J^t J)^{-1} J^t (pt - F) when DIM < SDIM
+         double A[DIM*DIM], rhs[DIM], dx[DIM];
+         if (sdim == DIM)
+         {
+            for (int c = 0; c < DIM*DIM; c++) { A[c] = J[c]; }
+            for (int d = 0; d < DIM; d++) { rhs[d] = F[d]; }
+         }
+         else
+         {
+            for (int d = 0; d < DIM; d++)
+            {
+               rhs[d] = 0.0;
+               for (int c = 0; c < sdim; c++) { rhs[d] += J[c + sdim*d]*F[c]; }
+               for (int d2 = 0; d2 < DIM; d2++)
+               {
+                  double a = 0.0;
+                  for (int c = 0; c < sdim; c++)
+                  {
+                     a += J[c + sdim*d]*J[c + sdim*d2];
+                  }
+                  A[d + DIM*d2] = a;
+               }
+            }
+         }
+         SmallSolve<DIM>(A, rhs, dx);
+         it++;
+
+         // Project the new iterate to the reference element
+         prev_hit_bdr = hit_bdr;
+         hit_bdr = false;
+         double dx_norm = 0.0;
+         for (int d = 0; d < DIM; d++)
+         {
+            prev_x[d] = x[d];
+            x[d] += dx[d];
+            if (x[d] < 0.0) { x[d] = 0.0; hit_bdr = true; }
+            else if (x[d] > 1.0) { x[d] = 1.0; hit_bdr = true; }
+            dx_norm = fmax(dx_norm, fabs(dx[d]));
+         }
+
+         // Check for convergence in reference coordinates
+         if (dx_norm < ref_tol)
+         {
+            type = InverseElementTransformation::Inside;
+            break;
+         }
+      }
+
+      for (int d = 0; d < DIM; d++)
+      {
+         R[byvdim ? DIM*k + d : k + npts*d] = x[d];
+      }
+      T[k] = type;
+   });
+}
+
+void BatchInverseElementTransformation::TransformHost(
+   const Vector &pts, const Array<int> &elems, Ordering::Type ordering,
+   Array<int> &types, Vector &refs) const
+{
+   const int npts = elems.Size();
+   const bool byvdim = (ordering == Ordering::byVDIM);
+   InverseElementTransformation inv_tr;
+   inv_tr.SetMaxIter(max_iter);
+   inv_tr.SetReferenceTol(ref_tol);
+   inv_tr.SetPhysicalRelTol(phys_rtol);
+
+   const double *P = pts.HostRead();
+   const int *E = elems.HostRead();
+   double *R = refs.HostWrite();
+   int *T = types.HostWrite();
+   Vector pt(sdim);
+   IntegrationPoint ip;
+   double x[3];
+   for (int k = 0; k < npts; k++)
+   {
+      for (int c = 0; c < sdim; c++)
+      {
+         pt(c) = P[byvdim ? sdim*k + c : k + npts*c];
+      }
+      inv_tr.SetTransformation(*mesh->GetElementTransformation(E[k]));
+      T[k] = inv_tr.Transform(pt, ip);
+      ip.Get(x, dim);
+      for (int d = 0; d < dim; d++)
+      {
+         R[byvdim ? dim*k + d : k + npts*d] = x[d];
+      }
+   }
+}
+
+void BatchInverseElementTransformation::Transform(
+   const Vector &pts, const Array<int> &elems, Ordering::Type ordering,
+   Array<int> &types, Vector &refs) const
+{
+   MFEM_VERIFY(sequence == mesh->GetSequence(),
+               "the mesh was modified, call Update()");
+   const int npts = elems.Size();
+   MFEM_VERIFY(pts.Size() == sdim*npts, "invalid size of pts: " << pts.Size()
+               << ", expected " << sdim*npts);
+   types.SetSize(npts);
+   refs.SetSize(dim*npts);
+   if (npts == 0) { return; }
+
+   if (!tensor)
+   {
+      TransformHost(pts, elems, ordering, types, refs);
+      return;
+   }
+
+   const int ne = mesh->GetNE();
+   const bool byvdim = (ordering == Ordering::byVDIM);
+   switch (dim)
+   {
+      case 1:
+         TransformKernel<1>(npts, sdim, d1d, ne, byvdim, max_iter, ref_tol,
+                            phys_rtol, z1d, w1d, enodes, pts, elems, types,
+                            refs);
+         break;
+      case 2:
+         TransformKernel<2>(npts, sdim, d1d, ne, byvdim, max_iter, ref_tol,
+                            phys_rtol, z1d, w1d, enodes, pts, elems, types,
+                            refs);
+         break;
+      case 3:
+         TransformKernel<3>(npts, sdim, d1d, ne, byvdim, max_iter, ref_tol,
+                            phys_rtol, z1d, w1d, enodes, pts, elems, types,
+                            refs);
+         break;
+      default: MFEM_ABORT("invalid dimension: " << dim);
+   }
+}
+
+}
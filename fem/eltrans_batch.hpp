@@ -0,0 +1,110 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_ELTRANS_BATCH
+#define MFEM_ELTRANS_BATCH
+
+#include "../config/config.hpp"
+#include "eltrans.hpp"
+#include "fespace.hpp"
+#include "gridfunc.hpp"
+
+namespace mfem
+{
+
+/** @brief Inverse transformation of many (element, physical point) pairs of a
+    Mesh at once, i.e. a batched version of InverseElementTransformation.
+
+    For meshes of quadrilaterals or hexahedra (or segments) with nodal tensor
+    product nodes, e.g. H1 or L2 with a nodal basis, of order less than
+    MAX_D1D, all the Newton problems are solved in a single MFEM_FORALL kernel,
+    on the device when one is enabled, from the lexicographic E-vector of the
+    mesh nodes. Otherwise, the points are mapped on the host, one at a time,
+    with an InverseElementTransformation.
+
+    Both versions start at the center of the reference element and use the
+    InverseElementTransformation::NewtonElementProject algorithm, with the same
+    default tolerances, and return the same InverseElementTransformation::
+    TransformResult values. */
+class BatchInverseElementTransformation
+{
+protected:
+   Mesh *mesh;
+   long sequence; ///< Mesh::GetSequence() when the node data was set up
+   int dim, sdim;
+   int max_iter;
+   double ref_tol, phys_rtol;
+
+   /// Tensor product data, used when UsesTensorKernels() is true
+   bool tensor;
+   int d1d;        ///< number of 1D nodes
+   Vector z1d;     ///< 1D node coordinates
+   Vector w1d;     ///< barycentric weights of the 1D nodes
+   Vector enodes;  ///< D1D^dim x SDIM x NE, lexicographic
+
+   /// Vertex-based nodes of meshes without nodes, owned
+   FiniteElementCollection *vert_fec;
+   FiniteElementSpace *vert_fes;
+   GridFunction *vert_nodes;
+
+   void Setup();
+   void DeleteVertexNodes();
+   void TransformHost(const Vector &pts, const Array<int> &elems,
+                      Ordering::Type ordering, Array<int> &types,
+                      Vector &refs) const;
+
+public:
+   /// Set up the node data of @a mesh_, which is not owned.
+   BatchInverseElementTransformation(Mesh &mesh_);
+
+   ~BatchInverseElementTransformation() { DeleteVertexNodes(); }
+
+   /** @brief Update the node data after the mesh nodes (or vertices) were
+       moved, or the mesh was modified, e.g. refined. */
+   void Update();
+
+   /// Set the maximum number of Newton iterations (default 16).
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+
+   /// Set the reference-space convergence tolerance (default 1e-15).
+   void SetReferenceTol(double ref_sp_tol) { ref_tol = ref_sp_tol; }
+
+   /// Set the relative physical-space convergence tolerance (default 1e-15).
+   void SetPhysicalRelTol(double phys_rel_tol) { phys_rtol = phys_rel_tol; }
+
+   /** @brief Return true if the points are mapped with the tensor product
+       MFEM_FORALL kernel, false if they are mapped on the host. */
+   bool UsesTensorKernels() const { return tensor; }
+
+   /** @brief Map the physical points @a pts in the elements @a elems to the
+       reference element.
+
+       @param[in]  pts       The Mesh::SpaceDimension() coordinates of the
+                             points, ordered according to @a ordering.
+       @param[in]  elems     The element of each point.
+       @param[in]  ordering  The ordering of @a pts and @a refs, Ordering::
+                             byNODES stores the first coordinate of all the
+                             points first.
+       @param[out] types     The InverseElementTransformation::TransformResult
+                             of each point.
+       @param[out] refs      The Mesh::Dimension() reference coordinates of the
+                             points, ordered according to @a ordering. */
+   void Transform(const Vector &pts, const Array<int> &elems,
+                  Ordering::Type ordering, Array<int> &types,
+                  Vector &refs) const;
+
+   /// Return the mesh.
+   Mesh *GetMesh() const { return mesh; }
+};
+
+}
+
+#endif
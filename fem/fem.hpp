@@ -18,6 +18,7 @@
 #include "fe_coll.hpp"
 #include "doftrans.hpp"
 #include "eltrans.hpp"
+#include "eltrans_batch.hpp"
 #include "coefficient.hpp"
 #include "complex_fem.hpp"
 #include "convergence.hpp"
@@ -45,6 +46,7 @@
 #include "multigrid.hpp"
 #include "ceed/algebraic.hpp"
 #include "lor.hpp"
+#include "particleset.hpp"
 
 #ifdef MFEM_USE_MPI
 #include "pfespace.hpp"
@@ -52,6 +54,7 @@
 #include "plinearform.hpp"
 #include "pbilinearform.hpp"
 #include "pnonlinearform.hpp"
+#include "pparticleset.hpp"
 #endif
 
 #ifdef MFEM_USE_SIDRE
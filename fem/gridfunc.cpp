@@ -507,6 +507,27 @@ void GridFunction::GetVectorValue(int i, const IntegrationPoint &ip,
    }
 }
 
+int GridFunction::GetPointValues(const DenseMatrix &points, DenseMatrix &vals,
+                                 const ElementBVH *bvh) const
+{
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   // FindPoints() does not modify the points
+   const int found =
+      fes->GetMesh()->FindPoints(const_cast<DenseMatrix&>(points), elem_ids,
+                                 ips, false, NULL, bvh);
+   vals.SetSize(VectorDim(), points.Width());
+   vals = 0.0;
+   Vector val;
+   for (int k = 0; k < elem_ids.Size(); k++)
+   {
+      if (elem_ids[k] < 0) { continue; }
+      vals.GetColumnReference(k, val);
+      GetVectorValue(elem_ids[k], ips[k], val);
+   }
+   return found;
+}
+
 void GridFunction::GetValues(int i, const IntegrationRule &ir, Vector &vals,
                              int vdim)
 const
@@ -203,6 +203,18 @@ public:
                         DenseMatrix &vals, DenseMatrix &tr) const;
    ///@}
 
+   /** @brief Evaluate the grid function at the physical points given by the
+       columns of @a points, located with Mesh::FindPoints().
+
+       On return, the i-th column of @a vals, of size VectorDim(), is the value
+       at the i-th point, or zero if the point was not found. The spatial index
+       @a bvh, if given, is passed to Mesh::FindPoints(). In parallel, all the
+       ranks get the values of all the points.
+
+       @returns The number of points that were found. */
+   virtual int GetPointValues(const DenseMatrix &points, DenseMatrix &vals,
+                              const ElementBVH *bvh = NULL) const;
+
    /** @name ElementTransformation Get Value Methods
 
        These member functions are designed for use within
@@ -12,6 +12,7 @@
 // Implementation of class LinearForm
 
 #include "fem.hpp"
+#include "../general/annotation.hpp"
 
 namespace mfem
 {
@@ -101,6 +102,8 @@ void LinearForm::AddInteriorFaceIntegrator(LinearFormIntegrator *lfi)
 
 void LinearForm::Assemble()
 {
+   MFEM_PERF_FUNCTION;
+
    Array<int> vdofs;
    ElementTransformation *eltrans;
    DofTransformation *doftrans;
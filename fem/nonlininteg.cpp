@@ -15,6 +15,28 @@
 namespace mfem
 {
 
+void NonlinearFormIntegrator::ConvertPAData(Vector &pa_data,
+                                            Array<float> &pa_data_sp) const
+{
+   if (!pa_single)
+   {
+      pa_data_sp.DeleteAll();
+      return;
+   }
+#ifdef MFEM_USE_OCCA
+   MFEM_VERIFY(!DeviceCanUseOcca(), "single precision PA data is not "
+               "supported with the OCCA backend");
+#endif
+   const int n = pa_data.Size();
+   const MemoryType mt = (pa_mt == MemoryType::DEFAULT) ?
+                         Device::GetDeviceMemoryType() : pa_mt;
+   pa_data_sp.SetSize(n, mt);
+   const auto d = pa_data.Read();
+   auto d_sp = pa_data_sp.Write();
+   MFEM_FORALL(i, n, d_sp[i] = static_cast<float>(d[i]););
+   pa_data.Destroy();
+}
+
 double NonlinearFormIntegrator::GetLocalStateEnergyPA(const Vector &x) const
 {
    mfem_error ("NonlinearFormIntegrator::GetLocalStateEnergyPA(...)\n"
@@ -34,9 +34,16 @@ protected:
 
    MemoryType pa_mt = MemoryType::DEFAULT;
 
+   /// Use single precision PA data, see SetPASinglePrecision().
+   bool pa_single = false;
+
    NonlinearFormIntegrator(const IntegrationRule *ir = NULL)
       : IntRule(ir), ceedOp(NULL) { }
 
+   /** @brief If single precision PA data was requested, round @a pa_data into
+       @a pa_data_sp and free @a pa_data; otherwise, free @a pa_data_sp. */
+   void ConvertPAData(Vector &pa_data, Array<float> &pa_data_sp) const;
+
 public:
    /** @brief Prescribe a fixed IntegrationRule to use (when @a ir != NULL) or
        let the integrator choose (when @a ir == NULL). */
@@ -49,6 +56,21 @@ public:
    /// in PA extensions.
    void SetPAMemoryType(MemoryType mt) { pa_mt = mt; }
 
+   /** @brief Store the quadrature point data computed by AssemblePA() in single
+       precision, halving the memory traffic of the PA action. */
+   /** The data is computed in double precision and rounded, and the action is
+       still evaluated in double precision, so the result is accurate to about
+       1e-7 relative to the double precision action. This is intended for
+       preconditioners, e.g. smoothers used inside an outer double precision
+       Krylov solver. Currently supported by MassIntegrator and
+       DiffusionIntegrator; the other integrators ignore it. Element and full
+       assembly always use double precision data. Must be called before
+       AssemblePA(). */
+   void SetPASinglePrecision(bool single = true) { pa_single = single; }
+
+   /// Return true if single precision PA data was requested.
+   bool GetPASinglePrecision() const { return pa_single; }
+
    /// Get the integration rule of the integrator (possibly NULL).
    const IntegrationRule *GetIntegrationRule() const { return IntRule; }
 
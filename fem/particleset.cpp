@@ -0,0 +1,396 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "particleset.hpp"
+#include "gslib.hpp"
+#include "../mesh/mesh.hpp"
+#include "../general/table.hpp"
+#include "../general/sort_pairs.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+ParticleSet::ParticleSet(Mesh &mesh_)
+   : mesh(&mesh_),
+     dim(mesh_.Dimension()),
+     sdim(mesh_.SpaceDimension()),
+     np(0),
+     next_id(0),
+     bvh(new ElementBVH(mesh_)),
+     inv_tr(new BatchInverseElementTransformation(mesh_)),
+     finder(NULL)
+{ }
+
+ParticleSet::~ParticleSet()
+{
+   for (int i = 0; i < fields.Size(); i++) { delete fields[i]; }
+   delete inv_tr;
+   delete bvh;
+}
+
+int ParticleSet::AddField(const std::string &name, int vdim)
+{
+   MFEM_VERIFY(vdim > 0, "invalid vdim = " << vdim);
+   MFEM_VERIFY(GetFieldIndex(name) < 0, "field '" << name
+               << "' already exists");
+   Vector *f = new Vector(vdim*np);
+   *f = 0.0;
+   fields.Append(f);
+   field_vdim.Append(vdim);
+   field_names.push_back(name);
+   return fields.Size() - 1;
+}
+
+int ParticleSet::GetFieldIndex(const std::string &name) const
+{
+   for (int i = 0; i < fields.Size(); i++)
+   {
+      if (field_names[i] == name) { return i; }
+   }
+   return -1;
+}
+
+// Keep the entries of the particles keep, of the VDIM x NP array v ordered by
+// nodes, followed by room for nnew - keep.Size() particles
+template <typename V>
+static void SelectEntries(V &v, int vdim, int np, const Array<int> &keep,
+                          int nnew)
+{
+   V old(v);
+   old.HostRead();
+   v.SetSize(vdim*nnew);
+   v.HostWrite();
+   for (int c = 0; c < vdim; c++)
+   {
+      for (int j = 0; j < keep.Size(); j++)
+      {
+         v[j + nnew*c] = old[keep[j] + np*c];
+      }
+   }
+}
+
+void ParticleSet::Select(const Array<int> &keep, int nadd)
+{
+   const int nnew = keep.Size() + nadd;
+   SelectEntries(ids, 1, np, keep, nnew);
+   SelectEntries(coords, sdim, np, keep, nnew);
+   SelectEntries(elems, 1, np, keep, nnew);
+   SelectEntries(refs, dim, np, keep, nnew);
+   for (int i = 0; i < fields.Size(); i++)
+   {
+      SelectEntries(*fields[i], field_vdim[i], np, keep, nnew);
+   }
+   np = nnew;
+}
+
+void ParticleSet::SetNewIds(int n)
+{
+   for (int j = 0; j < n; j++) { ids[np - n + j] = next_id + j; }
+   next_id += n;
+}
+
+int ParticleSet::AddParticles(const Vector &x, Ordering::Type ordering)
+{
+   MFEM_VERIFY(x.Size() % sdim == 0, "invalid size of x: " << x.Size());
+   const int n = x.Size()/sdim, first = np;
+   Array<int> keep(np);
+   for (int i = 0; i < np; i++) { keep[i] = i; }
+   Select(keep, n);
+
+   const double *X = x.HostRead();
+   for (int k = 0; k < n; k++)
+   {
+      for (int c = 0; c < sdim; c++)
+      {
+         coords(first + k + np*c) =
+            X[ordering == Ordering::byNODES ? k + n*c : sdim*k + c];
+      }
+      for (int d = 0; d < dim; d++) { refs(first + k + np*d) = 0.0; }
+      for (int i = 0; i < fields.Size(); i++)
+      {
+         for (int c = 0; c < field_vdim[i]; c++)
+         {
+            (*fields[i])(first + k + np*c) = 0.0;
+         }
+      }
+      elems[first + k] = -1;
+   }
+   SetNewIds(n);
+   return first;
+}
+
+void ParticleSet::RemoveParticles(const Array<int> &idx)
+{
+   Array<bool> remove(np);
+   remove = false;
+   for (int j = 0; j < idx.Size(); j++)
+   {
+      MFEM_ASSERT(0 <= idx[j] && idx[j] < np, "invalid index " << idx[j]);
+      remove[idx[j]] = true;
+   }
+   Array<int> keep;
+   keep.Reserve(np);
+   for (int i = 0; i < np; i++)
+   {
+      if (!remove[i]) { keep.Append(i); }
+   }
+   Select(keep, 0);
+}
+
+void ParticleSet::LocatePoints(const Vector &x, Array<int> &el,
+                               Vector &ref) const
+{
+   const int n = el.Size();
+   MFEM_VERIFY(!bvh->IsOutdated(), "the mesh was modified, call UpdateMesh()");
+   MFEM_ASSERT(x.Size() == sdim*n, "invalid size of x");
+   ref.SetSize(dim*n);
+   double *R = ref.HostWrite();
+   for (int i = 0; i < dim*n; i++) { R[i] = 0.0; }
+   if (n == 0) { return; }
+   const double *X = x.HostRead();
+   int *E = el.HostReadWrite();
+
+   // Map the points pidx in the elements pel, keep the ones inside
+   Array<int> pidx, pel, types;
+   Vector px, pref;
+   auto try_elements = [&]()
+   {
+      const int m = pidx.Size();
+      px.SetSize(sdim*m);
+      double *PX = px.HostWrite();
+      for (int c = 0; c < sdim; c++)
+      {
+         for (int j = 0; j < m; j++) { PX[j + m*c] = X[pidx[j] + n*c]; }
+      }
+      inv_tr->Transform(px, pel, Ordering::byNODES, types, pref);
+      const int *T = types.HostRead();
+      const double *PR = pref.HostRead();
+      const int *PE = pel.HostRead();
+      for (int j = 0; j < m; j++)
+      {
+         if (T[j] != InverseElementTransformation::Inside) { continue; }
+         E[pidx[j]] = PE[j];
+         for (int d = 0; d < dim; d++) { R[pidx[j] + n*d] = PR[j + m*d]; }
+      }
+   };
+
+   // Particles usually stay in their element, or move to a neighbor
+   Array<int> prev(n);
+   for (int i = 0; i < n; i++)
+   {
+      prev[i] = E[i];
+      E[i] = -1;
+      if (prev[i] >= 0)
+      {
+         pidx.Append(i);
+         pel.Append(prev[i]);
+      }
+   }
+   if (pidx.Size() > 0) { try_elements(); }
+
+   // Candidates of the other points, the closest box centers first
+   Array<int> offsets(n + 1), cands, found;
+   Array<Pair<double,int> > dist;
+   Vector xi(sdim), min, max;
+   offsets[0] = 0;
+   for (int i = 0; i < n; i++)
+   {
+      if (E[i] < 0)
+      {
+         for (int c = 0; c < sdim; c++) { xi(c) = X[i + n*c]; }
+         bvh->FindElements(xi, found);
+         dist.SetSize(0);
+         for (int j = 0; j < found.Size(); j++)
+         {
+            if (found[j] == prev[i]) { continue; }
+            bvh->GetElementBox(found[j], min, max);
+            double d2 = 0.0;
+            for (int c = 0; c < sdim; c++)
+            {
+               d2 += pow(xi(c) - 0.5*(min(c) + max(c)), 2);
+            }
+            dist.Append(Pair<double,int>(d2, found[j]));
+         }
+         dist.Sort();
+         for (int j = 0; j < dist.Size(); j++) { cands.Append(dist[j].two); }
+      }
+      offsets[i+1] = cands.Size();
+   }
+
+   // Try the k-th candidate of all the points not found yet
+   for (int k = 0; true; k++)
+   {
+      pidx.SetSize(0);
+      pel.SetSize(0);
+      for (int i = 0; i < n; i++)
+      {
+         if (E[i] < 0 && offsets[i] + k < offsets[i+1])
+         {
+            pidx.Append(i);
+            pel.Append(cands[offsets[i] + k]);
+         }
+      }
+      if (pidx.Size() == 0) { break; }
+      try_elements();
+   }
+}
+
+void ParticleSet::LocateGSLIB(Array<int> &proc)
+{
+#ifdef MFEM_USE_GSLIB
+   finder->FindPoints(coords);
+   const Array<unsigned int> &code = finder->GetCode();
+   const Array<unsigned int> &gsl_elem = finder->GetElem();
+   const Array<unsigned int> &gsl_proc = finder->GetProc();
+   const Vector &gsl_ref = finder->GetReferencePosition();
+   proc.SetSize(np);
+   for (int i = 0; i < np; i++)
+   {
+      // Not found (2), or inside an element (0) or on its boundary (1)
+      const bool found = (code[i] != 2);
+      proc[i] = found ? (int) gsl_proc[i] : -1;
+      elems[i] = found ? (int) gsl_elem[i] : -1;
+      for (int d = 0; d < dim; d++)
+      {
+         refs(i + np*d) = found ? gsl_ref(dim*i + d) : 0.0;
+      }
+   }
+#else
+   MFEM_CONTRACT_VAR(proc);
+   MFEM_ABORT("MFEM is not built with GSLIB");
+#endif
+}
+
+long long ParticleSet::Redistribute()
+{
+   if (finder)
+   {
+      Array<int> proc;
+      LocateGSLIB(proc);
+   }
+   else
+   {
+      LocatePoints(coords, elems, refs);
+   }
+
+   Array<int> keep;
+   keep.Reserve(np);
+   for (int i = 0; i < np; i++)
+   {
+      if (elems[i] >= 0) { keep.Append(i); }
+   }
+   const int lost = np - keep.Size();
+   Select(keep, 0);
+   return lost;
+}
+
+void ParticleSet::UpdateMesh()
+{
+   if (bvh->IsOutdated())
+   {
+      // The elements changed, locate all the particles again
+      bvh->Rebuild();
+      elems = -1;
+   }
+   else
+   {
+      bvh->Update();
+   }
+   inv_tr->Update();
+}
+
+void ParticleSet::Interpolate(const GridFunction &gf, Vector &vals,
+                              Ordering::Type ordering) const
+{
+   const FiniteElementSpace *fes = gf.FESpace();
+   MFEM_VERIFY(fes->GetMesh() == mesh,
+               "the GridFunction is not defined on the mesh of the particles");
+   MFEM_VERIFY(!bvh->IsOutdated(), "the mesh was modified, call UpdateMesh() "
+               "and Redistribute()");
+   const int vdim = gf.VectorDim();
+   vals.SetSize(vdim*np);
+   double *V = vals.HostWrite();
+   for (int i = 0; i < vdim*np; i++) { V[i] = 0.0; }
+
+   // Group the particles by element
+   const int ne = mesh->GetNE();
+   const int *E = elems.HostRead();
+   const double *R = refs.HostRead();
+   Table el_to_p;
+   el_to_p.MakeI(ne);
+   for (int i = 0; i < np; i++)
+   {
+      if (E[i] >= 0) { el_to_p.AddAColumnInRow(E[i]); }
+   }
+   el_to_p.MakeJ();
+   for (int i = 0; i < np; i++)
+   {
+      if (E[i] >= 0) { el_to_p.AddConnection(E[i], i); }
+   }
+   el_to_p.ShiftUpI();
+
+   Array<int> vdofs;
+   Vector loc, shape, val(vdim);
+   DenseMatrix vshape;
+   IntegrationPoint ip;
+   double r[3];
+   for (int e = 0; e < ne; e++)
+   {
+      const int cnt = el_to_p.RowSize(e);
+      if (cnt == 0) { continue; }
+      const int *pp = el_to_p.GetRow(e);
+
+      // The element data is gathered once for all its particles
+      const FiniteElement *fe = fes->GetFE(e);
+      const int nd = fe->GetDof();
+      DofTransformation *doftrans = fes->GetElementVDofs(e, vdofs);
+      gf.GetSubVector(vdofs, loc);
+      if (doftrans) { doftrans->InvTransformPrimal(loc); }
+      const bool scalar = (fe->GetRangeType() == FiniteElement::SCALAR);
+      ElementTransformation *T = NULL;
+      if (!scalar || fe->GetMapType() != FiniteElement::VALUE)
+      {
+         T = fes->GetElementTransformation(e);
+      }
+      shape.SetSize(nd);
+      vshape.SetSize(nd, vdim);
+
+      for (int j = 0; j < cnt; j++)
+      {
+         const int p = pp[j];
+         for (int d = 0; d < dim; d++) { r[d] = R[p + np*d]; }
+         ip.Set(r, dim);
+         if (T) { T->SetIntPoint(&ip); }
+         if (scalar)
+         {
+            if (T) { fe->CalcPhysShape(*T, shape); }
+            else { fe->CalcShape(ip, shape); }
+            for (int k = 0; k < vdim; k++)
+            {
+               val(k) = shape * (loc.GetData() + nd*k);
+            }
+         }
+         else
+         {
+            fe->CalcVShape(*T, vshape);
+            vshape.MultTranspose(loc, val);
+         }
+         for (int k = 0; k < vdim; k++)
+         {
+            V[ordering == Ordering::byNODES ? p + np*k : vdim*p + k] = val(k);
+         }
+      }
+   }
+}
+
+}
@@ -0,0 +1,167 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PARTICLESET
+#define MFEM_PARTICLESET
+
+#include "../config/config.hpp"
+#include "../mesh/bvh.hpp"
+#include "eltrans_batch.hpp"
+#include "gridfunc.hpp"
+#include <string>
+#include <vector>
+
+namespace mfem
+{
+
+class FindPointsGSLIB;
+
+/** @brief A set of particles, i.e. points moving through a Mesh, with the
+    element containing each particle and its reference coordinates.
+
+    The data of the particles is stored as a structure of arrays: the
+    coordinates, the reference coordinates and the user fields, see AddField(),
+    are Vectors ordered by nodes, e.g. the first coordinate of all the
+    particles followed by the second one. Each particle also has a unique id,
+    which it keeps when particles are removed or, in parallel, migrated to
+    other ranks, see ParParticleSet.
+
+    After moving the particles by modifying GetCoordinates(), Redistribute()
+    finds their new elements, first trying their previous element, then the
+    candidates given by an ElementBVH, all with a
+    BatchInverseElementTransformation. Alternatively, a FindPointsGSLIB object
+    can be used to locate the particles, see SetFindPointsGSLIB(). */
+class ParticleSet
+{
+protected:
+   Mesh *mesh;
+   int dim, sdim;
+   int np;                 ///< number of particles
+   long long next_id;      ///< id of the next particle added, on all ranks
+
+   Array<long long> ids;
+   Vector coords;          ///< SDIM x NP, ordered by nodes
+   Array<int> elems;       ///< element of each particle, -1 if not found
+   Vector refs;            ///< DIM x NP, ordered by nodes
+
+   Array<Vector*> fields;  ///< user fields, VDIM x NP ordered by nodes
+   Array<int> field_vdim;
+   std::vector<std::string> field_names;
+
+   ElementBVH *bvh;
+   BatchInverseElementTransformation *inv_tr;
+   FindPointsGSLIB *finder; ///< not owned
+
+   /** @brief Locate the points @a x, SDIM x el.Size() ordered by nodes, in the
+       local mesh. The elements @a el >= 0 are tried first; the elements of the
+       points that are not found are set to -1. */
+   void LocatePoints(const Vector &x, Array<int> &el, Vector &ref) const;
+
+   /// Locate the particles with FindPointsGSLIB, return their ranks in @a proc.
+   void LocateGSLIB(Array<int> &proc);
+
+   /** @brief Keep the particles @a keep, in this order, followed by @a nadd
+       new particles, whose data is not initialized. */
+   void Select(const Array<int> &keep, int nadd);
+
+   /// Set the ids of the @a n particles added last, and update #next_id.
+   virtual void SetNewIds(int n);
+
+public:
+   /** @brief Create an empty set of particles in @a mesh_, which is not
+       owned. */
+   ParticleSet(Mesh &mesh_);
+
+   virtual ~ParticleSet();
+
+   /** @brief Add a field of @a vdim values per particle, initialized to zero,
+       and return its index. The fields move with the particles. */
+   int AddField(const std::string &name, int vdim = 1);
+
+   /// Return the number of fields.
+   int GetNumFields() const { return fields.Size(); }
+
+   /// Return the index of the field @a name, or -1.
+   int GetFieldIndex(const std::string &name) const;
+
+   /// Return the field @a i, VDIM x NP ordered by nodes.
+   Vector &GetField(int i) { return *fields[i]; }
+   const Vector &GetField(int i) const { return *fields[i]; }
+
+   /// Return the number of values per particle of the field @a i.
+   int GetFieldVDim(int i) const { return field_vdim[i]; }
+
+   /** @brief Add particles at the points @a x, of size SDIM x N, ordered
+       according to @a ordering. Return the index of the first new particle.
+       The new field values are zero. The new particles are located by the
+       next Redistribute().
+
+       In parallel, this is a collective call, and the particles may be added
+       on any rank. */
+   int AddParticles(const Vector &x,
+                    Ordering::Type ordering = Ordering::byNODES);
+
+   /// Remove the particles with the given indices.
+   void RemoveParticles(const Array<int> &idx);
+
+   /// Return the number of (local) particles.
+   int GetNumParticles() const { return np; }
+
+   /// Return the total number of particles, over all the ranks.
+   virtual long long GetGlobalNumParticles() const { return np; }
+
+   /** @brief Return the coordinates of the particles, SDIM x NP ordered by
+       nodes. After they are modified, call Redistribute(). */
+   Vector &GetCoordinates() { return coords; }
+   const Vector &GetCoordinates() const { return coords; }
+
+   /// Return the unique ids of the particles.
+   const Array<long long> &GetIds() const { return ids; }
+
+   /// Return the element of each particle, -1 if it was not found.
+   const Array<int> &GetElements() const { return elems; }
+
+   /** @brief Return the reference coordinates of the particles in their
+       elements, DIM x NP ordered by nodes. */
+   const Vector &GetReferenceCoordinates() const { return refs; }
+
+   /** @brief Locate the particles, and remove the particles that are outside
+       of the mesh. Return the number of removed particles.
+
+       In parallel, this is a collective call, which also migrates the
+       particles that left the local part of the mesh to their new ranks, and
+       returns the number of removed particles over all the ranks. */
+   virtual long long Redistribute();
+
+   /** @brief Update the locator after the mesh nodes were moved, or the mesh
+       was modified, e.g. refined. Then, call Redistribute(). */
+   virtual void UpdateMesh();
+
+   /** @brief Use @a finder_, set up on the mesh of the particles, to locate the
+       particles, or the native locator if NULL. */
+   void SetFindPointsGSLIB(FindPointsGSLIB *finder_) { finder = finder_; }
+
+   /** @brief Evaluate @a gf, defined on the mesh of the particles, at all the
+       particles, and return the values, VDIM x NP ordered according to
+       @a ordering, in @a vals. The particles are processed element by element.
+       The values of the particles that were not found are zero.
+
+       With a ParGridFunction, the values are computed from its local data. */
+   void Interpolate(const GridFunction &gf, Vector &vals,
+                    Ordering::Type ordering = Ordering::byNODES) const;
+
+   /// Return the mesh.
+   Mesh *GetMesh() const { return mesh; }
+};
+
+}
+
+#endif
@@ -3467,6 +3467,13 @@ ConformingProlongationOperator::ConformingProlongationOperator(
 }
 
 void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
+{
+   MultBegin(x, y);
+   MultEnd(y);
+}
+
+void ConformingProlongationOperator::MultBegin(const Vector &x,
+                                               Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Width(), "");
    MFEM_ASSERT(y.Size() == Height(), "");
@@ -3493,16 +3500,35 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
       j = end+1;
    }
    std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
 
+void ConformingProlongationOperator::MultEnd(Vector &y) const
+{
    const int out_layout = 0; // 0 - output is ldofs array
    if (!local)
    {
-      gc.BcastEnd(ydata, out_layout);
+      gc.BcastEnd(y.HostReadWrite(), out_layout);
    }
 }
 
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
+{
+   MultTransposeBegin(x);
+   MultTransposeEnd(x, y);
+}
+
+void ConformingProlongationOperator::MultTransposeBegin(const Vector &x) const
+{
+   MFEM_ASSERT(x.Size() == Height(), "");
+   if (!local)
+   {
+      gc.ReduceBegin(x.HostRead());
+   }
+}
+
+void ConformingProlongationOperator::MultTransposeEnd(
+   const Vector &x, Vector &y) const
 {
    MFEM_ASSERT(x.Size() == Height(), "");
    MFEM_ASSERT(y.Size() == Width(), "");
@@ -3511,11 +3537,6 @@ void ConformingProlongationOperator::MultTranspose(
    double *ydata = y.HostWrite();
    const int m = external_ldofs.Size();
 
-   if (!local)
-   {
-      gc.ReduceBegin(xdata);
-   }
-
    int j = 0;
    for (int i = 0; i < m; i++)
    {
@@ -3596,6 +3617,7 @@ DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
       if (recv_size > 0) { req_counter++; }
    }
    requests = new MPI_Request[req_counter];
+   num_requests = 0;
 }
 
 DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
@@ -3658,6 +3680,13 @@ void DeviceConformingProlongationOperator::BcastEndCopy(
 
 void DeviceConformingProlongationOperator::Mult(const Vector &x,
                                                 Vector &y) const
+{
+   MultBegin(x, y);
+   MultEnd(y);
+}
+
+void DeviceConformingProlongationOperator::MultBegin(const Vector &x,
+                                                     Vector &y) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    int req_counter = 0;
@@ -3697,9 +3726,15 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
       }
    }
    BcastLocalCopy(x, y);
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultEnd(Vector &y) const
+{
    if (!local)
    {
-      MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+      MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+      num_requests = 0;
       BcastEndCopy(y); // copy from 'ext_buf'
    }
 }
@@ -3760,6 +3795,13 @@ void DeviceConformingProlongationOperator::ReduceEndAssemble(Vector &y) const
 
 void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
                                                          Vector &y) const
+{
+   MultTransposeBegin(x);
+   MultTransposeEnd(x, y);
+}
+
+void DeviceConformingProlongationOperator::MultTransposeBegin(
+   const Vector &x) const
 {
    const GroupTopology &gtopo = gc.GetGroupTopology();
    int req_counter = 0;
@@ -3788,10 +3830,17 @@ void DeviceConformingProlongationOperator::MultTranspose(const Vector &x,
          }
       }
    }
+   num_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultTransposeEnd(const Vector &x,
+                                                            Vector &y) const
+{
    ReduceLocalCopy(x, y);
    if (!local)
    {
-      MPI_Waitall(req_counter, requests, MPI_STATUSES_IGNORE);
+      MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+      num_requests = 0;
       ReduceEndAssemble(y); // assemble from 'shr_buf'
    }
 }
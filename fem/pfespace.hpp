@@ -455,6 +455,25 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Start the split-phase computation of y = P x: post the exchange of
+       the shared true dofs and copy the true dofs owned by this rank to @a y.
+
+       The entries of @a y owned by other ranks are set by MultEnd(), which
+       must be called before any other communication through this operator. */
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   /// Complete the computation started by MultBegin().
+   virtual void MultEnd(Vector &y) const;
+
+   /** @brief Start the split-phase computation of y = P^T x: send the entries
+       of @a x owned by other ranks. Only these entries need to be final. */
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   /** @brief Complete the computation started by MultTransposeBegin(): copy
+       the entries of @a x owned by this rank to @a y and add the received
+       contributions. */
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
 };
 
 /// Auxiliary device class used by ParFiniteElementSpace.
@@ -469,6 +488,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int num_requests; // Requests posted by the current Begin phase
 
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
@@ -506,6 +526,14 @@ public:
    virtual void Mult(const Vector &x, Vector &y) const;
 
    virtual void MultTranspose(const Vector &x, Vector &y) const;
+
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   virtual void MultEnd(Vector &y) const;
+
+   virtual void MultTransposeBegin(const Vector &x) const;
+
+   virtual void MultTransposeEnd(const Vector &x, Vector &y) const;
 };
 
 }
@@ -417,6 +417,16 @@ double ParGridFunction::GetValue(ElementTransformation &T,
    return (DofVal * LocVec);
 }
 
+int ParGridFunction::GetPointValues(const DenseMatrix &points,
+                                    DenseMatrix &vals,
+                                    const ElementBVH *bvh) const
+{
+   const int found = GridFunction::GetPointValues(points, vals, bvh);
+   MPI_Allreduce(MPI_IN_PLACE, vals.GetData(), vals.Height()*vals.Width(),
+                 MPI_DOUBLE, MPI_SUM, pfes->GetComm());
+   return found;
+}
+
 void ParGridFunction::GetVectorValue(ElementTransformation &T,
                                      const IntegrationPoint &ip,
                                      Vector &val, Vector *tr) const
@@ -226,6 +226,11 @@ public:
                                const IntegrationPoint &ip,
                                Vector &val, Vector *tr = NULL) const;
 
+   /** Each point is evaluated by the rank that owns it, see
+       ParMesh::FindPoints(), and the values are then summed over all ranks. */
+   int GetPointValues(const DenseMatrix &points, DenseMatrix &vals,
+                      const ElementBVH *bvh = NULL) const override;
+
    /// Parallel version of GridFunction::GetDerivative(); see its documentation.
    void GetDerivative(int comp, int der_comp, ParGridFunction &der);
 
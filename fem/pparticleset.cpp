@@ -0,0 +1,330 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "pparticleset.hpp"
+#include "../general/table.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace mfem
+{
+
+ParParticleSet::ParParticleSet(ParMesh &pmesh_)
+   : ParticleSet(pmesh_),
+     pmesh(&pmesh_),
+     comm(pmesh_.GetComm())
+{
+   MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nranks);
+   ComputeRankBoxes();
+}
+
+void ParParticleSet::ComputeRankBoxes()
+{
+   const double inf = std::numeric_limits<double>::infinity();
+   Vector box(2*sdim), min, max;
+   for (int d = 0; d < sdim; d++)
+   {
+      box(d) = inf;
+      box(sdim + d) = -inf;
+   }
+   for (int e = 0; e < pmesh->GetNE(); e++)
+   {
+      bvh->GetElementBox(e, min, max);
+      for (int d = 0; d < sdim; d++)
+      {
+         box(d) = std::min(box(d), min(d));
+         box(sdim + d) = std::max(box(sdim + d), max(d));
+      }
+   }
+   rank_boxes.SetSize(2*sdim*nranks);
+   MPI_Allgather(box.GetData(), 2*sdim, MPI_DOUBLE,
+                 rank_boxes.GetData(), 2*sdim, MPI_DOUBLE, comm);
+}
+
+bool ParParticleSet::InRankBox(int r, const double *x) const
+{
+   const double *box = rank_boxes.GetData() + 2*sdim*r;
+   for (int d = 0; d < sdim; d++)
+   {
+      if (x[d] < box[d] || x[d] > box[sdim + d]) { return false; }
+   }
+   return true;
+}
+
+void ParParticleSet::SetNewIds(int n)
+{
+   long long loc_n = n, offset = 0, total = 0;
+   MPI_Scan(&loc_n, &offset, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   MPI_Allreduce(&loc_n, &total, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   offset -= loc_n;
+   for (int j = 0; j < n; j++) { ids[np - n + j] = next_id + offset + j; }
+   next_id += total;
+}
+
+long long ParParticleSet::GetGlobalNumParticles() const
+{
+   long long loc_np = np, glob_np = 0;
+   MPI_Allreduce(&loc_np, &glob_np, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   return glob_np;
+}
+
+// Return the displacements of the counts cnt in displ, and their sum
+static int Displacements(const Array<int> &cnt, Array<int> &displ)
+{
+   displ.SetSize(cnt.Size());
+   int sum = 0;
+   for (int r = 0; r < cnt.Size(); r++)
+   {
+      displ[r] = sum;
+      sum += cnt[r];
+   }
+   return sum;
+}
+
+void ParParticleSet::FindRanks(Array<int> &dest, Array<int> &dest_el,
+                               Vector &dest_ref)
+{
+   dest.SetSize(np);
+   dest_el = elems;
+   dest_ref = refs;
+   const double *C = coords.HostRead();
+   const int *E = elems.HostRead();
+
+   // The particles that are not found locally are sent to the ranks whose
+   // boxes contain them
+   Table send;
+   double x[3];
+   send.MakeI(nranks);
+   for (int pass = 0; pass < 2; pass++)
+   {
+      for (int i = 0; i < np; i++)
+      {
+         dest[i] = (E[i] >= 0) ? myid : -1;
+         if (E[i] >= 0) { continue; }
+         for (int c = 0; c < sdim; c++) { x[c] = C[i + np*c]; }
+         for (int r = 0; r < nranks; r++)
+         {
+            if (r == myid || !InRankBox(r, x)) { continue; }
+            if (pass == 0) { send.AddAColumnInRow(r); }
+            else { send.AddConnection(r, i); }
+         }
+      }
+      if (pass == 0) { send.MakeJ(); }
+   }
+   send.ShiftUpI();
+
+   Array<int> send_cnt(nranks), recv_cnt(nranks), send_displ, recv_displ;
+   for (int r = 0; r < nranks; r++) { send_cnt[r] = sdim*send.RowSize(r); }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+   const int send_size = Displacements(send_cnt, send_displ);
+   const int recv_size = Displacements(recv_cnt, recv_displ);
+
+   Vector send_buf(send_size), recv_buf(recv_size);
+   for (int r = 0, k = 0; r < nranks; r++)
+   {
+      for (int j = 0; j < send.RowSize(r); j++, k++)
+      {
+         const int i = send.GetRow(r)[j];
+         for (int c = 0; c < sdim; c++) { send_buf(sdim*k + c) = C[i + np*c]; }
+      }
+   }
+   MPI_Alltoallv(send_buf.GetData(), send_cnt.GetData(),
+                 send_displ.GetData(), MPI_DOUBLE, recv_buf.GetData(),
+                 recv_cnt.GetData(), recv_displ.GetData(), MPI_DOUBLE, comm);
+
+   // Locate the received points, and reply with their elements, -1 if they
+   // were not found, and reference coordinates
+   const int nrecv = recv_size/sdim;
+   Vector rx(sdim*nrecv), rref;
+   Array<int> rel(nrecv);
+   rel = -1;
+   for (int k = 0; k < nrecv; k++)
+   {
+      for (int c = 0; c < sdim; c++) { rx(k + nrecv*c) = recv_buf(sdim*k + c); }
+   }
+   LocatePoints(rx, rel, rref);
+
+   const int rsize = 1 + dim;
+   Vector reply(rsize*nrecv), answer(rsize*(send_size/sdim));
+   for (int k = 0; k < nrecv; k++)
+   {
+      reply(rsize*k) = rel[k];
+      for (int d = 0; d < dim; d++)
+      {
+         reply(rsize*k + 1 + d) = rref(k + nrecv*d);
+      }
+   }
+   for (int r = 0; r < nranks; r++)
+   {
+      send_cnt[r] = rsize*(send_cnt[r]/sdim);
+      send_displ[r] = rsize*(send_displ[r]/sdim);
+      recv_cnt[r] = rsize*(recv_cnt[r]/sdim);
+      recv_displ[r] = rsize*(recv_displ[r]/sdim);
+   }
+   MPI_Alltoallv(reply.GetData(), recv_cnt.GetData(), recv_displ.GetData(),
+                 MPI_DOUBLE, answer.GetData(), send_cnt.GetData(),
+                 send_displ.GetData(), MPI_DOUBLE, comm);
+
+   // Each particle goes to the lowest rank that found it
+   double *DR = dest_ref.HostReadWrite();
+   for (int r = 0, k = 0; r < nranks; r++)
+   {
+      for (int j = 0; j < send.RowSize(r); j++, k++)
+      {
+         const int i = send.GetRow(r)[j];
+         const double *a = answer.GetData() + rsize*k;
+         if (dest[i] >= 0 || a[0] < 0.0) { continue; }
+         dest[i] = r;
+         dest_el[i] = (int) a[0];
+         for (int d = 0; d < dim; d++) { DR[i + np*d] = a[1 + d]; }
+      }
+   }
+}
+
+int ParParticleSet::Migrate(const Array<int> &dest, const Array<int> &dest_el,
+                            const Vector &dest_ref)
+{
+   // Per particle: the coordinates, reference coordinates and fields, then
+   // the id and element
+   int dsize = sdim + dim;
+   for (int f = 0; f < fields.Size(); f++) { dsize += field_vdim[f]; }
+   const int lsize = 2;
+
+   Table send;
+   Array<int> keep;
+   int lost = 0;
+   send.MakeI(nranks);
+   for (int i = 0; i < np; i++)
+   {
+      if (dest[i] == myid) { keep.Append(i); }
+      else if (dest[i] < 0) { lost++; }
+      else { send.AddAColumnInRow(dest[i]); }
+   }
+   send.MakeJ();
+   for (int i = 0; i < np; i++)
+   {
+      if (dest[i] >= 0 && dest[i] != myid) { send.AddConnection(dest[i], i); }
+   }
+   send.ShiftUpI();
+
+   Array<int> send_cnt(nranks), recv_cnt(nranks), send_displ, recv_displ;
+   for (int r = 0; r < nranks; r++) { send_cnt[r] = send.RowSize(r); }
+   MPI_Alltoall(send_cnt.GetData(), 1, MPI_INT,
+                recv_cnt.GetData(), 1, MPI_INT, comm);
+   const int nsend = Displacements(send_cnt, send_displ);
+   const int nrecv = Displacements(recv_cnt, recv_displ);
+
+   // Pack the particles in the order of the ranks
+   Vector dsend(dsize*nsend), drecv(dsize*nrecv);
+   Array<long long> lsend(lsize*nsend), lrecv(lsize*nrecv);
+   const double *C = coords.HostRead();
+   const double *DR = dest_ref.HostRead();
+   for (int r = 0, k = 0; r < nranks; r++)
+   {
+      for (int j = 0; j < send.RowSize(r); j++, k++)
+      {
+         const int i = send.GetRow(r)[j];
+         double *buf = dsend.GetData() + dsize*k;
+         for (int c = 0; c < sdim; c++) { *buf++ = C[i + np*c]; }
+         for (int d = 0; d < dim; d++) { *buf++ = DR[i + np*d]; }
+         for (int f = 0; f < fields.Size(); f++)
+         {
+            const double *F = fields[f]->HostRead();
+            for (int c = 0; c < field_vdim[f]; c++) { *buf++ = F[i + np*c]; }
+         }
+         lsend[lsize*k] = ids[i];
+         lsend[lsize*k + 1] = dest_el[i];
+      }
+   }
+
+   // The sizes of the double and integer data of the particles
+   Array<int> dsend_cnt(nranks), drecv_cnt(nranks), dsend_displ(nranks),
+         drecv_displ(nranks), lsend_cnt(nranks), lrecv_cnt(nranks),
+         lsend_displ(nranks), lrecv_displ(nranks);
+   for (int r = 0; r < nranks; r++)
+   {
+      dsend_cnt[r] = dsize*send_cnt[r];
+      drecv_cnt[r] = dsize*recv_cnt[r];
+      dsend_displ[r] = dsize*send_displ[r];
+      drecv_displ[r] = dsize*recv_displ[r];
+      lsend_cnt[r] = lsize*send_cnt[r];
+      lrecv_cnt[r] = lsize*recv_cnt[r];
+      lsend_displ[r] = lsize*send_displ[r];
+      lrecv_displ[r] = lsize*recv_displ[r];
+   }
+   MPI_Alltoallv(dsend.GetData(), dsend_cnt.GetData(), dsend_displ.GetData(),
+                 MPI_DOUBLE, drecv.GetData(), drecv_cnt.GetData(),
+                 drecv_displ.GetData(), MPI_DOUBLE, comm);
+   MPI_Alltoallv(lsend.GetData(), lsend_cnt.GetData(), lsend_displ.GetData(),
+                 MPI_LONG_LONG, lrecv.GetData(), lrecv_cnt.GetData(),
+                 lrecv_displ.GetData(), MPI_LONG_LONG, comm);
+
+   // Keep the local particles, in their new elements, followed by the
+   // received ones
+   elems = dest_el;
+   refs = dest_ref;
+   const int first = keep.Size();
+   Select(keep, nrecv);
+   for (int k = 0; k < nrecv; k++)
+   {
+      const int i = first + k;
+      const double *buf = drecv.GetData() + dsize*k;
+      for (int c = 0; c < sdim; c++) { coords(i + np*c) = *buf++; }
+      for (int d = 0; d < dim; d++) { refs(i + np*d) = *buf++; }
+      for (int f = 0; f < fields.Size(); f++)
+      {
+         for (int c = 0; c < field_vdim[f]; c++)
+         {
+            (*fields[f])(i + np*c) = *buf++;
+         }
+      }
+      ids[i] = lrecv[lsize*k];
+      elems[i] = (int) lrecv[lsize*k + 1];
+   }
+   return lost;
+}
+
+long long ParParticleSet::Redistribute()
+{
+   Array<int> dest, dest_el;
+   Vector dest_ref;
+   if (finder)
+   {
+      LocateGSLIB(dest);
+      dest_el = elems;
+      dest_ref = refs;
+   }
+   else
+   {
+      LocatePoints(coords, elems, refs);
+      FindRanks(dest, dest_el, dest_ref);
+   }
+   long long lost = Migrate(dest, dest_el, dest_ref), glob_lost = 0;
+   MPI_Allreduce(&lost, &glob_lost, 1, MPI_LONG_LONG, MPI_SUM, comm);
+   return glob_lost;
+}
+
+void ParParticleSet::UpdateMesh()
+{
+   ParticleSet::UpdateMesh();
+   ComputeRankBoxes();
+}
+
+}
+
+#endif // MFEM_USE_MPI
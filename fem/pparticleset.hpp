@@ -0,0 +1,80 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_PPARTICLESET
+#define MFEM_PPARTICLESET
+
+#include "../config/config.hpp"
+
+#ifdef MFEM_USE_MPI
+
+#include "particleset.hpp"
+#include "../mesh/pmesh.hpp"
+
+namespace mfem
+{
+
+/** @brief A set of particles in a ParMesh, each owned by the rank whose local
+    part of the mesh contains it.
+
+    Redistribute() migrates the particles that left the local part of the mesh
+    to their new ranks, with their ids and fields. With the native locator, the
+    particles that are not found locally are sent to the ranks whose local mesh
+    bounding boxes contain them, and each particle goes to the lowest rank that
+    finds it. With FindPointsGSLIB, see SetFindPointsGSLIB(), the particles go
+    to the ranks returned by FindPointsGSLIB::GetProc(). */
+class ParParticleSet : public ParticleSet
+{
+protected:
+   ParMesh *pmesh;
+   MPI_Comm comm;
+   int myid, nranks;
+   Vector rank_boxes; ///< min and max of the local mesh box of each rank
+
+   void ComputeRankBoxes();
+
+   bool InRankBox(int r, const double *x) const;
+
+   /** @brief Find the destination ranks @a dest of the particles, -1 for the
+       particles outside of the mesh, and their elements and reference
+       coordinates on these ranks. */
+   void FindRanks(Array<int> &dest, Array<int> &dest_el, Vector &dest_ref);
+
+   /** @brief Send the particles to the ranks @a dest, where their elements
+       and reference coordinates are @a dest_el and @a dest_ref, and remove
+       the particles with @a dest = -1. Return their number. */
+   int Migrate(const Array<int> &dest, const Array<int> &dest_el,
+               const Vector &dest_ref);
+
+   virtual void SetNewIds(int n);
+
+public:
+   /** @brief Create an empty set of particles in @a pmesh_, which is not
+       owned. */
+   ParParticleSet(ParMesh &pmesh_);
+
+   MPI_Comm GetComm() const { return comm; }
+
+   virtual long long GetGlobalNumParticles() const;
+
+   virtual long long Redistribute();
+
+   virtual void UpdateMesh();
+
+   /// Return the parallel mesh.
+   ParMesh *GetParMesh() const { return pmesh; }
+};
+
+}
+
+#endif // MFEM_USE_MPI
+
+#endif
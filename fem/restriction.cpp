@@ -106,6 +106,8 @@ ElementRestriction::ElementRestriction(const FiniteElementSpace &f,
 
 void ElementRestriction::Mult(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_FUNCTION;
+
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -149,6 +151,8 @@ void ElementRestriction::MultUnsigned(const Vector& x, Vector& y) const
 
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
+   MFEM_PERF_FUNCTION;
+
    // Assumes all elements have the same number of dofs
    const int nd = dof;
    const int vd = vdim;
@@ -313,6 +317,14 @@ int ElementRestriction::FillI(SparseMatrix &mat) const
    auto d_offsets = offsets.Read();
    auto d_indices = indices.Read();
    auto d_gather_map = gather_map.Read();
+   // The kernel assertions below are only active in debug builds.
+   const int *h_offsets = offsets.HostRead();
+   for (int i_L = 0; i_L < all_dofs; i_L++)
+   {
+      MFEM_VERIFY(h_offsets[i_L+1] - h_offsets[i_L] <= Max,
+                  "The connectivity of this mesh is beyond the max, increase "
+                  "the MaxNbNbr variable to comply with your mesh.");
+   }
    MFEM_FORALL(i_L, vd*all_dofs+1,
    {
       I[i_L] = 0;
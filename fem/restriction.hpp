@@ -28,8 +28,9 @@ class ElementRestriction : public Operator
 {
 private:
    /** This number defines the maximum number of elements any dof can belong to
-       for the FillSparseMatrix method. */
-   static const int MaxNbNbr = 16;
+       for the FillSparseMatrix method. Vertices of tetrahedral meshes are
+       commonly shared by 20-30 elements. */
+   static const int MaxNbNbr = 32;
 
 protected:
    const FiniteElementSpace &fes;
@@ -53,6 +54,10 @@ public:
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
 
+   /** @brief Return the map from the E-vector entries to the (signed) L-vector
+       indices; a negative index i refers to the entry -1-i with a minus sign. */
+   const Array<int> &GatherMap() const { return gather_map; }
+
    /// Compute MultTranspose by setting (rather than adding) element
    /// contributions; this is a left inverse of the Mult() operation
    void MultLeftInverse(const Vector &x, Vector &y) const;
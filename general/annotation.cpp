@@ -0,0 +1,367 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "annotation.hpp"
+#include "tic_toc.hpp"
+
+#include <vector>
+#include <unordered_map>
+#include <cstring>
+#include <iomanip>
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+namespace mfem
+{
+
+namespace internal
+{
+
+/// Node of the tree of regions recorded by the PerfRegistry.
+struct PerfNode
+{
+   int region, parent;
+   long count;
+   double time, start;
+   std::vector<int> children;
+   PerfNode(int r, int p) : region(r), parent(p), count(0), time(0.0),
+      start(0.0) { }
+};
+
+struct PerfData
+{
+   std::vector<std::string> names;
+   std::unordered_map<std::string, int> ids;
+   std::vector<PerfNode> nodes;
+   int current;
+   mfem::StopWatch timer;
+
+   PerfData() : current(0) { Clear(); timer.Start(); }
+
+   void Clear()
+   {
+      nodes.clear();
+      nodes.emplace_back(-1, -1); // root
+      current = 0;
+   }
+
+   std::string Path(int node) const
+   {
+      std::string path = names[nodes[node].region];
+      for (int p = nodes[node].parent; p > 0; p = nodes[p].parent)
+      {
+         path = names[nodes[p].region] + '/' + path;
+      }
+      return path;
+   }
+
+   /// Nodes in depth-first order, excluding the root, with their depth.
+   void DepthFirst(int node, int depth, std::vector<int> &order,
+                   std::vector<int> &depths) const
+   {
+      for (int c : nodes[node].children)
+      {
+         order.push_back(c);
+         depths.push_back(depth);
+         DepthFirst(c, depth + 1, order, depths);
+      }
+   }
+
+   double Exclusive(int node) const
+   {
+      double t = nodes[node].time;
+      for (int c : nodes[node].children) { t -= nodes[c].time; }
+      return t;
+   }
+
+   int Find(const std::string &path) const
+   {
+      std::vector<int> order, depths;
+      DepthFirst(0, 0, order, depths);
+      for (int n : order) { if (Path(n) == path) { return n; } }
+      return -1;
+   }
+};
+
+static PerfData &GetPerfData()
+{
+   static PerfData data;
+   return data;
+}
+
+} // namespace mfem::internal
+
+MFEM_THREAD_LOCAL bool PerfRegistry::enabled = false;
+
+// The thread on which the registry is enabled, if any
+static std::mutex perf_owner_mutex;
+static std::thread::id perf_owner;
+
+void PerfRegistry::Enable(bool enable)
+{
+   std::lock_guard<std::mutex> lock(perf_owner_mutex);
+   const std::thread::id self = std::this_thread::get_id();
+   if (enable)
+   {
+      MFEM_VERIFY(perf_owner == std::thread::id() || perf_owner == self,
+                  "the PerfRegistry is already enabled on another thread");
+      perf_owner = self;
+   }
+   else if (perf_owner == self)
+   {
+      perf_owner = std::thread::id();
+   }
+   enabled = enable;
+}
+
+int PerfRegistry::Register(const char *name)
+{
+   internal::PerfData &data = internal::GetPerfData();
+   auto it = data.ids.find(name);
+   if (it != data.ids.end()) { return it->second; }
+   const int id = (int)data.names.size();
+   data.names.push_back(name);
+   data.ids.emplace(data.names.back(), id);
+   return id;
+}
+
+int PerfRegistry::RegisterFunction(const char *pretty_name)
+{
+   // Drop the return type, the arguments and the mfem namespace:
+   // "virtual void mfem::CGSolver::Mult(...) const" -> "CGSolver::Mult"
+   std::string name(pretty_name);
+   const size_t args = name.find('(');
+   if (args != std::string::npos) { name.resize(args); }
+   const size_t space = name.rfind(' ');
+   if (space != std::string::npos) { name.erase(0, space + 1); }
+   if (name.compare(0, 6, "mfem::") == 0) { name.erase(0, 6); }
+   return Register(name.c_str());
+}
+
+void PerfRegistry::Begin(int id)
+{
+   internal::PerfData &data = internal::GetPerfData();
+   int child = -1;
+   for (int c : data.nodes[data.current].children)
+   {
+      if (data.nodes[c].region == id) { child = c; break; }
+   }
+   if (child < 0)
+   {
+      child = (int)data.nodes.size();
+      data.nodes.emplace_back(id, data.current);
+      data.nodes[data.current].children.push_back(child);
+   }
+   data.current = child;
+   data.nodes[child].start = data.timer.RealTime();
+}
+
+void PerfRegistry::End()
+{
+   internal::PerfData &data = internal::GetPerfData();
+   if (data.current == 0) { return; }
+   internal::PerfNode &node = data.nodes[data.current];
+   node.time += data.timer.RealTime() - node.start;
+   node.count++;
+   data.current = node.parent;
+}
+
+void PerfRegistry::EndRegion(const char *name)
+{
+   internal::PerfData &data = internal::GetPerfData();
+   // A region which is not open was opened while the registry was disabled
+   for (int n = data.current; n > 0; n = data.nodes[n].parent)
+   {
+      if (data.names[data.nodes[n].region] != name) { continue; }
+      MFEM_ASSERT(n == data.current, "region '" << name << "' closed before "
+                  "the nested region '"
+                  << data.names[data.nodes[data.current].region] << "'");
+      if (n == data.current) { End(); }
+      return;
+   }
+}
+
+void PerfRegistry::Reset()
+{
+   internal::PerfData &data = internal::GetPerfData();
+   MFEM_VERIFY(data.current == 0, "cannot reset with open regions");
+   data.Clear();
+}
+
+long PerfRegistry::GetCount(const std::string &path)
+{
+   const internal::PerfData &data = internal::GetPerfData();
+   const int node = data.Find(path);
+   return (node < 0) ? 0 : data.nodes[node].count;
+}
+
+double PerfRegistry::GetTime(const std::string &path)
+{
+   const internal::PerfData &data = internal::GetPerfData();
+   const int node = data.Find(path);
+   return (node < 0) ? 0.0 : data.nodes[node].time;
+}
+
+static void PrintPerfHeader(std::ostream &os, const char *value)
+{
+   os << std::left << std::setw(40) << "Region" << std::right
+      << std::setw(12) << "Count" << std::setw(14) << value
+      << std::setw(14) << "Exclusive" << std::setw(8) << "%" << '\n';
+}
+
+static void PrintPerfLine(std::ostream &os, const std::string &name,
+                          int depth, double count, double incl, double excl,
+                          double total)
+{
+   os << std::left << std::setw(40) << (std::string(2*depth, ' ') + name)
+      << std::right << std::setw(12) << count
+      << std::setw(14) << incl << std::setw(14) << excl
+      << std::setw(8) << std::setprecision(3)
+      << (total > 0.0 ? 100.0*incl/total : 0.0) << std::setprecision(6)
+      << '\n';
+}
+
+void PerfRegistry::Print(std::ostream &os)
+{
+   const internal::PerfData &data = internal::GetPerfData();
+   std::vector<int> order, depths;
+   data.DepthFirst(0, 0, order, depths);
+   double total = 0.0;
+   for (int c : data.nodes[0].children) { total += data.nodes[c].time; }
+
+   const std::ios::fmtflags old_flags = os.flags();
+   PrintPerfHeader(os, "Inclusive");
+   for (size_t i = 0; i < order.size(); i++)
+   {
+      const internal::PerfNode &node = data.nodes[order[i]];
+      PrintPerfLine(os, data.names[node.region], depths[i], node.count,
+                    node.time, data.Exclusive(order[i]), total);
+   }
+   os.flags(old_flags);
+   os << std::flush;
+}
+
+#ifdef MFEM_USE_MPI
+void PerfRegistry::Print(MPI_Comm comm, std::ostream &os)
+{
+   const internal::PerfData &data = internal::GetPerfData();
+   int rank, nranks;
+   MPI_Comm_rank(comm, &rank);
+   MPI_Comm_size(comm, &nranks);
+
+   // Gather the local region paths on rank 0 and broadcast their union
+   std::vector<int> order, depths;
+   data.DepthFirst(0, 0, order, depths);
+   std::string paths;
+   for (int n : order) { paths += data.Path(n) + '\n'; }
+   int len = (int)paths.size();
+   std::vector<int> lens(nranks), offsets(nranks+1, 0);
+   MPI_Gather(&len, 1, MPI_INT, lens.data(), 1, MPI_INT, 0, comm);
+   for (int r = 0; r < nranks; r++) { offsets[r+1] = offsets[r] + lens[r]; }
+   std::vector<char> all(rank == 0 ? offsets[nranks] : 0);
+   MPI_Gatherv(const_cast<char*>(paths.data()), len, MPI_CHAR, all.data(),
+               lens.data(), offsets.data(), MPI_CHAR, 0, comm);
+   std::vector<std::string> names;
+   std::unordered_map<std::string, int> index;
+   std::string merged;
+   if (rank == 0)
+   {
+      size_t start = 0;
+      for (size_t i = 0; i < all.size(); i++)
+      {
+         if (all[i] != '\n') { continue; }
+         std::string path(all.data() + start, i - start);
+         start = i + 1;
+         if (!index.emplace(path, 0).second) { continue; }
+         // Insert the path after the last descendant of its parent
+         const size_t sep = path.rfind('/');
+         auto pos = names.end();
+         if (sep != std::string::npos)
+         {
+            const std::string parent = path.substr(0, sep);
+            pos = std::find(names.begin(), names.end(), parent);
+            if (pos != names.end())
+            {
+               for (++pos; pos != names.end() &&
+                    pos->compare(0, sep + 1, parent + '/') == 0; ++pos) { }
+            }
+         }
+         names.insert(pos, path);
+      }
+      for (const std::string &path : names) { merged += path + '\n'; }
+   }
+   len = (int)merged.size();
+   MPI_Bcast(&len, 1, MPI_INT, 0, comm);
+   merged.resize(len);
+   MPI_Bcast(&merged[0], len, MPI_CHAR, 0, comm);
+   if (rank != 0)
+   {
+      size_t start = 0;
+      for (size_t i = 0; i < merged.size(); i++)
+      {
+         if (merged[i] != '\n') { continue; }
+         names.emplace_back(merged, start, i - start);
+         start = i + 1;
+      }
+   }
+
+   // Local values in the order of the union, zero for missing regions
+   const int nr = (int)names.size();
+   std::vector<double> loc(3*nr, 0.0), vmin(3*nr), vmax(3*nr), vsum(3*nr);
+   for (int n : order)
+   {
+      const std::string path = data.Path(n);
+      for (int k = 0; k < nr; k++)
+      {
+         if (names[k] != path) { continue; }
+         loc[3*k+0] = data.nodes[n].count;
+         loc[3*k+1] = data.nodes[n].time;
+         loc[3*k+2] = data.Exclusive(n);
+         break;
+      }
+   }
+   MPI_Reduce(loc.data(), vmin.data(), 3*nr, MPI_DOUBLE, MPI_MIN, 0, comm);
+   MPI_Reduce(loc.data(), vmax.data(), 3*nr, MPI_DOUBLE, MPI_MAX, 0, comm);
+   MPI_Reduce(loc.data(), vsum.data(), 3*nr, MPI_DOUBLE, MPI_SUM, 0, comm);
+   if (rank != 0) { return; }
+
+   double total = 0.0;
+   for (int k = 0; k < nr; k++)
+   {
+      if (names[k].find('/') == std::string::npos) { total += vmax[3*k+1]; }
+   }
+   const std::ios::fmtflags old_flags = os.flags();
+   const char *label[3] = { "min", "max", "avg" };
+   const std::vector<double> *vals[3] = { &vmin, &vmax, &vsum };
+   for (int j = 0; j < 3; j++)
+   {
+      const double scale = (j == 2) ? 1.0/nranks : 1.0;
+      os << "\nRegions, " << label[j] << " over " << nranks << " ranks:\n";
+      PrintPerfHeader(os, "Inclusive");
+      for (int k = 0; k < nr; k++)
+      {
+         const std::vector<double> &v = *vals[j];
+         const size_t sep = names[k].rfind('/');
+         const int depth = (int)std::count(names[k].begin(), names[k].end(),
+                                           '/');
+         const std::string name = (sep == std::string::npos) ? names[k] :
+                                  names[k].substr(sep + 1);
+         PrintPerfLine(os, name, depth, scale*v[3*k], scale*v[3*k+1],
+                       scale*v[3*k+2], total);
+      }
+   }
+   os.flags(old_flags);
+   os << std::flush;
+}
+#endif
+
+} // namespace mfem
@@ -13,6 +13,9 @@
 #define MFEM_ANNOTATION_HPP
 
 #include "../config/config.hpp"
+#include "globals.hpp"
+#include "error.hpp"
+#include <string>
 
 #ifdef MFEM_USE_CALIPER
 
@@ -27,11 +30,124 @@
 
 #else
 
-#define MFEM_PERF_FUNCTION
-#define MFEM_PERF_BEGIN(s)
-#define MFEM_PERF_END(s)
-#define MFEM_PERF_SCOPE(name)
+#define MFEM_PERF_FUNCTION \
+   static int mfem_perf_function_id = -1; \
+   mfem::PerfScope mfem_perf_function_scope(mfem_perf_function_id, \
+                                            _MFEM_FUNC_NAME)
+#define MFEM_PERF_BEGIN(s) mfem::PerfRegistry::Begin(s)
+#define MFEM_PERF_END(s) mfem::PerfRegistry::End(s)
+#define MFEM_PERF_SCOPE(name) mfem::PerfScope mfem_perf_scope(name)
 
 #endif
 
+namespace mfem
+{
+
+/** @brief Built-in hierarchical registry of timed regions, used by the
+    MFEM_PERF_* macros when MFEM is not configured with Caliper. */
+/** The regions form a tree: a region opened while another one is active is
+    recorded as its child. For every node of the tree the registry accumulates
+    the number of calls and the inclusive time; the exclusive time is the
+    inclusive time minus the inclusive times of the children. The times are
+    measured with a StopWatch, see MFEM_TIMER_TYPE.
+
+    The registry is disabled by default, in which case the regions only cost a
+    test of a thread-local flag. The recording is confined to one thread: the
+    regions opened on the other threads, e.g. OpenMP worker threads or the I/O
+    thread of AsyncDataCollection, are not recorded. */
+class PerfRegistry
+{
+   static MFEM_THREAD_LOCAL bool enabled;
+
+   /// Close the region named @a name, see End(const char*).
+   static void EndRegion(const char *name);
+
+public:
+   /** @brief Enable or disable the recording of the regions opened on the
+       calling thread. */
+   /** It is an error to enable the registry on a thread while it is enabled on
+       another one. */
+   static void Enable(bool enable = true);
+
+   /// Return true if the regions opened on the calling thread are recorded.
+   static bool Enabled() { return enabled; }
+
+   /// Return the id of the region with the given @a name, adding it if needed.
+   static int Register(const char *name);
+
+   /** @brief Return the id of the region named after the function signature
+       @a pretty_name, e.g. "mfem::CGSolver::Mult" for the output of
+       __PRETTY_FUNCTION__ in CGSolver::Mult. */
+   static int RegisterFunction(const char *pretty_name);
+
+   /// Open the region with the given id, see Register().
+   static void Begin(int id);
+
+   /// Open the region with the given @a name.
+   static void Begin(const char *name)
+   { if (enabled) { Begin(Register(name)); } }
+
+   /// Close the innermost open region.
+   static void End();
+
+   /** @brief Close the region with the given @a name, opened by
+       Begin(const char*). */
+   /** Like Begin(const char*), this is a no-op when the registry is disabled.
+       A region that was not opened, because the registry was disabled when
+       Begin() was called, is not closed either. Closing an open region other
+       than the innermost one is an error, checked in debug mode. */
+   static void End(const char *name)
+   { if (enabled) { EndRegion(name); } }
+
+   /// Clear all the recorded data. The regions must all be closed.
+   static void Reset();
+
+   /// Number of calls of the region with path @a path, e.g. "Solve/CG".
+   static long GetCount(const std::string &path);
+
+   /// Inclusive time, in seconds, of the region with path @a path.
+   static double GetTime(const std::string &path);
+
+   /// Print the tree of regions with their counts, inclusive and exclusive
+   /// times, and their percentage of the total time.
+   static void Print(std::ostream &os = mfem::out);
+
+#ifdef MFEM_USE_MPI
+   /** @brief Print the min/max/avg over the ranks of @a comm of the counts and
+       times of the regions, on rank 0. Collective on @a comm. */
+   /** Regions that were not executed on some ranks count as zero there. */
+   static void Print(MPI_Comm comm, std::ostream &os = mfem::out);
+#endif
+};
+
+/// Scoped region of the PerfRegistry: opened in the constructor and closed in
+/// the destructor. Used by the MFEM_PERF_FUNCTION and MFEM_PERF_SCOPE macros.
+class PerfScope
+{
+   const bool active;
+public:
+   explicit PerfScope(int id) : active(PerfRegistry::Enabled())
+   { if (active) { PerfRegistry::Begin(id); } }
+
+   explicit PerfScope(const char *name) : active(PerfRegistry::Enabled())
+   { if (active) { PerfRegistry::Begin(PerfRegistry::Register(name)); } }
+
+   explicit PerfScope(const std::string &name) : PerfScope(name.c_str()) { }
+
+   /** @brief Scope of the function @a pretty_name, see MFEM_PERF_FUNCTION. The
+       region is registered when it is first opened and its id is cached in
+       @a id, which must be initialized to -1. */
+   PerfScope(int &id, const char *pretty_name)
+      : active(PerfRegistry::Enabled())
+   {
+      if (!active) { return; }
+      if (id < 0) { id = PerfRegistry::RegisterFunction(pretty_name); }
+      PerfRegistry::Begin(id);
+   }
+
+   ~PerfScope() { if (active) { PerfRegistry::End(); } }
+};
+
+} // namespace mfem
+
 #endif
@@ -14,7 +14,9 @@
 
 #include "../config/config.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <string>
 #include <vector>
 
 namespace mfem
@@ -50,6 +52,35 @@ inline T read(const char *buf)
    return value;
 }
 
+/// Write the @a n values of @a data as raw bytes.
+template <typename T>
+inline void write(std::ostream& os, const T *data, std::size_t n)
+{
+   os.write((const char*) data, n*sizeof(T));
+}
+
+/// Read @a n values written with write(os, data, n) into @a data.
+template <typename T>
+inline void read(std::istream& is, T *data, std::size_t n)
+{
+   is.read((char*) data, n*sizeof(T));
+}
+
+/// Write a string as its length followed by its characters.
+inline void WriteString(std::ostream& os, const std::string &str)
+{
+   write<std::uint64_t>(os, str.size());
+   os.write(str.data(), str.size());
+}
+
+/// Read a string written with WriteString().
+inline std::string ReadString(std::istream& is)
+{
+   std::string str(read<std::uint64_t>(is), '\0');
+   if (str.size()) { is.read(&str[0], str.size()); }
+   return str;
+}
+
 /// Append the binary representation of @a val to the byte buffer @a vec.
 template <typename T>
 void AppendBytes(std::vector<char> &vec, const T &val)
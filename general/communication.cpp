@@ -350,6 +350,8 @@ GroupCommunicator::GroupCommunicator(GroupTopology &gt, Mode m)
    num_requests = 0;
    request_marker = NULL;
    buf_offsets = NULL;
+   nbr_comm = MPI_COMM_NULL;
+   nbr_recv_offset = 0;
 }
 
 void GroupCommunicator::Create(const Array<int> &ldof_group)
@@ -404,6 +406,8 @@ void GroupCommunicator::Finalize()
       }
    }
 
+   // at least one request, for the byNeighborhood collective
+   request_counter = max(request_counter, 1);
    requests = new MPI_Request[request_counter];
    // statuses = new MPI_Status[request_counter];
    request_marker = new int[request_counter];
@@ -485,6 +489,74 @@ void GroupCommunicator::Finalize()
          }
       }
    }
+
+   if (mode == byNeighborhood) { SetupNeighborhood(); }
+}
+
+void GroupCommunicator::SetupNeighborhood()
+{
+#if MPI_VERSION >= 3
+   const int num_nbrs = gtopo.GetNumNeighbors()-1;
+   Array<int> nbr_ranks(num_nbrs);
+   nbr_send_counts.SetSize(num_nbrs);
+   nbr_send_displs.SetSize(num_nbrs);
+   nbr_recv_counts.SetSize(num_nbrs);
+   nbr_recv_displs.SetSize(num_nbrs);
+   // All the data sent in a Bcast is placed before all the received data, at
+   // nbr_recv_offset; the send and the receive displacements are relative to
+   // the start of their part of group_buf, so the two parts can be passed to
+   // MPI as separate (non-aliased) buffers
+   int offset = 0;
+   for (int nbr = 1; nbr <= num_nbrs; nbr++)
+   {
+      nbr_ranks[nbr-1] = gtopo.GetNeighborRank(nbr);
+      const int *grp_list = nbr_send_groups.GetRow(nbr);
+      int count = 0;
+      for (int i = 0; i < nbr_send_groups.RowSize(nbr); i++)
+      {
+         count += group_ldof.RowSize(grp_list[i]);
+      }
+      nbr_send_counts[nbr-1] = count;
+      nbr_send_displs[nbr-1] = offset;
+      offset += count;
+   }
+   nbr_recv_offset = offset;
+   for (int nbr = 1; nbr <= num_nbrs; nbr++)
+   {
+      const int *grp_list = nbr_recv_groups.GetRow(nbr);
+      int count = 0;
+      for (int i = 0; i < nbr_recv_groups.RowSize(nbr); i++)
+      {
+         count += group_ldof.RowSize(grp_list[i]);
+      }
+      nbr_recv_counts[nbr-1] = count;
+      nbr_recv_displs[nbr-1] = offset - nbr_recv_offset;
+      offset += count;
+   }
+   MFEM_ASSERT(offset == group_buf_size, "");
+
+   // The neighbor relation is symmetric, so the sources and the destinations
+   // are the same
+   MPI_Dist_graph_create_adjacent(gtopo.GetComm(),
+                                  num_nbrs, nbr_ranks.GetData(),
+                                  MPI_UNWEIGHTED,
+                                  num_nbrs, nbr_ranks.GetData(),
+                                  MPI_UNWEIGHTED,
+                                  MPI_INFO_NULL, 0, &nbr_comm);
+#else
+   MFEM_ABORT("GroupCommunicator::byNeighborhood requires MPI-3");
+#endif
+}
+
+void GroupCommunicator::SetMode(Mode m)
+{
+   MFEM_VERIFY(comm_lock == 0, "object is in use");
+   mode = m;
+   // Finalize() sets up the neighborhood if it has not been called yet
+   if (mode == byNeighborhood && nbr_comm == MPI_COMM_NULL && buf_offsets)
+   {
+      SetupNeighborhood();
+   }
 }
 
 void GroupCommunicator::SetLTDofTable(const Array<int> &ldof_ltdof)
@@ -700,7 +772,9 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
 {
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
-   if (group_buf_size == 0) { return; }
+   // byNeighborhood posts the (possibly empty) collective on nbr_comm, which
+   // all the ranks must call
+   if (group_buf_size == 0 && mode != byNeighborhood) { return; }
 
    int request_counter = 0;
    switch (mode)
@@ -826,6 +900,33 @@ void GroupCommunicator::BcastBegin(T *ldata, int layout) const
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
          break;
       }
+
+      case byNeighborhood: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         group_buf.SetSize(group_buf_size*sizeof(T));
+         T *buf = (T *)group_buf.GetData();
+         for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+         {
+            T *nbr_buf = buf + nbr_send_displs[nbr-1];
+            const int *grp_list = nbr_send_groups.GetRow(nbr);
+            for (int i = 0; i < nbr_send_groups.RowSize(nbr); i++)
+            {
+               nbr_buf = CopyGroupToBuffer(ldata, nbr_buf, grp_list[i], layout);
+            }
+         }
+         MPI_Ineighbor_alltoallv(buf, nbr_send_counts.GetData(),
+                                 nbr_send_displs.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 buf + nbr_recv_offset,
+                                 nbr_recv_counts.GetData(),
+                                 nbr_recv_displs.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 nbr_comm, &requests[request_counter]);
+         request_counter++;
+#endif
+         break;
+      }
    }
 
    comm_lock = 1; // 1 - locked for Bcast
@@ -888,6 +989,23 @@ void GroupCommunicator::BcastEnd(T *ldata, int layout) const
          }
          break;
       }
+
+      case byNeighborhood: // ***** Neighborhood collective *****
+      {
+         MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+
+         for (int nbr = 1; nbr < nbr_recv_groups.Size(); nbr++)
+         {
+            const int *grp_list = nbr_recv_groups.GetRow(nbr);
+            const T *buf = (T*)group_buf.GetData() + nbr_recv_offset +
+                           nbr_recv_displs[nbr-1];
+            for (int i = 0; i < nbr_recv_groups.RowSize(nbr); i++)
+            {
+               buf = CopyGroupFromBuffer(buf, ldata, grp_list[i], layout);
+            }
+         }
+         break;
+      }
    }
 
    comm_lock = 0; // 0 - no lock
@@ -899,7 +1017,9 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
 {
    MFEM_VERIFY(comm_lock == 0, "object is already in use");
 
-   if (group_buf_size == 0) { return; }
+   // byNeighborhood posts the (possibly empty) collective on nbr_comm, which
+   // all the ranks must call
+   if (group_buf_size == 0 && mode != byNeighborhood) { return; }
 
    int request_counter = 0;
    group_buf.SetSize(group_buf_size*sizeof(T));
@@ -1007,6 +1127,33 @@ void GroupCommunicator::ReduceBegin(const T *ldata) const
          MFEM_ASSERT(buf - (T*)group_buf.GetData() == group_buf_size, "");
          break;
       }
+
+      case byNeighborhood: // ***** Neighborhood collective *****
+      {
+#if MPI_VERSION >= 3
+         // In Reduce operation: send_groups <--> recv_groups
+         for (int nbr = 1; nbr < nbr_recv_groups.Size(); nbr++)
+         {
+            T *nbr_buf = buf + nbr_recv_offset + nbr_recv_displs[nbr-1];
+            const int *grp_list = nbr_recv_groups.GetRow(nbr);
+            for (int i = 0; i < nbr_recv_groups.RowSize(nbr); i++)
+            {
+               const int layout = 0; // ldata is an array on all ldofs
+               nbr_buf = CopyGroupToBuffer(ldata, nbr_buf, grp_list[i], layout);
+            }
+         }
+         MPI_Ineighbor_alltoallv(buf + nbr_recv_offset,
+                                 nbr_recv_counts.GetData(),
+                                 nbr_recv_displs.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 buf, nbr_send_counts.GetData(),
+                                 nbr_send_displs.GetData(),
+                                 MPITypeMap<T>::mpi_type,
+                                 nbr_comm, &requests[request_counter]);
+         request_counter++;
+#endif
+         break;
+      }
    }
 
    comm_lock = 2;
@@ -1077,6 +1224,23 @@ void GroupCommunicator::ReduceEnd(T *ldata, int layout,
          }
          break;
       }
+
+      case byNeighborhood: // ***** Neighborhood collective *****
+      {
+         MPI_Waitall(num_requests, requests, MPI_STATUSES_IGNORE);
+
+         // In Reduce operation: send_groups <--> recv_groups
+         for (int nbr = 1; nbr < nbr_send_groups.Size(); nbr++)
+         {
+            const int *grp_list = nbr_send_groups.GetRow(nbr);
+            const T *buf = (T*)group_buf.GetData() + nbr_send_displs[nbr-1];
+            for (int i = 0; i < nbr_send_groups.RowSize(nbr); i++)
+            {
+               buf = ReduceGroupFromBuffer(buf, ldata, grp_list[i], layout, Op);
+            }
+         }
+         break;
+      }
    }
 
    comm_lock = 0; // 0 - no lock
@@ -1193,6 +1357,7 @@ void GroupCommunicator::PrintInfo(std::ostream &os) const
          break;
 
       case byNeighbor:
+      case byNeighborhood:
          for (int gr = 1; gr < group_ldof.Size(); gr++)
          {
             const int nldofs = group_ldof.RowSize(gr);
@@ -1247,7 +1412,8 @@ void GroupCommunicator::PrintInfo(std::ostream &os) const
    }
    os << "Rank " << myid << ":\n"
       "   mode             = " <<
-      (mode == byGroup ? "byGroup" : "byNeighbor") << "\n"
+      (mode == byGroup ? "byGroup" :
+       mode == byNeighbor ? "byNeighbor" : "byNeighborhood") << "\n"
       "   number of sends  = " << num_sends <<
       " (" << mem_sends << " bytes)\n"
       "   number of recvs  = " << num_recvs <<
@@ -1257,7 +1423,7 @@ void GroupCommunicator::PrintInfo(std::ostream &os) const
       num_master_groups << " + " <<
       group_ldof.Size()-num_master_groups-num_empty_groups << " + " <<
       num_empty_groups << " (master + slave + empty)\n";
-   if (mode == byNeighbor)
+   if (mode != byGroup)
    {
       os <<
          "   num neighbors    = " << nbr_send_groups.Size() << " = " <<
@@ -1279,6 +1445,12 @@ void GroupCommunicator::PrintInfo(std::ostream &os) const
 
 GroupCommunicator::~GroupCommunicator()
 {
+   if (nbr_comm != MPI_COMM_NULL)
+   {
+      int mpi_is_finalized;
+      MPI_Finalized(&mpi_is_finalized);
+      if (!mpi_is_finalized) { MPI_Comm_free(&nbr_comm); }
+   }
    delete [] buf_offsets;
    delete [] request_marker;
    // delete [] statuses;
@@ -205,8 +205,12 @@ public:
    enum Mode
    {
       byGroup,    ///< Communications are performed one group at a time.
-      byNeighbor  /**< Communications are performed one neighbor at a time,
+      byNeighbor, /**< Communications are performed one neighbor at a time,
                        aggregating over groups. */
+      byNeighborhood /**< Communications are aggregated over groups as in
+                          byNeighbor and performed with a single non-blocking
+                          MPI-3 neighborhood collective on a distributed graph
+                          communicator, which is created once. */
    };
 
 protected:
@@ -224,6 +228,17 @@ protected:
    int *request_marker;
    int *buf_offsets; // size = max(number of groups, number of neighbors)
    Table nbr_send_groups, nbr_recv_groups; // nbr 0 = me
+   // Distributed graph communicator of the neighbors, used by byNeighborhood
+   MPI_Comm nbr_comm;
+   // byNeighborhood Bcast counts and offsets, per neighbor except me; the
+   // send offsets are relative to group_buf and the receive offsets to
+   // group_buf + nbr_recv_offset. Reduce swaps the send and the receive arrays
+   Array<int> nbr_send_counts, nbr_send_displs;
+   Array<int> nbr_recv_counts, nbr_recv_displs;
+   int nbr_recv_offset;
+
+   /// Create nbr_comm and the byNeighborhood counts, collective on the comm.
+   void SetupNeighborhood();
 
 public:
    /// Construct a GroupCommunicator object.
@@ -249,6 +264,14 @@ public:
    /// Allocate internal buffers after the GroupLDofTable is defined
    void Finalize();
 
+   /// Set the communication mode.
+   /** Switching to byNeighborhood after Finalize() is collective on the
+       communicator of the GroupTopology. No operation can be in progress. */
+   void SetMode(Mode m);
+
+   /// Get the communication mode.
+   Mode GetMode() const { return mode; }
+
    /// Initialize the internal group_ltdof Table.
    /** This method must be called before performing operations that use local
        data layout 2, see CopyGroupToBuffer() for layout descriptions. */
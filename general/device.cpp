@@ -90,6 +90,12 @@ Device::Device()
          host_mem_type = MemoryType::HOST_64;
          device_mem_type = MemoryType::HOST_64;
       }
+      else if (mem_backend == "pool")
+      {
+         mem_host_env = true;
+         host_mem_type = MemoryType::HOST_POOL;
+         device_mem_type = MemoryType::HOST_POOL;
+      }
       else if (mem_backend == "umpire")
       {
          mem_host_env = true;
@@ -0,0 +1,41 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "forall.hpp"
+
+#include <vector>
+
+namespace mfem
+{
+
+OmpSchedule::Type OmpSchedule::type = OmpSchedule::STATIC;
+int OmpSchedule::chunk = 0;
+
+// The buffer of each thread, released when the thread exits.
+static thread_local std::vector<double> forall_scratch;
+
+double *ForallScratch::Get(std::size_t n)
+{
+   if (forall_scratch.size() < n) { forall_scratch.resize(n); }
+   return forall_scratch.data();
+}
+
+std::size_t ForallScratch::Capacity()
+{
+   return forall_scratch.size();
+}
+
+void ForallScratch::Clear()
+{
+   std::vector<double>().swap(forall_scratch);
+}
+
+} // namespace mfem
@@ -19,6 +19,11 @@
 #include "device.hpp"
 #include "mem_manager.hpp"
 #include "../linalg/dtensor.hpp"
+#include <cstddef>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 namespace mfem
 {
@@ -95,15 +100,102 @@ const int MAX_Q1D = 14;
                  [&] MFEM_LAMBDA (int i) {__VA_ARGS__})
 
 
+/// Loop scheduling of the OpenMP backend (Backend::OMP), see OmpWrap().
+/** The schedule applies to all MFEM_FORALL kernels executed with the OpenMP
+    backend and can be changed at any time with Set(). */
+class OmpSchedule
+{
+public:
+   enum Type
+   {
+      STATIC,  ///< Contiguous blocks of iterations, one per thread (default)
+      DYNAMIC, ///< Chunks of iterations handed out from a shared queue
+      GUIDED,  ///< Like DYNAMIC, with decreasing chunk sizes
+      RUNTIME, ///< Schedule read from the OMP_SCHEDULE environment variable
+      TASKS    ///< OpenMP taskloop: idle threads steal the pending chunks
+   };
+
+private:
+   static Type type;
+   static int chunk;
+
+public:
+   /** @brief Set the schedule @a type_ and the number of iterations per chunk,
+       @a chunk_. With @a chunk_ = 0, a default based on the loop size and the
+       number of threads is used. */
+   static void Set(Type type_, int chunk_ = 0)
+   { type = type_; chunk = chunk_; }
+
+   static Type GetType() { return type; }
+
+   /// Return the chunk size used for a loop with @a N iterations.
+   static int GetChunk(const int N)
+   {
+      if (chunk > 0) { return chunk; }
+#ifdef MFEM_USE_OPENMP
+      // About 8 chunks per thread: enough to balance, few enough to be cheap.
+      const int c = N / (8*omp_get_max_threads());
+      return c > 0 ? c : 1;
+#else
+      return N > 0 ? N : 1;
+#endif
+   }
+};
+
+/// Per-thread scratch memory for the host bodies of MFEM_FORALL kernels.
+/** Get() returns host memory private to the calling thread (an OpenMP thread
+    when using Backend::OMP), which stays valid until the next call to Get()
+    from the same thread. The memory is reused across loop iterations and
+    kernel launches, so kernels with large per-iteration temporaries do not
+    need to allocate inside the loop. It must not be used in device code. */
+class ForallScratch
+{
+public:
+   /// Return a thread-private buffer with room for at least @a n doubles.
+   static double *Get(std::size_t n);
+
+   /// Size, in doubles, of the buffer of the calling thread.
+   static std::size_t Capacity();
+
+   /// Release the buffer of the calling thread.
+   static void Clear();
+};
+
 /// OpenMP backend
 template <typename HBODY>
 void OmpWrap(const int N, HBODY &&h_body)
 {
 #ifdef MFEM_USE_OPENMP
-   #pragma omp parallel for
-   for (int k = 0; k < N; k++)
+   const int chunk = OmpSchedule::GetChunk(N);
+   switch (OmpSchedule::GetType())
    {
-      h_body(k);
+      case OmpSchedule::STATIC:
+         #pragma omp parallel for schedule(static)
+         for (int k = 0; k < N; k++) { h_body(k); }
+         break;
+      case OmpSchedule::DYNAMIC:
+         #pragma omp parallel for schedule(dynamic, chunk)
+         for (int k = 0; k < N; k++) { h_body(k); }
+         break;
+      case OmpSchedule::GUIDED:
+         #pragma omp parallel for schedule(guided, chunk)
+         for (int k = 0; k < N; k++) { h_body(k); }
+         break;
+      case OmpSchedule::RUNTIME:
+         #pragma omp parallel for schedule(runtime)
+         for (int k = 0; k < N; k++) { h_body(k); }
+         break;
+      case OmpSchedule::TASKS:
+#if _OPENMP >= 201511
+         #pragma omp parallel
+         #pragma omp single nowait
+         #pragma omp taskloop grainsize(chunk)
+         for (int k = 0; k < N; k++) { h_body(k); }
+#else
+         #pragma omp parallel for schedule(dynamic, chunk)
+         for (int k = 0; k < N; k++) { h_body(k); }
+#endif
+         break;
    }
 #else
    MFEM_CONTRACT_VAR(N);
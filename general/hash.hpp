@@ -450,6 +450,275 @@ protected:
 };
 
 
+/** OpenHashTable is a drop-in replacement for HashTable, with the same
+ *  interface and the same semantics: the items are stored in a BlockArray<T>,
+ *  their ids are stable and the ids of the deleted items are reused.
+ *
+ *  The difference is in the hash table itself, which uses open addressing
+ *  with linear probing and Robin Hood insertion instead of the linked lists
+ *  of HashTable. Each slot of the table stores the id of an item and the full
+ *  hash of its key, so that a lookup scans a few contiguous slots and only
+ *  reads the items whose hashes match, instead of following the 'next' links
+ *  through the BlockArray. With Robin Hood insertion, the items of each run of
+ *  occupied slots are sorted by their home slot, which bounds the length of
+ *  the probes and lets unsuccessful searches stop early. An item is inserted
+ *  by shifting the end of its run forward by one slot, and deleted by shifting
+ *  it back, without tombstones.
+ *
+ *  The 'next' member of the items is not used for chaining: it is -1 for
+ *  the items in use and -2 for the unused ones, see IdExists().
+ */
+template<typename T>
+class OpenHashTable : public BlockArray<T>
+{
+protected:
+   typedef BlockArray<T> Base;
+
+public:
+   /** @brief Main constructor of the OpenHashTable class.
+
+       @param[in] block_size The size of the storage blocks of the underlying
+                             BlockArray<T>.
+       @param[in] init_hash_size The initial number of slots of the hash
+                                 table. Must be a power of 2. */
+   OpenHashTable(int block_size = 16*1024, int init_hash_size = 32*1024);
+   /// @brief Deep copy
+   OpenHashTable(const OpenHashTable& other);
+   /// @brief Copy assignment not supported
+   OpenHashTable& operator=(const OpenHashTable&) = delete;
+   ~OpenHashTable();
+
+   /// Item accessor with key (p1, p2), see HashTable::Get(int, int).
+   T* Get(int p1, int p2);
+
+   /// Item accessor with key (p1, p2, p3, p4), see HashTable::Get().
+   T* Get(int p1, int p2, int p3, int p4 = -1 /* p4 optional */);
+
+   /** @brief Get the "id" of the item with key (p1, p2), creating it if it
+       doesn't exist, see HashTable::GetId(int, int). */
+   int GetId(int p1, int p2);
+
+   /** @brief Get the "id" of the item with key (p1, p2, p3, p4), creating it
+       if it doesn't exist, see HashTable::GetId(). */
+   int GetId(int p1, int p2, int p3, int p4 = -1);
+
+   /// Find the item with key (p1, p2), return NULL if it doesn't exist.
+   T* Find(int p1, int p2);
+
+   /// Find the item with key (p1, p2, p3, p4), return NULL if it doesn't exist.
+   T* Find(int p1, int p2, int p3, int p4 = -1);
+
+   /// Find the item with key (p1, p2), return NULL if it doesn't exist.
+   const T* Find(int p1, int p2) const;
+
+   /// Find the item with key (p1, p2, p3, p4), return NULL if it doesn't exist.
+   const T* Find(int p1, int p2, int p3, int p4 = -1) const;
+
+   /// Find the id of the item with key (p1, p2), return -1 if it doesn't exist.
+   int FindId(int p1, int p2) const;
+
+   /** @brief Find the id of the item with key (p1, p2, p3, p4), return -1 if
+       it doesn't exist. */
+   int FindId(int p1, int p2, int p3, int p4 = -1) const;
+
+   /// @brief Return the number of elements currently stored in the table.
+   int Size() const { return Base::Size() - unused.Size(); }
+
+   /// @brief Return the total number of ids (used and unused) in the table.
+   int NumIds() const { return Base::Size(); }
+
+   /// @brief Return the number of free/unused ids in the table.
+   int NumFreeIds() const { return unused.Size(); }
+
+   /** @brief Return true if item 'id' exists in (is used by) the container.
+
+       @warning It is assumed that 0 <= id < NumIds(). */
+   bool IdExists(int id) const { return (Base::At(id).next != -2); }
+
+   /** @brief Remove an item from the hash table.
+
+       @warning Its id will be reused by newly added items. */
+   void Delete(int id);
+
+   /// @brief Remove all items.
+   void DeleteAll();
+
+   /** @brief Allocate an item at 'id', see HashTable::Alloc().
+
+       @warning This is a special purpose method used when loading data from a
+       file. Does nothing if the slot 'id' has already been allocated. */
+   void Alloc(int id, int p1, int p2);
+
+   /** @brief Reinitialize the internal list of unallocated items.
+
+       @warning This is a special purpose method used when loading data from a
+       file. */
+   void UpdateUnused();
+
+   /// @brief Change the key of the item 'id' to (new_p1, new_p2).
+   void Reparent(int id, int new_p1, int new_p2);
+
+   /// @brief Change the key of the item 'id' to (new_p1, ..., new_p4).
+   void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4 = -1);
+
+   /// @brief Return total size of allocated memory (table and items), in bytes.
+   long MemoryUsage() const;
+
+   /// @brief Write details of the memory usage to the mfem output stream.
+   void PrintMemoryDetail() const;
+
+   /// @brief Print a histogram of the probe lengths for debugging purposes.
+   void PrintStats() const;
+
+   class iterator : public Base::iterator
+   {
+   protected:
+      friend class OpenHashTable;
+      typedef typename Base::iterator base;
+
+      iterator() { }
+      iterator(const base &it) : base(it)
+      {
+         while (base::good() && (*this)->next == -2) { base::next(); }
+      }
+
+   public:
+      iterator &operator++()
+      {
+         while (base::next(), base::good() && (*this)->next == -2) { }
+         return *this;
+      }
+   };
+
+   class const_iterator : public Base::const_iterator
+   {
+   protected:
+      friend class OpenHashTable;
+      typedef typename Base::const_iterator base;
+
+      const_iterator() { }
+      const_iterator(const base &it) : base(it)
+      {
+         while (base::good() && (*this)->next == -2) { base::next(); }
+      }
+
+   public:
+      const_iterator &operator++()
+      {
+         while (base::next(), base::good() && (*this)->next == -2) { }
+         return *this;
+      }
+   };
+
+   iterator begin() { return iterator(Base::begin()); }
+   iterator end() { return iterator(); }
+
+   const_iterator cbegin() const { return const_iterator(Base::cbegin()); }
+   const_iterator cend() const { return const_iterator(); }
+
+protected:
+   /// A slot of the table: the id of an item, -1 if empty, and its hash.
+   struct Slot
+   {
+      int id;
+      unsigned hash;
+   };
+
+   Slot* table; ///< the table of slots, of size mask+1
+
+   /** mask = table_size-1, the table size is a power of two. The home slot of
+       an item is (hash & mask). */
+   int mask;
+
+   int count; ///< number of occupied slots
+
+   /** List of deleted items in the BlockArray<T>. New items are created with
+       these ids first, before they are appended to the block array. */
+   Array<int> unused;
+
+   /** @brief Mix the bits of a key, so that linear probing does not see
+       clusters of consecutive keys. NOTE: the constants are arbitrary. */
+   static inline unsigned Mix(unsigned long long h)
+   {
+      h ^= h >> 29;
+      h *= 0xbf58476d1ce4e5b9ull;
+      h ^= h >> 32;
+      return (unsigned) h;
+   }
+
+   /// @brief Hash function for Hashed2 items.
+   inline unsigned Hash(size_t p1, size_t p2) const
+   { return Mix(984120265ul*p1 + 125965121ul*p2); }
+
+   /** @brief Hash function for Hashed4 items. NOTE: p4 is not hashed nor
+       stored as p1, p2, p3 identify a face uniquely. */
+   inline unsigned Hash(size_t p1, size_t p2, size_t p3) const
+   { return Mix(984120265ul*p1 + 125965121ul*p2 + 495698413ul*p3); }
+
+   /// @brief Hash function for items of type T that inherit from Hashed2.
+   inline unsigned Hash(const Hashed2& item) const
+   { return Hash(item.p1, item.p2); }
+
+   /// @brief Hash function for items of type T that inherit from Hashed4.
+   inline unsigned Hash(const Hashed4& item) const
+   { return Hash(item.p1, item.p2, item.p3); }
+
+   /// @brief Return the distance of the slot @a pos to the home slot of @a h.
+   inline int Distance(int pos, unsigned h) const
+   { return (pos - (int) (h & mask)) & mask; }
+
+   /** @brief Return the slot of the item with key (p1,p2) and hash @a h, or -1
+       if it is not in the table, in which case @a pos is set to the slot where
+       the item should be inserted, see InsertAt().
+
+       @warning This method should only be called if T inherits from Hashed2. */
+   int SearchSlot(unsigned h, int p1, int p2, int &pos) const;
+
+   /** @brief Return the slot of the item with key (p1,p2,p3) and hash @a h, or
+       -1 if it is not in the table, in which case @a pos is set to the slot
+       where the item should be inserted, see InsertAt().
+
+       @warning This method should only be called if T inherits from Hashed4. */
+   int SearchSlot(unsigned h, int p1, int p2, int p3, int &pos) const;
+
+   /// @brief Return the slot of the item @a id, which must be in the table.
+   int SlotOf(int id) const;
+
+   /** @brief Return an unused id, or append a new item to the BlockArray. */
+   inline int NewId();
+
+   /** @brief Return the slot where an item with hash @a h should be inserted:
+       after the items of its run with the same or an earlier home slot. */
+   int InsertPos(unsigned h) const;
+
+   /** @brief Insert the item @a id with hash @a h at the slot @a pos, shifting
+       the rest of the run forward by one slot.
+
+       @warning The method does not check the overall fill factor of the hash
+                table. If appropriate, use CheckRehash() for that. */
+   void InsertAt(int pos, int id, unsigned h);
+
+   /// @brief Insert the item @a id with hash @a h into the table.
+   void Insert(int id, unsigned h) { InsertAt(InsertPos(h), id, h); }
+
+   /** @brief Remove the slot @a pos from the table, shifting the following
+       slots of the same run back by one. */
+   void RemoveSlot(int pos);
+
+   /** @brief Check the fill factor of the table and resize it if necessary.
+
+       The table is doubled when more than 7/8 of its slots are occupied, so
+       that the probes stay short and always end at an empty slot. */
+   inline void CheckRehash();
+
+   /** @brief Double the size of the table and reinsert all the slots. The
+       stored hashes are reused, the items are not accessed. The slots are
+       reinserted in the order of their home slots, so each of them ends up
+       at the end of its run. */
+   void DoRehash();
+};
+
+
 /// Hash function for data sequences.
 /** Depends on GnuTLS for SHA-256 hashing. */
 class HashFunction
@@ -929,6 +1198,404 @@ void HashTable<T>::PrintStats() const
    }
 }
 
+template<typename T>
+OpenHashTable<T>::OpenHashTable(int block_size, int init_hash_size)
+   : Base(block_size)
+{
+   mask = init_hash_size-1;
+   MFEM_VERIFY(!(init_hash_size & mask), "init_size must be a power of two.");
+
+   table = new Slot[init_hash_size];
+   for (int i = 0; i < init_hash_size; i++)
+   {
+      table[i].id = -1;
+   }
+   count = 0;
+}
+
+template<typename T>
+OpenHashTable<T>::OpenHashTable(const OpenHashTable& other)
+   : Base(other), mask(other.mask), count(other.count)
+{
+   int size = mask+1;
+   table = new Slot[size];
+   memcpy(table, other.table, size*sizeof(Slot));
+   other.unused.Copy(unused);
+}
+
+template<typename T>
+OpenHashTable<T>::~OpenHashTable()
+{
+   delete [] table;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Get(int p1, int p2)
+{
+   return &(Base::At(GetId(p1, p2)));
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Get(int p1, int p2, int p3, int p4)
+{
+   return &(Base::At(GetId(p1, p2, p3, p4)));
+}
+
+template<typename T>
+inline int OpenHashTable<T>::NewId()
+{
+   if (unused.Size())
+   {
+      int new_id = unused.Last();
+      unused.DeleteLast();
+      return new_id;
+   }
+   return Base::Append();
+}
+
+template<typename T>
+int OpenHashTable<T>::GetId(int p1, int p2)
+{
+   // search for the item in the table
+   if (p1 > p2) { std::swap(p1, p2); }
+   const unsigned h = Hash(p1, p2);
+   int pos, slot = SearchSlot(h, p1, p2, pos);
+   if (slot >= 0) { return table[slot].id; }
+
+   // not found - use an unused item or create a new one
+   int new_id = NewId();
+   T& item = Base::At(new_id);
+   item.p1 = p1;
+   item.p2 = p2;
+   item.next = -1;
+
+   // insert into the table, where the search stopped
+   InsertAt(pos, new_id, h);
+   CheckRehash();
+
+   return new_id;
+}
+
+template<typename T>
+int OpenHashTable<T>::GetId(int p1, int p2, int p3, int p4)
+{
+   // search for the item in the table
+   internal::sort4_ext(p1, p2, p3, p4);
+   const unsigned h = Hash(p1, p2, p3);
+   int pos, slot = SearchSlot(h, p1, p2, p3, pos);
+   if (slot >= 0) { return table[slot].id; }
+
+   // not found - use an unused item or create a new one
+   int new_id = NewId();
+   T& item = Base::At(new_id);
+   item.p1 = p1;
+   item.p2 = p2;
+   item.p3 = p3;
+   item.next = -1;
+
+   // insert into the table, where the search stopped
+   InsertAt(pos, new_id, h);
+   CheckRehash();
+
+   return new_id;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Find(int p1, int p2)
+{
+   int id = FindId(p1, p2);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline T* OpenHashTable<T>::Find(int p1, int p2, int p3, int p4)
+{
+   int id = FindId(p1, p2, p3, p4);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline const T* OpenHashTable<T>::Find(int p1, int p2) const
+{
+   int id = FindId(p1, p2);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+inline const T* OpenHashTable<T>::Find(int p1, int p2, int p3, int p4) const
+{
+   int id = FindId(p1, p2, p3, p4);
+   return (id >= 0) ? &(Base::At(id)) : NULL;
+}
+
+template<typename T>
+int OpenHashTable<T>::FindId(int p1, int p2) const
+{
+   if (p1 > p2) { std::swap(p1, p2); }
+   int pos, slot = SearchSlot(Hash(p1, p2), p1, p2, pos);
+   return (slot >= 0) ? table[slot].id : -1;
+}
+
+template<typename T>
+int OpenHashTable<T>::FindId(int p1, int p2, int p3, int p4) const
+{
+   internal::sort4_ext(p1, p2, p3, p4);
+   int pos, slot = SearchSlot(Hash(p1, p2, p3), p1, p2, p3, pos);
+   return (slot >= 0) ? table[slot].id : -1;
+}
+
+template<typename T>
+int OpenHashTable<T>::SearchSlot(unsigned h, int p1, int p2, int &pos) const
+{
+   // the slots of a run are sorted by their home slot, so the search stops at
+   // the first slot whose home is after the home of the key
+   pos = h & mask;
+   for (int dist = 0; ; dist++, pos = (pos + 1) & mask)
+   {
+      const Slot &slot = table[pos];
+      if (slot.id < 0 || Distance(pos, slot.hash) < dist) { return -1; }
+      if (slot.hash == h)
+      {
+         const T& item = Base::At(slot.id);
+         if (item.p1 == p1 && item.p2 == p2) { return pos; }
+      }
+   }
+}
+
+template<typename T>
+int OpenHashTable<T>::SearchSlot(unsigned h, int p1, int p2, int p3,
+                                 int &pos) const
+{
+   pos = h & mask;
+   for (int dist = 0; ; dist++, pos = (pos + 1) & mask)
+   {
+      const Slot &slot = table[pos];
+      if (slot.id < 0 || Distance(pos, slot.hash) < dist) { return -1; }
+      if (slot.hash == h)
+      {
+         const T& item = Base::At(slot.id);
+         if (item.p1 == p1 && item.p2 == p2 && item.p3 == p3) { return pos; }
+      }
+   }
+}
+
+template<typename T>
+int OpenHashTable<T>::SlotOf(int id) const
+{
+   int pos = Hash(Base::At(id)) & mask;
+   while (table[pos].id >= 0)
+   {
+      if (table[pos].id == id) { return pos; }
+      pos = (pos + 1) & mask;
+   }
+   MFEM_ABORT("OpenHashTable<>::SlotOf: item not found!");
+   return -1;
+}
+
+template<typename T>
+int OpenHashTable<T>::InsertPos(unsigned h) const
+{
+   int pos = h & mask;
+   for (int dist = 0; table[pos].id >= 0; dist++, pos = (pos + 1) & mask)
+   {
+      if (Distance(pos, table[pos].hash) < dist) { break; }
+   }
+   return pos;
+}
+
+template<typename T>
+void OpenHashTable<T>::InsertAt(int pos, int id, unsigned h)
+{
+   // shift the rest of the run forward, up to the first empty slot
+   Slot slot = { id, h };
+   while (table[pos].id >= 0)
+   {
+      std::swap(slot, table[pos]);
+      pos = (pos + 1) & mask;
+   }
+   table[pos] = slot;
+   count++;
+}
+
+template<typename T>
+void OpenHashTable<T>::RemoveSlot(int pos)
+{
+   // shift the following items of the run back, until an empty slot or an
+   // item in its home slot
+   int next = (pos + 1) & mask;
+   while (table[next].id >= 0 && Distance(next, table[next].hash) > 0)
+   {
+      table[pos] = table[next];
+      pos = next;
+      next = (next + 1) & mask;
+   }
+   table[pos].id = -1;
+   count--;
+}
+
+template<typename T>
+inline void OpenHashTable<T>::CheckRehash()
+{
+   // is the table overfull?
+   if (8l*count > 7l*(mask+1))
+   {
+      DoRehash();
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::DoRehash()
+{
+   Slot* old_table = table;
+   int old_table_size = mask+1;
+
+   // double the table size
+   int new_table_size = 2*old_table_size;
+   table = new Slot[new_table_size];
+   for (int i = 0; i < new_table_size; i++) { table[i].id = -1; }
+   mask = new_table_size-1;
+   count = 0;
+
+#if defined(MFEM_DEBUG) && !defined(MFEM_USE_MPI)
+   mfem::out << _MFEM_FUNC_NAME << ": rehashing to size " << new_table_size
+             << std::endl;
+#endif
+
+   // reinsert all slots, with their stored hashes, starting after an empty
+   // slot so that the runs are not split
+   int start = 0;
+   while (old_table[start].id >= 0) { start++; }
+   for (int i = 1; i <= old_table_size; i++)
+   {
+      const Slot &slot = old_table[(start + i) & (old_table_size-1)];
+      if (slot.id >= 0) { Insert(slot.id, slot.hash); }
+   }
+   delete [] old_table;
+}
+
+template<typename T>
+void OpenHashTable<T>::Delete(int id)
+{
+   T& item = Base::At(id);
+   RemoveSlot(SlotOf(id));
+   item.next = -2;    // mark item as unused
+   unused.Append(id); // add its id to the unused ids
+}
+
+template<typename T>
+void OpenHashTable<T>::DeleteAll()
+{
+   Base::DeleteAll();
+   for (int i = 0; i <= mask; i++) { table[i].id = -1; }
+   count = 0;
+   unused.DeleteAll();
+}
+
+template<typename T>
+void OpenHashTable<T>::Alloc(int id, int p1, int p2)
+{
+   // enlarge the BlockArray to hold 'id'
+   while (id >= Base::Size())
+   {
+      Base::At(Base::Append()).next = -2; // append "unused" items
+   }
+
+   T& item = Base::At(id);
+   if (item.next == -2)
+   {
+      item.next = -1;
+      item.p1 = p1;
+      item.p2 = p2;
+
+      Insert(id, Hash(p1, p2));
+      CheckRehash();
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::UpdateUnused()
+{
+   unused.DeleteAll();
+   for (int i = 0; i < Base::Size(); i++)
+   {
+      if (Base::At(i).next == -2) { unused.Append(i); }
+   }
+}
+
+template<typename T>
+void OpenHashTable<T>::Reparent(int id, int new_p1, int new_p2)
+{
+   T& item = Base::At(id);
+   RemoveSlot(SlotOf(id));
+
+   if (new_p1 > new_p2) { std::swap(new_p1, new_p2); }
+   item.p1 = new_p1;
+   item.p2 = new_p2;
+
+   // reinsert under new parent IDs
+   Insert(id, Hash(new_p1, new_p2));
+}
+
+template<typename T>
+void OpenHashTable<T>::Reparent(int id,
+                                int new_p1, int new_p2, int new_p3, int new_p4)
+{
+   T& item = Base::At(id);
+   RemoveSlot(SlotOf(id));
+
+   internal::sort4_ext(new_p1, new_p2, new_p3, new_p4);
+   item.p1 = new_p1;
+   item.p2 = new_p2;
+   item.p3 = new_p3;
+
+   // reinsert under new parent IDs
+   Insert(id, Hash(new_p1, new_p2, new_p3));
+}
+
+template<typename T>
+long OpenHashTable<T>::MemoryUsage() const
+{
+   return (mask+1) * sizeof(Slot) + Base::MemoryUsage() +
+          unused.MemoryUsage();
+}
+
+template<typename T>
+void OpenHashTable<T>::PrintMemoryDetail() const
+{
+   mfem::out << Base::MemoryUsage() << " + " << (mask+1) * sizeof(Slot)
+             << " + " << unused.MemoryUsage();
+}
+
+template<typename T>
+void OpenHashTable<T>::PrintStats() const
+{
+   int table_size = mask+1;
+   mfem::out << "Hash table size: " << table_size << "\n";
+   mfem::out << "Item count: " << Size() << "\n";
+   mfem::out << "BlockArray size: " << Base::Size() << "\n";
+
+   const int H = 16;
+   int hist[H];
+
+   for (int i = 0; i < H; i++) { hist[i] = 0; }
+
+   for (int i = 0; i < table_size; i++)
+   {
+      if (table[i].id < 0) { continue; }
+      int dist = Distance(i, table[i].hash);
+      if (dist >= H) { dist = H-1; }
+      hist[dist]++;
+   }
+
+   mfem::out << "Probe length histogram:\n";
+   for (int i = 0; i < H; i++)
+   {
+      mfem::out << "  distance " << i << ": "
+                << hist[i] << " items" << std::endl;
+   }
+}
+
+
 
 template <typename int_type_const_iter>
 HashFunction &HashFunction::EncodeAndHashInts(int_type_const_iter begin,
@@ -13,9 +13,14 @@
 #include "mem_manager.hpp"
 
 #include <list>
+#include <map>
 #include <cstring> // std::memcpy, std::memcmp
+#include <cstdint>
 #include <unordered_map>
-#include <algorithm> // std::max
+#include <vector>
+#include <string>
+#include <algorithm> // std::max, std::sort
+#include <iomanip>
 
 // Uncomment to try _WIN32 platform
 //#define _WIN32
@@ -75,10 +80,12 @@ bool MemoryClassContainsType(MemoryClass mc, MemoryType mt)
       case MemoryClass::HOST_32:
          return (mt == MemoryType::HOST_32 ||
                  mt == MemoryType::HOST_64 ||
-                 mt == MemoryType::HOST_DEBUG);
+                 mt == MemoryType::HOST_DEBUG ||
+                 mt == MemoryType::HOST_POOL);
       case MemoryClass::HOST_64:
          return (mt == MemoryType::HOST_64 ||
-                 mt == MemoryType::HOST_DEBUG);
+                 mt == MemoryType::HOST_DEBUG ||
+                 mt == MemoryType::HOST_POOL);
       case MemoryClass::DEVICE: return IsDeviceMemory(mt);
       case MemoryClass::MANAGED:
          return (mt == MemoryType::MANAGED);
@@ -258,6 +265,187 @@ public:
    void Dealloc(void *ptr) { mfem_aligned_free(ptr); }
 };
 
+/// The pool host memory space: 64-byte aligned blocks recycled through
+/// size-class free lists.
+/** Each power of two is split into four size classes, so that at most 25% of a
+    block is lost to the rounding (blocks of up to 256 bytes use multiples of 64
+    bytes). The blocks of a class are carved from slabs of about 64 KB, or of
+    one block for the larger classes. The slabs are indexed by their address,
+    which gives the size class of a pointer and tells the pool's own pointers
+    from the ones it did not allocate, see Owns(). The free blocks of a class
+    form an intrusive list: each one stores the next free block and its slab,
+    so Alloc() and Dealloc() do not allocate any bookkeeping memory. Freed
+    blocks are returned to the system only by Release(), for the slabs without
+    blocks in use, or at destruction. Like the rest of the MemoryManager, this
+    class is not thread-safe. */
+class PoolHostMemorySpace : public HostMemorySpace
+{
+   static constexpr int num_classes = 4 + 4*(8*sizeof(size_t) - 8);
+   static constexpr size_t slab_bytes = 64*1024;
+
+   struct Slab
+   {
+      char *begin;
+      int k, blocks, carved, in_use;
+   };
+
+   /// Header of a free block, stored in the block itself.
+   struct FreeBlock
+   {
+      FreeBlock *next;
+      Slab *slab;
+   };
+
+   std::map<uintptr_t, Slab> slabs; // slab address -> slab
+   FreeBlock *free_list[num_classes];
+   Slab *carve[num_classes]; // last slab of each class, with uncarved blocks
+   MemoryManager::HostPoolStats stats;
+
+   static int SizeClass(size_t bytes)
+   {
+      if (bytes <= 256) { return bytes ? (int)((bytes - 1) / 64) : 0; }
+      int e = 8; // 2^e < bytes <= 2^(e+1)
+      while (((bytes - 1) >> (e + 1)) != 0) { e++; }
+      const size_t step = size_t(1) << (e - 2);
+      const size_t m = (bytes - (size_t(1) << e) + step - 1) / step;
+      return 4 + 4*(e - 8) + (int)(m - 1);
+   }
+
+   static size_t ClassBytes(int k)
+   {
+      if (k < 4) { return 64*(k + 1); }
+      const int e = 8 + (k - 4)/4;
+      return (size_t(1) << e) + ((k - 4)%4 + 1)*(size_t(1) << (e - 2));
+   }
+
+   /// Return the slab containing the block @a ptr, or NULL.
+   Slab *FindSlab(const void *ptr)
+   {
+      const uintptr_t addr = reinterpret_cast<uintptr_t>(ptr);
+      auto it = slabs.upper_bound(addr);
+      if (it == slabs.begin()) { return nullptr; }
+      Slab &slab = (--it)->second;
+      const size_t k_bytes = ClassBytes(slab.k);
+      const uintptr_t offset = addr - it->first;
+      if (offset >= slab.blocks*k_bytes || offset % k_bytes != 0)
+      {
+         return nullptr;
+      }
+      return &slab;
+   }
+
+   void NewSlab(int k)
+   {
+      const size_t k_bytes = ClassBytes(k);
+      const int blocks = (int)std::max(size_t(1), slab_bytes / k_bytes);
+      void *mem;
+      if (mfem_memalign(&mem, 64, blocks*k_bytes) != 0)
+      {
+         throw ::std::bad_alloc();
+      }
+      Slab &slab = slabs[reinterpret_cast<uintptr_t>(mem)];
+      slab.begin = static_cast<char*>(mem);
+      slab.k = k;
+      slab.blocks = blocks;
+      slab.carved = slab.in_use = 0;
+      carve[k] = &slab;
+      stats.bytes_cached += blocks*k_bytes;
+   }
+
+public:
+   PoolHostMemorySpace(): HostMemorySpace(), stats()
+   {
+      for (int k = 0; k < num_classes; k++)
+      {
+         free_list[k] = nullptr;
+         carve[k] = nullptr;
+      }
+   }
+
+   ~PoolHostMemorySpace()
+   {
+      for (auto &it : slabs) { mfem_aligned_free(it.second.begin); }
+   }
+
+   void Alloc(void **ptr, size_t bytes)
+   {
+      const int k = SizeClass(bytes);
+      const size_t k_bytes = ClassBytes(k);
+      Slab *slab;
+      void *block;
+      stats.requests++;
+      if (free_list[k])
+      {
+         FreeBlock *head = free_list[k];
+         free_list[k] = head->next;
+         slab = head->slab;
+         block = head;
+         stats.hits++;
+      }
+      else
+      {
+         if (!carve[k] || carve[k]->carved == carve[k]->blocks) { NewSlab(k); }
+         slab = carve[k];
+         block = slab->begin + (slab->carved++)*k_bytes;
+      }
+      slab->in_use++;
+      stats.bytes_cached -= k_bytes;
+      stats.bytes_in_use += k_bytes;
+      stats.peak_bytes = std::max(stats.peak_bytes, stats.bytes_in_use);
+      *ptr = block;
+   }
+
+   void Dealloc(void *ptr)
+   {
+      Slab *slab = FindSlab(ptr);
+      MFEM_VERIFY(slab, "the pointer " << ptr
+                  << " was not allocated by the host pool");
+      const int k = slab->k;
+      const size_t k_bytes = ClassBytes(k);
+      FreeBlock *block = static_cast<FreeBlock*>(ptr);
+      block->next = free_list[k];
+      block->slab = slab;
+      free_list[k] = block;
+      slab->in_use--;
+      stats.bytes_in_use -= k_bytes;
+      stats.bytes_cached += k_bytes;
+   }
+
+   /// Return true if @a ptr is a block allocated by the pool.
+   bool Owns(const void *ptr) { return FindSlab(ptr) != nullptr; }
+
+   void Release()
+   {
+      // Unlink the free blocks of the slabs without blocks in use
+      for (int k = 0; k < num_classes; k++)
+      {
+         FreeBlock **link = &free_list[k];
+         while (*link)
+         {
+            if ((*link)->slab->in_use == 0) { *link = (*link)->next; }
+            else { link = &(*link)->next; }
+         }
+      }
+      for (auto it = slabs.begin(); it != slabs.end(); )
+      {
+         Slab &slab = it->second;
+         if (slab.in_use != 0) { ++it; continue; }
+         if (carve[slab.k] == &slab) { carve[slab.k] = nullptr; }
+         stats.bytes_cached -= slab.blocks*ClassBytes(slab.k);
+         mfem_aligned_free(slab.begin);
+         it = slabs.erase(it);
+      }
+   }
+
+   void ResetStats()
+   {
+      stats.requests = stats.hits = 0;
+      stats.peak_bytes = stats.bytes_in_use;
+   }
+
+   const MemoryManager::HostPoolStats &GetStats() const { return stats; }
+};
+
 #ifndef _WIN32
 static uintptr_t pagesize = 0;
 static uintptr_t pagemask = 0;
@@ -704,6 +892,7 @@ private:
          case MT::HOST_UMPIRE: return new NoHostMemorySpace();
 #endif
          case MT::HOST_PINNED: return new HostPinnedMemorySpace();
+         case MT::HOST_POOL: return new PoolHostMemorySpace();
          default: MFEM_ABORT("Unknown host memory controller!");
       }
       return nullptr;
@@ -744,8 +933,136 @@ private:
 
 } // namespace mfem::internal
 
+
+namespace internal
+{
+
+/// Allocation statistics recorded by the MemoryManager in tracing mode, see
+/// MemoryManager::EnableTracing().
+class MemoryTrace
+{
+public:
+   /// Current and peak number of bytes and allocations of some category.
+   struct Usage
+   {
+      size_t bytes = 0, peak = 0, live = 0, count = 0;
+      void Add(size_t b)
+      { bytes += b; peak = std::max(peak, bytes); live++; count++; }
+      void Remove(size_t b) { bytes -= b; live--; }
+   };
+
+   Usage types[MemoryTypeSize];
+   Usage total;
+   std::vector<std::string> scope_names;
+   std::vector<Usage> scopes;
+   size_t htod_count = 0, htod_bytes = 0, dtoh_count = 0, dtoh_bytes = 0;
+
+private:
+   struct Record { size_t bytes; MemoryType mt; int scope; };
+   std::unordered_map<const void*, Record> live;
+   std::unordered_map<std::string, int> scope_ids;
+   std::vector<int> stack;
+
+   int ScopeId(const std::string &name)
+   {
+      auto it = scope_ids.find(name);
+      if (it != scope_ids.end()) { return it->second; }
+      const int id = (int)scope_names.size();
+      scope_ids.emplace(name, id);
+      scope_names.push_back(name);
+      scopes.emplace_back();
+      return id;
+   }
+
+public:
+   MemoryTrace() { ScopeId("untagged"); }
+
+   void Push(const char *name)
+   {
+      if (stack.empty()) { stack.push_back(ScopeId(name)); return; }
+      stack.push_back(ScopeId(scope_names[stack.back()] + '/' + name));
+   }
+
+   void Pop() { if (!stack.empty()) { stack.pop_back(); } }
+
+   void New(const void *ptr, size_t bytes, MemoryType mt)
+   {
+      if (!ptr) { return; }
+      const int scope = stack.empty() ? 0 : stack.back();
+      if (!live.emplace(ptr, Record{bytes, mt, scope}).second) { return; }
+      types[(int)mt].Add(bytes);
+      total.Add(bytes);
+      scopes[scope].Add(bytes);
+   }
+
+   void Delete(const void *ptr)
+   {
+      // Pointers allocated before enabling the tracing are not known
+      auto it = live.find(ptr);
+      if (it == live.end()) { return; }
+      const Record &r = it->second;
+      types[(int)r.mt].Remove(r.bytes);
+      total.Remove(r.bytes);
+      scopes[r.scope].Remove(r.bytes);
+      live.erase(it);
+   }
+};
+
+} // namespace mfem::internal
+
+static internal::MemoryTrace *trace;
+
 static internal::Ctrl *ctrl;
 
+static void HostAlloc(void **ptr, size_t bytes, MemoryType h_mt)
+{
+   ctrl->Host(h_mt)->Alloc(ptr, bytes);
+   if (MemoryManager::IsTracing()) { trace->New(*ptr, bytes, h_mt); }
+}
+
+static internal::PoolHostMemorySpace *HostPool();
+
+static void HostDealloc(void *ptr, MemoryType h_mt)
+{
+   if (MemoryManager::IsTracing()) { trace->Delete(ptr); }
+   ctrl->Host(h_mt)->Dealloc(ptr);
+}
+
+static void DeviceAlloc(internal::Memory &mem)
+{
+   ctrl->Device(mem.d_mt)->Alloc(mem);
+   if (MemoryManager::IsTracing())
+   {
+      trace->New(mem.d_ptr, mem.bytes, mem.d_mt);
+   }
+}
+
+static void DeviceDealloc(internal::Memory &mem)
+{
+   if (MemoryManager::IsTracing()) { trace->Delete(mem.d_ptr); }
+   ctrl->Device(mem.d_mt)->Dealloc(mem);
+}
+
+static void *HtoD(MemoryType d_mt, void *dst, const void *src, size_t bytes)
+{
+   if (MemoryManager::IsTracing())
+   {
+      trace->htod_count++;
+      trace->htod_bytes += bytes;
+   }
+   return ctrl->Device(d_mt)->HtoD(dst, src, bytes);
+}
+
+static void *DtoH(MemoryType d_mt, void *dst, const void *src, size_t bytes)
+{
+   if (MemoryManager::IsTracing())
+   {
+      trace->dtoh_count++;
+      trace->dtoh_bytes += bytes;
+   }
+   return ctrl->Device(d_mt)->DtoH(dst, src, bytes);
+}
+
 void *MemoryManager::New_(void *h_tmp, size_t bytes, MemoryType mt,
                           unsigned &flags)
 {
@@ -783,7 +1100,7 @@ void *MemoryManager::New_(void *h_tmp, size_t bytes, MemoryType h_mt,
    MFEM_ASSERT((valid_flags & ~(Mem::VALID_HOST | Mem::VALID_DEVICE)) == 0,
                "Internal error");
    void *h_ptr;
-   if (h_tmp == nullptr) { ctrl->Host(h_mt)->Alloc(&h_ptr, bytes); }
+   if (h_tmp == nullptr) { HostAlloc(&h_ptr, bytes, h_mt); }
    else { h_ptr = h_tmp; }
    flags = Mem::REGISTERED | Mem::OWNS_INTERNAL | Mem::OWNS_HOST |
            Mem::OWNS_DEVICE | valid_flags;
@@ -833,7 +1150,7 @@ void *MemoryManager::Register_(void *ptr, void *h_tmp, size_t bytes,
    {
       MFEM_VERIFY(ptr || bytes == 0,
                   "cannot register NULL device pointer with bytes = " << bytes);
-      if (h_tmp == nullptr) { ctrl->Host(h_mt)->Alloc(&h_ptr, bytes); }
+      if (h_tmp == nullptr) { HostAlloc(&h_ptr, bytes, h_mt); }
       else { h_ptr = h_tmp; }
       mm.InsertDevice(ptr, h_ptr, bytes, h_mt, d_mt);
       flags = own ? flags | Mem::OWNS_DEVICE : flags & ~Mem::OWNS_DEVICE;
@@ -925,6 +1242,7 @@ MemoryType MemoryManager::Delete_(void *h_ptr, MemoryType h_mt, unsigned flags)
                (!(owns_device || owns_internal) && h_ptr == nullptr),
                "invalid Memory state");
    if (!mm.exists || !registered) { return h_mt; }
+   MemoryType delete_mt = h_mt;
    if (alias)
    {
       if (owns_internal)
@@ -937,7 +1255,16 @@ MemoryType MemoryManager::Delete_(void *h_ptr, MemoryType h_mt, unsigned flags)
    else // Known
    {
       if (owns_host && (h_mt != MemoryType::HOST))
-      { ctrl->Host(h_mt)->Dealloc(h_ptr); }
+      {
+         // Pointers wrapped with Memory<T>::Wrap(ptr, size, true) while
+         // HOST_POOL is the default host type were not allocated by the pool:
+         // let Memory<T>::Delete() delete them as MemoryType::HOST
+         if (h_mt == MemoryType::HOST_POOL && !HostPool()->Owns(h_ptr))
+         {
+            delete_mt = MemoryType::HOST;
+         }
+         else { HostDealloc(h_ptr, h_mt); }
+      }
       if (owns_internal)
       {
          MFEM_ASSERT(mm.IsKnown(h_ptr), "");
@@ -945,7 +1272,7 @@ MemoryType MemoryManager::Delete_(void *h_ptr, MemoryType h_mt, unsigned flags)
          mm.Erase(h_ptr, owns_device);
       }
    }
-   return h_mt;
+   return delete_mt;
 }
 
 void MemoryManager::DeleteDevice_(void *h_ptr, unsigned & flags)
@@ -1185,7 +1512,7 @@ void MemoryManager::Copy_(void *dst_h_ptr, const void *src_h_ptr,
          {
             internal::Memory &src_d_base = maps->memories.at(src_h_ptr);
             MemoryType src_d_mt = src_d_base.d_mt;
-            ctrl->Device(src_d_mt)->DtoH(dst_h_ptr, src_d_ptr, bytes);
+            DtoH(src_d_mt, dst_h_ptr, src_d_ptr, bytes);
          }
       }
    }
@@ -1202,7 +1529,7 @@ void MemoryManager::Copy_(void *dst_h_ptr, const void *src_h_ptr,
          const MemoryType d_mt = known ?
                                  maps->memories.at(dst_h_ptr).d_mt :
                                  maps->aliases.at(dst_h_ptr).mem->d_mt;
-         ctrl->Device(d_mt)->HtoD(dest_d_ptr, src_h_ptr, bytes);
+         HtoD(d_mt, dest_d_ptr, src_h_ptr, bytes);
       }
       else
       {
@@ -1242,7 +1569,7 @@ void MemoryManager::CopyToHost_(void *dest_h_ptr, const void *src_h_ptr,
                               mm.GetDevicePtr(src_h_ptr, bytes, false);
       const internal::Memory &base = maps->memories.at(dest_h_ptr);
       const MemoryType d_mt = base.d_mt;
-      ctrl->Device(d_mt)->DtoH(dest_h_ptr, src_d_ptr, bytes);
+      DtoH(d_mt, dest_h_ptr, src_d_ptr, bytes);
    }
 }
 
@@ -1267,7 +1594,7 @@ void MemoryManager::CopyFromHost_(void *dest_h_ptr, const void *src_h_ptr,
                          mm.GetDevicePtr(dest_h_ptr, bytes, false);
       const internal::Memory &base = maps->memories.at(dest_h_ptr);
       const MemoryType d_mt = base.d_mt;
-      ctrl->Device(d_mt)->HtoD(dest_d_ptr, src_h_ptr, bytes);
+      HtoD(d_mt, dest_d_ptr, src_h_ptr, bytes);
    }
    dest_flags = dest_flags &
                 ~(dest_on_host ? Mem::VALID_DEVICE : Mem::VALID_HOST);
@@ -1323,7 +1650,7 @@ void MemoryManager::InsertDevice(void *d_ptr, void *h_ptr, size_t bytes,
    MFEM_ASSERT(h_ptr != NULL, "internal error");
    Insert(h_ptr, bytes, h_mt, d_mt);
    internal::Memory &mem = maps->memories.at(h_ptr);
-   if (d_ptr == NULL && bytes != 0) { ctrl->Device(d_mt)->Alloc(mem); }
+   if (d_ptr == NULL && bytes != 0) { DeviceAlloc(mem); }
    else { mem.d_ptr = d_ptr; }
 }
 
@@ -1380,7 +1707,7 @@ void MemoryManager::Erase(void *h_ptr, bool free_dev_ptr)
    auto mem_map_iter = maps->memories.find(h_ptr);
    if (mem_map_iter == maps->memories.end()) { mfem_error("Unknown pointer!"); }
    internal::Memory &mem = mem_map_iter->second;
-   if (mem.d_ptr && free_dev_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem);}
+   if (mem.d_ptr && free_dev_ptr) { DeviceDealloc(mem); }
    maps->memories.erase(mem_map_iter);
 }
 
@@ -1390,7 +1717,7 @@ void MemoryManager::EraseDevice(void *h_ptr)
    auto mem_map_iter = maps->memories.find(h_ptr);
    if (mem_map_iter == maps->memories.end()) { mfem_error("Unknown pointer!"); }
    internal::Memory &mem = mem_map_iter->second;
-   if (mem.d_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem);}
+   if (mem.d_ptr) { DeviceDealloc(mem); }
    mem.d_ptr = nullptr;
 }
 
@@ -1423,14 +1750,14 @@ void *MemoryManager::GetDevicePtr(const void *h_ptr, size_t bytes,
    if (!mem.d_ptr)
    {
       if (d_mt == MemoryType::DEFAULT) { d_mt = GetDualMemoryType(h_mt); }
-      if (mem.bytes) { ctrl->Device(d_mt)->Alloc(mem); }
+      if (mem.bytes) { DeviceAlloc(mem); }
    }
    // Aliases might have done some protections
    if (mem.d_ptr) { ctrl->Device(d_mt)->Unprotect(mem); }
    if (copy_data)
    {
       MFEM_ASSERT(bytes <= mem.bytes, "invalid copy size");
-      if (bytes) { ctrl->Device(d_mt)->HtoD(mem.d_ptr, h_ptr, bytes); }
+      if (bytes) { HtoD(d_mt, mem.d_ptr, h_ptr, bytes); }
    }
    ctrl->Host(h_mt)->Protect(mem, bytes);
    return mem.d_ptr;
@@ -1456,7 +1783,7 @@ void *MemoryManager::GetAliasDevicePtr(const void *alias_ptr, size_t bytes,
    if (!mem.d_ptr)
    {
       if (d_mt == MemoryType::DEFAULT) { d_mt = GetDualMemoryType(h_mt); }
-      if (mem.bytes) { ctrl->Device(d_mt)->Alloc(mem); }
+      if (mem.bytes) { DeviceAlloc(mem); }
    }
    void *alias_h_ptr = static_cast<char*>(mem.h_ptr) + offset;
    void *alias_d_ptr = static_cast<char*>(mem.d_ptr) + offset;
@@ -1466,7 +1793,7 @@ void *MemoryManager::GetAliasDevicePtr(const void *alias_ptr, size_t bytes,
    if (mem.d_ptr) { ctrl->Device(d_mt)->AliasUnprotect(alias_d_ptr, bytes); }
    ctrl->Host(h_mt)->AliasUnprotect(alias_ptr, bytes);
    if (copy && mem.d_ptr)
-   { ctrl->Device(d_mt)->HtoD(alias_d_ptr, alias_h_ptr, bytes); }
+   { HtoD(d_mt, alias_d_ptr, alias_h_ptr, bytes); }
    ctrl->Host(h_mt)->AliasProtect(alias_ptr, bytes);
    return alias_d_ptr;
 }
@@ -1482,7 +1809,7 @@ void *MemoryManager::GetHostPtr(const void *ptr, size_t bytes, bool copy)
    // Aliases might have done some protections
    ctrl->Host(h_mt)->Unprotect(mem, bytes);
    if (mem.d_ptr) { ctrl->Device(d_mt)->Unprotect(mem); }
-   if (copy && mem.d_ptr) { ctrl->Device(d_mt)->DtoH(mem.h_ptr, mem.d_ptr, bytes); }
+   if (copy && mem.d_ptr) { DtoH(d_mt, mem.h_ptr, mem.d_ptr, bytes); }
    if (mem.d_ptr) { ctrl->Device(d_mt)->Protect(mem); }
    return mem.h_ptr;
 }
@@ -1502,7 +1829,7 @@ void *MemoryManager::GetAliasHostPtr(const void *ptr, size_t bytes,
    ctrl->Host(h_mt)->AliasUnprotect(alias_h_ptr, bytes);
    if (mem->d_ptr) { ctrl->Device(d_mt)->AliasUnprotect(alias_d_ptr, bytes); }
    if (copy_data && mem->d_ptr)
-   { ctrl->Device(d_mt)->DtoH(const_cast<void*>(ptr), alias_d_ptr, bytes); }
+   { DtoH(d_mt, const_cast<void*>(ptr), alias_d_ptr, bytes); }
    if (mem->d_ptr) { ctrl->Device(d_mt)->AliasProtect(alias_d_ptr, bytes); }
    return alias_h_ptr;
 }
@@ -1594,17 +1921,162 @@ void MemoryManager::Destroy()
    {
       internal::Memory &mem = n.second;
       bool mem_h_ptr = mem.h_mt != MemoryType::HOST && mem.h_ptr;
+      // (pointers wrapped into the host pool are left to their owner)
+      if (mem.h_mt == MemoryType::HOST_POOL && !HostPool()->Owns(mem.h_ptr))
+      {
+         mem_h_ptr = false;
+      }
       if (mem_h_ptr) { ctrl->Host(mem.h_mt)->Dealloc(mem.h_ptr); }
       if (mem.d_ptr) { ctrl->Device(mem.d_mt)->Dealloc(mem); }
    }
    delete maps; maps = nullptr;
    delete ctrl; ctrl = nullptr;
+   delete trace; trace = nullptr;
+   tracing = false;
    host_mem_type = MemoryType::HOST;
    device_mem_type = MemoryType::HOST;
    exists = false;
    configured = false;
 }
 
+static internal::PoolHostMemorySpace *HostPool()
+{
+   MFEM_VERIFY(ctrl, "the MemoryManager has been destroyed!");
+   return static_cast<internal::PoolHostMemorySpace*>(
+             ctrl->Host(MemoryType::HOST_POOL));
+}
+
+MemoryManager::HostPoolStats MemoryManager::GetHostPoolStats()
+{
+   return HostPool()->GetStats();
+}
+
+void MemoryManager::ReleaseHostPool() { HostPool()->Release(); }
+
+void MemoryManager::ResetHostPoolStats() { HostPool()->ResetStats(); }
+
+void MemoryManager::TraceNew_(const void *h_ptr, size_t bytes)
+{
+   trace->New(h_ptr, bytes, MemoryType::HOST);
+}
+
+void MemoryManager::TraceDelete_(const void *h_ptr) { trace->Delete(h_ptr); }
+
+void MemoryManager::EnableTracing(bool enable)
+{
+   if (enable && !trace) { trace = new internal::MemoryTrace; }
+   tracing = enable;
+}
+
+void MemoryManager::ResetTracing()
+{
+   if (!trace) { return; }
+   delete trace;
+   trace = new internal::MemoryTrace;
+}
+
+size_t MemoryManager::GetTracedBytes(MemoryType mt)
+{
+   return trace ? trace->types[(int)mt].bytes : 0;
+}
+
+size_t MemoryManager::GetTracedPeakBytes()
+{
+   return trace ? trace->total.peak : 0;
+}
+
+void MemoryManager::PushTraceScope(const char *name)
+{
+   if (trace) { trace->Push(name); }
+}
+
+void MemoryManager::PopTraceScope() { if (trace) { trace->Pop(); } }
+
+// Indices of the traced scopes, by decreasing current and peak bytes
+static std::vector<int> SortedTraceScopes()
+{
+   const std::vector<internal::MemoryTrace::Usage> &scopes = trace->scopes;
+   std::vector<int> order;
+   for (int i = 0; i < (int)scopes.size(); i++)
+   {
+      if (scopes[i].count) { order.push_back(i); }
+   }
+   std::sort(order.begin(), order.end(), [&](int i, int j)
+   {
+      if (scopes[i].bytes != scopes[j].bytes)
+      { return scopes[i].bytes > scopes[j].bytes; }
+      return scopes[i].peak > scopes[j].peak;
+   });
+   return order;
+}
+
+void MemoryManager::PrintTrace(std::ostream &os)
+{
+   if (!trace) { os << "Memory tracing is disabled.\n"; return; }
+   const internal::MemoryTrace &t = *trace;
+   auto line = [&](const char *name, const internal::MemoryTrace::Usage &u)
+   {
+      os << std::setw(24) << std::left << name << std::right
+         << std::setw(16) << u.bytes << std::setw(16) << u.peak
+         << std::setw(10) << u.live << std::setw(12) << u.count << '\n';
+   };
+   const std::ios::fmtflags old_flags = os.flags();
+   os << std::setw(24) << std::left << "Memory type" << std::right
+      << std::setw(16) << "bytes" << std::setw(16) << "peak bytes"
+      << std::setw(10) << "live" << std::setw(12) << "allocs" << '\n';
+   for (int mt = 0; mt < MemoryTypeSize; mt++)
+   {
+      if (t.types[mt].count) { line(MemoryTypeName[mt], t.types[mt]); }
+   }
+   line("total", t.total);
+   os << '\n' << std::setw(24) << std::left << "Scope" << std::right
+      << std::setw(16) << "bytes" << std::setw(16) << "peak bytes"
+      << std::setw(10) << "live" << std::setw(12) << "allocs" << '\n';
+   for (int i : SortedTraceScopes())
+   {
+      line(t.scope_names[i].c_str(), t.scopes[i]);
+   }
+   os << "\nHost to device copies: " << t.htod_count << " ("
+      << t.htod_bytes << " bytes)\n"
+      << "Device to host copies: " << t.dtoh_count << " ("
+      << t.dtoh_bytes << " bytes)" << std::endl;
+   os.flags(old_flags);
+}
+
+void MemoryManager::PrintTraceJSON(std::ostream &os)
+{
+   if (!trace) { os << "{}" << std::endl; return; }
+   const internal::MemoryTrace &t = *trace;
+   auto usage = [&](const internal::MemoryTrace::Usage &u)
+   {
+      os << "{\"bytes\": " << u.bytes << ", \"peak_bytes\": " << u.peak
+         << ", \"live\": " << u.live << ", \"allocs\": " << u.count << "}";
+   };
+   os << "{\n  \"memory_types\": {";
+   const char *sep = "\n";
+   for (int mt = 0; mt < MemoryTypeSize; mt++)
+   {
+      if (!t.types[mt].count) { continue; }
+      os << sep << "    \"" << MemoryTypeName[mt] << "\": ";
+      usage(t.types[mt]);
+      sep = ",\n";
+   }
+   os << "\n  },\n  \"total\": ";
+   usage(t.total);
+   os << ",\n  \"scopes\": {";
+   sep = "\n";
+   for (int i : SortedTraceScopes())
+   {
+      os << sep << "    \"" << t.scope_names[i] << "\": ";
+      usage(t.scopes[i]);
+      sep = ",\n";
+   }
+   os << "\n  },\n  \"transfers\": {\"htod_count\": " << t.htod_count
+      << ", \"htod_bytes\": " << t.htod_bytes
+      << ", \"dtoh_count\": " << t.dtoh_count
+      << ", \"dtoh_bytes\": " << t.dtoh_bytes << "}\n}" << std::endl;
+}
+
 void MemoryManager::RegisterCheck(void *ptr)
 {
    if (ptr != NULL)
@@ -1706,6 +2178,7 @@ MemoryManager mm;
 
 bool MemoryManager::exists = false;
 bool MemoryManager::configured = false;
+bool MemoryManager::tracing = false;
 
 MemoryType MemoryManager::host_mem_type = MemoryType::HOST;
 MemoryType MemoryManager::device_mem_type = MemoryType::HOST;
@@ -1718,6 +2191,7 @@ MemoryType MemoryManager::dual_map[MemoryTypeSize] =
    /* HOST_DEBUG      */  MemoryType::DEVICE_DEBUG,
    /* HOST_UMPIRE     */  MemoryType::DEVICE_UMPIRE,
    /* HOST_PINNED     */  MemoryType::DEVICE,
+   /* HOST_POOL       */  MemoryType::DEVICE,
    /* MANAGED         */  MemoryType::MANAGED,
    /* DEVICE          */  MemoryType::HOST,
    /* DEVICE_DEBUG    */  MemoryType::HOST_DEBUG,
@@ -1735,6 +2209,7 @@ const char * MemoryManager::d_umpire_2_name = "MFEM_DEVICE_2";
 const char *MemoryTypeName[MemoryTypeSize] =
 {
    "host-std", "host-32", "host-64", "host-debug", "host-umpire", "host-pinned",
+   "host-pool",
 #if defined(MFEM_USE_CUDA)
    "cuda-uvm",
    "cuda",
@@ -37,6 +37,9 @@ enum class MemoryType
    HOST_UMPIRE,    /**< Host memory; using an Umpire allocator which can be set
                         with MemoryManager::SetUmpireHostAllocatorName */
    HOST_PINNED,    ///< Host memory: pinned (page-locked)
+   HOST_POOL,      /**< Host memory; aligned at 64 bytes and recycled through
+                        size-class free lists, see
+                        MemoryManager::GetHostPoolStats */
    MANAGED,        /**< Managed memory; using CUDA or HIP *MallocManaged
                         and *Free */
    DEVICE,         ///< Device memory; using CUDA or HIP *Malloc and *Free
@@ -73,9 +76,10 @@ extern const char *MemoryTypeName[MemoryTypeSize];
 enum class MemoryClass
 {
    HOST,    /**< Memory types: { HOST, HOST_32, HOST_64, HOST_DEBUG,
-                                 HOST_UMPIRE, HOST_PINNED, MANAGED } */
-   HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG }
-   HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG }
+                                 HOST_UMPIRE, HOST_PINNED, HOST_POOL,
+                                 MANAGED } */
+   HOST_32, ///< Memory types: { HOST_32, HOST_64, HOST_DEBUG, HOST_POOL }
+   HOST_64, ///< Memory types: { HOST_64, HOST_DEBUG, HOST_POOL }
    DEVICE,  /**< Memory types: { DEVICE, DEVICE_DEBUG, DEVICE_UMPIRE,
                                  DEVICE_UMPIRE_2, MANAGED } */
    MANAGED  ///< Memory types: { MANAGED }
@@ -568,10 +572,7 @@ private:
 #endif
 
    // Shortcut for Alloc<new_align_bytes>::New(size)
-   static inline T *NewHOST(std::size_t size)
-   {
-      return Alloc<new_align_bytes>::New(size);
-   }
+   static inline T *NewHOST(std::size_t size);
 };
 
 
@@ -610,6 +611,9 @@ private:
    /// True if Configure() was called.
    static bool configured;
 
+   /// True if the allocations and transfers are being traced.
+   static bool tracing;
+
    /// Host and device allocator names for Umpire.
 #ifdef MFEM_USE_UMPIRE
    static const char * h_umpire_name;
@@ -648,6 +652,12 @@ private: // Static methods used by the Memory<T> class
    /// memory type of the host pointer.
    static MemoryType Delete_(void *h_ptr, MemoryType mt, unsigned flags);
 
+   /// Record a MemoryType::HOST allocation in tracing mode.
+   static void TraceNew_(const void *h_ptr, size_t bytes);
+
+   /// Record the release of a MemoryType::HOST allocation in tracing mode.
+   static void TraceDelete_(const void *h_ptr);
+
    /// Free device memory identified by its host pointer
    static void DeleteDevice_(void *h_ptr, unsigned & flags);
 
@@ -762,6 +772,7 @@ public:
        HOST_DEBUG      | DEVICE_DEBUG
        HOST_UMPIRE     | DEVICE_UMPIRE
        HOST_PINNED     | DEVICE
+       HOST_POOL       | DEVICE
        MANAGED         | MANAGED
        DEVICE          | HOST
        DEVICE_DEBUG    | HOST_DEBUG
@@ -828,11 +839,102 @@ public:
 
    static MemoryType GetHostMemoryType() { return host_mem_type; }
    static MemoryType GetDeviceMemoryType() { return device_mem_type; }
+
+   /// Statistics of the MemoryType::HOST_POOL allocator.
+   struct HostPoolStats
+   {
+      size_t requests;     ///< Number of allocations
+      size_t hits;         ///< Number of allocations reusing a cached block
+      size_t bytes_in_use; ///< Bytes in the blocks currently in use
+      size_t peak_bytes;   ///< Maximum value reached by bytes_in_use
+      size_t bytes_cached; ///< Bytes kept by the pool and not in use
+
+      /// Fraction of the allocations served from the free lists.
+      double HitRate() const
+      { return requests ? (double)hits / requests : 0.0; }
+   };
+
+   /// Return the statistics of the MemoryType::HOST_POOL allocator.
+   /** The requests are rounded up to one of four size classes per power of
+       two, so the byte counts include this rounding. */
+   static HostPoolStats GetHostPoolStats();
+
+   /// Return the free blocks of the MemoryType::HOST_POOL allocator to the
+   /// system. The blocks are allocated in slabs, and only the slabs without
+   /// blocks in use are released.
+   static void ReleaseHostPool();
+
+   /// Reset the counters of the MemoryType::HOST_POOL allocator: the number
+   /// of requests and hits, and the peak number of bytes in use.
+   static void ResetHostPoolStats();
+
+   /** @brief Enable or disable the tracing of the memory allocations and of
+       the host/device transfers. */
+   /** In tracing mode, the MemoryManager records the current and peak number
+       of bytes for each MemoryType and for each MemoryTraceScope, together
+       with the number and size of the host-to-device and device-to-host
+       copies. Only the allocations made while tracing is enabled are
+       recorded. Tracing is disabled by default. */
+   static void EnableTracing(bool enable = true);
+
+   /// Return true if the allocations are being traced, see EnableTracing().
+   static bool IsTracing() { return tracing; }
+
+   /// Clear all the data recorded in tracing mode.
+   static void ResetTracing();
+
+   /// Return the number of bytes currently allocated with the MemoryType
+   /// @a mt, as recorded in tracing mode.
+   static size_t GetTracedBytes(MemoryType mt);
+
+   /// Return the peak total number of allocated bytes recorded in tracing mode.
+   static size_t GetTracedPeakBytes();
+
+   /// Print a summary of the data recorded in tracing mode.
+   static void PrintTrace(std::ostream &os = mfem::out);
+
+   /// Print the data recorded in tracing mode in JSON format.
+   static void PrintTraceJSON(std::ostream &os = mfem::out);
+
+   /// Open a new MemoryTraceScope named @a name inside the current one.
+   static void PushTraceScope(const char *name);
+
+   /// Close the current MemoryTraceScope.
+   static void PopTraceScope();
+};
+
+
+/// Label of the allocations made during the lifetime of this object.
+/** In tracing mode, see MemoryManager::EnableTracing(), the allocations are
+    accounted to the innermost scope. Nested scopes are named by joining the
+    names of the enclosing scopes with '/', e.g. "CGSolver/Vector". Vector,
+    SparseMatrix and DenseTensor label their allocations with their class name.
+    When tracing is disabled, constructing a scope has no effect. */
+class MemoryTraceScope
+{
+   const bool active;
+public:
+   explicit MemoryTraceScope(const char *name)
+      : active(MemoryManager::IsTracing())
+   { if (active) { MemoryManager::PushTraceScope(name); } }
+
+   ~MemoryTraceScope() { if (active) { MemoryManager::PopTraceScope(); } }
 };
 
 
 // Inline methods
 
+template <typename T>
+inline T *Memory<T>::NewHOST(std::size_t size)
+{
+   T *ptr = Alloc<new_align_bytes>::New(size);
+   if (MemoryManager::IsTracing())
+   {
+      MemoryManager::TraceNew_(ptr, size*sizeof(T));
+   }
+   return ptr;
+}
+
 template <typename T>
 inline void Memory<T>::Reset()
 {
@@ -1010,7 +1112,11 @@ inline void Memory<T>::Delete()
    if (std_delete ||
        MemoryManager::Delete_((void*)h_ptr, h_mt, flags) == MemoryType::HOST)
    {
-      if (flags & OWNS_HOST) { delete [] h_ptr; }
+      if (flags & OWNS_HOST)
+      {
+         if (MemoryManager::IsTracing()) { MemoryManager::TraceDelete_(h_ptr); }
+         delete [] h_ptr;
+      }
    }
    Reset(h_mt);
 }
@@ -172,6 +172,9 @@ const char *GetConfigStr()
 #ifdef MFEM_USE_SUPERLU5
       "MFEM_USE_SUPERLU5\n"
 #endif
+#ifdef MFEM_USE_THREADS
+      "MFEM_USE_THREADS\n"
+#endif
 #ifdef MFEM_USE_UMPIRE
       "MFEM_USE_UMPIRE\n"
 #endif
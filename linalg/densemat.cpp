@@ -3972,4 +3972,161 @@ void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X)
 
 }
 
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv)
+{
+   const int m = Mlu.SizeI();
+   const int NE = Mlu.SizeK();
+   Minv.SetSize(m, m, NE);
+
+   auto data_all = mfem::Reshape(Mlu.Read(), m, m, NE);
+   auto piv_all = mfem::Reshape(P.Read(), m, NE);
+   auto inv_all = mfem::Reshape(Minv.Write(), m, m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int j = 0; j < m; j++)
+      {
+         for (int i = 0; i < m; i++) { inv_all(i,j,e) = (i == j) ? 1.0 : 0.0; }
+         kernels::LUSolve(&data_all(0,0,e), m, &piv_all(0,e), &inv_all(0,j,e));
+      }
+   });
+}
+
+void BatchCholeskyFactor(DenseTensor &Mchol, const double TOL)
+{
+   const int m = Mchol.SizeI();
+   const int NE = Mchol.SizeK();
+
+   auto data_all = mfem::Reshape(Mchol.ReadWrite(), m, m, NE);
+   Array<bool> spd_flag(1);
+   spd_flag[0] = true;
+   bool *d_spd_flag = spd_flag.ReadWrite();
+
+   // Cholesky-Crout algorithm, see CholeskyFactors::Factor
+   MFEM_FORALL(e, NE,
+   {
+      for (int j = 0; j < m; j++)
+      {
+         double a = data_all(j,j,e);
+         for (int k = 0; k < j; k++)
+         {
+            a -= data_all(j,k,e) * data_all(j,k,e);
+         }
+         if (a <= TOL * TOL)
+         {
+            d_spd_flag[0] = false;
+         }
+         const double l_jj = sqrt(a);
+         data_all(j,j,e) = l_jj;
+
+         const double l_jj_inv = 1.0 / l_jj;
+         for (int i = j+1; i < m; i++)
+         {
+            double b = data_all(i,j,e);
+            for (int k = 0; k < j; k++)
+            {
+               b -= data_all(i,k,e) * data_all(j,k,e);
+            }
+            data_all(i,j,e) = b * l_jj_inv;
+         }
+      }
+   });
+
+   MFEM_VERIFY(spd_flag.HostRead()[0],
+               "Batch Cholesky factorization failed: a matrix is not SPD");
+}
+
+void BatchCholeskySolve(const DenseTensor &Mchol, Vector &X)
+{
+   const int m = Mchol.SizeI();
+   const int NE = Mchol.SizeK();
+
+   auto data_all = mfem::Reshape(Mchol.Read(), m, m, NE);
+   auto x_all = mfem::Reshape(X.ReadWrite(), m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      // X <- L^{-1} X
+      for (int j = 0; j < m; j++)
+      {
+         const double x_j = (x_all(j,e) /= data_all(j,j,e));
+         for (int i = j+1; i < m; i++)
+         {
+            x_all(i,e) -= data_all(i,j,e) * x_j;
+         }
+      }
+      // X <- L^{-t} X
+      for (int i = m-1; i >= 0; i--)
+      {
+         double x_i = x_all(i,e);
+         for (int j = i+1; j < m; j++)
+         {
+            x_i -= data_all(j,i,e) * x_all(j,e);
+         }
+         x_all(i,e) = x_i / data_all(i,i,e);
+      }
+   });
+}
+
+void BatchMult(const DenseTensor &A, const Vector &x, Vector &y)
+{
+   const int m = A.SizeI();
+   const int k = A.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(x.Size() == k*NE, "Incompatible sizes");
+   y.SetSize(m*NE);
+
+   auto a_all = mfem::Reshape(A.Read(), m, k, NE);
+   auto x_all = mfem::Reshape(x.Read(), k, NE);
+   auto y_all = mfem::Reshape(y.Write(), m, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int i = 0; i < m; i++) { y_all(i,e) = 0.0; }
+      for (int j = 0; j < k; j++)
+      {
+         const double x_j = x_all(j,e);
+         for (int i = 0; i < m; i++)
+         {
+            y_all(i,e) += a_all(i,j,e) * x_j;
+         }
+      }
+   });
+}
+
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C)
+{
+   const int m = A.SizeI();
+   const int k = A.SizeJ();
+   const int l = B.SizeJ();
+   const int NE = A.SizeK();
+   MFEM_VERIFY(B.SizeI() == k && B.SizeK() == NE, "Incompatible sizes");
+   MFEM_VERIFY(&C != &A && &C != &B, "C must not alias A or B");
+   if (C.SizeI() != m || C.SizeJ() != l || C.SizeK() != NE)
+   {
+      C.SetSize(m, l, NE);
+   }
+
+   auto a_all = mfem::Reshape(A.Read(), m, k, NE);
+   auto b_all = mfem::Reshape(B.Read(), k, l, NE);
+   auto c_all = mfem::Reshape(C.Write(), m, l, NE);
+
+   MFEM_FORALL(e, NE,
+   {
+      for (int j = 0; j < l; j++)
+      {
+         for (int i = 0; i < m; i++) { c_all(i,j,e) = 0.0; }
+         for (int p = 0; p < k; p++)
+         {
+            const double b_pj = b_all(p,j,e);
+            for (int i = 0; i < m; i++)
+            {
+               c_all(i,j,e) += a_all(i,p,e) * b_pj;
+            }
+         }
+      }
+   });
+}
+
 } // namespace mfem
@@ -901,6 +901,7 @@ public:
       : Mk(NULL, i, j)
    {
       nk = k;
+      MemoryTraceScope trace_scope("DenseTensor");
       tdata.New(i*j*k);
    }
 
@@ -915,6 +916,7 @@ public:
       : Mk(NULL, i, j)
    {
       nk = k;
+      MemoryTraceScope trace_scope("DenseTensor");
       tdata.New(i*j*k, mt);
    }
 
@@ -925,6 +927,7 @@ public:
       const int size = Mk.Height()*Mk.Width()*nk;
       if (size > 0)
       {
+         MemoryTraceScope trace_scope("DenseTensor");
          tdata.New(size, other.tdata.GetMemoryType());
          tdata.CopyFrom(other.tdata, size);
       }
@@ -942,6 +945,7 @@ public:
       tdata.Delete();
       Mk.UseExternalData(NULL, i, j);
       nk = k;
+      MemoryTraceScope trace_scope("DenseTensor");
       tdata.New(i*j*k, mt);
    }
 
@@ -1062,6 +1066,55 @@ void BatchLUFactor(DenseTensor &Mlu, Array<int> &P, const double TOL = 0.0);
     dimension m x n. */
 void BatchLUSolve(const DenseTensor &Mlu, const Array<int> &P, Vector &X);
 
+/** @brief Compute the inverses of a batch of LU factored matrices
+
+    Given the output of BatchLUFactor() for n matrices (m x m), compute the
+    inverses of the original matrices.
+
+    @param [in] Mlu batch of LU factors for matrix M - dimension m x m x n.
+    @param [in] P array storing pivot information - dimension m x n.
+    @param [out] Minv batch of inverse matrices - dimension m x m x n. */
+void BatchInverseMatrix(const DenseTensor &Mlu, const Array<int> &P,
+                        DenseTensor &Minv);
+
+/** @brief Compute the Cholesky factorization of a batch of SPD matrices
+
+    Factorize n symmetric positive definite matrices of size (m x m) stored in
+    a dense tensor, overwriting their lower triangular parts with the factors L
+    such that L.L^t = A. The strictly upper triangular parts are not accessed.
+
+    @param [in, out] Mchol batch of SPD matrices - dimension m x m x n.
+    @param [in] TOL optional fuzzy comparison tolerance. Defaults to 0.0. */
+void BatchCholeskyFactor(DenseTensor &Mchol, const double TOL = 0.0);
+
+/** @brief Solve batch SPD linear systems
+
+    Assuming L.L^t = A for n factored matrices (m x m), compute x <- A^{-1} x,
+    for n companion vectors.
+
+    @param [in] Mchol batch of Cholesky factors from BatchCholeskyFactor() -
+    dimension m x m x n.
+    @param [in, out] X vector storing right-hand side and then solution -
+    dimension m x n. */
+void BatchCholeskySolve(const DenseTensor &Mchol, Vector &X);
+
+/** @brief Compute the matrix-vector products y <- A x for a batch of
+    rectangular matrices
+
+    @param [in] A batch of matrices - dimension m x k x n.
+    @param [in] x batch of vectors - dimension k x n.
+    @param [out] y batch of vectors - dimension m x n. */
+void BatchMult(const DenseTensor &A, const Vector &x, Vector &y);
+
+/** @brief Compute the matrix-matrix products C <- A B for a batch of
+    rectangular matrices
+
+    @param [in] A batch of matrices - dimension m x k x n.
+    @param [in] B batch of matrices - dimension k x l x n.
+    @param [out] C batch of matrices - dimension m x l x n. It is resized if
+    needed and must not alias A or B. */
+void BatchMult(const DenseTensor &A, const DenseTensor &B, DenseTensor &C);
+
 
 // Inline methods
 
@@ -0,0 +1,137 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+// Implementation of the SELL-C-sigma sparse matrix format
+
+#include "sellmat.hpp"
+#include "sparsemat.hpp"
+#include "../general/device.hpp"
+
+#include <algorithm>
+
+namespace mfem
+{
+
+SELLMatrix::SELLMatrix(const SparseMatrix &A, int sigma_)
+   : Operator(A.Height(), A.Width()),
+     sigma(sigma_ > 1 ? MFEM_ROUNDUP(sigma_, C) : 1)
+{
+   MFEM_VERIFY(A.Finalized(), "the SparseMatrix must be finalized");
+
+   const int *I = A.HostReadI(), *J = A.HostReadJ();
+   const double *V = A.HostReadData();
+   const int nchunks = (height + C - 1)/C;
+
+   // Sort the rows by decreasing length inside each window of sigma rows
+   perm.SetSize(nchunks*C);
+   for (int i = 0; i < perm.Size(); i++) { perm[i] = (i < height) ? i : -1; }
+   if (sigma > 1)
+   {
+      for (int w = 0; w < height; w += sigma)
+      {
+         int *first = perm.GetData() + w;
+         int *last = perm.GetData() + std::min(w + sigma, height);
+         std::stable_sort(first, last, [&](int r, int s)
+         {
+            return I[r+1] - I[r] > I[s+1] - I[s];
+         });
+      }
+   }
+
+   // Chunk widths and offsets
+   chunk_offsets.SetSize(nchunks+1);
+   chunk_offsets[0] = 0;
+   for (int c = 0; c < nchunks; c++)
+   {
+      int len = 0;
+      for (int l = 0; l < C; l++)
+      {
+         const int r = perm[c*C + l];
+         if (r >= 0) { len = std::max(len, I[r+1] - I[r]); }
+      }
+      chunk_offsets[c+1] = chunk_offsets[c] + len*C;
+   }
+
+   // Fill the column-major chunks, padding with zeros
+   const int nnz = chunk_offsets[nchunks];
+   col.SetSize(nnz);
+   val.SetSize(nnz, MemoryType::HOST_64);
+   for (int c = 0; c < nchunks; c++)
+   {
+      const int off = chunk_offsets[c];
+      const int len = (chunk_offsets[c+1] - off)/C;
+      for (int l = 0; l < C; l++)
+      {
+         const int r = perm[c*C + l];
+         const int rlen = (r >= 0) ? I[r+1] - I[r] : 0;
+         const int pad_col = (rlen > 0) ? J[I[r+1]-1] : 0;
+         for (int j = 0; j < len; j++)
+         {
+            const bool is_entry = (j < rlen);
+            col[off + j*C + l] = is_entry ? J[I[r] + j] : pad_col;
+            val[off + j*C + l] = is_entry ? V[I[r] + j] : 0.0;
+         }
+      }
+   }
+}
+
+void SELLMatrix::Mult(const Vector &x, Vector &y) const
+{
+   y = 0.0;
+   AddMult(x, y);
+}
+
+void SELLMatrix::AddMult(const Vector &x, Vector &y, const double a) const
+{
+   MFEM_ASSERT(width == x.Size(), "Input vector size (" << x.Size()
+               << ") must match matrix width (" << width << ")");
+   MFEM_ASSERT(height == y.Size(), "Output vector size (" << y.Size()
+               << ") must match matrix height (" << height << ")");
+
+   const int nchunks = NumChunks();
+   const int *offsets = chunk_offsets.GetData(), *rows = perm.GetData();
+   const int *cols = col.GetData();
+   const vreal_t *vals = reinterpret_cast<const vreal_t*>(val.HostRead());
+   const double *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+
+#ifdef MFEM_USE_OPENMP
+   const bool use_omp = Device::Allows(Backend::OMP_MASK);
+   #pragma omp parallel for if (use_omp)
+#endif
+   for (int c = 0; c < nchunks; c++)
+   {
+      const int len = (offsets[c+1] - offsets[c])/C;
+      const vreal_t *cv = vals + offsets[c]/C;
+      const int *cc = cols + offsets[c];
+      vreal_t sum, xv;
+      sum = 0.0;
+      for (int j = 0; j < len; j++)
+      {
+         MFEM_VECTORIZE_LOOP
+         for (int l = 0; l < C; l++) { xv[l] = xp[cc[j*C + l]]; }
+         sum.fma(cv[j], xv);
+      }
+      for (int l = 0; l < C; l++)
+      {
+         const int r = rows[c*C + l];
+         if (r >= 0) { yp[r] += a * sum[l]; }
+      }
+   }
+}
+
+long SELLMatrix::MemoryUsage() const
+{
+   return (long)NumStoredEntries()*(sizeof(int) + sizeof(double)) +
+          (long)(chunk_offsets.Size() + perm.Size())*sizeof(int);
+}
+
+} // namespace mfem
@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_SELLMAT_HPP
+#define MFEM_SELLMAT_HPP
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "vector.hpp"
+#include "operator.hpp"
+#include "simd.hpp"
+
+namespace mfem
+{
+
+class SparseMatrix;
+
+/** @brief Sparse matrix in the SELL-C-sigma format, used as an alternative
+    storage for the action of a finalized SparseMatrix on the host. */
+/** The rows are sorted by decreasing length within windows of sigma
+    consecutive rows and then grouped in chunks of C rows. Each chunk is stored
+    column-major and padded to the length of its longest row, so that the
+    inner loop of the matrix-vector product processes C rows at once using the
+    AutoSIMD types from linalg/simd.hpp.
+
+    See M. Kreutzer et al., "A unified sparse matrix data format for efficient
+    general sparse matrix-vector multiplication on modern processors with wide
+    SIMD units", SIAM J. Sci. Comput. 36 (2014).
+
+    The object is a snapshot of the SparseMatrix it was built from: changes in
+    the values or the sparsity of that matrix are not reflected here. */
+class SELLMatrix : public Operator
+{
+public:
+   /// Chunk height: the number of rows processed together.
+   static constexpr int C = (MFEM_SIMD_BYTES >= 32) ?
+                            MFEM_SIMD_BYTES/sizeof(double) : 4;
+
+   typedef AutoSIMD<double, C, C*sizeof(double)> vreal_t;
+
+protected:
+   int sigma;
+   /// Offsets of the chunks in #col and #val, size (number of chunks)+1.
+   Array<int> chunk_offsets;
+   /// Original row of each (sorted) row slot, -1 for the padding rows.
+   Array<int> perm;
+   /// Column indices, padding entries repeat a valid column.
+   Array<int> col;
+   /// Matrix entries, padding entries are zero. Aligned to 64 bytes.
+   Vector val;
+
+public:
+   /** @brief Build the SELL-C-sigma representation of the finalized matrix
+       @a A. With @a sigma = 1 the original row ordering is kept, otherwise
+       @a sigma is rounded up to a multiple of C. */
+   SELLMatrix(const SparseMatrix &A, int sigma = 1);
+
+   /// y = A * x
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   /// y += a * A * x
+   void AddMult(const Vector &x, Vector &y, const double a = 1.0) const;
+
+   /// The sorting scope used during the construction.
+   int GetSigma() const { return sigma; }
+
+   /// Number of chunks of C rows.
+   int NumChunks() const { return chunk_offsets.Size()-1; }
+
+   /// Number of stored entries, including the zero padding.
+   int NumStoredEntries() const { return chunk_offsets.Last(); }
+
+   /// Memory used by the SELL-C-sigma data, in bytes.
+   long MemoryUsage() const;
+};
+
+} // namespace mfem
+
+#endif // MFEM_SELLMAT_HPP
@@ -68,6 +68,16 @@ double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 #endif
 }
 
+void IterativeSolver::GlobalSum(double *v, int n) const
+{
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type != 0)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, v, n, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+}
+
 void IterativeSolver::SetPrintLevel(int print_lvl)
 {
    print_options = FromLegacyPrintLevel(print_lvl);
@@ -197,6 +207,31 @@ void IterativeSolver::Monitor(int it, double norm, const Vector& r,
    }
 }
 
+// Move the data of v to v_sp, rounded to single precision, or move the data of
+// v_sp back to v, so that only one of them is stored.
+static void SetPrecision(bool single, Vector &v, Array<float> &v_sp)
+{
+   if (single && v.Size() > 0)
+   {
+      const int n = v.Size();
+      v_sp.SetSize(n);
+      const auto d = v.Read();
+      auto d_sp = v_sp.Write();
+      MFEM_FORALL(i, n, d_sp[i] = static_cast<float>(d[i]););
+      v.Destroy();
+   }
+   else if (!single && v_sp.Size() > 0)
+   {
+      const int n = v_sp.Size();
+      v.SetSize(n);
+      v.UseDevice(true);
+      const auto d_sp = v_sp.Read();
+      auto d = v.Write();
+      MFEM_FORALL(i, n, d[i] = d_sp[i];);
+      v_sp.DeleteAll();
+   }
+}
+
 OperatorJacobiSmoother::OperatorJacobiSmoother(const double dmpng)
    : damping(dmpng),
      ess_tdof_list(nullptr),
@@ -274,9 +309,17 @@ void OperatorJacobiSmoother::SetOperator(const Operator &op)
    Setup(diag);
 }
 
+void OperatorJacobiSmoother::SetSinglePrecision(bool single_)
+{
+   single = single_;
+   SetPrecision(single, dinv, dinv_sp);
+}
+
 void OperatorJacobiSmoother::Setup(const Vector &diag)
 {
    residual.UseDevice(true);
+   dinv_sp.DeleteAll();
+   dinv.SetSize(height);
    const double delta = damping;
    auto D = diag.Read();
    auto DI = dinv.Write();
@@ -295,6 +338,7 @@ void OperatorJacobiSmoother::Setup(const Vector &diag)
       auto I = ess_tdof_list->Read();
       MFEM_FORALL(i, ess_tdof_list->Size(), DI[I[i]] = delta; );
    }
+   SetPrecision(single, dinv, dinv_sp);
 }
 
 void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
@@ -316,9 +360,18 @@ void OperatorJacobiSmoother::Mult(const Vector &x, Vector &y) const
       y.UseDevice(true);
       y = 0.0;
    }
-   auto DI = dinv.Read();
    auto R = residual.Read();
    auto Y = y.ReadWrite();
+   if (single)
+   {
+      auto DI = dinv_sp.Read();
+      MFEM_FORALL(i, height,
+      {
+         Y[i] += DI[i] * R[i];
+      });
+      return;
+   }
+   auto DI = dinv.Read();
    MFEM_FORALL(i, height,
    {
       Y[i] += DI[i] * R[i];
@@ -399,15 +452,24 @@ OperatorChebyshevSmoother::OperatorChebyshevSmoother(const Operator* oper_,
                                power_tolerance) { }
 #endif
 
+void OperatorChebyshevSmoother::SetSinglePrecision(bool single_)
+{
+   single = single_;
+   SetPrecision(single, dinv, dinv_sp);
+}
+
 void OperatorChebyshevSmoother::Setup()
 {
    // Invert diagonal
    residual.UseDevice(true);
+   dinv_sp.DeleteAll();
+   dinv.SetSize(N);
    auto D = diag.Read();
    auto X = dinv.Write();
    MFEM_FORALL(i, N, X[i] = 1.0 / D[i]; );
    auto I = ess_tdof_list.Read();
    MFEM_FORALL(i, ess_tdof_list.Size(), X[I[i]] = 1.0; );
+   SetPrecision(single, dinv, dinv_sp);
 
    // Set up Chebyshev coefficients
    // For reference, see e.g., Parallel multigrid smoothing: polynomial versus
@@ -490,6 +552,7 @@ void OperatorChebyshevSmoother::Mult(const Vector& x, Vector &y) const
 
    residual = x;
    helperVector.SetSize(x.Size());
+   helperVector.UseDevice(true);
 
    y.UseDevice(true);
    y = 0.0;
@@ -500,19 +563,32 @@ void OperatorChebyshevSmoother::Mult(const Vector& x, Vector &y) const
       if (k > 0)
       {
          oper->Mult(residual, helperVector);
-         residual = helperVector;
+         residual.Swap(helperVector);
       }
 
-      // Scale residual by inverse diagonal
+      // Scale residual by inverse diagonal and add weighted contribution to y
       const int n = N;
-      auto Dinv = dinv.Read();
       auto R = residual.ReadWrite();
-      MFEM_FORALL(i, n, R[i] *= Dinv[i]; );
-
-      // Add weighted contribution to y
       auto Y = y.ReadWrite();
       auto C = coeffs.Read();
-      MFEM_FORALL(i, n, Y[i] += C[k] * R[i]; );
+      if (single)
+      {
+         auto Dinv = dinv_sp.Read();
+         MFEM_FORALL(i, n,
+         {
+            R[i] *= Dinv[i];
+            Y[i] += C[k] * R[i];
+         });
+      }
+      else
+      {
+         auto Dinv = dinv.Read();
+         MFEM_FORALL(i, n,
+         {
+            R[i] *= Dinv[i];
+            Y[i] += C[k] * R[i];
+         });
+      }
    }
 }
 
@@ -524,6 +600,8 @@ void SLISolver::UpdateVectors()
 
 void SLISolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    int i;
 
    // Optimized preconditioned SLI with fixed number of iterations and given
@@ -710,6 +788,8 @@ void CGSolver::UpdateVectors()
 
 void CGSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
@@ -790,16 +870,18 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    {
       alpha = nom/den;
       add(x,  alpha, d, x);     //  x = x + alpha d
-      add(r, -alpha, z, r);     //  r = r - alpha A d
 
       if (prec)
       {
+         add(r, -alpha, z, r);  //  r = r - alpha A d
          prec->Mult(r, z);      //  z = B r
          betanom = Dot(r, z);
       }
       else
       {
-         betanom = Dot(r, r);
+         //  r = r - alpha A d and (r, r) in one pass
+         betanom = AXPBYDot(1.0, r, -alpha, z, r, r);
+         GlobalSum(&betanom, 1);
       }
       MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
       if (betanom < 0.0)
@@ -918,6 +1000,460 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void PipelinedCGSolver::SetOperator(const Operator &op)
+{
+   CGSolver::SetOperator(op);
+
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   u.SetSize(width, mt); u.UseDevice(true);
+   w.SetSize(width, mt); w.UseDevice(true);
+   m.SetSize(width, mt); m.UseDevice(true);
+   n.SetSize(width, mt); n.UseDevice(true);
+   s.SetSize(width, mt); s.UseDevice(true);
+   q.SetSize(width, mt); q.UseDevice(true);
+}
+
+void PipelinedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_FUNCTION;
+
+   int i;
+   double r0 = 0.0, nom0 = 0.0, gamma = 0.0, gamma_old = 0.0, alpha = 0.0;
+   double dots[2];
+
+   // With p = d, the recurrences maintain: u = B r, w = A u, s = A p,
+   // q = B s, z = A q, m = B w and n = A m
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (prec)
+   {
+      prec->Mult(r, u); // u = B r
+   }
+   else
+   {
+      u = r;
+   }
+   oper->Mult(u, w);    // w = A u
+
+   converged = false;
+   final_iter = max_iter;
+   for (i = 0; true; i++)
+   {
+      // Start the reduction of gamma = (B r, r) and delta = (A u, u)
+      const Vector *rw[2] = { &r, &w };
+      MultiDot(2, rw, u, dots);
+#ifdef MFEM_USE_MPI
+      MPI_Request request = MPI_REQUEST_NULL;
+      if (GetComm() != MPI_COMM_NULL)
+      {
+#if MPI_VERSION >= 3
+         MPI_Iallreduce(MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, GetComm(),
+                        &request);
+#else
+         MPI_Allreduce(MPI_IN_PLACE, dots, 2, MPI_DOUBLE, MPI_SUM, GetComm());
+#endif
+      }
+#endif
+
+      // Overlap the reduction with m = B w and n = A m
+      if (prec)
+      {
+         prec->Mult(w, m);
+      }
+      else
+      {
+         m = w;
+      }
+      oper->Mult(m, n);
+
+#ifdef MFEM_USE_MPI
+      MPI_Wait(&request, MPI_STATUS_IGNORE);
+#endif
+      gamma = dots[0];
+      const double delta = dots[1];
+      MFEM_ASSERT(IsFinite(gamma), "gamma = " << gamma);
+      MFEM_ASSERT(IsFinite(delta), "delta = " << delta);
+
+      if (i == 0)
+      {
+         nom0 = gamma;
+         r0 = std::max(nom0*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      if (print_options.iterations ||
+          (i == 0 && print_options.first_and_last))
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << gamma << (print_options.first_and_last ? " ...\n" : "\n");
+      }
+      Monitor(i, gamma, r, x);
+
+      if (gamma < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "PipelinedCG: The preconditioner is not positive "
+                      "definite. (Br, r) = " << gamma << '\n';
+         }
+         final_iter = i;
+         break;
+      }
+      if (gamma <= r0)
+      {
+         converged = true;
+         final_iter = i;
+         break;
+      }
+      if (i >= max_iter)
+      {
+         break;
+      }
+
+      // den = (A p, p) for the new search direction p = u + beta p
+      const double beta = (i == 0) ? 0.0 : gamma/gamma_old;
+      const double den = (i == 0) ? delta : delta - beta*gamma/alpha;
+      if (den <= 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "PipelinedCG: The operator is not positive definite. "
+                      "(Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      alpha = gamma/den;
+
+      if (i == 0)
+      {
+         z = n;
+         q = m;
+         s = w;
+         d = u;
+      }
+      else
+      {
+         add(n, beta, z, z);  //  z = n + beta z
+         add(m, beta, q, q);  //  q = m + beta q
+         add(w, beta, s, s);  //  s = w + beta s
+         add(u, beta, d, d);  //  d = u + beta d
+      }
+      add(x,  alpha, d, x);   //  x = x + alpha d
+      add(r, -alpha, s, r);   //  r = r - alpha A d
+      add(u, -alpha, q, u);   //  u = u - alpha B A d
+      add(w, -alpha, z, w);   //  w = w - alpha A B A d
+      gamma_old = gamma;
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << gamma << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "PipelinedCG: Number of iterations: " << final_iter << '\n';
+   }
+   if ((print_options.summary || print_options.iterations ||
+        print_options.first_and_last) && final_iter > 0)
+   {
+      const auto arf = pow (gamma/nom0, 0.5/final_iter);
+      mfem::out << "Average reduction factor = " << arf << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "PipelinedCG: No convergence!" << '\n';
+   }
+
+   final_norm = sqrt(gamma);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+
+void SStepCGSolver::SetNumSteps(int s_)
+{
+   MFEM_VERIFY(s_ > 0, "invalid number of steps: " << s_);
+   s = s_;
+   if (oper) { UpdateBlocks(); }
+}
+
+void SStepCGSolver::UpdateBlocks()
+{
+   MemoryType mt = GetMemoryType(oper->GetMemoryClass());
+
+   R.SetSize(s*width, mt); R.UseDevice(true);
+   AR.SetSize(s*width, mt); AR.UseDevice(true);
+   P.SetSize(s*width, mt); P.UseDevice(true);
+   AP.SetSize(s*width, mt); AP.UseDevice(true);
+}
+
+void SStepCGSolver::SetOperator(const Operator &op)
+{
+   CGSolver::SetOperator(op);
+   UpdateBlocks();
+   lmax = 0.0;
+}
+
+void SStepCGSolver::EstimateMaxEigenvalue() const
+{
+#ifdef MFEM_USE_MPI
+   PowerMethod power_method(GetComm());
+#else
+   PowerMethod power_method;
+#endif
+   Vector ev(width);
+   if (prec)
+   {
+      ProductOperator BA(prec, oper, false, false);
+      lmax = power_method.EstimateLargestEigenvalue(BA, ev, 10, 1e-3);
+   }
+   else
+   {
+      lmax = power_method.EstimateLargestEigenvalue(
+                const_cast<Operator&>(*oper), ev, 10, 1e-3);
+   }
+   MFEM_VERIFY(lmax > 0.0, "invalid eigenvalue estimate: " << lmax);
+}
+
+void SStepCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_PERF_FUNCTION;
+
+   x.UseDevice(true);
+   if (iterative_mode)
+   {
+      oper->Mult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+   if (lmax == 0.0) { EstimateMaxEigenvalue(); }
+
+   // The Gram matrices of the blocks are reduced together with the inner
+   // products of the basis with the residual: the upper triangle of R^t A R,
+   // (A P_old)^t R and R^t r
+   const int ng = s*(s+1)/2;
+   Vector red(ng + s*s + s);
+   DenseMatrix G(s), C(s), CtB(s), Bk(s), W(s);
+   CholeskyFactors chol; // factors of W = P^t A P, overwriting W
+   Vector g(s), a(s);
+   Vector Ri, Rj, ARj, Pi, APi;
+   double r0 = 0.0, nom0 = 0.0, betanom = 0.0;
+
+   converged = false;
+   final_iter = 0;
+   for (int k = 0; true; k++)
+   {
+      // Chebyshev basis R_j = T_j(2/lmax B A - I) B r on [0, lmax], and AR
+      Rj.MakeRef(R, 0, width);
+      if (prec)
+      {
+         prec->Mult(r, Rj);
+      }
+      else
+      {
+         Rj = r;
+      }
+      for (int j = 0; j < s; j++)
+      {
+         Rj.MakeRef(R, j*width, width);
+         ARj.MakeRef(AR, j*width, width);
+         oper->Mult(Rj, ARj);
+         if (j+1 == s) { break; }
+         Ri.MakeRef(R, (j+1)*width, width);
+         if (prec)
+         {
+            prec->Mult(ARj, Ri);
+         }
+         else
+         {
+            Ri = ARj;
+         }
+         if (j == 0)
+         {
+            add(2.0/lmax, Ri, -1.0, Rj, Ri);
+         }
+         else
+         {
+            add(4.0/lmax, Ri, -2.0, Rj, Ri);
+            Rj.MakeRef(R, (j-1)*width, width);
+            Ri -= Rj;
+         }
+      }
+
+      int c = 0;
+      for (int j = 0; j < s; j++)
+      {
+         ARj.MakeRef(AR, j*width, width);
+         for (int i = 0; i <= j; i++)
+         {
+            Ri.MakeRef(R, i*width, width);
+            red(c++) = Ri * ARj;
+         }
+      }
+      if (k > 0)
+      {
+         for (int j = 0; j < s; j++)
+         {
+            Rj.MakeRef(R, j*width, width);
+            for (int i = 0; i < s; i++)
+            {
+               APi.MakeRef(AP, i*width, width);
+               red(c++) = APi * Rj;
+            }
+         }
+      }
+      for (int j = 0; j < s; j++)
+      {
+         Rj.MakeRef(R, j*width, width);
+         red(c++) = Rj * r;
+      }
+      GlobalSum(red.HostReadWrite(), c);
+      c = 0;
+      for (int j = 0; j < s; j++)
+      {
+         for (int i = 0; i <= j; i++) { G(i,j) = G(j,i) = red(c++); }
+      }
+      if (k > 0)
+      {
+         for (int j = 0; j < s; j++)
+         {
+            for (int i = 0; i < s; i++) { C(i,j) = red(c++); }
+         }
+      }
+      for (int j = 0; j < s; j++) { g(j) = red(c++); }
+
+      // The first basis vector is B r, so g(0) = (B r, r)
+      betanom = g(0);
+      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      if (k == 0)
+      {
+         nom0 = betanom;
+         r0 = std::max(nom0*rel_tol*rel_tol, abs_tol*abs_tol);
+      }
+      if (print_options.iterations ||
+          (k == 0 && print_options.first_and_last))
+      {
+         mfem::out << "   Iteration : " << setw(3) << final_iter
+                   << "  (B r, r) = " << betanom
+                   << (print_options.first_and_last ? " ...\n" : "\n");
+      }
+      Monitor(final_iter, betanom, r, x);
+
+      if (betanom < 0.0)
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "SStepCG: The preconditioner is not positive "
+                      "definite. (Br, r) = " << betanom << '\n';
+         }
+         break;
+      }
+      if (betanom <= r0)
+      {
+         converged = true;
+         break;
+      }
+      if (final_iter >= max_iter)
+      {
+         break;
+      }
+
+      // Make the block A-conjugate to the previous one: P = R + P_old Bk with
+      // Bk = -W_old^{-1} C, so that W = P^t A P = G + C^t Bk
+      if (k > 0)
+      {
+         // chol holds the factors of W_old
+         Bk = C;
+         chol.Solve(s, s, Bk.Data());
+         Bk.Neg();
+         MultAtB(C, Bk, CtB);
+         W = G;
+         W += CtB;
+         W.Symmetrize();
+         for (int j = 0; j < s; j++)
+         {
+            Rj.MakeRef(R, j*width, width);
+            ARj.MakeRef(AR, j*width, width);
+            for (int i = 0; i < s; i++)
+            {
+               Pi.MakeRef(P, i*width, width);
+               APi.MakeRef(AP, i*width, width);
+               Rj.Add(Bk(i,j), Pi);
+               ARj.Add(Bk(i,j), APi);
+            }
+         }
+      }
+      else
+      {
+         W = G;
+      }
+      P.Swap(R);
+      AP.Swap(AR);
+
+      // Since P_old^t r = 0, the coefficients solve W a = P^t r = R^t r
+      chol.data = W.Data();
+      if (!chol.Factor(s))
+      {
+         if (print_options.warnings)
+         {
+            mfem::out << "SStepCG: The block P^t A P is not positive definite."
+                      << '\n';
+         }
+         break;
+      }
+      a = g;
+      chol.Solve(s, 1, a.GetData());
+      for (int j = 0; j < s; j++)
+      {
+         Pi.MakeRef(P, j*width, width);
+         APi.MakeRef(AP, j*width, width);
+         x.Add(a(j), Pi);      //  x = x + P a
+         r.Add(-a(j), APi);    //  r = r - A P a
+      }
+      final_iter += s;
+   }
+   if (print_options.first_and_last && !print_options.iterations)
+   {
+      mfem::out << "   Iteration : " << setw(3) << final_iter << "  (B r, r) = "
+                << betanom << '\n';
+   }
+   if (print_options.summary || (print_options.warnings && !converged))
+   {
+      mfem::out << "SStepCG: Number of iterations: " << final_iter << '\n';
+   }
+   if ((print_options.summary || print_options.iterations ||
+        print_options.first_and_last) && final_iter > 0)
+   {
+      const auto arf = pow (betanom/nom0, 0.5/final_iter);
+      mfem::out << "Average reduction factor = " << arf << '\n';
+   }
+   if (print_options.warnings && !converged)
+   {
+      mfem::out << "SStepCG: No convergence!" << '\n';
+   }
+
+   final_norm = sqrt(betanom);
+
+   Monitor(final_iter, final_norm, r, x, true);
+}
+
+
 inline void GeneratePlaneRotation(double &dx, double &dy,
                                   double &cs, double &sn)
 {
@@ -947,6 +1483,29 @@ inline void ApplyPlaneRotation(double &dx, double &dy, double &cs, double &sn)
    dx = temp;
 }
 
+// Orthogonalize w against the orthonormal vectors v[0], ..., v[n-1] using the
+// classical Gram-Schmidt process with one reorthogonalization pass, and store
+// the coefficients in h. Each pass needs a single global reduction (through
+// global_sum) and a single update of w, instead of n of each with the modified
+// Gram-Schmidt process. The Vector c is used as a work array of size >= n.
+template <typename GlobalSumOp>
+inline void Orthogonalize(int n, Vector *const *v, Vector &w, double *h,
+                          Vector &c, GlobalSumOp global_sum)
+{
+   for (int k = 0; k < n; k++) { h[k] = 0.0; }
+   for (int pass = 0; pass < 2; pass++)
+   {
+      MultiDot(n, v, w, c.GetData());
+      global_sum(c.GetData(), n);
+      for (int k = 0; k < n; k++)
+      {
+         h[k] += c(k);
+         c(k) = -c(k);
+      }
+      MultiAdd(n, c.GetData(), v, w);  // w -= sum_k c_k v[k]
+   }
+}
+
 inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
                    Array<Vector*> &v)
 {
@@ -962,21 +1521,20 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
       }
    }
 
-   for (int j = 0; j <= k; j++)
-   {
-      x.Add(y(j), *v[j]);
-   }
+   MultiAdd(k+1, y.GetData(), v.GetData(), x);
 }
 
 void GMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    // Generalized Minimum Residual method following the algorithm
    // on p. 20 of the SIAM Templates book.
 
    int n = width;
 
    DenseMatrix H(m+1, m);
-   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector s(m+1), cs(m+1), sn(m+1), c(m+1);
    Vector r(n), w(n);
    Array<Vector *> v;
 
@@ -1058,11 +1616,9 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
             oper->Mult(*v[i], w);
          }
 
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
-         }
+         // H(k,i) = w * v[k], w -= H(k,i) * v[k], k = 0, ..., i
+         Orthogonalize(i+1, v.GetData(), w, &H(0,i), c,
+                       [this](double *v, int n) { GlobalSum(v, n); });
 
          H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
          MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
@@ -1158,8 +1714,10 @@ finish:
 
 void FGMRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    DenseMatrix H(m+1,m);
-   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector s(m+1), cs(m+1), sn(m+1), c(m+1);
    Vector r(b.Size());
 
    int i, j, k;
@@ -1233,11 +1791,9 @@ void FGMRESSolver::Mult(const Vector &b, Vector &x) const
          }
          oper->Mult(*z[i], r);
 
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
-            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
-         }
+         // H(k,i) = r * v[k], r -= H(k,i) * v[k], k = 0, ..., i
+         Orthogonalize(i+1, v.GetData(), r, &H(0,i), c,
+                       [this](double *v, int n) { GlobalSum(v, n); });
 
          H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
          if (v[i+1] == NULL) { v[i+1] = new Vector(b.Size()); }
@@ -1372,12 +1928,15 @@ void BiCGSTABSolver::UpdateVectors()
 
 void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    // BiConjugate Gradient Stabilized method following the algorithm
    // on p. 27 of the SIAM Templates book.
 
    int i;
    double resid, tol_goal;
    double rho_1, rho_2=1.0, alpha=1.0, beta, omega=1.0;
+   double dots[2];
 
    if (iterative_mode)
    {
@@ -1392,6 +1951,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
    rtilde = r;
 
    resid = Norm(r);
+   rho_1 = resid*resid;
    MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
    if (print_options.iterations || print_options.first_and_last)
    {
@@ -1413,7 +1973,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
 
    for (i = 1; i <= max_iter; i++)
    {
-      rho_1 = Dot(rtilde, r);
+      // rho_1 = (rtilde, r) is computed with the norm of r
       if (rho_1 == 0)
       {
          if (print_options.iterations || print_options.first_and_last)
@@ -1457,8 +2017,10 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       }
       oper->Mult(phat, v);     //  v = A * phat
       alpha = rho_1 / Dot(rtilde, v);
-      add(r, -alpha, v, s); //  s = r - alpha * v
-      resid = Norm(s);
+      //  s = r - alpha * v and (s, s) in one pass
+      resid = AXPBYDot(1.0, r, -alpha, v, s, s);
+      GlobalSum(&resid, 1);
+      resid = sqrt(resid);
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (resid < tol_goal)
       {
@@ -1492,13 +2054,21 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
          shat = s;
       }
       oper->Mult(shat, t);     //  t = A * shat
-      omega = Dot(t, s) / Dot(t, t);
-      x.Add(alpha, phat);   //  x += alpha * phat
-      x.Add(omega, shat);   //  x += omega * shat
-      add(s, -omega, t, r); //  r = s - omega * t
+      const Vector *st[2] = { &s, &t };
+      MultiDot(2, st, t, dots);
+      GlobalSum(dots, 2);
+      omega = dots[0] / dots[1];  //  omega = (t, s) / (t, t)
+      const double xc[2] = { alpha, omega };
+      const Vector *xv[2] = { &phat, &shat };
+      MultiAdd(2, xc, xv, x);     //  x += alpha * phat + omega * shat
+      add(s, -omega, t, r);       //  r = s - omega * t
 
       rho_2 = rho_1;
-      resid = Norm(r);
+      const Vector *rr[2] = { &r, &rtilde };
+      MultiDot(2, rr, r, dots);
+      GlobalSum(dots, 2);
+      resid = sqrt(dots[0]);
+      rho_1 = dots[1];            //  rho_1 = (rtilde, r) for the next iteration
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
       if (print_options.iterations)
       {
@@ -1601,6 +2171,8 @@ void MINRESSolver::SetOperator(const Operator &op)
 
 void MINRESSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    // Based on the MINRES algorithm on p. 86, Fig. 6.9 in
    // "Iterative Krylov Methods for Large Linear Systems",
    // by Henk A. van der Vorst, 2003.
@@ -1803,6 +2375,8 @@ void NewtonSolver::SetOperator(const Operator &op)
 
 void NewtonSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
    MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
 
@@ -1991,6 +2565,8 @@ void NewtonSolver::AdaptiveLinRtolPostSolve(const Vector &x,
 
 void LBFGSSolver::Mult(const Vector &b, Vector &x) const
 {
+   MFEM_PERF_FUNCTION;
+
    MFEM_VERIFY(oper != NULL, "the Operator is not set (use SetOperator).");
 
    // Quadrature points that are checked for negative Jacobians etc.
@@ -2922,11 +3498,18 @@ void BlockILU::Factorize()
    int nblockrows = Height()/block_size;
 
    // Precompute LU factorization of diagonal blocks
+#ifdef MFEM_USE_LAPACK
+   // LUFactors uses the LAPACK (1-based) pivot convention in this case
    for (int i=0; i<nblockrows; ++i)
    {
       LUFactors factorization(DB.GetData(i), &ipiv[i*block_size]);
       factorization.Factor(block_size);
    }
+#else
+   BatchLUFactor(DB, ipiv);
+   DB.HostReadWrite();
+   ipiv.HostReadWrite();
+#endif
 
    // Note: we use UseExternalData to extract submatrices from the tensor AB
    // instead of the DenseTensor call operator, because the call operator does
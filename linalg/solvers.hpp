@@ -169,6 +169,10 @@ protected:
 
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
+   /** @brief Sum the @a n local values @a v over the MPI ranks, in place, as
+       Dot() does for one inner product. Used with the fused vector operations
+       to perform several inner products with a single reduction. */
+   void GlobalSum(double *v, int n) const;
    void Monitor(int it, double norm, const Vector& r, const Vector& x,
                 bool final=false) const;
 
@@ -310,6 +314,13 @@ public:
    /// Replace diagonal entries with their absolute values.
    void SetPositiveDiagonal(bool pos_diag = true) { use_abs_diag = pos_diag; }
 
+   /** @brief Store the inverse of the diagonal in single precision, halving
+       its memory traffic. */
+   /** The smoother is then accurate to about 1e-7 relative, which is enough
+       when it is used as a preconditioner in a double precision Krylov solver.
+       See also NonlinearFormIntegrator::SetPASinglePrecision(). */
+   void SetSinglePrecision(bool single = true);
+
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const { Mult(x, y); }
 
@@ -328,11 +339,14 @@ public:
 
 private:
    Vector dinv;
+   Array<float> dinv_sp; // dinv in single precision, see SetSinglePrecision()
    const double damping;
    const Array<int> *ess_tdof_list; // not owned; may be NULL
    mutable Vector residual;
    /// Uses absolute values of the diagonal entries.
    bool use_abs_diag = false;
+   /// Store the inverse diagonal in single precision.
+   bool single = false;
 
    const Operator *oper; // not owned
 
@@ -413,6 +427,10 @@ public:
       oper = &op_;
    }
 
+   /** @brief Store the inverse of the diagonal in single precision, see
+       OperatorJacobiSmoother::SetSinglePrecision(). */
+   void SetSinglePrecision(bool single = true);
+
    void Setup();
 
 private:
@@ -420,6 +438,8 @@ private:
    double max_eig_estimate;
    const int N;
    Vector dinv;
+   Array<float> dinv_sp; // dinv in single precision, see SetSinglePrecision()
+   bool single = false;
    const Vector &diag;
    Array<double> coeffs;
    const Array<int>& ess_tdof_list;
@@ -493,6 +513,82 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
          double RTOLERANCE = 1e-12, double ATOLERANCE = 1e-24);
 
 
+/// Pipelined conjugate gradient method
+/** Preconditioned variant of the conjugate gradient method of Ghysels and
+    Vanroose, Parallel Computing 40 (2014), where the two global reductions of
+    each iteration are combined into one, which is overlapped (using
+    MPI_Iallreduce) with the application of the preconditioner and of the
+    operator. In exact arithmetic the iterates are the same as in CGSolver. The
+    additional recurrences require 6 more vectors and the accumulation of
+    rounding errors may increase the number of iterations slightly. The
+    convergence criterion (B r, r) is the same as in CGSolver. */
+class PipelinedCGSolver : public CGSolver
+{
+protected:
+   mutable Vector u, w, m, n, s, q;
+
+public:
+   PipelinedCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   PipelinedCGSolver(MPI_Comm comm_) : CGSolver(comm_) { }
+#endif
+
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
+/// s-step (communication-avoiding) conjugate gradient method
+/** Each outer iteration builds a basis of s Krylov vectors of the
+    preconditioned operator B A, makes it A-conjugate to the previous block and
+    performs s steps of the conjugate gradient method at once, see Chronopoulos
+    and Gear, J. Comput. Appl. Math. 25 (1989). All the inner products of an
+    outer iteration are combined into a single global reduction, instead of 2s
+    for CGSolver.
+
+    To limit the growth of the condition number of the basis with s, the basis
+    uses Chebyshev polynomials on [0, lmax], where lmax is an estimate of the
+    largest eigenvalue of B A computed with PowerMethod, unless set with
+    SetMaxEigenvalue(). The convergence criterion (B r, r) is the same as in
+    CGSolver, but it is checked once per outer iteration, so the number of
+    iterations is a multiple of s. */
+class SStepCGSolver : public CGSolver
+{
+protected:
+   int s;
+   mutable double lmax;
+   // The Krylov basis, the direction blocks and their products with the
+   // operator, with s vectors of size width each
+   mutable Vector R, AR, P, AP;
+
+   void UpdateBlocks();
+   void EstimateMaxEigenvalue() const;
+
+public:
+   SStepCGSolver(int s_ = 4) : s(s_), lmax(0.0) { }
+
+#ifdef MFEM_USE_MPI
+   SStepCGSolver(MPI_Comm comm_, int s_ = 4)
+      : CGSolver(comm_), s(s_), lmax(0.0) { }
+#endif
+
+   /// Set the number of steps s performed in each outer iteration.
+   void SetNumSteps(int s_);
+
+   /** @brief Set the estimate of the largest eigenvalue of B A used by the
+       Chebyshev basis. A value of 0 means that it is estimated in the next
+       call to Mult(). Since SetOperator() resets the estimate, this method
+       should be called after it. */
+   void SetMaxEigenvalue(double lmax_) { lmax = lmax_; }
+
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
 /// GMRES method
 class GMRESSolver : public IterativeSolver
 {
@@ -23,6 +23,10 @@
 #include <limits>
 #include <cstring>
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 #if defined(MFEM_USE_CUDA)
 #define MFEM_cu_or_hip(stub) cu##stub
 #define MFEM_Cu_or_Hip(stub) Cu##stub
@@ -162,6 +166,7 @@ SparseMatrix::SparseMatrix(int *i, int *j, double *data, int m, int n,
    else
    {
       const int nnz = I[height];
+      MemoryTraceScope trace_scope("SparseMatrix");
       A.New(nnz);
       for (int ii=0; ii<nnz; ++ii)
       {
@@ -183,6 +188,7 @@ SparseMatrix::SparseMatrix(int nrows, int ncols, int rowsize)
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
+   MemoryTraceScope trace_scope("SparseMatrix");
    I.New(nrows + 1);
    J.New(nrows * rowsize);
    A.New(nrows * rowsize);
@@ -199,6 +205,7 @@ SparseMatrix::SparseMatrix(const SparseMatrix &mat, bool copy_graph,
                            MemoryType mt)
    : AbstractSparseMatrix(mat.Height(), mat.Width())
 {
+   MemoryTraceScope trace_scope("SparseMatrix");
    if (mat.Finalized())
    {
       const int nnz = mat.I[height];
@@ -274,6 +281,7 @@ SparseMatrix::SparseMatrix(const Vector &v)
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
+   MemoryTraceScope trace_scope("SparseMatrix");
    I.New(height + 1);
    J.New(height);
    A.New(height);
@@ -331,12 +339,16 @@ void SparseMatrix::SetEmpty()
    ColPtrJ = NULL;
    ColPtrNode = NULL;
    At = NULL;
+   Sell = NULL;
 #ifdef MFEM_USE_MEMALLOC
    NodesMem = NULL;
 #endif
    isSorted = false;
 
    ClearGPUSparse();
+#ifdef MFEM_USE_OPENMP
+   ResetOmpRowPartition();
+#endif
 }
 
 int SparseMatrix::RowSize(const int i) const
@@ -675,6 +687,12 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
       return;
    }
 
+   if (Sell && !Device::Allows(Backend::DEVICE_MASK))
+   {
+      Sell->AddMult(x, y, a);
+      return;
+   }
+
 #ifndef MFEM_USE_LEGACY_OPENMP
    const int height = this->height;
    const int nnz = J.Capacity();
@@ -781,6 +799,14 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
 #endif // CUDA_VERSION >= 10010 || defined(MFEM_USE_HIP)
 #endif // MFEM_USE_CUDA_OR_HIP
    }
+#ifdef MFEM_USE_OPENMP
+   else if (Device::Allows(Backend::OMP_MASK) &&
+            !Device::Allows(Backend::DEVICE_MASK))
+   {
+      // Threaded host version with nnz-balanced row chunks
+      OmpAddMult(x, y, a);
+   }
+#endif
    else
    {
       // Native version
@@ -852,11 +878,18 @@ void SparseMatrix::AddMultTranspose(const Vector &x, Vector &y,
    {
       At->AddMult(x, y, a);
    }
+#ifdef MFEM_USE_OPENMP
+   else if (Device::Allows(Backend::OMP_MASK) &&
+            !Device::Allows(Backend::DEVICE_MASK))
+   {
+      OmpAddMultTranspose(x, y, a);
+   }
+#endif
    else
    {
-      MFEM_VERIFY(!Device::Allows(~Backend::CPU_MASK), "transpose action with "
-                  "this backend is not enabled; see EnsureMultTranspose() for "
-                  "details.");
+      MFEM_VERIFY(!Device::Allows(~(Backend::CPU_MASK | Backend::OMP_MASK)),
+                  "transpose action with this backend is not enabled; see "
+                  "EnsureMultTranspose() for details.");
       for (int i = 0; i < height; i++)
       {
          const double xi = a * x[i];
@@ -884,14 +917,179 @@ void SparseMatrix::ResetTranspose() const
    At = NULL;
 }
 
+void SparseMatrix::BuildSELL(int sigma) const
+{
+   MFEM_VERIFY(Finalized(), "the matrix must be finalized");
+   if (Sell == NULL)
+   {
+      Sell = new SELLMatrix(*this, sigma);
+   }
+}
+
+void SparseMatrix::ResetSELL() const
+{
+   delete Sell;
+   Sell = NULL;
+}
+
 void SparseMatrix::EnsureMultTranspose() const
 {
-   if (Device::Allows(~Backend::CPU_MASK))
+   if (Device::Allows(~(Backend::CPU_MASK | Backend::OMP_MASK)))
    {
       BuildTranspose();
    }
 }
 
+#ifdef MFEM_USE_OPENMP
+const Array<int> &SparseMatrix::GetOmpRowPartition() const
+{
+   const int *Ip = HostReadI(), *Jp = HostReadJ();
+   const int nnz = Ip[height];
+   const int nt = omp_get_max_threads();
+   if (omp_rows.Size() == nt+1 && omp_rows[nt] == height &&
+       omp_nnz == nnz && omp_width == width && omp_J == Jp)
+   {
+      return omp_rows;
+   }
+
+   // Balance the work w(i) = I[i] + i, i.e. the number of nonzeros plus the
+   // number of rows, which accounts for the cost of the empty rows.
+   omp_rows.SetSize(nt+1);
+   omp_rows[0] = 0;
+   for (int c = 1; c < nt; c++)
+   {
+      const long long target = ((long long)(nnz + height)*c)/nt;
+      int lo = omp_rows[c-1], hi = height;
+      while (lo < hi)
+      {
+         const int mid = lo + (hi - lo)/2;
+         if ((long long)Ip[mid] + mid < target) { lo = mid + 1; }
+         else { hi = mid; }
+      }
+      omp_rows[c] = lo;
+   }
+   omp_rows[nt] = height;
+
+   // Column range of each chunk: the size of the transpose accumulators
+   omp_cols.SetSize(2*nt);
+   const int *rows = omp_rows.GetData();
+   int *cols = omp_cols.GetData();
+   #pragma omp parallel for
+   for (int c = 0; c < nt; c++)
+   {
+      int cmin = width, cmax = -1;
+      for (int j = Ip[rows[c]]; j < Ip[rows[c+1]]; j++)
+      {
+         cmin = std::min(cmin, Jp[j]);
+         cmax = std::max(cmax, Jp[j]);
+      }
+      cols[2*c] = (cmax < 0) ? 0 : cmin;
+      cols[2*c+1] = cmax + 1;
+   }
+   omp_nnz = nnz;
+   omp_width = width;
+   omp_J = Jp;
+   return omp_rows;
+}
+
+void SparseMatrix::ResetOmpRowPartition()
+{
+   omp_rows.DeleteAll();
+   omp_cols.DeleteAll();
+   omp_J = NULL;
+   omp_nnz = omp_width = -1;
+}
+
+void SparseMatrix::OmpAddMult(const Vector &x, Vector &y, const double a) const
+{
+   const Array<int> &rows = GetOmpRowPartition();
+   const int nt = rows.Size()-1;
+   const int *Ip = HostReadI(), *Jp = HostReadJ(), *rp = rows.GetData();
+   const double *Ap = HostReadData(), *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+
+   #pragma omp parallel
+   {
+      const int nthr = omp_get_num_threads(), tid = omp_get_thread_num();
+      for (int c = tid; c < nt; c += nthr)
+      {
+         for (int i = rp[c]; i < rp[c+1]; i++)
+         {
+            double d = 0.0;
+            const int end = Ip[i+1];
+            for (int j = Ip[i]; j < end; j++)
+            {
+               d += Ap[j] * xp[Jp[j]];
+            }
+            yp[i] += a * d;
+         }
+      }
+   }
+}
+
+void SparseMatrix::OmpAddMultTranspose(const Vector &x, Vector &y,
+                                       const double a) const
+{
+   const Array<int> &rows = GetOmpRowPartition();
+   const int nt = rows.Size()-1;
+   const int *Ip = HostReadI(), *Jp = HostReadJ(), *rp = rows.GetData();
+   const int *cols = omp_cols.GetData();
+   const double *Ap = HostReadData(), *xp = x.HostRead();
+   double *yp = y.HostReadWrite();
+
+   // Each chunk accumulates into a buffer covering only the columns it
+   // references, in the ForallScratch memory of the thread processing it; the
+   // buffers are then summed, column by column, into y.
+   Array<double*> work(nt);
+   double **wp = work.GetData();
+   const int width = this->width;
+
+   #pragma omp parallel
+   {
+      const int nthr = omp_get_num_threads(), tid = omp_get_thread_num();
+      std::size_t size = 0;
+      for (int c = tid; c < nt; c += nthr)
+      {
+         size += std::max(cols[2*c+1] - cols[2*c], 0);
+      }
+      double *buf = ForallScratch::Get(size);
+      for (int c = tid; c < nt; c += nthr)
+      {
+         const int nc = std::max(cols[2*c+1] - cols[2*c], 0);
+         for (int k = 0; k < nc; k++) { buf[k] = 0.0; }
+         double *w = buf - cols[2*c];
+         wp[c] = w;
+         buf += nc;
+         for (int i = rp[c]; i < rp[c+1]; i++)
+         {
+            const double xi = a * xp[i];
+            const int end = Ip[i+1];
+            for (int j = Ip[i]; j < end; j++)
+            {
+               w[Jp[j]] += Ap[j] * xi;
+            }
+         }
+      }
+      #pragma omp barrier
+
+      // Each thread reduces a contiguous block of columns, always adding the
+      // chunk contributions in the same order, so the result is deterministic.
+      const int k0 = (int)(((long long)width*tid)/nthr);
+      const int k1 = (int)(((long long)width*(tid+1))/nthr);
+      for (int c = 0; c < nt; c++)
+      {
+         const double *w = wp[c];
+         const int kb = std::max(k0, cols[2*c]);
+         const int ke = std::min(k1, cols[2*c+1]);
+         for (int k = kb; k < ke; k++)
+         {
+            yp[k] += w[k];
+         }
+      }
+   }
+}
+#endif // MFEM_USE_OPENMP
+
 void SparseMatrix::PartMult(
    const Array<int> &rows, const Vector &x, Vector &y) const
 {
@@ -1069,9 +1267,9 @@ void SparseMatrix::AbsMultTranspose(const Vector &x, Vector &y) const
    }
    else
    {
-      MFEM_VERIFY(!Device::Allows(~Backend::CPU_MASK), "transpose action with "
-                  "this backend is not enabled; see EnsureMultTranspose() for "
-                  "details.");
+      MFEM_VERIFY(!Device::Allows(~(Backend::CPU_MASK | Backend::OMP_MASK)),
+                  "transpose action with this backend is not enabled; see "
+                  "EnsureMultTranspose() for details.");
       for (int i = 0; i < height; i++)
       {
          const double xi = x[i];
@@ -1247,6 +1445,7 @@ void SparseMatrix::Finalize(int skip_zeros, bool fix_empty_rows)
    delete [] ColPtrNode;
    ColPtrNode = NULL;
 
+   MemoryTraceScope trace_scope("SparseMatrix");
    I.New(height+1);
    I[0] = 0;
    for (i = 1; i <= height; i++)
@@ -1402,6 +1601,7 @@ void SparseMatrix::GetBlocks(Array2D<SparseMatrix *> &blocks) const
          {
             rs = b.I[k], b.I[k] = nnz, nnz += rs;
          }
+         MemoryTraceScope trace_scope("SparseMatrix");
          b.J.New(nnz);
          b.A.New(nnz);
       }
@@ -3330,8 +3530,12 @@ void SparseMatrix::Destroy()
    delete NodesMem;
 #endif
    delete At;
+   delete Sell;
 
    ClearGPUSparse();
+#ifdef MFEM_USE_OPENMP
+   ResetOmpRowPartition();
+#endif
 }
 
 int SparseMatrix::ActualWidth() const
@@ -4059,6 +4263,12 @@ void SparseMatrix::Swap(SparseMatrix &other)
    mfem::Swap(ColPtrJ, other.ColPtrJ);
    mfem::Swap(ColPtrNode, other.ColPtrNode);
    mfem::Swap(At, other.At);
+   mfem::Swap(Sell, other.Sell);
+
+#ifdef MFEM_USE_OPENMP
+   ResetOmpRowPartition();
+   other.ResetOmpRowPartition();
+#endif
 
 #ifdef MFEM_USE_MEMALLOC
    mfem::Swap(NodesMem, other.NodesMem);
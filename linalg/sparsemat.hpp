@@ -21,6 +21,7 @@
 #include "../general/table.hpp"
 #include "../general/globals.hpp"
 #include "densemat.hpp"
+#include "sellmat.hpp"
 
 #if defined(MFEM_USE_HIP)
 #include <hipsparse.h>
@@ -75,6 +76,9 @@ protected:
    /// Transpose of A. Owned. Used to perform MultTranspose() on devices.
    mutable SparseMatrix *At;
 
+   /// SELL-C-sigma copy of A. Owned. Used to perform Mult() on the host.
+   mutable SELLMatrix *Sell = NULL;
+
 #ifdef MFEM_USE_MEMALLOC
    typedef MemAlloc <RowNode, 1024> RowNodeAlloc;
    RowNodeAlloc * NodesMem;
@@ -91,6 +95,37 @@ protected:
    // Initialize cuSPARSE/hipSPARSE
    void InitGPUSparse();
 
+#ifdef MFEM_USE_OPENMP
+   /// @name Data used by the threaded host kernels of the OpenMP backend.
+   /** These are built on demand by GetOmpRowPartition() and rebuilt when the
+       number of threads or the sparsity pattern changes. They are discarded
+       when #I and #J are released or swapped, see ResetOmpRowPartition(). The
+       threaded AddMultTranspose() accumulates in ForallScratch memory. */
+   ///@{
+   /// Row offsets of the nnz-balanced row chunks, one chunk per thread.
+   mutable Array<int> omp_rows;
+   /** @brief Column range [omp_cols[2*c], omp_cols[2*c+1]) referenced by the
+       rows in chunk c. */
+   mutable Array<int> omp_cols;
+   /// The #J host pointer, nnz and width for which the partition was computed.
+   mutable const int *omp_J = NULL;
+   mutable int omp_nnz = -1, omp_width = -1;
+   ///@}
+
+   /// Return the row offsets #omp_rows, (re)computing them if necessary.
+   const Array<int> &GetOmpRowPartition() const;
+
+   /// Discard the row partition, e.g. when #I or #J are released or replaced.
+   void ResetOmpRowPartition();
+
+   /// Threaded host version of AddMult() used with the OpenMP backend.
+   void OmpAddMult(const Vector &x, Vector &y, const double a) const;
+
+   /** @brief Threaded host version of AddMultTranspose() used with the OpenMP
+       backend. It does not require the internal transpose matrix. */
+   void OmpAddMultTranspose(const Vector &x, Vector &y, const double a) const;
+#endif
+
 #ifdef MFEM_USE_CUDA_OR_HIP
    // common for hipSPARSE and cuSPARSE
    static int SparseMatrixCount;
@@ -366,12 +401,15 @@ public:
        call to this method. If the internal transpose is already built, this
        method has no effect.
 
-       When any non-serial-CPU backend is enabled, i.e. the call
-       Device::Allows(~ Backend::CPU_MASK) returns true, the above methods
-       require the internal transpose to be built. If that is not the case (i.e.
-       the internal transpose is not built), these methods will raise an error
-       with an appropriate message pointing to EnsureMultTranspose(). When using
-       any backend from Backend::CPU_MASK, calling this method is optional.
+       When any non-host backend is enabled, i.e. the call
+       Device::Allows(~(Backend::CPU_MASK | Backend::OMP_MASK)) returns true,
+       the above methods require the internal transpose to be built. If that is
+       not the case (i.e. the internal transpose is not built), these methods
+       will raise an error with an appropriate message pointing to
+       EnsureMultTranspose(). When using any backend from Backend::CPU_MASK or
+       Backend::OMP_MASK, calling this method is optional; with the OpenMP
+       backends the transpose action is computed with a threaded kernel that
+       does not need the transpose matrix.
 
        This method can only be used when the sparse matrix is finalized.
 
@@ -384,16 +422,37 @@ public:
 
    /** @brief Ensures that the matrix is capable of performing MultTranspose(),
        AddMultTranspose(), and AbsMultTranspose(). */
-   /** For non-serial-CPU backends (e.g. GPU, OpenMP), multiplying by the
-       transpose requires that the internal transpose matrix be already built.
-       When such a backend is enabled, this function will build the internal
-       transpose matrix, see BuildTranspose().
-
-       For the serial CPU backends, the internal transpose is not required, and
-       this function is a no-op. This allows for significant memory savings
-       when the internal transpose matrix is not required. */
+   /** For device backends (e.g. CUDA, HIP), multiplying by the transpose
+       requires that the internal transpose matrix be already built. When such
+       a backend is enabled, this function will build the internal transpose
+       matrix, see BuildTranspose().
+
+       For the serial CPU and the OpenMP backends, the internal transpose is
+       not required, and this function is a no-op. This allows for significant
+       memory savings when the internal transpose matrix is not required. */
    void EnsureMultTranspose() const;
 
+   /** @brief Build and store internally a SELL-C-sigma copy of this matrix,
+       see SELLMatrix, which will be used in the methods Mult() and AddMult()
+       on the host. */
+   /** The SELL-C-sigma storage pads the rows in chunks of SELLMatrix::C rows so
+       that the inner loop of the product is vectorized across rows. Sorting
+       the rows by length within windows of @a sigma rows reduces the padding.
+
+       Warning: any changes in this matrix will invalidate the internal copy.
+       To rebuild it, call ResetSELL() followed by a call to this method. If the
+       internal copy is already built, this method has no effect. The copy is
+       not used when a device backend is enabled.
+
+       This method can only be used when the sparse matrix is finalized. */
+   void BuildSELL(int sigma = 1) const;
+
+   /// Reset (destroy) the internal SELL-C-sigma copy, see BuildSELL().
+   void ResetSELL() const;
+
+   /// Return the internal SELL-C-sigma copy, or NULL if it is not built.
+   const SELLMatrix *GetSELL() const { return Sell; }
+
    void PartMult(const Array<int> &rows, const Vector &x, Vector &y) const;
    void PartAddMult(const Array<int> &rows, const Vector &x, Vector &y,
                     const double a=1.0) const;
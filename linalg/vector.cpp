@@ -43,6 +43,7 @@ Vector::Vector(const Vector &v)
    if (s > 0)
    {
       MFEM_ASSERT(!v.data.Empty(), "invalid source vector");
+      MemoryTraceScope trace_scope("Vector");
       data.New(s, v.data.GetMemoryType());
       data.CopyFrom(v.data, s);
    }
@@ -917,6 +918,15 @@ double Vector::Sum() const
    return sum;
 }
 
+#if defined(MFEM_USE_CUDA) || defined(MFEM_USE_HIP)
+// Maximum number of inner products computed by one launch of the MultiDot
+// device kernels
+#define MFEM_MULTI_DOT_MAX 8
+
+// Device pointers of the vectors of one launch of the MultiDot device kernels
+static Array<const double*> multi_dot_ptrs;
+#endif
+
 #ifdef MFEM_USE_CUDA
 static __global__ void cuKernelMin(const int N, double *gdsr, const double *x)
 {
@@ -1004,6 +1014,102 @@ static double cuVectorDot(const int N, const double *X, const double *Y)
    for (int i = 0; i < dot_sz; i++) { dot += h_dot[i]; }
    return dot;
 }
+
+static __global__ void cuKernelAXPBYDot(const int N, double *gdsr,
+                                        const double a, const double *x,
+                                        const double b, const double *y,
+                                        double *z, const double *w)
+{
+   __shared__ double s_dot[MFEM_CUDA_BLOCKS];
+   const int n = blockDim.x*blockIdx.x + threadIdx.x;
+   const int tid = threadIdx.x;
+   double dot = 0.0;
+   if (n < N)
+   {
+      const double zn = a*x[n] + b*y[n];
+      z[n] = zn;
+      dot = zn * w[n];
+   }
+   s_dot[tid] = dot;
+   for (int workers=blockDim.x>>1; workers>0; workers>>=1)
+   {
+      __syncthreads();
+      if (tid < workers) { s_dot[tid] += s_dot[tid + workers]; }
+   }
+   if (tid==0) { gdsr[blockIdx.x] = s_dot[0]; }
+}
+
+static double cuVectorAXPBYDot(const int N, const double a, const double *X,
+                               const double b, const double *Y, double *Z,
+                               const double *W)
+{
+   const int blockSize = MFEM_CUDA_BLOCKS;
+   const int gridSize = (N+blockSize-1)/blockSize;
+   cuda_reduce_buf.SetSize(gridSize, Device::GetDeviceMemoryType());
+   Memory<double> &buf = cuda_reduce_buf.GetMemory();
+   double *d_dot = buf.Write(MemoryClass::DEVICE, gridSize);
+   cuKernelAXPBYDot<<<gridSize,blockSize>>>(N, d_dot, a, X, b, Y, Z, W);
+   MFEM_GPU_CHECK(cudaGetLastError());
+   const double *h_dot = buf.Read(MemoryClass::HOST, gridSize);
+   double dot = 0.0;
+   for (int i = 0; i < gridSize; i++) { dot += h_dot[i]; }
+   return dot;
+}
+
+static __global__ void cuKernelMultiDot(const int N, const int nv,
+                                        double *gdsr,
+                                        const double * const *v,
+                                        const double *w)
+{
+   __shared__ double s_dot[MFEM_MULTI_DOT_MAX*MFEM_CUDA_BLOCKS];
+   const int n = blockDim.x*blockIdx.x + threadIdx.x;
+   const int tid = threadIdx.x;
+   const int bd = blockDim.x;
+   const double wn = (n < N) ? w[n] : 0.0;
+   for (int k = 0; k < nv; k++)
+   {
+      s_dot[k*bd + tid] = (n < N) ? v[k][n] * wn : 0.0;
+   }
+   for (int workers=bd>>1; workers>0; workers>>=1)
+   {
+      __syncthreads();
+      if (tid >= workers) { continue; }
+      for (int k = 0; k < nv; k++)
+      {
+         s_dot[k*bd + tid] += s_dot[k*bd + tid + workers];
+      }
+   }
+   if (tid < nv) { gdsr[tid*gridDim.x + blockIdx.x] = s_dot[tid*bd]; }
+}
+
+static void cuVectorMultiDot(const int N, const int nv,
+                             const Vector *const *v, const Vector &w,
+                             double *dots)
+{
+   const int blockSize = MFEM_CUDA_BLOCKS;
+   const int gridSize = (N+blockSize-1)/blockSize;
+   const double *W = w.Read();
+   for (int k0 = 0; k0 < nv; k0 += MFEM_MULTI_DOT_MAX)
+   {
+      const int nk = std::min(MFEM_MULTI_DOT_MAX, nv - k0);
+      multi_dot_ptrs.SetSize(nk);
+      const double **h_ptr = multi_dot_ptrs.HostWrite();
+      for (int k = 0; k < nk; k++) { h_ptr[k] = v[k0+k]->Read(); }
+      const double * const *d_ptr = multi_dot_ptrs.Read();
+      cuda_reduce_buf.SetSize(nk*gridSize, Device::GetDeviceMemoryType());
+      Memory<double> &buf = cuda_reduce_buf.GetMemory();
+      double *d_dot = buf.Write(MemoryClass::DEVICE, nk*gridSize);
+      cuKernelMultiDot<<<gridSize,blockSize>>>(N, nk, d_dot, d_ptr, W);
+      MFEM_GPU_CHECK(cudaGetLastError());
+      const double *h_dot = buf.Read(MemoryClass::HOST, nk*gridSize);
+      for (int k = 0; k < nk; k++)
+      {
+         double dot = 0.0;
+         for (int i = 0; i < gridSize; i++) { dot += h_dot[k*gridSize + i]; }
+         dots[k0+k] = dot;
+      }
+   }
+}
 #endif // MFEM_USE_CUDA
 
 #ifdef MFEM_USE_HIP
@@ -1093,6 +1199,104 @@ static double hipVectorDot(const int N, const double *X, const double *Y)
    for (int i = 0; i < dot_sz; i++) { dot += h_dot[i]; }
    return dot;
 }
+
+static __global__ void hipKernelAXPBYDot(const int N, double *gdsr,
+                                         const double a, const double *x,
+                                         const double b, const double *y,
+                                         double *z, const double *w)
+{
+   __shared__ double s_dot[MFEM_HIP_BLOCKS];
+   const int n = hipBlockDim_x*hipBlockIdx_x + hipThreadIdx_x;
+   const int tid = hipThreadIdx_x;
+   double dot = 0.0;
+   if (n < N)
+   {
+      const double zn = a*x[n] + b*y[n];
+      z[n] = zn;
+      dot = zn * w[n];
+   }
+   s_dot[tid] = dot;
+   for (int workers=hipBlockDim_x>>1; workers>0; workers>>=1)
+   {
+      __syncthreads();
+      if (tid < workers) { s_dot[tid] += s_dot[tid + workers]; }
+   }
+   if (tid==0) { gdsr[hipBlockIdx_x] = s_dot[0]; }
+}
+
+static double hipVectorAXPBYDot(const int N, const double a, const double *X,
+                                const double b, const double *Y, double *Z,
+                                const double *W)
+{
+   const int blockSize = MFEM_HIP_BLOCKS;
+   const int gridSize = (N+blockSize-1)/blockSize;
+   cuda_reduce_buf.SetSize(gridSize);
+   Memory<double> &buf = cuda_reduce_buf.GetMemory();
+   double *d_dot = buf.Write(MemoryClass::DEVICE, gridSize);
+   hipLaunchKernelGGL(hipKernelAXPBYDot,gridSize,blockSize,0,0,
+                      N,d_dot,a,X,b,Y,Z,W);
+   MFEM_GPU_CHECK(hipGetLastError());
+   const double *h_dot = buf.Read(MemoryClass::HOST, gridSize);
+   double dot = 0.0;
+   for (int i = 0; i < gridSize; i++) { dot += h_dot[i]; }
+   return dot;
+}
+
+static __global__ void hipKernelMultiDot(const int N, const int nv,
+                                         double *gdsr,
+                                         const double * const *v,
+                                         const double *w)
+{
+   __shared__ double s_dot[MFEM_MULTI_DOT_MAX*MFEM_HIP_BLOCKS];
+   const int n = hipBlockDim_x*hipBlockIdx_x + hipThreadIdx_x;
+   const int tid = hipThreadIdx_x;
+   const int bd = hipBlockDim_x;
+   const double wn = (n < N) ? w[n] : 0.0;
+   for (int k = 0; k < nv; k++)
+   {
+      s_dot[k*bd + tid] = (n < N) ? v[k][n] * wn : 0.0;
+   }
+   for (int workers=bd>>1; workers>0; workers>>=1)
+   {
+      __syncthreads();
+      if (tid >= workers) { continue; }
+      for (int k = 0; k < nv; k++)
+      {
+         s_dot[k*bd + tid] += s_dot[k*bd + tid + workers];
+      }
+   }
+   if (tid < nv) { gdsr[tid*hipGridDim_x + hipBlockIdx_x] = s_dot[tid*bd]; }
+}
+
+static void hipVectorMultiDot(const int N, const int nv,
+                              const Vector *const *v, const Vector &w,
+                              double *dots)
+{
+   const int blockSize = MFEM_HIP_BLOCKS;
+   const int gridSize = (N+blockSize-1)/blockSize;
+   const double *W = w.Read();
+   for (int k0 = 0; k0 < nv; k0 += MFEM_MULTI_DOT_MAX)
+   {
+      const int nk = std::min(MFEM_MULTI_DOT_MAX, nv - k0);
+      multi_dot_ptrs.SetSize(nk);
+      const double **h_ptr = multi_dot_ptrs.HostWrite();
+      for (int k = 0; k < nk; k++) { h_ptr[k] = v[k0+k]->Read(); }
+      const double * const *d_ptr = multi_dot_ptrs.Read();
+      cuda_reduce_buf.SetSize(nk*gridSize);
+      Memory<double> &buf = cuda_reduce_buf.GetMemory();
+      double *d_dot = buf.Write(MemoryClass::DEVICE, nk*gridSize);
+      hipLaunchKernelGGL(hipKernelMultiDot,gridSize,blockSize,0,0,
+                         N,nk,d_dot,d_ptr,W);
+      MFEM_GPU_CHECK(hipGetLastError());
+      const double *h_dot = buf.Read(MemoryClass::HOST, nk*gridSize);
+      for (int k = 0; k < nk; k++)
+      {
+         double dot = 0.0;
+         for (int i = 0; i < gridSize; i++) { dot += h_dot[k*gridSize + i]; }
+         dots[k0+k] = dot;
+      }
+   }
+}
 #endif // MFEM_USE_HIP
 
 double Vector::operator*(const Vector &v) const
@@ -1254,6 +1458,162 @@ vector_min_cpu:
    return minimum;
 }
 
+// Size of the chunks processed by the host versions of MultiDot and MultiAdd,
+// so that the chunk of the common Vector stays in cache
+static constexpr int multi_chunk = 512;
+
+// Vector pointers and coefficients of MultiDot and MultiAdd, kept between the
+// calls so that the Krylov iterations do not allocate them every time
+static Array<const double*> multi_ptrs;
+static Vector multi_coeffs;
+
+double AXPBYDot(const double a, const Vector &x, const double b,
+                const Vector &y, Vector &z, const Vector &w)
+{
+   MFEM_ASSERT(x.Size() == z.Size() && y.Size() == z.Size() &&
+               w.Size() == z.Size(), "incompatible Vectors!");
+   const int N = z.Size();
+   if (N == 0) { return 0.0; }
+
+   const bool use_dev = x.UseDevice() || y.UseDevice() || z.UseDevice() ||
+                        w.UseDevice();
+   if (use_dev)
+   {
+#ifdef MFEM_USE_CUDA
+      if (Device::Allows(Backend::CUDA_MASK))
+      {
+         // Note: get read access first, in case z is the same as x/y/w.
+         auto xd = x.Read(), yd = y.Read(), wd = w.Read();
+         auto zd = z.Write();
+         return cuVectorAXPBYDot(N, a, xd, b, yd, zd, wd);
+      }
+#endif
+#ifdef MFEM_USE_HIP
+      if (Device::Allows(Backend::HIP_MASK))
+      {
+         auto xd = x.Read(), yd = y.Read(), wd = w.Read();
+         auto zd = z.Write();
+         return hipVectorAXPBYDot(N, a, xd, b, yd, zd, wd);
+      }
+#endif
+      add(a, x, b, y, z);
+      return z * w;
+   }
+
+   auto xd = x.HostRead(), yd = y.HostRead(), wd = w.HostRead();
+   auto zd = z.HostWrite();
+   double dot = 0.0;
+   for (int i = 0; i < N; i++)
+   {
+      const double zi = a * xd[i] + b * yd[i];
+      zd[i] = zi;
+      dot += zi * wd[i];
+   }
+   return dot;
+}
+
+void MultiDot(const int n, const Vector *const *v, const Vector &w,
+              double *dots)
+{
+   const int N = w.Size();
+   bool use_dev = w.UseDevice();
+   for (int k = 0; k < n; k++)
+   {
+      MFEM_ASSERT(v[k]->Size() == N, "incompatible Vectors!");
+      use_dev = use_dev || v[k]->UseDevice();
+      dots[k] = 0.0;
+   }
+   if (n == 0 || N == 0) { return; }
+
+   if (use_dev)
+   {
+#ifdef MFEM_USE_CUDA
+      if (Device::Allows(Backend::CUDA_MASK))
+      {
+         cuVectorMultiDot(N, n, v, w, dots);
+         return;
+      }
+#endif
+#ifdef MFEM_USE_HIP
+      if (Device::Allows(Backend::HIP_MASK))
+      {
+         hipVectorMultiDot(N, n, v, w, dots);
+         return;
+      }
+#endif
+      for (int k = 0; k < n; k++) { dots[k] = (*v[k]) * w; }
+      return;
+   }
+
+   multi_ptrs.SetSize(n);
+   const double **vd = multi_ptrs.HostWrite();
+   for (int k = 0; k < n; k++) { vd[k] = v[k]->HostRead(); }
+   auto wd = w.HostRead();
+   for (int i0 = 0; i0 < N; i0 += multi_chunk)
+   {
+      const int i1 = std::min(i0 + multi_chunk, N);
+      for (int k = 0; k < n; k++)
+      {
+         const double *vk = vd[k];
+         double dot = 0.0;
+         for (int i = i0; i < i1; i++) { dot += vk[i] * wd[i]; }
+         dots[k] += dot;
+      }
+   }
+}
+
+void MultiAdd(const int n, const double *a, const Vector *const *v,
+              Vector &w)
+{
+   const int N = w.Size();
+   bool use_dev = w.UseDevice();
+   for (int k = 0; k < n; k++)
+   {
+      MFEM_ASSERT(v[k]->Size() == N, "incompatible Vectors!");
+      MFEM_ASSERT(v[k] != &w, "w must not be one of the v[k]");
+      use_dev = use_dev || v[k]->UseDevice();
+   }
+   if (n == 0 || N == 0) { return; }
+
+   if (use_dev)
+   {
+      multi_ptrs.SetSize(n);
+      multi_coeffs.SetSize(n);
+      multi_coeffs.UseDevice(true);
+      const double **h_ptrs = multi_ptrs.HostWrite();
+      double *h_coeffs = multi_coeffs.HostWrite();
+      for (int k = 0; k < n; k++)
+      {
+         h_ptrs[k] = v[k]->Read();
+         h_coeffs[k] = a[k];
+      }
+      auto vd = multi_ptrs.Read();
+      auto ad = multi_coeffs.Read();
+      auto wd = w.ReadWrite();
+      MFEM_FORALL(i, N,
+      {
+         double s = 0.0;
+         for (int k = 0; k < n; k++) { s += ad[k] * vd[k][i]; }
+         wd[i] += s;
+      });
+      return;
+   }
+
+   multi_ptrs.SetSize(n);
+   const double **vd = multi_ptrs.HostWrite();
+   for (int k = 0; k < n; k++) { vd[k] = v[k]->HostRead(); }
+   auto wd = w.HostReadWrite();
+   for (int i0 = 0; i0 < N; i0 += multi_chunk)
+   {
+      const int i1 = std::min(i0 + multi_chunk, N);
+      for (int k = 0; k < n; k++)
+      {
+         const double ak = a[k], *vk = vd[k];
+         for (int i = i0; i < i1; i++) { wd[i] += ak * vk[i]; }
+      }
+   }
+}
+
 
 #ifdef MFEM_USE_SUNDIALS
 
@@ -93,13 +93,19 @@ public:
       : data(base.data, base_offset, size_), size(size_) { }
 
    /// Create a Vector of size @a size_ using MemoryType @a mt.
-   Vector(int size_, MemoryType mt)
-      : data(size_, mt), size(size_) { }
+   Vector(int size_, MemoryType mt) : size(size_)
+   {
+      MemoryTraceScope trace_scope("Vector");
+      data.New(size_, mt);
+   }
 
    /** @brief Create a Vector of size @a size_ using host MemoryType @a h_mt and
        device MemoryType @a d_mt. */
-   Vector(int size_, MemoryType h_mt, MemoryType d_mt)
-      : data(size_, h_mt, d_mt), size(size_) { }
+   Vector(int size_, MemoryType h_mt, MemoryType d_mt) : size(size_)
+   {
+      MemoryTraceScope trace_scope("Vector");
+      data.New(size_, h_mt, d_mt);
+   }
 
    /// Create a vector using a braced initializer list
    template <int N>
@@ -517,6 +523,7 @@ inline Vector::Vector(int s)
    size = s;
    if (s > 0)
    {
+      MemoryTraceScope trace_scope("Vector");
       data.New(s);
    }
 }
@@ -537,6 +544,7 @@ inline void Vector::SetSize(int s)
    const bool use_dev = data.UseDevice();
    data.Delete();
    size = s;
+   MemoryTraceScope trace_scope("Vector");
    data.New(s, mt);
    data.UseDevice(use_dev);
 }
@@ -559,6 +567,7 @@ inline void Vector::SetSize(int s, MemoryType mt)
    data.Delete();
    if (s > 0)
    {
+      MemoryTraceScope trace_scope("Vector");
       data.New(s, mt);
       size = s;
    }
@@ -690,6 +699,33 @@ inline double InnerProduct(MPI_Comm comm, const Vector &x, const Vector &y)
 }
 #endif
 
+/** @name Fused vector operations
+
+    These functions combine vector updates and inner products that would
+    otherwise be performed in separate passes over the data, e.g. in the loops
+    of the Krylov solvers. As for the Vector inner product, the returned inner
+    products are local to the MPI rank. With the CUDA and HIP backends they are
+    computed by fused device kernels; with the other device backends they fall
+    back to the separate operations. */
+///@{
+
+/** @brief Set z = a x + b y and return the inner product (z, w), computed in
+    the same pass. The Vector @a z can be the same as @a x, @a y or @a w. */
+double AXPBYDot(const double a, const Vector &x, const double b,
+                const Vector &y, Vector &z, const Vector &w);
+
+/** @brief Compute the inner products dots[k] = (v[k], w), k = 0, ..., n-1, in
+    a single pass over @a w. */
+void MultiDot(const int n, const Vector *const *v, const Vector &w,
+              double *dots);
+
+/** @brief Set w = w + sum_k a[k] v[k], k = 0, ..., n-1, in a single pass over
+    @a w. The Vector @a w must not be one of the v[k]. */
+void MultiAdd(const int n, const double *a, const Vector *const *v,
+              Vector &w);
+
+///@}
+
 } // namespace mfem
 
 #endif
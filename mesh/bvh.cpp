@@ -0,0 +1,285 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bvh.hpp"
+#include "mesh_headers.hpp"
+#include "../fem/fem.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace mfem
+{
+
+ElementBVH::ElementBVH(Mesh &mesh_, int leaf_size)
+   : mesh(&mesh_),
+     sequence(-1),
+     sdim(mesh_.SpaceDimension()),
+     leaf_size(leaf_size),
+     curved_pad(0.05)
+{
+   MFEM_VERIFY(leaf_size > 0, "invalid leaf_size = " << leaf_size);
+   Rebuild();
+}
+
+void ElementBVH::ComputeElementBoxes()
+{
+   const int ne = mesh->GetNE();
+   const double inf = std::numeric_limits<double>::infinity();
+   elem_box.SetSize(2*sdim*ne);
+
+   const GridFunction *nodes = mesh->GetNodes();
+   const int order = nodes ? nodes->FESpace()->GetMaxElementOrder() : 1;
+   // Straight-sided elements are contained in the box of their vertices, the
+   // boxes of curved elements are sampled and enlarged
+   const int ref = (order > 1) ? order + 1 : 1;
+   const double pad = (order > 1) ? curved_pad : 1e-12;
+
+   Array<int> v;
+   DenseMatrix pointmat;
+   for (int i = 0; i < ne; i++)
+   {
+      double *box = elem_box.GetData() + 2*sdim*i;
+      for (int d = 0; d < sdim; d++)
+      {
+         box[d] = inf;
+         box[sdim + d] = -inf;
+      }
+      if (nodes == NULL)
+      {
+         mesh->GetElementVertices(i, v);
+         for (int j = 0; j < v.Size(); j++)
+         {
+            const double *x = mesh->GetVertex(v[j]);
+            for (int d = 0; d < sdim; d++)
+            {
+               box[d] = std::min(box[d], x[d]);
+               box[sdim + d] = std::max(box[sdim + d], x[d]);
+            }
+         }
+      }
+      else
+      {
+         RefinedGeometry *RefG =
+            GlobGeometryRefiner.Refine(mesh->GetElementBaseGeometry(i), ref);
+         mesh->GetElementTransformation(i)->Transform(RefG->RefPts, pointmat);
+         for (int j = 0; j < pointmat.Width(); j++)
+         {
+            for (int d = 0; d < sdim; d++)
+            {
+               box[d] = std::min(box[d], pointmat(d,j));
+               box[sdim + d] = std::max(box[sdim + d], pointmat(d,j));
+            }
+         }
+      }
+      // Enlarge the box in all the directions by a fraction of its largest
+      // extent, which also covers flat elements, e.g. surfaces in 3D
+      double size = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         size = std::max(size, box[sdim + d] - box[d]);
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         box[d] -= pad*size;
+         box[sdim + d] += pad*size;
+      }
+   }
+}
+
+int ElementBVH::BuildNode(int first, int size, const Vector &centers)
+{
+   const int n = nodes.Append(Node{-1, first, size}) - 1;
+   if (size <= leaf_size) { return n; }
+
+   // Split at the median of the centers, along the longest axis of their box
+   const double inf = std::numeric_limits<double>::infinity();
+   int axis = 0;
+   double max_extent = -inf;
+   for (int d = 0; d < sdim; d++)
+   {
+      double cmin = inf, cmax = -inf;
+      for (int j = first; j < first + size; j++)
+      {
+         const double c = centers(sdim*perm[j] + d);
+         cmin = std::min(cmin, c);
+         cmax = std::max(cmax, c);
+      }
+      if (cmax - cmin > max_extent) { max_extent = cmax - cmin; axis = d; }
+   }
+   const int half = size/2;
+   int *p = perm.GetData() + first;
+   std::nth_element(p, p + half, p + size, [&](int a, int b)
+   {
+      return centers(sdim*a + axis) < centers(sdim*b + axis);
+   });
+
+   BuildNode(first, half, centers);
+   const int right = BuildNode(first + half, size - half, centers);
+   nodes[n].right = right;
+   nodes[n].size = 0;
+   return n;
+}
+
+void ElementBVH::Refit()
+{
+   node_box.SetSize(2*sdim*nodes.Size());
+   // The children of a node follow it
+   for (int n = nodes.Size() - 1; n >= 0; n--)
+   {
+      double *box = node_box.GetData() + 2*sdim*n;
+      const Node &node = nodes[n];
+      if (node.size > 0)
+      {
+         const double *ebox = elem_box.GetData() + 2*sdim*perm[node.first];
+         std::copy(ebox, ebox + 2*sdim, box);
+         for (int j = node.first + 1; j < node.first + node.size; j++)
+         {
+            ebox = elem_box.GetData() + 2*sdim*perm[j];
+            for (int d = 0; d < sdim; d++)
+            {
+               box[d] = std::min(box[d], ebox[d]);
+               box[sdim + d] = std::max(box[sdim + d], ebox[sdim + d]);
+            }
+         }
+      }
+      else
+      {
+         const double *lbox = node_box.GetData() + 2*sdim*(n + 1);
+         const double *rbox = node_box.GetData() + 2*sdim*node.right;
+         for (int d = 0; d < sdim; d++)
+         {
+            box[d] = std::min(lbox[d], rbox[d]);
+            box[sdim + d] = std::max(lbox[sdim + d], rbox[sdim + d]);
+         }
+      }
+   }
+}
+
+void ElementBVH::Update()
+{
+   MFEM_VERIFY(!IsOutdated(), "the mesh was modified, call Rebuild()");
+   ComputeElementBoxes();
+   Refit();
+}
+
+void ElementBVH::Rebuild()
+{
+   const int ne = mesh->GetNE();
+   sdim = mesh->SpaceDimension();
+   sequence = mesh->GetSequence();
+   ComputeElementBoxes();
+
+   Vector centers(sdim*ne);
+   for (int i = 0; i < ne; i++)
+   {
+      const double *box = elem_box.GetData() + 2*sdim*i;
+      for (int d = 0; d < sdim; d++)
+      {
+         centers(sdim*i + d) = 0.5*(box[d] + box[sdim + d]);
+      }
+   }
+   perm.SetSize(ne);
+   for (int i = 0; i < ne; i++) { perm[i] = i; }
+   nodes.SetSize(0);
+   // A balanced tree with leaves of at least leaf_size/2 elements
+   nodes.Reserve(ne > 0 ? 4*ne/std::max(leaf_size/2, 1) + 1 : 0);
+   if (ne > 0) { BuildNode(0, ne, centers); }
+   Refit();
+}
+
+bool ElementBVH::IsOutdated() const
+{
+   return sequence != mesh->GetSequence() || perm.Size() != mesh->GetNE();
+}
+
+void ElementBVH::FindElements(const double *x, Array<int> &elems) const
+{
+   elems.SetSize(0);
+   if (nodes.Size() == 0) { return; }
+
+   // The depth of the balanced tree is at most log2(NE) + 1
+   int stack[64];
+   int top = 0;
+   stack[top++] = 0;
+   while (top > 0)
+   {
+      const int n = stack[--top];
+      if (!BoxContains(node_box.GetData() + 2*sdim*n, x)) { continue; }
+      const Node &node = nodes[n];
+      if (node.size > 0)
+      {
+         for (int j = node.first; j < node.first + node.size; j++)
+         {
+            if (BoxContains(elem_box.GetData() + 2*sdim*perm[j], x))
+            {
+               elems.Append(perm[j]);
+            }
+         }
+      }
+      else
+      {
+         stack[top++] = node.right;
+         stack[top++] = n + 1;
+      }
+   }
+}
+
+int ElementBVH::FindClosestElement(const double *x) const
+{
+   if (nodes.Size() == 0) { return -1; }
+
+   // Depth-first search, skipping the nodes whose boxes are farther than the
+   // closest element box found so far
+   int closest = -1;
+   double min_dist = std::numeric_limits<double>::infinity();
+   int stack[64];
+   int top = 0;
+   stack[top++] = 0;
+   while (top > 0)
+   {
+      const int n = stack[--top];
+      if (BoxDistanceSquared(node_box.GetData() + 2*sdim*n, x) >= min_dist)
+      {
+         continue;
+      }
+      const Node &node = nodes[n];
+      if (node.size > 0)
+      {
+         for (int j = node.first; j < node.first + node.size; j++)
+         {
+            const double dist =
+               BoxDistanceSquared(elem_box.GetData() + 2*sdim*perm[j], x);
+            if (dist < min_dist) { min_dist = dist; closest = perm[j]; }
+         }
+      }
+      else
+      {
+         stack[top++] = node.right;
+         stack[top++] = n + 1;
+      }
+   }
+   return closest;
+}
+
+void ElementBVH::GetElementBox(int i, Vector &min, Vector &max) const
+{
+   const double *box = elem_box.GetData() + 2*sdim*i;
+   min.SetSize(sdim);
+   max.SetSize(sdim);
+   for (int d = 0; d < sdim; d++)
+   {
+      min(d) = box[d];
+      max(d) = box[sdim + d];
+   }
+}
+
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#ifndef MFEM_BVH
+#define MFEM_BVH
+
+#include "../config/config.hpp"
+#include "../general/array.hpp"
+#include "../linalg/vector.hpp"
+#include <algorithm>
+
+namespace mfem
+{
+
+class Mesh;
+
+/** @brief Bounding volume hierarchy of the axis-aligned bounding boxes of the
+    elements of a Mesh, used to find the elements that may contain a point.
+
+    The tree is built in O(NE log NE) operations by recursively splitting the
+    elements at the median of their box centers, along the longest axis. A
+    point query visits only the branches whose boxes contain the point, i.e.
+    O(log NE) nodes for a quasi-uniform mesh.
+
+    The boxes of straight-sided elements are the boxes of their vertices. The
+    boxes of curved elements are computed from a refined sampling of the
+    element, enlarged by a fraction of their size, see SetCurvedPadding().
+    Since the sampling may miss parts of strongly curved elements, such boxes
+    are not guaranteed to contain their elements, and Mesh::FindPoints() also
+    tries the neighbors of FindClosestElement() for the points it misses.
+
+    After the mesh nodes (or vertices) are moved, Update() recomputes the
+    element boxes and refits the tree, keeping its structure. After large
+    deformations, Rebuild() may give a tighter tree. After the mesh topology is
+    changed, e.g. by refinement, Rebuild() must be called. */
+class ElementBVH
+{
+protected:
+   /// Node of the tree, the left child of an internal node follows it.
+   struct Node
+   {
+      int right;       ///< index of the right child, internal nodes only
+      int first, size; ///< range of elements in the permutation, leaves only
+   };
+
+   Mesh *mesh;
+   long sequence; ///< Mesh::GetSequence() when the tree was built
+   int sdim;
+   int leaf_size;
+   double curved_pad;
+
+   Vector elem_box;  ///< min and max of each element box, 2*sdim per element
+   Vector node_box;  ///< min and max of each node box, 2*sdim per node
+   Array<Node> nodes;
+   Array<int> perm;  ///< elements in the order of the leaves
+
+   void ComputeElementBoxes();
+   int BuildNode(int first, int size, const Vector &centers);
+   void Refit();
+
+   bool BoxContains(const double *box, const double *x) const
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         if (x[d] < box[d] || x[d] > box[sdim + d]) { return false; }
+      }
+      return true;
+   }
+
+   double BoxDistanceSquared(const double *box, const double *x) const
+   {
+      double dist = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         const double dx = std::max(box[d] - x[d], x[d] - box[sdim + d]);
+         if (dx > 0.0) { dist += dx*dx; }
+      }
+      return dist;
+   }
+
+public:
+   /** @brief Build the tree for the elements of @a mesh_, with at most
+       @a leaf_size elements per leaf. */
+   explicit ElementBVH(Mesh &mesh_, int leaf_size = 4);
+
+   /** @brief Set the fraction of their size by which the sampled boxes of the
+       curved elements are enlarged (default 0.05), then call Update(). */
+   void SetCurvedPadding(double pad) { curved_pad = pad; Update(); }
+
+   /// Recompute the element boxes after mesh motion and refit the tree.
+   void Update();
+
+   /// Rebuild the tree, e.g. after the mesh was refined.
+   void Rebuild();
+
+   /// Return true if the mesh was modified, e.g. refined, since the last build.
+   bool IsOutdated() const;
+
+   /** @brief Return in @a elems the elements whose boxes contain the point
+       @a x, of size Mesh::SpaceDimension(). */
+   void FindElements(const double *x, Array<int> &elems) const;
+
+   /// Same as FindElements(), with the point given as a Vector.
+   void FindElements(const Vector &x, Array<int> &elems) const
+   { FindElements(x.GetData(), elems); }
+
+   /** @brief Return the element whose box is the closest to the point @a x,
+       or -1 if the mesh has no elements. */
+   int FindClosestElement(const double *x) const;
+
+   /// Return the box of element @a i, in @a min and @a max.
+   void GetElementBox(int i, Vector &min, Vector &max) const;
+
+   /// Return the mesh of the tree.
+   Mesh *GetMesh() const { return mesh; }
+
+   /// Return the number of nodes of the tree.
+   int GetNumNodes() const { return nodes.Size(); }
+};
+
+}
+
+#endif
@@ -19,6 +19,7 @@
 #include "../general/device.hpp"
 #include "../general/tic_toc.hpp"
 #include "../general/gecko.hpp"
+#include "../general/annotation.hpp"
 #include "../fem/quadinterpolator.hpp"
 
 #include <iostream>
@@ -31,6 +32,8 @@
 #include <functional>
 #include <map>
 #include <set>
+#include <memory>
+#include <algorithm>
 
 // Include the METIS header, if using version 5. If using METIS 4, the needed
 // declarations are inlined below, i.e. no header is needed.
@@ -6972,8 +6975,50 @@ int *Mesh::CartesianPartitioning(int nxyz[])
    return partitioning;
 }
 
+int *Mesh::GenerateSFCPartitioning(int nparts, const Vector *weights)
+{
+   MFEM_VERIFY(nparts > 0, "invalid number of parts: " << nparts);
+   MFEM_VERIFY(!weights || weights->Size() == NumOfElements,
+               "the size of the weights must be the number of elements");
+
+   int *partitioning = new int[NumOfElements];
+   if (NumOfElements == 0) { return partitioning; }
+
+   Array<int> ordering, sfc_elem(NumOfElements);
+   GetHilbertElementOrdering(ordering);
+   for (int i = 0; i < NumOfElements; i++) { sfc_elem[ordering[i]] = i; }
+
+   double total = NumOfElements;
+   if (weights)
+   {
+      total = 0.0;
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         MFEM_VERIFY((*weights)(i) >= 0.0, "negative element weight");
+         total += (*weights)(i);
+      }
+      MFEM_VERIFY(total > 0.0, "the element weights are all zero");
+   }
+
+   // Element i goes to the part containing the middle of its weight interval
+   // [sum, sum + w_i) along the curve, so the parts are contiguous pieces of
+   // the curve with (up to one element) equal total weight.
+   double sum = 0.0;
+   for (int k = 0; k < NumOfElements; k++)
+   {
+      const int i = sfc_elem[k];
+      const double w = weights ? (*weights)(i) : 1.0;
+      const int part = (int)((sum + 0.5*w) * nparts / total);
+      partitioning[i] = std::min(part, nparts-1);
+      sum += w;
+   }
+   return partitioning;
+}
+
 int *Mesh::GeneratePartitioning(int nparts, int part_method)
 {
+   if (part_method == 6) { return GenerateSFCPartitioning(nparts); }
+
 #ifdef MFEM_USE_METIS
 
    int print_messages = 1;
@@ -7283,10 +7328,8 @@ int *Mesh::GeneratePartitioning(int nparts, int part_method)
 
 #else
 
-   mfem_error("Mesh::GeneratePartitioning(...): "
-              "MFEM was compiled without Metis.");
-
-   return NULL;
+   // Without METIS, use the space-filling curve partitioning
+   return GenerateSFCPartitioning(nparts);
 
 #endif
 }
@@ -9133,6 +9176,8 @@ bool Mesh::NonconformingDerefinement(Array<double> &elem_error,
 bool Mesh::DerefineByError(Array<double> &elem_error, double threshold,
                            int nc_limit, int op)
 {
+   MFEM_PERF_FUNCTION;
+
    // NOTE: the error array is not const because it will be expanded in parallel
    //       by ghost element errors
    if (Nonconforming())
@@ -9150,6 +9195,8 @@ bool Mesh::DerefineByError(Array<double> &elem_error, double threshold,
 bool Mesh::DerefineByError(const Vector &elem_error, double threshold,
                            int nc_limit, int op)
 {
+   MFEM_PERF_FUNCTION;
+
    Array<double> tmp(elem_error.Size());
    for (int i = 0; i < tmp.Size(); i++)
    {
@@ -9296,6 +9343,8 @@ static Array<int>& AllElements(Array<int> &list, int nelem)
 
 void Mesh::UniformRefinement(int ref_algo)
 {
+   MFEM_PERF_FUNCTION;
+
    Array<int> list;
 
    if (NURBSext)
@@ -9326,6 +9375,8 @@ void Mesh::UniformRefinement(int ref_algo)
 void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
                              int nonconforming, int nc_limit)
 {
+   MFEM_PERF_FUNCTION;
+
    if (ncmesh)
    {
       nonconforming = 1;
@@ -9383,6 +9434,8 @@ void Mesh::GeneralRefinement(const Array<Refinement> &refinements,
 void Mesh::GeneralRefinement(const Array<int> &el_to_refine, int nonconforming,
                              int nc_limit)
 {
+   MFEM_PERF_FUNCTION;
+
    Array<Refinement> refinements(el_to_refine.Size());
    for (int i = 0; i < el_to_refine.Size(); i++)
    {
@@ -10165,6 +10218,141 @@ void Mesh::Printer(std::ostream &os, std::string section_delimiter) const
    }
 }
 
+static const char *binary_mesh_header = "MFEM binary mesh v1.0";
+
+// Write the geometry, attribute and vertices of the elements in 'elems' as
+// three arrays.
+static void PrintBinaryElements(std::ostream &os, const Array<Element*> &elems)
+{
+   const int n = elems.Size();
+   Array<int> geom(n), attr(n), vert;
+   for (int i = 0; i < n; i++)
+   {
+      geom[i] = elems[i]->GetGeometryType();
+      attr[i] = elems[i]->GetAttribute();
+      vert.Append(elems[i]->GetVertices(), elems[i]->GetNVertices());
+   }
+   bin_io::write<int>(os, n);
+   bin_io::write<int>(os, vert.Size());
+   bin_io::write(os, geom.GetData(), n);
+   bin_io::write(os, attr.GetData(), n);
+   bin_io::write(os, vert.GetData(), vert.Size());
+}
+
+void Mesh::ReadBinaryElements(std::istream &input, Array<Element*> &elems)
+{
+   const int n = bin_io::read<int>(input);
+   Array<int> geom(n), attr(n), vert(bin_io::read<int>(input));
+   bin_io::read(input, geom.GetData(), n);
+   bin_io::read(input, attr.GetData(), n);
+   bin_io::read(input, vert.GetData(), vert.Size());
+   elems.SetSize(n);
+   for (int i = 0, j = 0; i < n; i++)
+   {
+      elems[i] = NewElement(geom[i]);
+      elems[i]->SetAttribute(attr[i]);
+      elems[i]->SetVertices(vert.GetData() + j);
+      j += elems[i]->GetNVertices();
+   }
+}
+
+void Mesh::PrintBinary(std::ostream &os) const
+{
+   os << binary_mesh_header << '\n';
+   if (ncmesh || NURBSext)
+   {
+      // Nonconforming and NURBS meshes are stored with their text format, with
+      // enough digits to restore the nodes exactly
+      std::ostringstream text;
+      text.precision(17);
+      Print(text);
+      bin_io::write<int>(os, 1);
+      bin_io::WriteString(os, text.str());
+      return;
+   }
+   bin_io::write<int>(os, 0);
+   bin_io::write<int>(os, Dim);
+   bin_io::write<int>(os, spaceDim);
+   PrintBinaryElements(os, elements);
+   PrintBinaryElements(os, boundary);
+
+   bin_io::write<int>(os, NumOfVertices);
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      bin_io::write(os, vertices[i](), spaceDim);
+   }
+
+   bin_io::write<int>(os, Nodes ? 1 : 0);
+   if (Nodes)
+   {
+      const FiniteElementSpace *fes = Nodes->FESpace();
+      bin_io::WriteString(os, fes->FEColl()->Name());
+      bin_io::write<int>(os, fes->GetVDim());
+      bin_io::write<int>(os, fes->GetOrdering());
+      bin_io::write<int>(os, Nodes->Size());
+      bin_io::write(os, Nodes->HostRead(), Nodes->Size());
+   }
+}
+
+bool Mesh::BinaryLoader(std::istream &input)
+{
+   std::string header;
+   getline(input, header);
+   MFEM_VERIFY(input && header == binary_mesh_header,
+               "input stream is not a binary MFEM mesh");
+
+   if (bin_io::read<int>(input) == 1)
+   {
+      std::istringstream text(bin_io::ReadString(input));
+      Load(text, 1, 1, true);
+      return false;
+   }
+
+   Clear();
+   Dim = bin_io::read<int>(input);
+   spaceDim = bin_io::read<int>(input);
+   ReadBinaryElements(input, elements);
+   ReadBinaryElements(input, boundary);
+   NumOfElements = elements.Size();
+   NumOfBdrElements = boundary.Size();
+
+   NumOfVertices = bin_io::read<int>(input);
+   vertices.SetSize(NumOfVertices);
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      bin_io::read(input, vertices[i](), spaceDim);
+   }
+   MFEM_VERIFY(input, "error reading the binary mesh");
+
+   // Same steps as in Loader()
+   FinalizeTopology(false);
+
+   if (bin_io::read<int>(input))
+   {
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(bin_io::ReadString(input).c_str());
+      const int vdim = bin_io::read<int>(input);
+      const int ordering = bin_io::read<int>(input);
+      Nodes = new GridFunction(new FiniteElementSpace(this, fec, vdim,
+                                                      ordering));
+      Nodes->MakeOwner(fec);
+      MFEM_VERIFY(Nodes->Size() == bin_io::read<int>(input),
+                  "invalid size of the mesh nodes");
+      bin_io::read(input, Nodes->HostWrite(), Nodes->Size());
+      own_nodes = 1;
+      spaceDim = Nodes->VectorDim();
+   }
+   MFEM_VERIFY(input, "error reading the binary mesh");
+   return true;
+}
+
+Mesh Mesh::LoadBinary(std::istream &input)
+{
+   Mesh mesh;
+   if (mesh.BinaryLoader(input)) { mesh.Finalize(true, true); }
+   return mesh;
+}
+
 void Mesh::PrintTopo(std::ostream &os,const Array<int> &e_to_k) const
 {
    int i;
@@ -11819,7 +12007,8 @@ std::ostream &operator<<(std::ostream &os, const Mesh &mesh)
 
 int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
                      Array<IntegrationPoint>& ips, bool warn,
-                     InverseElementTransformation *inv_trans)
+                     InverseElementTransformation *inv_trans,
+                     const ElementBVH *bvh)
 {
    const int npts = point_mat.Width();
    if (!npts) { return 0; }
@@ -11829,96 +12018,102 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    elem_ids = -1;
    if (!GetNE()) { return 0; }
 
+   // Without a given spatial index, build one: the cost is similar to the
+   // evaluation of the centers of all the elements
+   std::unique_ptr<ElementBVH> own_bvh;
+   if (bvh == NULL)
+   {
+      own_bvh.reset(new ElementBVH(*this));
+      bvh = own_bvh.get();
+   }
+   MFEM_VERIFY(bvh->GetMesh() == this, "the ElementBVH is for another mesh");
+   MFEM_VERIFY(!bvh->IsOutdated(), "the ElementBVH is outdated");
+
    double *data = point_mat.GetData();
    InverseElementTransformation *inv_tr = inv_trans;
    inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
 
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
-
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
+   int pts_found = 0;
+   Array<int> elems;
+   std::vector<std::pair<double,int>> order;
+   Vector pt, box_min, box_max;
+   for (int k = 0; k < npts; k++)
    {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
+      pt.SetDataAndSize(data+k*spaceDim, spaceDim);
+      bvh->FindElements(pt, elems);
+
+      // Try the elements whose boxes contain the point, starting with the
+      // closest box centers
+      order.resize(elems.Size());
+      for (int j = 0; j < elems.Size(); j++)
       {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
+         bvh->GetElementBox(elems[j], box_min, box_max);
+         box_min += box_max;
+         box_min *= 0.5;
+         order[j] = std::make_pair(pt.DistanceSquaredTo(box_min.GetData()),
+                                   elems[j]);
+      }
+      std::sort(order.begin(), order.end());
+      for (const auto &e : order)
+      {
+         inv_tr->SetTransformation(*GetElementTransformation(e.second));
+         int res = inv_tr->Transform(pt, ips[k]);
+         if (res == InverseElementTransformation::Inside)
          {
-            min_dist(k) = dist;
-            e_idx[k] = i;
+            elem_ids[k] = e.second;
+            pts_found++;
+            break;
          }
       }
    }
 
-   // Checks if the points lie in the closest element
-   int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
-   for (int k = 0; k < npts; k++)
-   {
-      pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
-   }
+   // The boxes of curved elements are sampled and may miss parts of them: try
+   // the neighbors of the element with the closest box
    if (pts_found != npts)
    {
-      Array<int> elvertices;
+      Array<int> elvertices, neigh;
       Table *vtoel = GetVertexToElementTable();
       for (int k = 0; k < npts; k++)
       {
          if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], elvertices);
+         pt.SetDataAndSize(data+k*spaceDim, spaceDim);
+         const int e_idx = bvh->FindClosestElement(pt.GetData());
+         bvh->FindElements(pt, elems);
+
+         // Try all vertex-neighbors of element e_idx, then the neighbors in
+         // the non-conforming mesh, skipping the elements tried above
+         neigh.SetSize(0);
+         neigh.Append(e_idx);
+         GetElementVertices(e_idx, elvertices);
          for (int v = 0; v < elvertices.Size(); v++)
          {
-            int vv = elvertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
+            neigh.Append(vtoel->GetRow(elvertices[v]),
+                         vtoel->RowSize(elvertices[v]));
+         }
+         if (ncmesh)
+         {
+            Array<int> nc_neigh;
+            ncmesh->FindNeighbors(ncmesh->leaf_elements[e_idx], nc_neigh);
+            for (int e = 0; e < nc_neigh.Size(); e++)
             {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
+               const NCMesh::Element &el = ncmesh->elements[nc_neigh[e]];
+               if (!ncmesh->IsGhost(el)) { neigh.Append(el.index); }
             }
          }
-         // Try neighbors for non-conforming meshes
-         if (ncmesh)
+         neigh.Sort();
+         neigh.Unique();
+         for (int e = 0; e < neigh.Size(); e++)
          {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
+            if (elems.Find(neigh[e]) >= 0) { continue; }
+            inv_tr->SetTransformation(*GetElementTransformation(neigh[e]));
+            int res = inv_tr->Transform(pt, ips[k]);
+            if (res == InverseElementTransformation::Inside)
             {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
+               elem_ids[k] = neigh[e];
+               pts_found++;
+               break;
             }
          }
-      next_point: ;
       }
       delete vtoel;
    }
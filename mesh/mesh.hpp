@@ -39,6 +39,7 @@ class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
 class GridFunction;
+class ElementBVH;
 struct Refinement;
 
 /** An enum type to specify if interior or boundary faces are desired. */
@@ -513,6 +514,14 @@ protected:
    void Loader(std::istream &input, int generate_edges = 0,
                std::string parse_tag = "");
 
+   /// Read the element arrays written by PrintBinary().
+   void ReadBinaryElements(std::istream &input, Array<Element*> &elems);
+
+   /** Read the mesh written by PrintBinary(), up to (but not including) the
+       call to Finalize(). Returns false if the stream contains a mesh in text
+       format, which is then fully loaded with Load(). */
+   bool BinaryLoader(std::istream &input);
+
    // If NURBS mesh, write NURBS format. If NCMesh, write mfem v1.1 format.
    // If section_delimiter is empty, write mfem v1.0 format. Otherwise, write
    // mfem v1.2 format with the given section_delimiter at the end.
@@ -1488,7 +1497,25 @@ public:
    MFEM_DEPRECATED virtual void ReorientTetMesh();
 
    int *CartesianPartitioning(int nxyz[]);
+
+   /** @brief Partition the mesh into @a nparts parts, returning a new array
+       with the part of each element.
+
+       The values 0-5 of @a part_method select the METIS algorithm: 0/3
+       recursive bisection, 1/4 k-way, 2/5 k-way minimizing the communication
+       volume (with the neighbor lists sorted for 0-2). The value 6, or any
+       value when MFEM is built without METIS, selects
+       GenerateSFCPartitioning(). */
    int *GeneratePartitioning(int nparts, int part_method = 1);
+
+   /** @brief Partition the mesh by splitting the Hilbert curve ordering of the
+       elements (see GetHilbertElementOrdering()) into @a nparts contiguous
+       pieces of equal total weight.
+
+       The optional @a weights (one non-negative value per element, e.g. the
+       cost of the element from its polynomial order) default to 1. This is a
+       fast alternative to METIS, with larger but still local interfaces. */
+   int *GenerateSFCPartitioning(int nparts, const Vector *weights = NULL);
    void CheckPartitioning(int *partitioning_);
 
    void CheckDisplacements(const Vector &displacements, double &tmax);
@@ -1649,6 +1676,17 @@ public:
    /// used for ASCII output.
    virtual void Save(const char *fname, int precision=16) const;
 
+   /** @brief Write the mesh to the stream in MFEM's binary mesh format, see
+       LoadBinary(). */
+   /** The elements, boundary elements, vertices and nodes of a conforming mesh
+       are written as raw arrays of native endianness, so the format is meant
+       for checkpoints read back on the same kind of machine. Nonconforming and
+       NURBS meshes are stored in their text format. */
+   virtual void PrintBinary(std::ostream &os) const;
+
+   /// Read a mesh written with PrintBinary().
+   static Mesh LoadBinary(std::istream &input);
+
    /// Print the mesh to the given stream using the adios2 bp format
 #ifdef MFEM_USE_ADIOS2
    virtual void Print(adios2stream &os) const;
@@ -1773,6 +1811,12 @@ public:
        completely overwritten by deriving custom classes that override the
        Transform() method.
 
+       The candidate elements of each point are the elements whose bounding
+       boxes contain it, found with the spatial index @a bvh. If NULL pointer
+       is given, a temporary ElementBVH is built. When searching many sets of
+       points, the ElementBVH can be built once and reused, see
+       ElementBVH::Update() after the mesh is moved.
+
        If no element is found for the i-th point, elem_ids[i] is set to -1.
 
        In the ParMesh implementation, the @a point_mat is expected to be the
@@ -1787,7 +1831,8 @@ public:
        to find a point, even if it lies inside a mesh element. */
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
-                          InverseElementTransformation *inv_trans = NULL);
+                          InverseElementTransformation *inv_trans = NULL,
+                          const ElementBVH *bvh = NULL);
 
    /// Swaps internal data with another mesh. By default, non-geometry members
    /// like 'ncmesh' and 'NURBSExt' are only swapped when 'non_geometry' is set.
@@ -12,10 +12,17 @@
 #include "mesh_headers.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
+#include "../general/annotation.hpp"
 
 #include <string>
 #include <cmath>
 #include <map>
+#include <vector>
+#include <cstdint>
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
 
 #include "ncmesh_tables.hpp"
 
@@ -884,23 +891,9 @@ void NCMesh::CheckIsoFace(int vn1, int vn2, int vn3, int vn4,
 }
 
 
-void NCMesh::RefineElement(int elem, char ref_type)
+char NCMesh::CreateChildren(int elem, char ref_type, int child[8])
 {
-   if (!ref_type) { return; }
-
-   // handle elements that may have been (force-) refined already
    Element &el = elements[elem];
-   if (el.ref_type)
-   {
-      char remaining = ref_type & ~el.ref_type;
-
-      // do the remaining splits on the children
-      for (int i = 0; i < 8; i++)
-      {
-         if (el.child[i] >= 0) { RefineElement(el.child[i], remaining); }
-      }
-      return;
-   }
 
    /*mfem::out << "Refining element " << elem << " ("
              << el.node[0] << ", " << el.node[1] << ", "
@@ -912,7 +905,6 @@ void NCMesh::RefineElement(int elem, char ref_type)
    int* no = el.node;
    int attr = el.attribute;
 
-   int child[8];
    for (int i = 0; i < 8; i++) { child[i] = -1; }
 
    // get parent's face attributes
@@ -1485,16 +1477,49 @@ void NCMesh::RefineElement(int elem, char ref_type)
       MFEM_ABORT("Unsupported element geometry.");
    }
 
-   // start using the nodes of the children, create edges & faces
-   for (int i = 0; i < 8 && child[i] >= 0; i++)
+   return ref_type;
+}
+
+void NCMesh::RefineElement(int elem, char ref_type)
+{
+   if (!ref_type) { return; }
+
+   // handle elements that may have been (force-) refined already
+   Element &el = elements[elem];
+   if (el.ref_type)
    {
-      ReferenceElement(child[i]);
+      char remaining = ref_type & ~el.ref_type;
+
+      // do the remaining splits on the children
+      for (int i = 0; i < 8; i++)
+      {
+         if (el.child[i] >= 0) { RefineElement(el.child[i], remaining); }
+      }
+      return;
    }
 
+   int child[8];
+   ref_type = CreateChildren(elem, ref_type, child);
+
    int buf[6];
    Array<int> parentFaces(buf, 6);
    parentFaces.SetSize(0);
 
+   AttachChildren(elem, ref_type, child, parentFaces);
+
+   // clean up parent faces, if unused
+   DeleteUnusedFaces(parentFaces);
+}
+
+void NCMesh::AttachChildren(int elem, char ref_type, const int child[8],
+                            Array<int> &parentFaces)
+{
+   // start using the nodes of the children, create edges & faces
+   for (int i = 0; i < 8 && child[i] >= 0; i++)
+   {
+      ReferenceElement(child[i]);
+   }
+
    // sign off of all nodes of the parent, clean up unused nodes, but keep faces
    UnreferenceElement(elem, parentFaces);
 
@@ -1504,10 +1529,8 @@ void NCMesh::RefineElement(int elem, char ref_type)
       RegisterFaces(child[i]);
    }
 
-   // clean up parent faces, if unused
-   DeleteUnusedFaces(parentFaces);
-
    // make the children inherit our rank; set the parent element
+   Element &el = elements[elem];
    for (int i = 0; i < 8 && child[i] >= 0; i++)
    {
       Element &ch = elements[child[i]];
@@ -1520,15 +1543,210 @@ void NCMesh::RefineElement(int elem, char ref_type)
    std::memcpy(el.child, child, sizeof(el.child));
 }
 
+bool NCMesh::IsotropicBatch(const Array<Refinement> &refs) const
+{
+   // in an isotropic mesh, isotropic refinements neither force other
+   // refinements nor reparent nodes, see CheckIsoFace()
+   if (!Iso) { return false; }
+   for (int i = 0; i < refs.Size(); i++)
+   {
+      const char ref_type = refs[i].ref_type;
+      switch (elements[refs[i].index].Geom())
+      {
+         case Geometry::CUBE:
+         case Geometry::PRISM:
+            if (ref_type != Refinement::XYZ) { return false; }
+            break;
+         case Geometry::SQUARE:
+            if ((ref_type & Refinement::XY) != Refinement::XY) { return false; }
+            break;
+         default: // always split isotropically
+            if (!ref_type) { return false; }
+      }
+   }
+   return true;
+}
+
+void NCMesh::RefineIsotropic(const Array<Refinement> &refs)
+{
+   // 1. Create the children with their vertex nodes and faces, one element at
+   //    a time in the order of 'refs', as in RefineElement(). The parents keep
+   //    their nodes until step 5, 'ref_type' marks them to skip duplicates.
+   Array<int> elems, children;
+   elems.Reserve(refs.Size());
+   children.Reserve(8*refs.Size());
+   for (int i = 0; i < refs.Size(); i++)
+   {
+      const int elem = refs[i].index;
+      if (elements[elem].ref_type) { continue; }
+
+      int child[8];
+      elements[elem].ref_type = CreateChildren(elem, refs[i].ref_type, child);
+      elems.Append(elem);
+      children.Append(child, 8);
+   }
+   const int n = elems.Size();
+
+   // 2. Look up the edges of the children, which are the only entities still
+   //    missing. Each thread collects the missing edges of a contiguous range
+   //    of elements, so the concatenated lists follow the order of 'elems' for
+   //    any number of threads.
+   int nthreads = 1;
+#ifdef MFEM_USE_OPENMP
+   nthreads = omp_get_max_threads();
+#endif
+   std::vector<Array<int>> new_edges(nthreads);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel num_threads(nthreads)
+#endif
+   {
+      int tid = 0, nt = 1;
+#ifdef MFEM_USE_OPENMP
+      tid = omp_get_thread_num();
+      nt = omp_get_num_threads();
+#endif
+      Array<int> &edges = new_edges[tid];
+      const int begin = (int) ((long long) n*tid/nt);
+      const int end = (int) ((long long) n*(tid+1)/nt);
+      for (int i = begin; i < end; i++)
+      {
+         const int *child = &children[8*i];
+         for (int k = 0; k < 8 && child[k] >= 0; k++)
+         {
+            const Element &ch = elements[child[k]];
+            const GeomInfo &gi = GI[ch.Geom()];
+            for (int j = 0; j < gi.ne; j++)
+            {
+               const int* ev = gi.edges[j];
+               const int n0 = ch.node[ev[0]], n1 = ch.node[ev[1]];
+               if (nodes.FindId(n0, n1) < 0)
+               {
+                  edges.Append(n0);
+                  edges.Append(n1);
+               }
+            }
+         }
+      }
+   }
+
+   // 3. Merge: create the missing edges in that order. An edge shared by the
+   //    children of two elements is created the first time.
+   for (int t = 0; t < nthreads; t++)
+   {
+      const Array<int> &edges = new_edges[t];
+      for (int i = 0; i < edges.Size(); i += 2)
+      {
+         nodes.GetId(edges[i], edges[i+1]);
+      }
+   }
+
+   // 4. Color the elements so that the elements of a color share none of the
+   //    vertices and edges of their children. The faces of the children and of
+   //    the parent are spanned by these vertices, and the edges of the parent
+   //    are vertices of the children, so the elements of a color then update
+   //    the reference counts of different nodes and faces. The greedy coloring
+   //    follows the order of 'elems'. The elements that do not fit in the 64
+   //    colors are refined one at a time, as the last color.
+   const int max_colors = 64;
+   std::vector<uint64_t> node_colors(nodes.NumIds(), 0);
+   Array<int> color_offsets(max_colors + 2), color(n), touched;
+   color_offsets = 0;
+   for (int i = 0; i < n; i++)
+   {
+      const int *child = &children[8*i];
+      touched.SetSize(0);
+      for (int k = 0; k < 8 && child[k] >= 0; k++)
+      {
+         const Element &ch = elements[child[k]];
+         const GeomInfo &gi = GI[ch.Geom()];
+         touched.Append(ch.node, gi.nv);
+         for (int j = 0; j < gi.ne; j++)
+         {
+            const int* ev = gi.edges[j];
+            touched.Append(nodes.FindId(ch.node[ev[0]], ch.node[ev[1]]));
+         }
+      }
+
+      uint64_t used = 0;
+      for (int j = 0; j < touched.Size(); j++)
+      {
+         used |= node_colors[touched[j]];
+      }
+      int c = 0;
+      while (c < max_colors && (used >> c) & 1) { c++; }
+      if (c < max_colors)
+      {
+         for (int j = 0; j < touched.Size(); j++)
+         {
+            node_colors[touched[j]] |= uint64_t(1) << c;
+         }
+      }
+      color[i] = c;
+      color_offsets[c + 1]++;
+   }
+   color_offsets.PartialSum();
+   Array<int> colored(n), next(color_offsets);
+   for (int i = 0; i < n; i++) { colored[next[color[i]]++] = i; }
+
+   // 5. Replace the parents by their children, one color at a time. The faces
+   //    of the parents are only deleted in step 6. The nodes of a parent are
+   //    all vertices of its children, so UnreferenceElement() deletes none and
+   //    no entity is created or deleted in this step.
+   Array<int> parent_faces(6*n);
+   parent_faces = -1;
+   for (int c = 0; c <= max_colors; c++)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for if (c < max_colors)
+#endif
+      for (int k = color_offsets[c]; k < color_offsets[c+1]; k++)
+      {
+         const int i = colored[k];
+         Array<int> faces_i(&parent_faces[6*i], 6);
+         faces_i.SetSize(0);
+         AttachChildren(elems[i], elements[elems[i]].ref_type,
+                        &children[8*i], faces_i);
+      }
+   }
+
+   // 6. Delete the unused faces of the parents in the order of 'elems'. A face
+   //    shared by two parents is deleted the first time.
+   for (int i = 0; i < parent_faces.Size(); i++)
+   {
+      const int face = parent_faces[i];
+      if (face >= 0 && faces.IdExists(face) && faces[face].Unused())
+      {
+         faces.Delete(face);
+      }
+   }
+}
+
 
 void NCMesh::Refine(const Array<Refinement>& refinements)
 {
-   // push all refinements on the stack in reverse order
-   ref_stack.Reserve(refinements.Size());
-   for (int i = refinements.Size()-1; i >= 0; i--)
+   MFEM_PERF_FUNCTION;
+
+   Array<Refinement> refs(refinements.Size());
+   for (int i = 0; i < refinements.Size(); i++)
    {
       const Refinement& ref = refinements[i];
-      ref_stack.Append(Refinement(leaf_elements[ref.index], ref.ref_type));
+      refs[i] = Refinement(leaf_elements[ref.index], ref.ref_type);
+   }
+
+   // isotropic refinements of an isotropic mesh force no other refinements
+   // and can be performed concurrently
+   if (IsotropicBatch(refs))
+   {
+      RefineIsotropic(refs);
+   }
+   else
+   {
+      // push all refinements on the stack in reverse order
+      ref_stack.Reserve(refs.Size());
+      for (int i = refs.Size()-1; i >= 0; i--)
+      {
+         ref_stack.Append(refs[i]);
+      }
    }
 
    // keep refining as long as the stack contains something
@@ -1848,6 +2066,8 @@ void NCMesh::CheckDerefinementNCLevel(const Table &deref_table,
 
 void NCMesh::Derefine(const Array<int> &derefs)
 {
+   MFEM_PERF_FUNCTION;
+
    MFEM_VERIFY(Dim < 3 || Iso,
                "derefinement of 3D anisotropic meshes not implemented yet.");
 
@@ -2008,6 +2228,9 @@ void NCMesh::UpdateLeafElements()
    leaf_elements.Append(ghosts);
    leaf_sfc_index.SetSize(leaf_elements.Size());
 
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < leaf_elements.Size(); i++)
    {
       Element &el = elements[leaf_elements[i]];
@@ -2319,6 +2542,10 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
 
    mesh.boundary.SetSize(0);
 
+   // look up the faces of the leaf elements (in parallel)
+   Array<int> leaf_faces;
+   const int nf = FindLeafFaces(leaf_faces);
+
    // create an mfem::Element for each leaf Element
    for (int i = 0; i < NElements; i++)
    {
@@ -2342,8 +2569,7 @@ void NCMesh::GetMeshComponents(Mesh &mesh) const
       {
          const int* fv = gi.faces[k];
          const int nfv = gi.nfv[k];
-         const Face* face = faces.Find(node[fv[0]], node[fv[1]],
-                                       node[fv[2]], node[fv[3]]);
+         const Face* face = &faces[leaf_faces[nf*i + k]];
          if (face->Boundary())
          {
             if ((nc_elem.geom == Geometry::CUBE) ||
@@ -2412,6 +2638,9 @@ void NCMesh::OnMeshUpdated(Mesh *mesh)
 
    // get edge enumeration from the Mesh
    Table *edge_vertex = mesh->GetEdgeVertexTable();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < edge_vertex->Size(); i++)
    {
       const int *ev = edge_vertex->GetRow(i);
@@ -2426,6 +2655,9 @@ void NCMesh::OnMeshUpdated(Mesh *mesh)
 
    // get face enumeration from the Mesh, initialize 'face_geom'
    face_geom.SetSize(NFaces);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
    for (int i = 0; i < NFaces; i++)
    {
       const int* fv = mesh->GetFace(i)->GetVertices();
@@ -2963,6 +3195,35 @@ bool NCMesh::TraverseTriFace(int vn0, int vn1, int vn2,
    return false;
 }
 
+int NCMesh::FindLeafFaces(Array<int> &leaf_faces) const
+{
+   int nf = 0;
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      if (Geoms & (1 << g)) { nf = std::max(nf, GI[g].nf); }
+   }
+
+   const int nleaves = leaf_elements.Size();
+   leaf_faces.SetSize(nf*nleaves);
+
+   // the lookups only read the hash table, so they can run in parallel
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      const GeomInfo& gi = GI[el.Geom()];
+      for (int j = 0; j < gi.nf; j++)
+      {
+         const int* fv = gi.faces[j];
+         leaf_faces[nf*i + j] = faces.FindId(el.node[fv[0]], el.node[fv[1]],
+                                            el.node[fv[2]], el.node[fv[3]]);
+      }
+   }
+   return nf;
+}
+
 void NCMesh::BuildFaceList()
 {
    face_list.Clear();
@@ -2977,6 +3238,10 @@ void NCMesh::BuildFaceList()
 
    MatrixMap matrix_maps[Geometry::NumGeom];
 
+   // look up the faces of the leaf elements (in parallel)
+   Array<int> leaf_faces;
+   const int nf = FindLeafFaces(leaf_faces);
+
    // visit faces of leaf elements
    for (int i = 0; i < leaf_elements.Size(); i++)
    {
@@ -2994,7 +3259,7 @@ void NCMesh::BuildFaceList()
             node[k] = el.node[gi.faces[j][k]];
          }
 
-         int face = faces.FindId(node[0], node[1], node[2], node[3]);
+         int face = leaf_faces[nf*i + j];
          MFEM_ASSERT(face >= 0, "face not found!");
 
          // tell ParNCMesh about the face
@@ -3097,8 +3362,44 @@ void NCMesh::BuildEdgeList()
 
    MatrixMap matrix_map;
 
+   // look up the edge nodes of the leaf elements, whether they are slave
+   // edges and (in 2D) their faces; this only reads the hash tables, so it is
+   // done in parallel before the (sequential) traversal below
+   int ne = 0;
+   for (int g = 0; g < Geometry::NumGeom; g++)
+   {
+      if (Geoms & (1 << g)) { ne = std::max(ne, GI[g].ne); }
+   }
+   const int nleaves = leaf_elements.Size();
+   Array<int> leaf_edges(ne*nleaves), leaf_faces((Dim <= 2) ? ne*nleaves : 0);
+   Array<char> leaf_slave(ne*nleaves);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      const GeomInfo& gi = GI[el.Geom()];
+      for (int j = 0; j < gi.ne; j++)
+      {
+         const int* ev = gi.edges[j];
+         int n0 = el.node[ev[0]], n1 = el.node[ev[1]];
+
+         int enode = nodes.FindId(n0, n1);
+         MFEM_ASSERT(enode >= 0, "edge node not found!");
+
+         leaf_edges[ne*i + j] = enode;
+         leaf_slave[ne*i + j] = (GetEdgeMaster(enode) >= 0);
+         if (Dim <= 2)
+         {
+            leaf_faces[ne*i + j] = faces.FindId(n0, n0, n1, n1);
+         }
+      }
+   }
+
    // visit edges of leaf elements
-   for (int i = 0; i < leaf_elements.Size(); i++)
+   for (int i = 0; i < nleaves; i++)
    {
       int elem = leaf_elements[i];
       Element &el = elements[elem];
@@ -3111,8 +3412,7 @@ void NCMesh::BuildEdgeList()
          const int* ev = gi.edges[j];
          int node[2] = { el.node[ev[0]], el.node[ev[1]] };
 
-         int enode = nodes.FindId(node[0], node[1]);
-         MFEM_ASSERT(enode >= 0, "edge node not found!");
+         int enode = leaf_edges[ne*i + j];
 
          Node &nd = nodes[enode];
          MFEM_ASSERT(nd.HasEdge(), "edge not found!");
@@ -3123,7 +3423,7 @@ void NCMesh::BuildEdgeList()
          // (2D only, store boundary faces)
          if (Dim <= 2)
          {
-            int face = faces.FindId(node[0], node[0], node[1], node[1]);
+            int face = leaf_faces[ne*i + j];
             MFEM_ASSERT(face >= 0, "face not found!");
             if (faces[face].Boundary()) { boundary_faces.Append(face); }
          }
@@ -3133,7 +3433,7 @@ void NCMesh::BuildEdgeList()
          edge_local[nd.edge_index] = j;
 
          // skip slave edges here, they will be reached from their masters
-         if (GetEdgeMaster(enode) >= 0) { continue; }
+         if (leaf_slave[ne*i + j]) { continue; }
 
          // have we already processed this edge? skip if yes
          if (processed_edges[enode]) { continue; }
@@ -3193,24 +3493,38 @@ void NCMesh::BuildVertexList()
    vertex_list.Clear();
    vertex_list.conforming.Reserve(total);
 
+   // look up the vertex indices of the leaf elements in parallel, before the
+   // (sequential) traversal below, as in BuildEdgeList()
+   const int nleaves = leaf_elements.Size();
+   Array<int> leaf_verts(8*nleaves);
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < nleaves; i++)
+   {
+      const Element &el = elements[leaf_elements[i]];
+      for (int j = 0; j < GI[el.Geom()].nv; j++)
+      {
+         leaf_verts[8*i + j] = nodes[el.node[j]].vert_index;
+      }
+   }
+
    Array<char> processed_vertices(total);
    processed_vertices = 0;
 
    // analogously to above, visit vertices of leaf elements
-   for (int i = 0; i < leaf_elements.Size(); i++)
+   for (int i = 0; i < nleaves; i++)
    {
       int elem = leaf_elements[i];
       Element &el = elements[elem];
 
       for (int j = 0; j < GI[el.Geom()].nv; j++)
       {
-         int node = el.node[j];
-         Node &nd = nodes[node];
-
-         int index = nd.vert_index;
+         int index = leaf_verts[8*i + j];
          if (index >= 0)
          {
-            ElementSharesVertex(elem, j, node);
+            ElementSharesVertex(elem, j, el.node[j]);
 
             if (processed_vertices[index]) { continue; }
             processed_vertices[index] = 1;
@@ -156,7 +156,11 @@ public:
    /** Perform the given batch of refinements. Please note that in the presence
        of anisotropic splits additional refinements may be necessary to keep
        the mesh consistent. However, the function always performs at least the
-       requested refinements. */
+       requested refinements. If all refinements are isotropic and the mesh
+       has no anisotropic splits, no other refinements are needed and, with
+       MFEM_USE_OPENMP, the batch is refined concurrently, see
+       RefineIsotropic(). Otherwise the refinements are applied sequentially.
+       The resulting mesh does not depend on the number of threads. */
    virtual void Refine(const Array<Refinement> &refinements);
 
    /** Check the mesh and potentially refine some elements so that the maximum
@@ -496,8 +500,8 @@ protected: // implementation
 
    // primary data
 
-   HashTable<Node> nodes; // associative container holding all Nodes
-   HashTable<Face> faces; // associative container holding all Faces
+   OpenHashTable<Node> nodes; // associative container holding all Nodes
+   OpenHashTable<Face> faces; // associative container holding all Faces
 
    BlockArray<Element> elements; // storage for all Elements
    Array<int> free_element_ids;  // unused element ids - indices into 'elements'
@@ -596,7 +600,7 @@ protected: // implementation
    // refinement/derefinement
 
    Array<Refinement> ref_stack; ///< stack of scheduled refinements (temporary)
-   HashTable<Node> shadow; ///< temporary storage for reparented nodes
+   OpenHashTable<Node> shadow; ///< temporary storage for reparented nodes
    Array<Triple<int, int, int> > reparents; ///< scheduled node reparents (tmp)
 
    Table derefinements; ///< possible derefinements, see GetDerefinementTable
@@ -605,6 +609,30 @@ protected: // implementation
        (c.f. Refinement::enum) */
    void RefineElement(int elem, char ref_type);
 
+   /** Create the children of the element @a elem for the refinement
+       @a ref_type, with their vertex nodes and their faces, and return the
+       refinement type actually used. The element keeps its nodes, see
+       AttachChildren(). Unused entries of @a child are set to -1. */
+   char CreateChildren(int elem, char ref_type, int child[8]);
+
+   /** Let the children @a child of the element @a elem reference their nodes
+       and faces instead of @a elem, and make @a elem their parent. The faces
+       of @a elem are appended to @a parentFaces, to be deleted if unused. */
+   void AttachChildren(int elem, char ref_type, const int child[8],
+                       Array<int> &parentFaces);
+
+   /** Return true if the refinements @a refs (of element ids) are isotropic
+       and the mesh has no anisotropic splits, so that RefineIsotropic() can
+       be used. */
+   bool IsotropicBatch(const Array<Refinement> &refs) const;
+
+   /** Perform the isotropic refinements @a refs (of element ids). The children
+       are created sequentially, their missing edges are collected by threads
+       and created in a deterministic order, and the elements are then
+       attached to their children concurrently, in groups (colors) of
+       elements whose children share no vertex. */
+   void RefineIsotropic(const Array<Refinement> &refs);
+
    /// Derefine the element @a elem, does nothing on leaf elements.
    void DerefineElement(int elem);
 
@@ -719,6 +747,12 @@ protected: // implementation
    void TraverseEdge(int vn0, int vn1, double t0, double t1, int flags,
                      int level, MatrixMap &matrix_map);
 
+   /** Look up the faces of all leaf elements in the 'faces' table, in parallel
+       with OpenMP. The face @a j of leaf element @a i is stored in
+       @a leaf_faces[nf*i + j], where nf, the maximum number of faces of the
+       element geometries in the mesh, is returned. */
+   int FindLeafFaces(Array<int> &leaf_faces) const;
+
    virtual void BuildFaceList();
    virtual void BuildEdgeList();
    virtual void BuildVertexList();
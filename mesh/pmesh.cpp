@@ -19,9 +19,11 @@
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
 #include "../general/globals.hpp"
+#include "../general/binaryio.hpp"
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
 
 using namespace std;
 
@@ -1512,6 +1514,352 @@ ParMesh ParMesh::MakeSimplicial(ParMesh &orig_mesh)
    return mesh;
 }
 
+// Replace the element indices in the rows of 'ent_elem' by the sorted list of
+// the distinct ranks that own these elements.
+static void EntityElementsToRanks(Table &ent_elem, const int *partitioning)
+{
+   int *I = ent_elem.GetI(), *J = ent_elem.GetJ();
+   int nnz = 0;
+   for (int i = 0; i < ent_elem.Size(); i++)
+   {
+      const int begin = I[i], end = I[i+1];
+      for (int j = begin; j < end; j++) { J[j] = partitioning[J[j]]; }
+      std::sort(J + begin, J + end);
+      const int *last = std::unique(J + begin, J + end);
+      I[i] = nnz;
+      for (const int *r = J + begin; r != last; r++) { J[nnz++] = *r; }
+   }
+   I[ent_elem.Size()] = nnz;
+}
+
+// Write the part of the conforming 'mesh' owned by 'rank' to 'os', in the
+// binary parallel mesh format read by ParMesh::LoadBinary(). All work arrays
+// are indexed by global entity and shared by the calls for the different
+// ranks: entries are considered valid only if the corresponding 'stamp' is
+// 'rank'.
+void ParMesh::PrintPart(Mesh &mesh, int rank, const int *partitioning,
+                        const Table &rank_elem, const Table &rank_bdr,
+                        const Table &vert_ranks, const Table &edge_ranks,
+                        Array<int> &vert_stamp, Array<int> &vert_local,
+                        Array<int> &edge_stamp, Array<int> &face_stamp,
+                        std::ostream &os)
+{
+   const int dim = mesh.Dimension();
+   const int nle = rank_elem.RowSize(rank);
+   const int *elems = rank_elem.GetRow(rank);
+   const int nlbe = rank_bdr.RowSize(rank);
+   const int *bdr_elems = rank_bdr.GetRow(rank);
+
+   // Number the local vertices in the order of their global indices, so that
+   // the orientation of the local edges and faces matches the global one.
+   Array<int> lverts;
+   for (int i = 0; i < nle; i++)
+   {
+      const Element *el = mesh.GetElement(elems[i]);
+      const int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++)
+      {
+         if (vert_stamp[v[j]] != rank)
+         {
+            vert_stamp[v[j]] = rank;
+            lverts.Append(v[j]);
+         }
+      }
+   }
+   lverts.Sort();
+   for (int i = 0; i < lverts.Size(); i++) { vert_local[lverts[i]] = i; }
+
+   Mesh part(dim, lverts.Size(), nle, nlbe, mesh.SpaceDimension());
+   for (int i = 0; i < lverts.Size(); i++)
+   {
+      part.AddVertex(mesh.GetVertex(lverts[i]));
+   }
+   for (int i = 0; i < nle; i++)
+   {
+      Element *el = mesh.GetElement(elems[i])->Duplicate(&part);
+      int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNVertices(); j++) { v[j] = vert_local[v[j]]; }
+      part.AddElement(el);
+   }
+   for (int i = 0; i < nlbe; i++)
+   {
+      Element *be = mesh.GetBdrElement(bdr_elems[i])->Duplicate(&part);
+      int *v = be->GetVertices();
+      for (int j = 0; j < be->GetNVertices(); j++) { v[j] = vert_local[v[j]]; }
+      part.AddBdrElement(be);
+   }
+
+   const GridFunction *nodes = mesh.GetNodes();
+   if (nodes)
+   {
+      part.FinalizeTopology(false);
+      const FiniteElementSpace *fes = nodes->FESpace();
+      FiniteElementCollection *fec =
+         FiniteElementCollection::New(fes->FEColl()->Name());
+      part.SetNodalFESpace(new FiniteElementSpace(&part, fec, fes->GetVDim(),
+                                                  fes->GetOrdering()));
+      GridFunction *part_nodes = part.GetNodes();
+      part_nodes->MakeOwner(fec);
+
+      Array<int> vdofs, part_vdofs;
+      Vector values;
+      for (int i = 0; i < nle; i++)
+      {
+         fes->GetElementVDofs(elems[i], vdofs);
+         nodes->GetSubVector(vdofs, values);
+         part_nodes->FESpace()->GetElementVDofs(i, part_vdofs);
+         part_nodes->SetSubVector(part_vdofs, values);
+      }
+   }
+
+   part.PrintBinary(os);
+
+   // Find the shared vertices, edges and faces of the part, and the groups
+   // (sets of ranks) they belong to. Group 0 is always the local rank.
+   ListOfIntegerSets groups;
+   IntegerSet group;
+   group.Recreate(1, &rank);
+   groups.Insert(group);
+
+   // (group, global entity index) pairs, sorted below so that all ranks in a
+   // group list its entities in the same order
+   Array<Connection> svert, sedge, sface;
+   for (int i = 0; i < lverts.Size(); i++)
+   {
+      const int v = lverts[i];
+      if (vert_ranks.RowSize(v) > 1)
+      {
+         group.Recreate(vert_ranks.RowSize(v), vert_ranks.GetRow(v));
+         svert.Append(Connection(groups.Insert(group), v));
+      }
+   }
+   if (dim >= 2)
+   {
+      const Table &el_to_edge = mesh.ElementToEdgeTable();
+      for (int i = 0; i < nle; i++)
+      {
+         const int ne = el_to_edge.RowSize(elems[i]);
+         const int *edges = el_to_edge.GetRow(elems[i]);
+         for (int j = 0; j < ne; j++)
+         {
+            const int e = edges[j];
+            if (edge_stamp[e] == rank) { continue; }
+            edge_stamp[e] = rank;
+            if (edge_ranks.RowSize(e) > 1)
+            {
+               group.Recreate(edge_ranks.RowSize(e), edge_ranks.GetRow(e));
+               sedge.Append(Connection(groups.Insert(group), e));
+            }
+         }
+      }
+   }
+   if (dim == 3)
+   {
+      const Table &el_to_face = mesh.ElementToFaceTable();
+      for (int i = 0; i < nle; i++)
+      {
+         const int nf = el_to_face.RowSize(elems[i]);
+         const int *faces = el_to_face.GetRow(elems[i]);
+         for (int j = 0; j < nf; j++)
+         {
+            const int f = faces[j];
+            if (face_stamp[f] == rank) { continue; }
+            face_stamp[f] = rank;
+            int el[2];
+            mesh.GetFaceElements(f, &el[0], &el[1]);
+            if (el[1] < 0) { continue; }
+            el[0] = partitioning[el[0]];
+            el[1] = partitioning[el[1]];
+            if (el[0] != el[1])
+            {
+               group.Recreate(2, el);
+               sface.Append(Connection(groups.Insert(group), f));
+            }
+         }
+      }
+   }
+   svert.Sort();
+   sedge.Sort();
+   sface.Sort();
+
+   // Same layout as ParMesh::PrintBinary(): the groups, the number of shared
+   // vertices, edges, triangles and quadrilaterals in each group, followed by
+   // their local vertices
+   const int ngroups = groups.Size();
+   bin_io::write<int>(os, ngroups);
+   {
+      Table group_ranks;
+      groups.AsTable(group_ranks);
+      for (int gr = 0; gr < ngroups; gr++)
+      {
+         bin_io::write<int>(os, group_ranks.RowSize(gr));
+         bin_io::write(os, group_ranks.GetRow(gr), group_ranks.RowSize(gr));
+      }
+   }
+
+   Array<int> counts[4];
+   for (int k = 0; k < 4; k++)
+   {
+      counts[k].SetSize(ngroups-1);
+      counts[k] = 0;
+   }
+   for (int i = 0; i < svert.Size(); i++) { counts[0][svert[i].from-1]++; }
+   for (int i = 0; i < sedge.Size(); i++) { counts[1][sedge[i].from-1]++; }
+   for (int i = 0; i < sface.Size(); i++)
+   {
+      const bool tri =
+         mesh.GetFace(sface[i].to)->GetGeometryType() == Geometry::TRIANGLE;
+      counts[tri ? 2 : 3][sface[i].from-1]++;
+   }
+   for (int k = 0; k < 4; k++)
+   {
+      bin_io::write(os, counts[k].GetData(), ngroups-1);
+   }
+
+   Array<int> v, ev;
+   int iv = 0, ie = 0, i_f = 0;
+   for (int gr = 1; gr < ngroups; gr++)
+   {
+      for ( ; iv < svert.Size() && svert[iv].from == gr; iv++)
+      {
+         v.Append(vert_local[svert[iv].to]);
+      }
+      for ( ; ie < sedge.Size() && sedge[ie].from == gr; ie++)
+      {
+         mesh.GetEdgeVertices(sedge[ie].to, ev);
+         v.Append(vert_local[ev[0]]);
+         v.Append(vert_local[ev[1]]);
+      }
+      // The triangles of the group, then its quadrilaterals
+      int end = i_f;
+      while (end < sface.Size() && sface[end].from == gr) { end++; }
+      for (int geom : { Geometry::TRIANGLE, Geometry::SQUARE })
+      {
+         for (int i = i_f; i < end; i++)
+         {
+            const Element *face = mesh.GetFace(sface[i].to);
+            if (face->GetGeometryType() != geom) { continue; }
+            const int *fv = face->GetVertices();
+            for (int j = 0; j < face->GetNVertices(); j++)
+            {
+               v.Append(vert_local[fv[j]]);
+            }
+         }
+      }
+      i_f = end;
+   }
+   bin_io::write<int>(os, v.Size());
+   bin_io::write(os, v.GetData(), v.Size());
+}
+
+ParMesh ParMesh::MakeDistributed(MPI_Comm comm, Mesh *mesh, int root,
+                                 int *partitioning, int part_method)
+{
+   const int tag = 829;
+   int nranks, rank;
+   MPI_Comm_size(comm, &nranks);
+   MPI_Comm_rank(comm, &rank);
+
+   string part_str;
+   if (rank == root)
+   {
+      MFEM_VERIFY(mesh != NULL, "the serial mesh is required on the root rank");
+      MFEM_VERIFY(mesh->Conforming() && !mesh->NURBSext,
+                  "only conforming, non-NURBS meshes are supported, use the "
+                  "ParMesh(MPI_Comm, Mesh&) constructor instead");
+
+      const int dim = mesh->Dimension();
+      int *part = partitioning ? partitioning :
+                  mesh->GeneratePartitioning(nranks, part_method);
+      Array<int> elem_rank(part, mesh->GetNE());
+
+      // The owner of a boundary element is the rank of the element chosen by
+      // BuildLocalBoundary(): in 3D the element on the side given by the face
+      // orientation, in 2D the first element of the edge in the transpose of
+      // ElementToEdgeTable(), and in 1D the first element of the vertex
+      Array<int> bdr_rank(mesh->GetNBE());
+      Table edge_ranks;
+      if (dim >= 2)
+      {
+         Transpose(mesh->ElementToEdgeTable(), edge_ranks, mesh->GetNEdges());
+      }
+      for (int i = 0; i < mesh->GetNBE(); i++)
+      {
+         int el1, el2;
+         if (dim == 3)
+         {
+            int face, o;
+            mesh->GetBdrElementFace(i, &face, &o);
+            mesh->GetFaceElements(face, &el1, &el2);
+            el1 = (o % 2 == 0 || el2 < 0) ? el1 : el2;
+         }
+         else if (dim == 2)
+         {
+            el1 = edge_ranks.GetRow(mesh->GetBdrElementEdgeIndex(i))[0];
+         }
+         else
+         {
+            mesh->GetFaceElements(mesh->GetBdrElement(i)->GetVertices()[0],
+                                  &el1, &el2);
+         }
+         bdr_rank[i] = part[el1];
+      }
+      if (dim >= 2) { EntityElementsToRanks(edge_ranks, part); }
+
+      Table rank_elem, rank_bdr;
+      Transpose(elem_rank, rank_elem, nranks);
+      Transpose(bdr_rank, rank_bdr, nranks);
+
+      Table *vert_ranks = mesh->GetVertexToElementTable();
+      EntityElementsToRanks(*vert_ranks, part);
+
+      Array<int> vert_stamp(mesh->GetNV()), vert_local(mesh->GetNV());
+      Array<int> edge_stamp(mesh->GetNEdges()), face_stamp(mesh->GetNFaces());
+      vert_stamp = -1;
+      edge_stamp = -1;
+      face_stamp = -1;
+
+      // Send the part of each rank while the next one is being written
+      string buf[2];
+      MPI_Request req[2] = { MPI_REQUEST_NULL, MPI_REQUEST_NULL };
+      for (int r = 0, k = 0; r < nranks; r++)
+      {
+         ostringstream os;
+         PrintPart(*mesh, r, part, rank_elem, rank_bdr, *vert_ranks,
+                   edge_ranks, vert_stamp, vert_local, edge_stamp, face_stamp,
+                   os);
+         if (r == root)
+         {
+            part_str = os.str();
+            continue;
+         }
+         MPI_Wait(&req[k], MPI_STATUS_IGNORE);
+         buf[k] = os.str();
+         MPI_Isend(&buf[k][0], (int)buf[k].size(), MPI_CHAR, r, tag, comm,
+                   &req[k]);
+         k = 1 - k;
+      }
+      MPI_Waitall(2, req, MPI_STATUSES_IGNORE);
+
+      delete vert_ranks;
+      if (part != partitioning) { delete [] part; }
+   }
+   else
+   {
+      MPI_Status status;
+      int size;
+      MPI_Probe(root, tag, comm, &status);
+      MPI_Get_count(&status, MPI_CHAR, &size);
+      part_str.resize(size);
+      MPI_Recv(&part_str[0], size, MPI_CHAR, root, tag, comm,
+               MPI_STATUS_IGNORE);
+   }
+
+   istringstream is(part_str);
+   part_str.clear();
+   return LoadBinary(comm, is);
+}
+
 void ParMesh::Finalize(bool refine, bool fix_orientation)
 {
    const int meshgen_save = meshgen; // Mesh::Finalize() may call SetMeshGen()
@@ -3910,6 +4258,37 @@ void ParMesh::Rebalance(const Array<int> &partition)
    RebalanceImpl(&partition);
 }
 
+void ParMesh::Rebalance(const Vector &weights)
+{
+   MFEM_VERIFY(Nonconforming(), "Load balancing is currently not supported "
+               "for conforming meshes.");
+   MFEM_VERIFY(weights.Size() == GetNE(),
+               "the size of the weights must be the number of local elements");
+
+   // The local elements are a contiguous piece of the global space-filling
+   // sequence of elements: find the weight preceding them with a scan, then
+   // split the global sequence into pieces of equal weight.
+   double local = 0.0, first = 0.0, total = 0.0;
+   for (int i = 0; i < GetNE(); i++)
+   {
+      MFEM_VERIFY(weights(i) >= 0.0, "negative element weight");
+      local += weights(i);
+   }
+   MPI_Scan(&local, &first, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   first -= local;
+   MPI_Allreduce(&local, &total, 1, MPI_DOUBLE, MPI_SUM, MyComm);
+   MFEM_VERIFY(total > 0.0, "the element weights are all zero");
+
+   Array<int> partition(GetNE());
+   for (int i = 0; i < GetNE(); i++)
+   {
+      const int rank = (int)((first + 0.5*weights(i)) * NRanks / total);
+      partition[i] = std::min(rank, NRanks-1);
+      first += weights(i);
+   }
+   RebalanceImpl(&partition);
+}
+
 void ParMesh::RebalanceImpl(const Array<int> *partition)
 {
    if (Conforming())
@@ -5906,6 +6285,155 @@ void ParMesh::ParPrint(ostream &os) const
    os << "\nmfem_mesh_end" << endl;
 }
 
+void ParMesh::PrintBinary(ostream &os) const
+{
+   if (NURBSext || Nonconforming())
+   {
+      // Same header as Mesh::PrintBinary(), with the parallel text format and
+      // enough digits to restore the nodes exactly
+      ostringstream text;
+      text.precision(17);
+      ParPrint(text);
+      os << "MFEM binary mesh v1.0\n";
+      bin_io::write<int>(os, 1);
+      bin_io::WriteString(os, text.str());
+      return;
+   }
+
+   Mesh::PrintBinary(os);
+
+   // The shared entities, as in ParPrint(): the groups, the number of shared
+   // vertices, edges, triangles and quadrilaterals in each group, followed by
+   // their local vertices.
+   bin_io::write<int>(os, GetNGroups());
+   for (int gr = 0; gr < GetNGroups(); gr++)
+   {
+      const int size = gtopo.GetGroupSize(gr);
+      const int *group = gtopo.GetGroup(gr);
+      bin_io::write<int>(os, size);
+      for (int i = 0; i < size; i++)
+      {
+         bin_io::write<int>(os, gtopo.GetNeighborRank(group[i]));
+      }
+   }
+   const Table *group_sent[4] = { &group_svert, &group_sedge, &group_stria,
+                                  &group_squad
+                                };
+   for (int k = 0; k < 4; k++)
+   {
+      for (int gr = 1; gr < GetNGroups(); gr++)
+      {
+         bin_io::write<int>(os, group_sent[k]->RowSize(gr-1));
+      }
+   }
+   Array<int> v;
+   for (int gr = 1; gr < GetNGroups(); gr++)
+   {
+      for (int i = 0; i < group_svert.RowSize(gr-1); i++)
+      {
+         v.Append(svert_lvert[group_svert.GetRow(gr-1)[i]]);
+      }
+      for (int i = 0; i < group_sedge.RowSize(gr-1); i++)
+      {
+         v.Append(shared_edges[group_sedge.GetRow(gr-1)[i]]->GetVertices(), 2);
+      }
+      for (int i = 0; i < group_stria.RowSize(gr-1); i++)
+      {
+         v.Append(shared_trias[group_stria.GetRow(gr-1)[i]].v, 3);
+      }
+      for (int i = 0; i < group_squad.RowSize(gr-1); i++)
+      {
+         v.Append(shared_quads[group_squad.GetRow(gr-1)[i]].v, 4);
+      }
+   }
+   bin_io::write<int>(os, v.Size());
+   bin_io::write(os, v.GetData(), v.Size());
+}
+
+// Set the group-to-entity table 'group_ent' with consecutive entities and the
+// given number of entities in each group.
+static void MakeSharedTable(Table &group_ent, const Array<int> &counts)
+{
+   group_ent.SetDims(counts.Size(), counts.Sum());
+   int *I = group_ent.GetI(), *J = group_ent.GetJ();
+   I[0] = 0;
+   for (int gr = 0; gr < counts.Size(); gr++) { I[gr+1] = I[gr] + counts[gr]; }
+   for (int i = 0; i < I[counts.Size()]; i++) { J[i] = i; }
+}
+
+void ParMesh::LoadSharedEntitiesBinary(istream &input)
+{
+   const int ngroups = bin_io::read<int>(input);
+   ListOfIntegerSets integer_sets;
+   for (int gr = 0; gr < ngroups; gr++)
+   {
+      IntegerSet integer_set;
+      Array<int> &ranks = integer_set;
+      ranks.SetSize(bin_io::read<int>(input));
+      bin_io::read(input, ranks.GetData(), ranks.Size());
+      integer_sets.Insert(integer_set);
+   }
+   gtopo.Create(integer_sets, 823);
+
+   Array<int> counts[4];
+   for (int k = 0; k < 4; k++)
+   {
+      counts[k].SetSize(ngroups-1);
+      bin_io::read(input, counts[k].GetData(), ngroups-1);
+   }
+   MakeSharedTable(group_svert, counts[0]);
+   MakeSharedTable(group_sedge, counts[1]);
+   MakeSharedTable(group_stria, counts[2]);
+   MakeSharedTable(group_squad, counts[3]);
+   svert_lvert.SetSize(counts[0].Sum());
+   shared_edges.SetSize(counts[1].Sum());
+   sedge_ledge.SetSize(counts[1].Sum());
+   shared_trias.SetSize(counts[2].Sum());
+   shared_quads.SetSize(counts[3].Sum());
+   sface_lface.SetSize(shared_trias.Size() + shared_quads.Size());
+
+   Array<int> v(bin_io::read<int>(input));
+   bin_io::read(input, v.GetData(), v.Size());
+   MFEM_VERIFY(input, "error reading the binary parallel mesh");
+   int *vp = v.GetData(), sv = 0, se = 0, st = 0, sq = 0;
+   for (int gr = 1; gr < ngroups; gr++)
+   {
+      for (int i = 0; i < counts[0][gr-1]; i++) { svert_lvert[sv++] = *vp++; }
+      for (int i = 0; i < counts[1][gr-1]; i++, vp += 2)
+      {
+         shared_edges[se++] = new Segment(vp[0], vp[1], 1);
+      }
+      for (int i = 0; i < counts[2][gr-1]; i++, vp += 3)
+      {
+         shared_trias[st++].Set(vp);
+      }
+      for (int i = 0; i < counts[3][gr-1]; i++, vp += 4)
+      {
+         shared_quads[sq++].Set(vp);
+      }
+   }
+   MFEM_VERIFY(vp == v.GetData() + v.Size(), "invalid shared entities");
+}
+
+ParMesh ParMesh::LoadBinary(MPI_Comm comm, istream &input)
+{
+   ParMesh mesh;
+   mesh.MyComm = comm;
+   MPI_Comm_size(comm, &mesh.NRanks);
+   MPI_Comm_rank(comm, &mesh.MyRank);
+   mesh.gtopo.SetComm(comm);
+
+   // Same steps as in Load()
+   if (mesh.BinaryLoader(input))
+   {
+      mesh.ReduceMeshGen();
+      mesh.LoadSharedEntitiesBinary(input);
+      mesh.Finalize(true, true);
+      mesh.EnsureParNodes();
+   }
+   return mesh;
+}
+
 void ParMesh::PrintVTU(std::string pathname,
                        VTKFormat format,
                        bool high_order_output,
@@ -5975,13 +6503,16 @@ void ParMesh::PrintVTU(std::string pathname,
 
 int ParMesh::FindPoints(DenseMatrix& point_mat, Array<int>& elem_id,
                         Array<IntegrationPoint>& ip, bool warn,
-                        InverseElementTransformation *inv_trans)
+                        InverseElementTransformation *inv_trans,
+                        const ElementBVH *bvh)
 {
    const int npts = point_mat.Width();
    if (npts == 0) { return 0; }
 
+   // The points outside of the local elements are quickly discarded by the
+   // root box of the local spatial index
    const bool no_warn = false;
-   Mesh::FindPoints(point_mat, elem_id, ip, no_warn, inv_trans);
+   Mesh::FindPoints(point_mat, elem_id, ip, no_warn, inv_trans, bvh);
 
    // If multiple processors find the same point, we need to choose only one of
    // the processors to mark that point as found.
@@ -213,6 +213,20 @@ protected:
 
    void LoadSharedEntities(std::istream &input);
 
+   /// Read the shared entities written by PrintBinary().
+   void LoadSharedEntitiesBinary(std::istream &input);
+
+   /** Write the elements of the conforming serial @a mesh assigned to @a rank
+       in the binary mesh format read by LoadBinary(). Used in MakeDistributed(),
+       the work arrays are indexed by global vertex, edge and face and are
+       reused for all ranks. */
+   static void PrintPart(Mesh &mesh, int rank, const int *partitioning,
+                         const Table &rank_elem, const Table &rank_bdr,
+                         const Table &vert_ranks, const Table &edge_ranks,
+                         Array<int> &vert_stamp, Array<int> &vert_local,
+                         Array<int> &edge_stamp, Array<int> &face_stamp,
+                         std::ostream &os);
+
    /// If the mesh is curved, make sure 'Nodes' is ParGridFunction.
    /** Note that this method is not related to the public 'Mesh::EnsureNodes`.*/
    void EnsureParNodes();
@@ -236,9 +250,11 @@ public:
    /** The mesh is partitioned automatically or using external partitioning
        data (the optional parameter 'partitioning_[i]' contains the desired MPI
        rank for element 'i'). Automatic partitioning uses METIS for conforming
-       meshes and quick space-filling curve equipartitioning for nonconforming
-       meshes (elements of nonconforming meshes should ideally be ordered as a
-       sequence of face-neighbors). */
+       meshes (or the Hilbert curve partitioning when @a part_method is 6 or
+       MFEM is built without METIS, see Mesh::GeneratePartitioning()) and quick
+       space-filling curve equipartitioning for nonconforming meshes (elements
+       of nonconforming meshes should ideally be ordered as a sequence of
+       face-neighbors). */
    ParMesh(MPI_Comm comm, Mesh &mesh, int *partitioning_ = NULL,
            int part_method = 1);
 
@@ -282,6 +298,22 @@ public:
        See @a Mesh::MakeSimplicial for more details. */
    static ParMesh MakeSimplicial(ParMesh &orig_mesh);
 
+   /// Create a parallel mesh from a serial Mesh that only exists on one rank.
+   /** Unlike the ParMesh(MPI_Comm, Mesh&, int*, int) constructor, only the
+       rank @a root needs to hold the serial @a mesh (which can be NULL on the
+       other ranks). The root rank partitions the mesh (using @a partitioning
+       if given, otherwise Mesh::GeneratePartitioning() with @a part_method),
+       writes the part of each rank with its shared vertices, edges and faces
+       in the binary format of PrintBinary() and sends it to that rank, which
+       then only stores its local part. The partitioning and the extraction of
+       the parts remain serial on the root rank, overlapped only with the
+       sends. The result is the same as the one from the constructor, up to
+       the local ordering of the vertices. Only conforming, non-NURBS meshes
+       are supported. */
+   static ParMesh MakeDistributed(MPI_Comm comm, Mesh *mesh, int root = 0,
+                                  int *partitioning = NULL,
+                                  int part_method = 1);
+
    void Finalize(bool refine = false, bool fix_orientation = false) override;
 
    void SetAttributes() override;
@@ -457,9 +489,25 @@ public:
        for 0 <= i < GetNE(). */
    void Rebalance(const Array<int> &partition);
 
+   /** Load balance a nonconforming mesh by splitting the global space-filling
+       sequence of elements into pieces of equal total weight, where
+       'weights[i]' is the (non-negative) cost of the local element 'i', e.g.
+       from its polynomial order or refinement level. The partition is found
+       in parallel with a prefix sum, without gathering the mesh. */
+   void Rebalance(const Vector &weights);
+
    /// Save the mesh in a parallel mesh format.
    void ParPrint(std::ostream &out) const;
 
+   /** Write the local part of the mesh, including the shared entities, in the
+       binary mesh format, see Mesh::PrintBinary(). Nonconforming meshes are
+       stored in the text format of ParPrint(). */
+   void PrintBinary(std::ostream &os) const override;
+
+   /** Read a parallel mesh written with PrintBinary(), each MPI rank from its
+       own stream, as in ParMesh(MPI_Comm, std::istream&, bool). */
+   static ParMesh LoadBinary(MPI_Comm comm, std::istream &input);
+
    // Enable Print() to add the parallel interface as boundary (typically used
    // for visualization purposes)
    void SetPrintShared(bool print) { print_shared = print; }
@@ -527,7 +575,8 @@ public:
 
    int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                   Array<IntegrationPoint>& ips, bool warn = true,
-                  InverseElementTransformation *inv_trans = NULL) override;
+                  InverseElementTransformation *inv_trans = NULL,
+                  const ElementBVH *bvh = NULL) override;
 
    /// Debugging method
    void PrintSharedEntities(const char *fname_prefix) const;
@@ -1290,11 +1290,23 @@ void ParNCMesh::Refine(const Array<Refinement> &refinements)
    // send the messages (overlap with local refinements)
    NeighborRefinementMessage::IsendAll(send_ref, MyComm);
 
-   // do local refinements
+   // do local refinements, concurrently if they are all isotropic
+   Array<Refinement> local(refinements.Size());
    for (int i = 0; i < refinements.Size(); i++)
    {
       const Refinement &ref = refinements[i];
-      NCMesh::RefineElement(leaf_elements[ref.index], ref.ref_type);
+      local[i] = Refinement(leaf_elements[ref.index], ref.ref_type);
+   }
+   if (IsotropicBatch(local))
+   {
+      RefineIsotropic(local);
+   }
+   else
+   {
+      for (int i = 0; i < local.Size(); i++)
+      {
+         NCMesh::RefineElement(local[i].index, local[i].ref_type);
+      }
    }
 
    // receive (ghost layer) refinements from all neighbors
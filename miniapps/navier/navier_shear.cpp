@@ -114,12 +114,21 @@ int main(int argc, char *argv[])
    pvdc.SetDataFormat(VTKFormat::BINARY32);
    pvdc.SetHighOrderOutput(true);
    pvdc.SetLevelsOfDetail(ctx.order);
-   pvdc.SetCycle(0);
-   pvdc.SetTime(t);
-   pvdc.RegisterField("velocity", u_gf);
-   pvdc.RegisterField("pressure", p_gf);
-   pvdc.RegisterField("vorticity", &w_gf);
-   pvdc.Save();
+
+#ifdef MFEM_USE_THREADS
+   // Write the ParaView files on a background thread, while the time stepping
+   // continues
+   AsyncDataCollection adc(pvdc, pmesh);
+   DataCollection &dc = adc;
+#else
+   DataCollection &dc = pvdc;
+#endif
+   dc.SetCycle(0);
+   dc.SetTime(t);
+   dc.RegisterField("velocity", u_gf);
+   dc.RegisterField("pressure", p_gf);
+   dc.RegisterField("vorticity", &w_gf);
+   dc.Save();
 
    for (int step = 0; !last_step; ++step)
    {
@@ -133,9 +142,9 @@ int main(int argc, char *argv[])
       if (step % 10 == 0)
       {
          flowsolver.ComputeCurl2D(*u_gf, w_gf);
-         pvdc.SetCycle(step);
-         pvdc.SetTime(t);
-         pvdc.Save();
+         dc.SetCycle(step);
+         dc.SetTime(t);
+         dc.Save();
       }
 
       if (Mpi::Root())
@@ -7,6 +7,7 @@
 //               mpirun -np 4 ex1p -m ../../data/fichera.mesh -perf -asm -pc ho -sc
 //               mpirun -np 4 ex1p -m ../../data/fichera.mesh -std  -asm -pc ho
 //               mpirun -np 4 ex1p -m ../../data/fichera.mesh -std  -asm -pc ho -sc
+//               mpirun -np 4 ex1p -m ../../data/fichera.mesh -std  -mf  -pc lor
 //               mpirun -np 4 ex1p -m ../../data/amr-hex.mesh -perf -asm -pc ho -sc
 //               mpirun -np 4 ex1p -m ../../data/amr-hex.mesh -std  -asm -pc ho -sc
 //               mpirun -np 4 ex1p -m ../../data/ball-nurbs.mesh -perf -asm -pc ho  -sc
@@ -37,6 +38,13 @@
 //               discrete linear system. We also cover the explicit elimination
 //               of essential boundary conditions, static condensation, and the
 //               optional connection to the GLVis tool for visualization.
+//
+//               The standard matrix-free version (-std -mf) uses partial
+//               assembly with the fused operator action which overlaps the
+//               exchange of the shared dofs with the element computations
+//               (disable it with -no-fpa). Running it on a fixed mesh with an
+//               increasing number of processors, e.g. with -pc none, gives a
+//               strong scaling study of the "Time per CG step".
 
 #include "mfem-performance.hpp"
 #include <fstream>
@@ -82,7 +90,7 @@ struct ex1_t
 
    static int run(Mesh *mesh, int ser_ref_levels, int par_ref_levels, int order,
                   int basis, bool static_cond, PCType pc_choice, bool perf,
-                  bool matrix_free, bool visualization);
+                  bool matrix_free, bool fused, bool visualization);
 };
 
 int main(int argc, char *argv[])
@@ -106,6 +114,7 @@ int main(int argc, char *argv[])
    const char *pc = "lor";
    bool perf = true;
    bool matrix_free = true;
+   bool fused = true;
    bool visualization = 1;
 
    OptionsParser args(argc, argv);
@@ -125,7 +134,11 @@ int main(int argc, char *argv[])
                   "Enable high-performance, tensor-based, assembly/evaluation.");
    args.AddOption(&matrix_free, "-mf", "--matrix-free", "-asm", "--assembly",
                   "Use matrix-free evaluation or efficient matrix assembly in "
-                  "the high-performance version.");
+                  "the high-performance version, or partial assembly in the "
+                  "standard version.");
+   args.AddOption(&fused, "-fpa", "--fused-pa", "-no-fpa", "--no-fused-pa",
+                  "Use the fused partial assembly action in the standard "
+                  "matrix-free version.");
    args.AddOption(&pc, "-pc", "--preconditioner",
                   "Preconditioner: lor - low-order-refined (matrix-free) AMG, "
                   "ho - high-order (assembled) AMG, none.");
@@ -143,7 +156,7 @@ int main(int argc, char *argv[])
       }
       return 1;
    }
-   if (static_cond && perf && matrix_free)
+   if (static_cond && matrix_free)
    {
       if (myid == 0)
       {
@@ -152,8 +165,6 @@ int main(int argc, char *argv[])
       }
       return 2;
    }
-   MFEM_VERIFY(perf || !matrix_free,
-               "--standard-version is not compatible with --matrix-free");
    if (myid == 0)
    {
       args.PrintOptions(cout);
@@ -191,14 +202,14 @@ int main(int argc, char *argv[])
    if (dim == 2)
    {
       return ex1_t<2>::run(mesh, ser_ref_levels, par_ref_levels, order, basis,
-                           static_cond, pc_choice, perf, matrix_free,
+                           static_cond, pc_choice, perf, matrix_free, fused,
                            visualization);
    }
    else if (dim == 3)
    {
       return ex1_t<3>::run(mesh, ser_ref_levels, par_ref_levels, order,
                            basis, static_cond, pc_choice, perf, matrix_free,
-                           visualization);
+                           fused, visualization);
    }
    else
    {
@@ -211,7 +222,8 @@ int main(int argc, char *argv[])
 template <int dim>
 int ex1_t<dim>::run(Mesh *mesh, int ser_ref_levels, int par_ref_levels,
                     int order, int basis, bool static_cond, PCType pc_choice,
-                    bool perf, bool matrix_free, bool visualization)
+                    bool perf, bool matrix_free, bool fused,
+                    bool visualization)
 {
    int num_procs, myid;
    MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
@@ -399,6 +411,11 @@ int ex1_t<dim>::run(Mesh *mesh, int ser_ref_levels, int par_ref_levels,
    if (!perf)
    {
       // Standard assembly using a diffusion domain integrator
+      if (matrix_free)
+      {
+         a->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         a->EnableFusedPA(fused);
+      }
       a->AddDomainIntegrator(new DiffusionIntegrator(one));
       a->Assemble();
    }
@@ -436,6 +453,18 @@ int ex1_t<dim>::run(Mesh *mesh, int ser_ref_levels, int par_ref_levels,
          cout << "Size of linear system: " << glob_size << endl;
       }
    }
+   else if (matrix_free)
+   {
+      OperatorHandle A_pa;
+      a->FormLinearSystem(ess_tdof_list, x, *b, A_pa, X, B);
+      A_pa.SetOperatorOwner(false);
+      a_oper = A_pa.Ptr();
+      HYPRE_BigInt glob_size = fespace->GlobalTrueVSize();
+      if (myid == 0)
+      {
+         cout << "Size of linear system: " << glob_size << endl;
+      }
+   }
    else
    {
       a->FormLinearSystem(ess_tdof_list, x, *b, A, X, B);
@@ -473,7 +502,15 @@ int ex1_t<dim>::run(Mesh *mesh, int ser_ref_levels, int par_ref_levels,
       else
       {
          a_pc->UsePrecomputedSparsity();
-         a_hpc->AssembleBilinearForm(*a_pc);
+         if (perf)
+         {
+            a_hpc->AssembleBilinearForm(*a_pc);
+         }
+         else
+         {
+            a_pc->AddDomainIntegrator(new DiffusionIntegrator(one));
+            a_pc->Assemble();
+         }
          a_pc->FormSystemMatrix(ess_tdof_list, A_pc);
       }
    }
@@ -0,0 +1,311 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+/*
+  Setup and action of the bilinear form integrators with the different
+  assembly levels: LEGACY, FULL, ELEMENT, PARTIAL and NONE (matrix-free).
+
+  The benchmarks are named <Op>_<Integrator>_<dim>D, with Op being Assemble or
+  Mult, and their arguments are: the polynomial order p, the element type
+  (0: quadrilateral/hexahedron, 1: triangle/tetrahedron) and the AssemblyLevel.
+  Only the supported combinations are registered. All the integrators use a
+  Gauss-Legendre rule of order 2p+1 (or 2p for H(curl) and H(div)).
+
+  Reported counters:
+  - MDof/s: millions of (vector) degrees of freedom processed per second,
+  - GB/s: estimated memory traffic of the operator action, counting the
+    input/output vectors, the E-vectors and the data stored by the assembly
+    level (matrix, element matrices, or quadrature point data).
+*/
+
+enum Integ
+{
+   MASS, DIFFUSION, CONVECTION, VECTOR_DIFFUSION,
+   ND_MASS, CURL_CURL, RT_MASS, DIV_DIV
+};
+
+static bool IsH1(Integ integ) { return integ <= VECTOR_DIFFUSION; }
+
+/// Return true if the combination is supported by the integrator.
+static bool Supported(Integ integ, int dim, int p, bool simplex,
+                      AssemblyLevel level)
+{
+   // Keep the memory usage of the assembled matrices reasonable
+   const bool matrix = level == AssemblyLevel::LEGACY ||
+                       level == AssemblyLevel::FULL;
+   if (dim == 3 && matrix && p > 4) { return false; }
+   if (level == AssemblyLevel::LEGACY) { return true; }
+   // On simplices, only the mass and diffusion integrators support partial
+   // assembly, the other device assembly levels require tensor-product elements
+   if (simplex)
+   {
+      return (integ == MASS || integ == DIFFUSION) &&
+             level == AssemblyLevel::PARTIAL;
+   }
+   switch (integ)
+   {
+      case MASS: case DIFFUSION: case CONVECTION: return true;
+      case VECTOR_DIFFUSION:
+         return level == AssemblyLevel::PARTIAL || level == AssemblyLevel::NONE;
+      default: return level == AssemblyLevel::PARTIAL;
+   }
+}
+
+/// Number of values stored per quadrature point with AssemblyLevel::PARTIAL.
+static int QuadratureData(Integ integ, int dim)
+{
+   const int symm = dim*(dim+1)/2;
+   switch (integ)
+   {
+      case MASS: case DIV_DIV: return 1;
+      case CONVECTION: return dim;
+      case CURL_CURL: return (dim == 2) ? 1 : symm;
+      default: return symm;
+   }
+}
+
+static const char *level_name[] =
+{ "LEGACY", "FULL", "ELEMENT", "PARTIAL", "NONE" };
+
+struct Assembly
+{
+   const Integ integ;
+   const int p, dim;
+   const bool simplex;
+   const AssemblyLevel level;
+   const int N;
+   Mesh mesh;
+   std::unique_ptr<FiniteElementCollection> fec;
+   FiniteElementSpace fes;
+   const IntegrationRule &ir;
+   ConstantCoefficient one;
+   VectorConstantCoefficient velocity;
+   BilinearForm a;
+   GridFunction x, y;
+   const int dofs;
+   double mdofs, bytes, gbytes;
+
+   static Element::Type ElementType(int dim, bool simplex)
+   {
+      if (dim == 2)
+      {
+         return simplex ? Element::TRIANGLE : Element::QUADRILATERAL;
+      }
+      return simplex ? Element::TETRAHEDRON : Element::HEXAHEDRON;
+   }
+
+   static Vector Velocity(int dim)
+   {
+      Vector v(dim);
+      for (int d = 0; d < dim; d++) { v(d) = 1.0/(d+1); }
+      return v;
+   }
+
+   static FiniteElementCollection *NewFEC(Integ integ, int p, int dim)
+   {
+      if (IsH1(integ)) { return new H1_FECollection(p, dim); }
+      if (integ <= CURL_CURL) { return new ND_FECollection(p, dim); }
+      return new RT_FECollection(p-1, dim);
+   }
+
+   Assembly(Integ integ, int dim, int order, bool simplex, AssemblyLevel level):
+      integ(integ),
+      p(order),
+      dim(dim),
+      simplex(simplex),
+      level(level),
+      // About 2^15 dofs in 3D and 2^16 dofs in 2D
+      N(std::max(1, (dim == 3 ? 32 : 256)/(p*(simplex ? 2 : 1)))),
+      mesh(dim == 2 ?
+           Mesh::MakeCartesian2D(N, N, ElementType(dim, simplex), true) :
+           Mesh::MakeCartesian3D(N, N, N, ElementType(dim, simplex))),
+      fec(NewFEC(integ, p, dim)),
+      fes(&mesh, fec.get(), integ == VECTOR_DIFFUSION ? dim : 1),
+      ir(IntRules.Get(fes.GetFE(0)->GetGeomType(),
+                      2*p + (IsH1(integ) ? 1 : 0))),
+      one(1.0),
+      velocity(Velocity(dim)),
+      a(&fes),
+      x(&fes),
+      y(&fes),
+      dofs(fes.GetVSize()),
+      mdofs(0.0),
+      bytes(0.0),
+      gbytes(0.0)
+   {
+      x.Randomize(1);
+      a.SetAssemblyLevel(level);
+      a.AddDomainIntegrator(NewIntegrator());
+      Assemble();
+      Mult();
+      bytes = Bytes();
+      mdofs = gbytes = 0.0;
+   }
+
+   BilinearFormIntegrator *NewIntegrator()
+   {
+      BilinearFormIntegrator *bfi = nullptr;
+      switch (integ)
+      {
+         case MASS: bfi = new MassIntegrator(one); break;
+         case DIFFUSION: bfi = new DiffusionIntegrator(one); break;
+         case CONVECTION: bfi = new ConvectionIntegrator(velocity); break;
+         case VECTOR_DIFFUSION:
+            bfi = new VectorDiffusionIntegrator(one);
+            break;
+         case ND_MASS: case RT_MASS:
+            bfi = new VectorFEMassIntegrator(one);
+            break;
+         case CURL_CURL: bfi = new CurlCurlIntegrator(one); break;
+         case DIV_DIV: bfi = new DivDivIntegrator(one); break;
+      }
+      bfi->SetIntRule(&ir);
+      return bfi;
+   }
+
+   /// Estimated memory traffic of one operator action, in bytes.
+   double Bytes() const
+   {
+      const double d = sizeof(double), i = sizeof(int);
+      const double ne = fes.GetNE();
+      const double nd = fes.GetFE(0)->GetDof() * fes.GetVDim();
+      const double l_vecs = 2.0 * d * dofs;
+      const double e_vecs = 2.0 * d * ne * nd;
+      switch (level)
+      {
+         case AssemblyLevel::LEGACY:
+         case AssemblyLevel::FULL:
+         {
+            const SparseMatrix &A = a.SpMat();
+            return l_vecs + (d + i)*A.NumNonZeroElems() + i*(A.Height() + 1);
+         }
+         case AssemblyLevel::ELEMENT: return l_vecs + e_vecs + d*ne*nd*nd;
+         case AssemblyLevel::PARTIAL:
+            return l_vecs + e_vecs +
+                   d * ne * ir.GetNPoints() * QuadratureData(integ, dim);
+         default: return l_vecs + e_vecs;
+      }
+   }
+
+   void Assemble()
+   {
+      a.Update();
+      a.Assemble();
+      if (level == AssemblyLevel::LEGACY) { a.Finalize(); }
+      MFEM_DEVICE_SYNC;
+      mdofs += 1e-6 * dofs;
+   }
+
+   void Mult()
+   {
+      a.Mult(x, y);
+      MFEM_DEVICE_SYNC;
+      mdofs += 1e-6 * dofs;
+      gbytes += 1e-9 * bytes;
+   }
+};
+
+static void Args(bm::internal::Benchmark *b, Integ integ, int dim)
+{
+   for (int p = 1; p <= 8; p++)
+   {
+      for (int simplex = 0; simplex <= 1; simplex++)
+      {
+         for (int l = 0; l <= (int)AssemblyLevel::NONE; l++)
+         {
+            if (Supported(integ, dim, p, simplex, (AssemblyLevel)l))
+            {
+               b->Args({p, simplex, l});
+            }
+         }
+      }
+   }
+}
+
+#define Assembly_Benchmark(Op,KER,DIM)\
+static void Op##_##KER##_##DIM##D(bm::State &state){\
+   const int p = state.range(0);\
+   const bool simplex = state.range(1);\
+   const auto level = static_cast<AssemblyLevel>(state.range(2));\
+   Assembly ker(KER, DIM, p, simplex, level);\
+   while (state.KeepRunning()) { ker.Op(); }\
+   state.SetLabel(level_name[state.range(2)]);\
+   state.counters["MDof/s"] = bm::Counter(ker.mdofs, bm::Counter::kIsRate);\
+   state.counters["GB/s"] = bm::Counter(ker.gbytes, bm::Counter::kIsRate);\
+   state.counters["Dofs"] = bm::Counter(ker.dofs);}\
+BENCHMARK(Op##_##KER##_##DIM##D)\
+   ->Apply([](bm::internal::Benchmark *b) { Args(b, KER, DIM); })\
+   ->Unit(bm::kMillisecond);
+
+#define Assembly_Benchmarks(KER)\
+   Assembly_Benchmark(Assemble,KER,2)\
+   Assembly_Benchmark(Mult,KER,2)\
+   Assembly_Benchmark(Assemble,KER,3)\
+   Assembly_Benchmark(Mult,KER,3)
+
+/// Scalar H1 mass
+Assembly_Benchmarks(MASS)
+
+/// Scalar H1 diffusion
+Assembly_Benchmarks(DIFFUSION)
+
+/// Scalar H1 convection
+Assembly_Benchmarks(CONVECTION)
+
+/// Vector H1 diffusion
+Assembly_Benchmarks(VECTOR_DIFFUSION)
+
+/// H(curl) mass
+Assembly_Benchmarks(ND_MASS)
+
+/// H(curl) curl-curl
+Assembly_Benchmarks(CURL_CURL)
+
+/// H(div) mass
+Assembly_Benchmarks(RT_MASS)
+
+/// H(div) div-div
+Assembly_Benchmarks(DIV_DIV)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=Mult_DIFFUSION_3D/4
+ * --benchmark_context=device=cpu
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
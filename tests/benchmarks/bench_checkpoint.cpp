@@ -0,0 +1,143 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+#include <cstdio>
+
+/*
+  Save and load times of a mesh with two fields in the text format of
+  VisItDataCollection (0) and in the binary format of CheckpointDataCollection
+  (1), for a curved 3D mesh of order p = 1..4.
+
+  - Save_3D / Load_3D: one save or load of the whole collection. The MB/s
+    counter is based on the size of the raw data: the mesh nodes and the fields.
+*/
+
+enum Format { TEXT, BINARY };
+
+static const char *format_name[] = { "TEXT", "BINARY" };
+static const char *collection_name[] = { "bench-text", "bench-binary" };
+
+struct Checkpoint
+{
+   const int p;
+   const Format format;
+   const int N;
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes, vfes;
+   GridFunction u, w;
+   const std::string name;
+   std::unique_ptr<DataCollection> dc;
+   const int dofs;
+   double mbytes;
+
+   DataCollection *NewCollection(Mesh *m = nullptr) const
+   {
+      if (format == TEXT)
+      {
+         VisItDataCollection *visit_dc = new VisItDataCollection(name, m);
+         visit_dc->SetPrecision(16);
+         return visit_dc;
+      }
+      return new CheckpointDataCollection(name, m);
+   }
+
+   Checkpoint(int order, Format format):
+      p(order),
+      format(format),
+      // About 2^18 vector dofs
+      N(std::max(1, 64/p)),
+      mesh(Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON)),
+      fec(p, 3),
+      fes(&mesh, &fec),
+      vfes(&mesh, &fec, 3),
+      u(&fes),
+      w(&vfes),
+      name(collection_name[format]),
+      dc(NewCollection(&mesh)),
+      dofs(fes.GetVSize()),
+      mbytes(0.0)
+   {
+      mesh.SetCurvature(p);
+      u.Randomize(1);
+      w.Randomize(2);
+      dc->RegisterField("u", &u);
+      dc->RegisterField("w", &w);
+      dc->SetCycle(0);
+      dc->Save();
+   }
+
+   ~Checkpoint()
+   {
+      for (std::string file : {"mesh", "u", "w", "checkpoint"})
+      {
+         std::remove((name + "_000000/" + file + ".000000").c_str());
+      }
+      std::remove((name + "_000000.mfem_root").c_str());
+      std::remove((name + "_000000").c_str());
+   }
+
+   double MBytes() const
+   {
+      return 1e-6 * sizeof(double) *
+             (mesh.GetNodes()->Size() + u.Size() + w.Size());
+   }
+
+   void Save()
+   {
+      dc->Save();
+      MFEM_VERIFY(dc->Error() == DataCollection::NO_ERROR, "save failed");
+      mbytes += MBytes();
+   }
+
+   void Load()
+   {
+      std::unique_ptr<DataCollection> dc_new(NewCollection());
+      dc_new->Load(0);
+      MFEM_VERIFY(dc_new->Error() == DataCollection::NO_ERROR, "load failed");
+      mbytes += MBytes();
+   }
+};
+
+#define Checkpoint_Benchmark(Op)\
+static void Op##_3D(bm::State &state){\
+   const int p = state.range(0);\
+   const auto format = static_cast<Format>(state.range(1));\
+   Checkpoint ker(p, format);\
+   while (state.KeepRunning()) { ker.Op(); }\
+   state.SetLabel(format_name[format]);\
+   state.counters["MB/s"] = bm::Counter(ker.mbytes, bm::Counter::kIsRate);\
+   state.counters["Dofs"] = bm::Counter(ker.dofs);}\
+BENCHMARK(Op##_3D)\
+   ->ArgsProduct({bm::CreateDenseRange(1,4,1), {TEXT,BINARY}})\
+   ->Unit(bm::kMillisecond);
+
+Checkpoint_Benchmark(Save)
+Checkpoint_Benchmark(Load)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=Load_3D/2
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
@@ -0,0 +1,131 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#if defined(MFEM_USE_BENCHMARK) && defined(MFEM_USE_MPI)
+
+/*
+  Exchange of the shared degrees of freedom of a parallel H1 space with the
+  different GroupCommunicator modes: byGroup, byNeighbor and byNeighborhood.
+
+  The benchmarks are named <Op>_<dim>D, with Op being Bcast, Reduce or
+  BcastReduce, and their arguments are: the communication mode and the
+  polynomial order p. All the benchmarks use a fixed number of iterations, so
+  that all the ranks take part in the same collective calls; only the timings
+  of rank 0 are reported.
+
+  Example run:
+     mpirun -np 8 bench_comm --benchmark_filter=BcastReduce_3D
+*/
+
+static const char *mode_name[] = { "byGroup", "byNeighbor", "byNeighborhood" };
+
+struct Exchange
+{
+   const int p, dim;
+   const int N;
+   ParMesh pmesh;
+   H1_FECollection fec;
+   ParFiniteElementSpace pfes;
+   GroupCommunicator &gcomm;
+   Array<double> ldata;
+   const int dofs;
+
+   static ParMesh MakeParMesh(int dim, int N)
+   {
+      Mesh mesh = dim == 2 ?
+                  Mesh::MakeCartesian2D(N, N, Element::QUADRILATERAL) :
+                  Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON);
+      return ParMesh(MPI_COMM_WORLD, mesh);
+   }
+
+   Exchange(int dim, int order, GroupCommunicator::Mode mode):
+      p(order),
+      dim(dim),
+      // About 2^15 dofs per rank in 3D and 2^16 in 2D
+      N(std::max(1, (dim == 3 ? 32 : 256)/p)),
+      pmesh(MakeParMesh(dim, N)),
+      fec(p, dim),
+      pfes(&pmesh, &fec),
+      gcomm(pfes.GroupComm()),
+      ldata(pfes.GetVSize()),
+      dofs(pfes.GlobalTrueVSize())
+   {
+      gcomm.SetMode(mode);
+      for (int i = 0; i < ldata.Size(); i++) { ldata[i] = i; }
+   }
+
+   void Bcast() { gcomm.Bcast(ldata); }
+
+   void Reduce() { gcomm.Reduce<double>(ldata, GroupCommunicator::Sum); }
+
+   void BcastReduce() { Reduce(); Bcast(); }
+};
+
+// Reporter used by all the ranks except rank 0
+class NullReporter : public bm::BenchmarkReporter
+{
+public:
+   bool ReportContext(const Context&) { return true; }
+   void ReportRuns(const std::vector<Run>&) { }
+};
+
+static void Args(bm::internal::Benchmark *b)
+{
+   for (int mode = GroupCommunicator::byGroup;
+        mode <= GroupCommunicator::byNeighborhood; mode++)
+   {
+      for (int p = 1; p <= 4; p *= 2) { b->Args({mode, p}); }
+   }
+}
+
+#define Exchange_Benchmark(Op,DIM)\
+static void Op##_##DIM##D(bm::State &state){\
+   const auto mode = static_cast<GroupCommunicator::Mode>(state.range(0));\
+   const int p = state.range(1);\
+   Exchange ex(DIM, p, mode);\
+   while (state.KeepRunning()) { ex.Op(); }\
+   state.SetLabel(mode_name[state.range(0)]);\
+   state.counters["Dofs"] = bm::Counter(ex.dofs);}\
+BENCHMARK(Op##_##DIM##D)\
+   ->Apply(Args)\
+   ->Iterations(1000)\
+   ->Unit(bm::kMicrosecond);
+
+#define Exchange_Benchmarks(DIM)\
+   Exchange_Benchmark(Bcast,DIM)\
+   Exchange_Benchmark(Reduce,DIM)\
+   Exchange_Benchmark(BcastReduce,DIM)
+
+Exchange_Benchmarks(2)
+
+Exchange_Benchmarks(3)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=BcastReduce_3D
+ */
+int main(int argc, char *argv[])
+{
+   Mpi::Init(argc, argv);
+
+   bm::ConsoleReporter CR;
+   NullReporter NR;
+   bm::Initialize(&argc, argv);
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   if (Mpi::Root()) { bm::RunSpecifiedBenchmarks(&CR); }
+   else { bm::RunSpecifiedBenchmarks(&NR); }
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK && MFEM_USE_MPI
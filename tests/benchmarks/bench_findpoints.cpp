@@ -0,0 +1,217 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+/*
+  Point location with Mesh::FindPoints() on a curved 3D hexahedral mesh of
+  order p = 1, 2 with N^3 elements, for 4096 random points inside the mesh.
+
+  - FindPoints_<Method>_3D: BRUTE_FORCE is the previous algorithm, which
+    compares every point to every element center. BVH builds an ElementBVH in
+    each call, BVH_REUSE reuses a prebuilt one. The Points/s counter is the
+    number of points located per second.
+
+  - Update_BVH_3D: refit of the ElementBVH after mesh motion, compared with
+    Rebuild_BVH_3D, a full rebuild.
+*/
+
+enum Method { BRUTE_FORCE, BVH, BVH_REUSE };
+
+// Closest element center, then its vertex neighbors
+static int BruteForceFindPoints(Mesh &mesh, DenseMatrix &point_mat,
+                                Array<int> &elem_ids,
+                                Array<IntegrationPoint> &ips)
+{
+   const int npts = point_mat.Width(), sdim = mesh.SpaceDimension();
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+   elem_ids = -1;
+   InverseElementTransformation inv_tr;
+
+   Vector min_dist(npts);
+   Array<int> e_idx(npts);
+   min_dist = std::numeric_limits<double>::max();
+   e_idx = -1;
+   Vector pt(sdim);
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      mesh.GetElementTransformation(i)->Transform(
+         Geometries.GetCenter(mesh.GetElementBaseGeometry(i)), pt);
+      for (int k = 0; k < npts; k++)
+      {
+         const double dist = pt.DistanceTo(point_mat.GetColumn(k));
+         if (dist < min_dist(k))
+         {
+            min_dist(k) = dist;
+            e_idx[k] = i;
+         }
+      }
+   }
+
+   int pts_found = 0;
+   std::unique_ptr<Table> vtoel(mesh.GetVertexToElementTable());
+   Array<int> elvertices;
+   for (int k = 0; k < npts; k++)
+   {
+      pt.SetDataAndSize(point_mat.GetColumn(k), sdim);
+      inv_tr.SetTransformation(*mesh.GetElementTransformation(e_idx[k]));
+      if (inv_tr.Transform(pt, ips[k]) == InverseElementTransformation::Inside)
+      {
+         elem_ids[k] = e_idx[k];
+         pts_found++;
+         continue;
+      }
+      mesh.GetElementVertices(e_idx[k], elvertices);
+      for (int v = 0; v < elvertices.Size() && elem_ids[k] < 0; v++)
+      {
+         const int *els = vtoel->GetRow(elvertices[v]);
+         for (int e = 0; e < vtoel->RowSize(elvertices[v]); e++)
+         {
+            inv_tr.SetTransformation(*mesh.GetElementTransformation(els[e]));
+            if (inv_tr.Transform(pt, ips[k]) ==
+                InverseElementTransformation::Inside)
+            {
+               elem_ids[k] = els[e];
+               pts_found++;
+               break;
+            }
+         }
+      }
+   }
+   return pts_found;
+}
+
+struct FindPoints
+{
+   const int p, N, npts;
+   Mesh mesh;
+   DenseMatrix points;
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   std::unique_ptr<ElementBVH> bvh;
+   double points_located;
+
+   static void Deform(const Vector &x, Vector &y)
+   {
+      y = x;
+      y(0) += 0.05*sin(2.0*M_PI*x(1));
+      y(1) += 0.05*sin(2.0*M_PI*x(2));
+      y(2) += 0.05*sin(2.0*M_PI*x(0));
+   }
+
+   FindPoints(int order, int n):
+      p(order),
+      N(n),
+      npts(4096),
+      mesh(Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON)),
+      points(3, npts),
+      points_located(0.0)
+   {
+      mesh.SetCurvature(p);
+      mesh.Transform(Deform);
+      // Random points in random elements
+      srand(1);
+      for (int k = 0; k < npts; k++)
+      {
+         IntegrationPoint ip;
+         ip.Set3(rand()/(RAND_MAX + 1.0), rand()/(RAND_MAX + 1.0),
+                 rand()/(RAND_MAX + 1.0));
+         Vector x(points.GetColumn(k), 3);
+         mesh.GetElementTransformation(rand() % mesh.GetNE())->Transform(ip, x);
+      }
+      bvh.reset(new ElementBVH(mesh));
+   }
+
+   void Find(Method method)
+   {
+      int found = 0;
+      switch (method)
+      {
+         case BRUTE_FORCE:
+            found = BruteForceFindPoints(mesh, points, elem_ids, ips);
+            break;
+         case BVH:
+            found = mesh.FindPoints(points, elem_ids, ips, false);
+            break;
+         case BVH_REUSE:
+            found = mesh.FindPoints(points, elem_ids, ips, false, NULL,
+                                    bvh.get());
+            break;
+      }
+      MFEM_VERIFY(found == npts, "points not found: " << npts - found);
+      points_located += npts;
+   }
+};
+
+#define FindPoints_Benchmark(METHOD)\
+static void FindPoints_##METHOD##_3D(bm::State &state){\
+   const int p = state.range(0);\
+   const int N = state.range(1);\
+   FindPoints ker(p, N);\
+   while (state.KeepRunning()) { ker.Find(METHOD); }\
+   state.counters["Points/s"] =\
+      bm::Counter(ker.points_located, bm::Counter::kIsRate);\
+   state.counters["NE"] = bm::Counter(ker.mesh.GetNE());}\
+BENCHMARK(FindPoints_##METHOD##_3D)\
+   ->ArgsProduct({{1,2}, {8,16,32}})\
+   ->Unit(bm::kMillisecond);
+
+FindPoints_Benchmark(BRUTE_FORCE)
+FindPoints_Benchmark(BVH)
+FindPoints_Benchmark(BVH_REUSE)
+
+#define BVH_Benchmark(OP)\
+static void OP##_BVH_3D(bm::State &state){\
+   const int p = state.range(0);\
+   const int N = state.range(1);\
+   FindPoints ker(p, N);\
+   while (state.KeepRunning()) { ker.bvh->OP(); }\
+   state.counters["NE"] = bm::Counter(ker.mesh.GetNE());}\
+BENCHMARK(OP##_BVH_3D)\
+   ->ArgsProduct({{1,2}, {8,16,32}})\
+   ->Unit(bm::kMillisecond);
+
+BVH_Benchmark(Update)
+BVH_Benchmark(Rebuild)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=FindPoints_BVH_3D/2/32
+ * --benchmark_context=device=cpu
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
@@ -0,0 +1,152 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+/*
+  Inverse transformation of 2^16 random points, each in a known element of a
+  curved 3D hexahedral mesh of order p = 1..4 with 16^3 elements.
+
+  - InvTrans_SCALAR_3D: one InverseElementTransformation::Transform() per
+    point, through the virtual ElementTransformation interface.
+
+  - InvTrans_BATCH_3D: BatchInverseElementTransformation::Transform() of all
+    the points, in a single tensor product kernel. The Points/s counter is the
+    number of points mapped per second.
+*/
+
+enum Method { SCALAR, BATCH };
+
+struct InvTrans
+{
+   const int p, N, npts;
+   Mesh mesh;
+   Vector points, refs;
+   Array<int> elems, types;
+   BatchInverseElementTransformation batch;
+   double points_mapped;
+
+   static void Deform(const Vector &x, Vector &y)
+   {
+      y = x;
+      y(0) += 0.05*sin(2.0*M_PI*x(1));
+      y(1) += 0.05*sin(2.0*M_PI*x(2));
+      y(2) += 0.05*sin(2.0*M_PI*x(0));
+   }
+
+   static Mesh MakeMesh(int p, int N)
+   {
+      Mesh mesh = Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON);
+      mesh.SetCurvature(p);
+      mesh.Transform(Deform);
+      return mesh;
+   }
+
+   InvTrans(int order):
+      p(order),
+      N(16),
+      npts(1 << 16),
+      mesh(MakeMesh(p, N)),
+      points(3*npts),
+      refs(3*npts),
+      elems(npts),
+      types(npts),
+      batch(mesh),
+      points_mapped(0.0)
+   {
+      MFEM_VERIFY(batch.UsesTensorKernels(), "tensor kernels not used");
+      // Random points in random elements, ordered by nodes
+      srand(1);
+      Vector x(3);
+      for (int k = 0; k < npts; k++)
+      {
+         IntegrationPoint ip;
+         ip.Set3(rand()/(RAND_MAX + 1.0), rand()/(RAND_MAX + 1.0),
+                 rand()/(RAND_MAX + 1.0));
+         elems[k] = rand() % mesh.GetNE();
+         mesh.GetElementTransformation(elems[k])->Transform(ip, x);
+         for (int d = 0; d < 3; d++) { points(k + npts*d) = x(d); }
+      }
+      points.UseDevice(true);
+      refs.UseDevice(true);
+   }
+
+   void Scalar()
+   {
+      InverseElementTransformation inv_tr;
+      IntegrationPoint ip;
+      Vector x(3);
+      const double *P = points.HostRead();
+      const int *E = elems.HostRead();
+      int *T = types.HostWrite();
+      for (int k = 0; k < npts; k++)
+      {
+         for (int d = 0; d < 3; d++) { x(d) = P[k + npts*d]; }
+         inv_tr.SetTransformation(*mesh.GetElementTransformation(E[k]));
+         T[k] = inv_tr.Transform(x, ip);
+      }
+   }
+
+   void Transform(Method method)
+   {
+      if (method == SCALAR) { Scalar(); }
+      else { batch.Transform(points, elems, Ordering::byNODES, types, refs); }
+      MFEM_DEVICE_SYNC;
+      points_mapped += npts;
+   }
+};
+
+#define InvTrans_Benchmark(METHOD)\
+static void InvTrans_##METHOD##_3D(bm::State &state){\
+   const int p = state.range(0);\
+   InvTrans ker(p);\
+   while (state.KeepRunning()) { ker.Transform(METHOD); }\
+   state.counters["Points/s"] =\
+      bm::Counter(ker.points_mapped, bm::Counter::kIsRate);}\
+BENCHMARK(InvTrans_##METHOD##_3D)\
+   ->DenseRange(1,4,1)\
+   ->Unit(bm::kMillisecond);
+
+InvTrans_Benchmark(SCALAR)
+InvTrans_Benchmark(BATCH)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=InvTrans_BATCH_3D/2
+ * --benchmark_context=device=cpu
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
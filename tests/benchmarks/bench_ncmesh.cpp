@@ -0,0 +1,202 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
+/*
+  Hash tables of NCMesh and nonconforming refinement.
+
+  - Hash_CHAINED / Hash_OPEN: the node keys of a structured m^3 grid, (v, v)
+    for the vertices and (v1, v2) for the edges, with 2^16..2^24 keys, stored
+    in HashTable and in OpenHashTable. Each iteration inserts all the keys,
+    finds them, finds as many absent keys, and deletes and reinserts every
+    other key. The Ops/s counter is the number of operations per second, and
+    Bytes/item the memory of the table divided by the number of items.
+
+  - NCRefine_2D / NCRefine_3D: uniform nonconforming refinement of a 16x16
+    quadrilateral or 4x4x4 hexahedral mesh, repeated 'level' times, up to
+    16.7M quadrilaterals or 2.1M hexahedra, with the Update() of an H1
+    FiniteElementSpace and its conforming prolongation after each refinement.
+    The counters are the final number of elements, the elements created per
+    second and the memory of the NCMesh in MB.
+
+  - NCRefine_Threads: with MFEM_USE_OPENMP, NCRefine_3D with 4 levels and 1
+    to omp_get_max_threads() threads. The threads share the isotropic
+    refinements themselves and the lookups of the faces and edges of the leaf
+    elements that follow each refinement.
+*/
+
+struct Item : public Hashed2 { };
+
+template <typename Table>
+struct HashKeys
+{
+   const int m, nkeys;
+   Array<int> p1, p2;
+   double ops;
+   long memory;
+
+   HashKeys(int log2_keys):
+      m((int) std::ceil(std::cbrt((1 << log2_keys)/4.0))),
+      nkeys(1 << log2_keys),
+      p1(nkeys),
+      p2(nkeys),
+      ops(0.0),
+      memory(0)
+   {
+      // vertex keys (v, v) and edge keys (v, v + 1), (v, v + m), (v, v + m^2)
+      const int stride[4] = { 0, 1, m, m*m };
+      for (int k = 0; k < nkeys; k++)
+      {
+         p1[k] = k/4;
+         p2[k] = k/4 + stride[k % 4];
+      }
+   }
+
+   void Run()
+   {
+      Table table;
+      for (int k = 0; k < nkeys; k++) { table.GetId(p1[k], p2[k]); }
+      int found = 0;
+      for (int k = 0; k < nkeys; k++)
+      {
+         found += (table.FindId(p2[k], p1[k]) >= 0);
+         found += (table.FindId(p1[k], p2[k] + nkeys) >= 0);
+      }
+      MFEM_VERIFY(found == nkeys, "wrong number of keys found");
+      for (int k = 0; k < nkeys; k += 2)
+      {
+         table.Delete(table.FindId(p1[k], p2[k]));
+      }
+      for (int k = 0; k < nkeys; k += 2) { table.GetId(p1[k], p2[k]); }
+      MFEM_VERIFY(table.Size() == nkeys, "wrong number of items");
+      memory = table.MemoryUsage();
+      ops += 5.0*nkeys;
+   }
+};
+
+#define Hash_Benchmark(NAME, TABLE)\
+static void Hash_##NAME(bm::State &state){\
+   HashKeys<TABLE<Item> > ker(state.range(0));\
+   while (state.KeepRunning()) { ker.Run(); }\
+   state.counters["Ops/s"] = bm::Counter(ker.ops, bm::Counter::kIsRate);\
+   state.counters["Bytes/item"] = bm::Counter((double) ker.memory/ker.nkeys);}\
+BENCHMARK(Hash_##NAME)\
+   ->DenseRange(16,24,4)\
+   ->Unit(bm::kMillisecond);
+
+Hash_Benchmark(CHAINED, HashTable)
+Hash_Benchmark(OPEN, OpenHashTable)
+
+struct NCRefine
+{
+   const int dim, levels;
+   double elements, created;
+   long memory;
+
+   NCRefine(int dim, int levels):
+      dim(dim),
+      levels(levels),
+      elements(0.0),
+      created(0.0),
+      memory(0)
+   { }
+
+   void Run()
+   {
+      Mesh mesh = (dim == 2) ?
+                  Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL) :
+                  Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+      mesh.EnsureNCMesh();
+      H1_FECollection fec(1, dim);
+      FiniteElementSpace fes(&mesh, &fec);
+      for (int l = 0; l < levels; l++)
+      {
+         mesh.UniformRefinement();
+         fes.Update(false);
+         fes.GetConformingProlongation();
+      }
+      elements = mesh.GetNE();
+      created += elements;
+      memory = mesh.ncmesh->MemoryUsage();
+   }
+};
+
+#define NCRefine_Benchmark(DIM, MAX_LEVEL)\
+static void NCRefine_##DIM##D(bm::State &state){\
+   NCRefine ker(DIM, state.range(0));\
+   while (state.KeepRunning()) { ker.Run(); }\
+   state.counters["Elements"] = bm::Counter(ker.elements);\
+   state.counters["Elements/s"] =\
+      bm::Counter(ker.created, bm::Counter::kIsRate);\
+   state.counters["NCMesh_MB"] = bm::Counter(ker.memory/1048576.0);}\
+BENCHMARK(NCRefine_##DIM##D)\
+   ->DenseRange(2,MAX_LEVEL,2)\
+   ->Unit(bm::kMillisecond);
+
+NCRefine_Benchmark(2,8)
+NCRefine_Benchmark(3,5)
+
+#ifdef MFEM_USE_OPENMP
+static void NCRefine_Threads(bm::State &state)
+{
+   const int nt = state.range(1);
+   const int max_nt = omp_get_max_threads();
+   if (nt > max_nt) { state.SkipWithError("not enough threads"); return; }
+   omp_set_num_threads(nt);
+   NCRefine ker(3, state.range(0));
+   while (state.KeepRunning()) { ker.Run(); }
+   omp_set_num_threads(max_nt);
+   state.counters["Elements"] = bm::Counter(ker.elements);
+   state.counters["Elements/s"] =
+      bm::Counter(ker.created, bm::Counter::kIsRate);
+}
+BENCHMARK(NCRefine_Threads)
+   ->ArgsProduct({{4}, bm::CreateRange(1, omp_get_max_threads(), 2)})
+   ->Unit(bm::kMillisecond);
+#endif
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=NCRefine_2D/6
+ * --benchmark_context=device=cpu
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
@@ -0,0 +1,124 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#if defined(MFEM_USE_BENCHMARK) && defined(MFEM_USE_OPENMP)
+
+#include <omp.h>
+
+/*
+  Thread scaling of the mass and diffusion partial assembly kernels with the
+  OpenMP backend, for each OmpSchedule type. The arguments of the benchmarks
+  are: the polynomial order, the OmpSchedule::Type and the number of threads.
+*/
+
+template <typename BFI>
+struct PAKernel
+{
+   const int p, N, dim = 3;
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes;
+   const int dofs;
+   ConstantCoefficient one;
+   BilinearForm a;
+   GridFunction x, y;
+   double mdofs;
+
+   PAKernel(int order):
+      p(order),
+      N(std::max(2, 32/order)),
+      mesh(Mesh::MakeCartesian3D(N,N,N,Element::HEXAHEDRON)),
+      fec(p, dim),
+      fes(&mesh, &fec),
+      dofs(fes.GetTrueVSize()),
+      one(1.0),
+      a(&fes),
+      x(&fes),
+      y(&fes),
+      mdofs(0.0)
+   {
+      x.Randomize(1);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(new BFI(one));
+      a.Assemble();
+      a.Mult(x, y);
+   }
+
+   void benchmark()
+   {
+      a.Mult(x, y);
+      mdofs += 1e-6 * dofs;
+   }
+};
+
+static const char *schedule_name[] =
+{ "static", "dynamic", "guided", "runtime", "tasks" };
+
+#define Omp_Benchmark(KER)\
+static void OMP_##KER(bm::State &state){\
+   const int order = state.range(0);\
+   const auto type = static_cast<OmpSchedule::Type>(state.range(1));\
+   const int nt = state.range(2);\
+   const int max_nt = omp_get_max_threads();\
+   if (nt > max_nt) { state.SkipWithError("not enough threads"); return; }\
+   OmpSchedule::Set(type);\
+   omp_set_num_threads(nt);\
+   PAKernel<KER##Integrator> ker(order);\
+   while (state.KeepRunning()) { ker.benchmark(); }\
+   omp_set_num_threads(max_nt);\
+   OmpSchedule::Set(OmpSchedule::STATIC);\
+   state.SetLabel(schedule_name[type]);\
+   state.counters["MDof/s"] = bm::Counter(ker.mdofs, bm::Counter::kIsRate);}\
+BENCHMARK(OMP_##KER)\
+   ->ArgsProduct({{2,4,6},\
+                  {OmpSchedule::STATIC, OmpSchedule::DYNAMIC,\
+                   OmpSchedule::GUIDED, OmpSchedule::TASKS},\
+                  bm::CreateRange(1, omp_get_max_threads(), 2)})\
+   ->Unit(bm::kMillisecond);
+
+/// Mass PA kernel
+Omp_Benchmark(Mass)
+
+/// Diffusion PA kernel
+Omp_Benchmark(Diffusion)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=OMP_Diffusion/4
+ * --benchmark_context=device=omp
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, omp by default
+   std::string device_config = "omp";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK && MFEM_USE_OPENMP
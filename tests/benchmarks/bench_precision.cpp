@@ -0,0 +1,254 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+/*
+  Speed and accuracy of the single precision partial assembly data, see
+  NonlinearFormIntegrator::SetPASinglePrecision().
+
+  - Mult_<Integrator>_<dim>D: action of the PA operator with double (0) or
+    single (1) precision quadrature data, for the polynomial orders p = 1..8.
+    The RelErr counter is the relative difference with the double precision
+    action.
+
+  - Solve_<Smoother>_3D: double precision PCG solve of a diffusion problem,
+    preconditioned by a Jacobi or Chebyshev smoother that uses either the
+    double precision operator and diagonal (0), or the single precision ones
+    (1). The Iterations counter shows the effect on the convergence.
+*/
+
+enum Integ { MASS, DIFFUSION };
+enum Smoother { JACOBI, CHEBYSHEV };
+
+static BilinearFormIntegrator *NewIntegrator(Integ integ, bool single)
+{
+   BilinearFormIntegrator *bfi = nullptr;
+   if (integ == MASS) { bfi = new MassIntegrator; }
+   else { bfi = new DiffusionIntegrator; }
+   bfi->SetPASinglePrecision(single);
+   return bfi;
+}
+
+struct PAPrecision
+{
+   const int p, dim;
+   const bool single;
+   const int N;
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes;
+   BilinearForm a;
+   GridFunction x, y;
+   const int dofs;
+   double mdofs, bytes, gbytes, rel_err;
+
+   PAPrecision(Integ integ, int dim, int order, bool single):
+      p(order),
+      dim(dim),
+      single(single),
+      // About 2^15 dofs in 3D and 2^16 dofs in 2D
+      N(std::max(1, (dim == 3 ? 32 : 256)/p)),
+      mesh(dim == 2 ?
+           Mesh::MakeCartesian2D(N, N, Element::QUADRILATERAL, true) :
+           Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON)),
+      fec(p, dim),
+      fes(&mesh, &fec),
+      a(&fes),
+      x(&fes),
+      y(&fes),
+      dofs(fes.GetVSize()),
+      mdofs(0.0),
+      bytes(0.0),
+      gbytes(0.0),
+      rel_err(0.0)
+   {
+      x.Randomize(1);
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(NewIntegrator(integ, single));
+      a.Assemble();
+
+      BilinearForm a_ref(&fes);
+      a_ref.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_ref.AddDomainIntegrator(NewIntegrator(integ, false));
+      a_ref.Assemble();
+      GridFunction y_ref(&fes);
+      a_ref.Mult(x, y_ref);
+      a.Mult(x, y);
+      y -= y_ref;
+      rel_err = y.Normlinf() / y_ref.Normlinf();
+
+      const double ne = fes.GetNE();
+      const double nd = fes.GetFE(0)->GetDof();
+      const double nq = pow(p+1, dim);
+      const double nc = integ == MASS ? 1 : dim*(dim+1)/2;
+      const double d = sizeof(double);
+      const double s = single ? sizeof(float) : sizeof(double);
+      bytes = 2.0*d*dofs + 2.0*d*ne*nd + s*ne*nq*nc;
+   }
+
+   void Mult()
+   {
+      a.Mult(x, y);
+      MFEM_DEVICE_SYNC;
+      mdofs += 1e-6 * dofs;
+      gbytes += 1e-9 * bytes;
+   }
+};
+
+#define Precision_Benchmark(KER,DIM)\
+static void Mult_##KER##_##DIM##D(bm::State &state){\
+   const int p = state.range(0);\
+   const bool single = state.range(1);\
+   PAPrecision ker(KER, DIM, p, single);\
+   while (state.KeepRunning()) { ker.Mult(); }\
+   state.counters["MDof/s"] = bm::Counter(ker.mdofs, bm::Counter::kIsRate);\
+   state.counters["GB/s"] = bm::Counter(ker.gbytes, bm::Counter::kIsRate);\
+   state.counters["RelErr"] = bm::Counter(ker.rel_err);\
+   state.counters["Dofs"] = bm::Counter(ker.dofs);}\
+BENCHMARK(Mult_##KER##_##DIM##D)\
+   ->ArgsProduct({bm::CreateDenseRange(1,8,1), {0,1}})\
+   ->Unit(bm::kMillisecond);
+
+Precision_Benchmark(MASS,2)
+Precision_Benchmark(MASS,3)
+Precision_Benchmark(DIFFUSION,2)
+Precision_Benchmark(DIFFUSION,3)
+
+struct SmootherPrecision
+{
+   const int p, N;
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes;
+   Array<int> ess_tdof_list;
+   BilinearForm a, a_prec;
+   OperatorPtr A, A_prec;
+   Vector diag, b, x;
+   std::unique_ptr<Solver> S;
+   CGSolver cg;
+   const int dofs;
+   double mdofs;
+   int iterations;
+
+   SmootherPrecision(Smoother smoother, int order, bool single):
+      p(order),
+      N(std::max(1, 32/p)),
+      mesh(Mesh::MakeCartesian3D(N, N, N, Element::HEXAHEDRON)),
+      fec(p, 3),
+      fes(&mesh, &fec),
+      a(&fes),
+      a_prec(&fes),
+      cg(),
+      dofs(fes.GetTrueVSize()),
+      mdofs(0.0),
+      iterations(0)
+   {
+      Array<int> ess_bdr(mesh.bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      // The outer solver always uses the double precision operator
+      a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a.AddDomainIntegrator(NewIntegrator(DIFFUSION, false));
+      a.Assemble();
+      a.FormSystemMatrix(ess_tdof_list, A);
+
+      a_prec.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a_prec.AddDomainIntegrator(NewIntegrator(DIFFUSION, single));
+      a_prec.Assemble();
+      a_prec.FormSystemMatrix(ess_tdof_list, A_prec);
+
+      diag.SetSize(dofs);
+      a_prec.AssembleDiagonal(diag);
+      if (smoother == JACOBI)
+      {
+         auto J = new OperatorJacobiSmoother(diag, ess_tdof_list);
+         J->SetSinglePrecision(single);
+         S.reset(J);
+      }
+      else
+      {
+         auto C = new OperatorChebyshevSmoother(*A_prec, diag, ess_tdof_list, 3);
+         C->SetSinglePrecision(single);
+         S.reset(C);
+      }
+
+      b.SetSize(dofs);
+      b.Randomize(1);
+      b.SetSubVector(ess_tdof_list, 0.0);
+      x.SetSize(dofs);
+
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(1000);
+      cg.SetOperator(*A);
+      cg.SetPreconditioner(*S);
+   }
+
+   void Solve()
+   {
+      x = 0.0;
+      cg.Mult(b, x);
+      MFEM_DEVICE_SYNC;
+      MFEM_VERIFY(cg.GetConverged(), "PCG did not converge");
+      iterations = cg.GetNumIterations();
+      mdofs += 1e-6 * dofs;
+   }
+};
+
+#define Smoother_Benchmark(SMOOTHER)\
+static void Solve_##SMOOTHER##_3D(bm::State &state){\
+   const int p = state.range(0);\
+   const bool single = state.range(1);\
+   SmootherPrecision ker(SMOOTHER, p, single);\
+   while (state.KeepRunning()) { ker.Solve(); }\
+   state.counters["MDof/s"] = bm::Counter(ker.mdofs, bm::Counter::kIsRate);\
+   state.counters["Iterations"] = bm::Counter(ker.iterations);\
+   state.counters["Dofs"] = bm::Counter(ker.dofs);}\
+BENCHMARK(Solve_##SMOOTHER##_3D)\
+   ->ArgsProduct({bm::CreateDenseRange(1,4,1), {0,1}})\
+   ->Unit(bm::kMillisecond);
+
+Smoother_Benchmark(JACOBI)
+Smoother_Benchmark(CHEBYSHEV)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=Mult_DIFFUSION_3D/4
+ * --benchmark_context=device=cpu
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "bench.hpp"
+
+#ifdef MFEM_USE_BENCHMARK
+
+/*
+  SpMV benchmarks with legacy assembled H1 stiffness matrices: y = A x and
+  y = A^T x, using the CSR or the SELL-C-sigma storage (SparseMatrix::BuildSELL)
+  for y = A x. With --benchmark_context=device=omp the threaded host kernels of
+  SparseMatrix are used.
+*/
+
+struct SpMV
+{
+   const int p, N, dim = 3;
+   Mesh mesh;
+   H1_FECollection fec;
+   FiniteElementSpace fes;
+   const int dofs;
+   BilinearForm a;
+   ConstantCoefficient one;
+   Vector x, y;
+   double mdofs;
+   const int sigma = 64;
+
+   SpMV(int order):
+      p(order),
+      N(std::max(2, 24/order)),
+      mesh(Mesh::MakeCartesian3D(N,N,N,Element::HEXAHEDRON)),
+      fec(p, dim),
+      fes(&mesh, &fec),
+      dofs(fes.GetVSize()),
+      a(&fes),
+      one(1.0),
+      x(dofs),
+      y(dofs),
+      mdofs(0.0)
+   {
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.Assemble();
+      a.Finalize();
+      x.Randomize(1);
+      Check();
+   }
+
+   /// Compare the backend results with a sequential reference computation.
+   void Check()
+   {
+      const SparseMatrix &A = a.SpMat();
+      const int *I = A.HostReadI(), *J = A.HostReadJ();
+      const double *V = A.HostReadData();
+      Vector z(dofs), zt(dofs);
+      z = 0.0; zt = 0.0;
+      const double *X = x.HostRead();
+      for (int i = 0; i < dofs; i++)
+      {
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            z(i) += V[k] * X[J[k]];
+            zt(J[k]) += V[k] * X[i];
+         }
+      }
+      A.Mult(x, y);
+      z -= y;
+      MFEM_VERIFY(z.Normlinf() < 1e-12 * zt.Normlinf() + 1e-12, "Mult");
+      A.EnsureMultTranspose();
+      A.MultTranspose(x, y);
+      y -= zt;
+      MFEM_VERIFY(y.Normlinf() < 1e-12 * zt.Normlinf() + 1e-12,
+                  "MultTranspose");
+   }
+
+   void Mult()
+   {
+      a.SpMat().Mult(x, y);
+      MFEM_DEVICE_SYNC;
+      mdofs += 1e-6 * dofs;
+   }
+
+   void MultSELL()
+   {
+      a.SpMat().BuildSELL(sigma);
+      Mult();
+   }
+
+   void MultTranspose()
+   {
+      a.SpMat().MultTranspose(x, y);
+      MFEM_DEVICE_SYNC;
+      mdofs += 1e-6 * dofs;
+   }
+};
+
+#define SpMV_Benchmark(op)\
+static void SpMV_##op(bm::State &state){\
+   SpMV spmv(state.range(0));\
+   while (state.KeepRunning()) { spmv.op(); }\
+   state.counters["MDof/s"] = bm::Counter(spmv.mdofs, bm::Counter::kIsRate);\
+   state.counters["NNZ"] = bm::Counter(spmv.a.SpMat().NumNonZeroElems());}\
+BENCHMARK(SpMV_##op)->DenseRange(1,4)->Unit(bm::kMillisecond);
+
+/// y = A x
+SpMV_Benchmark(Mult)
+
+/// y = A x with the SELL-C-sigma storage
+SpMV_Benchmark(MultSELL)
+
+/// y = A^T x
+SpMV_Benchmark(MultTranspose)
+
+/**
+ * @brief main entry point
+ * --benchmark_filter=SpMV_Mult/2
+ * --benchmark_context=device=omp
+ */
+int main(int argc, char *argv[])
+{
+   bm::ConsoleReporter CR;
+   bm::Initialize(&argc, argv);
+
+   // Device setup, cpu by default
+   std::string device_config = "cpu";
+   if (bmi::global_context != nullptr)
+   {
+      const auto device = bmi::global_context->find("device");
+      if (device != bmi::global_context->end())
+      {
+         mfem::out << device->first << " : " << device->second << std::endl;
+         device_config = device->second;
+      }
+   }
+   Device device(device_config.c_str());
+   device.Print();
+
+   if (bm::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+   bm::RunSpecifiedBenchmarks(&CR);
+   return 0;
+}
+
+#endif // MFEM_USE_BENCHMARK
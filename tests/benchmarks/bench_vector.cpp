@@ -154,6 +154,105 @@ static void Vector_Virtuals_Inlined_PE(benchmark::State& state)
 }
 MFEM_VECTOR_BENCHMARK(Vector_Virtuals_Inlined_PE);
 
+// Fused operations, compared with the equivalent sequences of single vector
+// operations, on vectors larger than the caches
+
+#define MFEM_FUSED_BENCHMARK(x) \
+   BENCHMARK(x)->RangeMultiplier(8)->Range(KB, 8*KB*KB);
+
+static void Vector_AXPBY_Dot(benchmark::State& state)
+{
+   const int size = state.range(0);
+   mfem::Vector x(size), y(size), z(size);
+   x = M_PI; y = M_E;
+   for (auto _ : state)
+   {
+      add(1.0, x, -1e-3, y, z);
+      benchmark::DoNotOptimize(z*z);
+   }
+   state.SetBytesProcessed(3*sizeof(double)*size*state.iterations());
+}
+MFEM_FUSED_BENCHMARK(Vector_AXPBY_Dot);
+
+static void Vector_AXPBYDot(benchmark::State& state)
+{
+   const int size = state.range(0);
+   mfem::Vector x(size), y(size), z(size);
+   x = M_PI; y = M_E;
+   for (auto _ : state)
+   {
+      benchmark::DoNotOptimize(AXPBYDot(1.0, x, -1e-3, y, z, z));
+   }
+   state.SetBytesProcessed(3*sizeof(double)*size*state.iterations());
+}
+MFEM_FUSED_BENCHMARK(Vector_AXPBYDot);
+
+static const int fused_n = 8;
+
+static void Vector_Dots(benchmark::State& state)
+{
+   const int size = state.range(0);
+   std::vector<mfem::Vector> v(fused_n, mfem::Vector(size));
+   mfem::Vector w(size), dots(fused_n);
+   for (int k = 0; k < fused_n; k++) { v[k] = k; }
+   w = M_PI;
+   for (auto _ : state)
+   {
+      for (int k = 0; k < fused_n; k++) { dots(k) = v[k]*w; }
+      benchmark::DoNotOptimize(dots.GetData());
+   }
+   state.SetBytesProcessed((fused_n+1)*sizeof(double)*size*state.iterations());
+}
+MFEM_FUSED_BENCHMARK(Vector_Dots);
+
+static void Vector_MultiDot(benchmark::State& state)
+{
+   const int size = state.range(0);
+   std::vector<mfem::Vector> v(fused_n, mfem::Vector(size));
+   mfem::Array<mfem::Vector*> vp(fused_n);
+   mfem::Vector w(size), dots(fused_n);
+   for (int k = 0; k < fused_n; k++) { v[k] = k; vp[k] = &v[k]; }
+   w = M_PI;
+   for (auto _ : state)
+   {
+      MultiDot(fused_n, vp.GetData(), w, dots.GetData());
+      benchmark::DoNotOptimize(dots.GetData());
+   }
+   state.SetBytesProcessed((fused_n+1)*sizeof(double)*size*state.iterations());
+}
+MFEM_FUSED_BENCHMARK(Vector_MultiDot);
+
+static void Vector_Adds(benchmark::State& state)
+{
+   const int size = state.range(0);
+   std::vector<mfem::Vector> v(fused_n, mfem::Vector(size));
+   mfem::Vector w(size), a(fused_n);
+   for (int k = 0; k < fused_n; k++) { v[k] = k; a(k) = 1e-3; }
+   w = M_PI;
+   for (auto _ : state)
+   {
+      for (int k = 0; k < fused_n; k++) { w.Add(a(k), v[k]); }
+   }
+   state.SetBytesProcessed((fused_n+2)*sizeof(double)*size*state.iterations());
+}
+MFEM_FUSED_BENCHMARK(Vector_Adds);
+
+static void Vector_MultiAdd(benchmark::State& state)
+{
+   const int size = state.range(0);
+   std::vector<mfem::Vector> v(fused_n, mfem::Vector(size));
+   mfem::Array<mfem::Vector*> vp(fused_n);
+   mfem::Vector w(size), a(fused_n);
+   for (int k = 0; k < fused_n; k++) { v[k] = k; vp[k] = &v[k]; a(k) = 1e-3; }
+   w = M_PI;
+   for (auto _ : state)
+   {
+      MultiAdd(fused_n, a.GetData(), vp.GetData(), w);
+   }
+   state.SetBytesProcessed((fused_n+2)*sizeof(double)*size*state.iterations());
+}
+MFEM_FUSED_BENCHMARK(Vector_MultiAdd);
+
 // Base class
 struct Base
 {
@@ -213,6 +312,7 @@ MFEM_VECTOR_BENCHMARK(Base_Virtuals_Derived_not_inlined);
 
 // --benchmark_filter=all
 // --benchmark_filter=Vector_PE_MFEM
+// --benchmark_filter=Vector_Multi
 int main(int argc, char *argv[])
 {
    mfem::Reporter mfem_reporter;
@@ -93,24 +93,28 @@ void symmetricMatrixCoeffFunction(const Vector & x, DenseSymmetricMatrix & f)
 
 TEST_CASE("Mass Diagonal PA", "[PartialAssembly][AssembleDiagonal]")
 {
+   const bool simplex = GENERATE(false, true);
    for (dimension = 2; dimension < 4; ++dimension)
    {
       for (int ne = 1; ne < 3; ++ne)
       {
          std::cout << "Testing " << dimension << "D partial assembly mass diagonal: "
-                   << std::pow(ne, dimension) << " elements." << std::endl;
+                   << std::pow(ne, dimension) << (simplex ? " simplex" : "")
+                   << " elements." << std::endl;
          for (int order = 1; order < 5; ++order)
          {
             Mesh mesh;
             if (dimension == 2)
             {
                mesh = Mesh::MakeCartesian2D(
-                         ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+                         ne, ne, simplex ? Element::TRIANGLE :
+                         Element::QUADRILATERAL, 1, 1.0, 1.0);
             }
             else
             {
                mesh = Mesh::MakeCartesian3D(
-                         ne, ne, ne, Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+                         ne, ne, ne, simplex ? Element::TETRAHEDRON :
+                         Element::HEXAHEDRON, 1.0, 1.0, 1.0);
             }
             FiniteElementCollection *h1_fec = new H1_FECollection(order, dimension);
             FiniteElementSpace h1_fespace(&mesh, h1_fec);
@@ -142,25 +146,29 @@ TEST_CASE("Mass Diagonal PA", "[PartialAssembly][AssembleDiagonal]")
 
 TEST_CASE("Diffusion Diagonal PA", "[PartialAssembly][AssembleDiagonal]")
 {
+   const bool simplex = GENERATE(false, true);
    for (dimension = 2; dimension < 4; ++dimension)
    {
       for (int ne = 1; ne < 3; ++ne)
       {
          std::cout << "Testing " << dimension <<
                    "D partial assembly diffusion diagonal: "
-                   << std::pow(ne, dimension) << " elements." << std::endl;
+                   << std::pow(ne, dimension) << (simplex ? " simplex" : "")
+                   << " elements." << std::endl;
          for (int order = 1; order < 5; ++order)
          {
             Mesh mesh;
             if (dimension == 2)
             {
                mesh = Mesh::MakeCartesian2D(
-                         ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+                         ne, ne, simplex ? Element::TRIANGLE :
+                         Element::QUADRILATERAL, 1, 1.0, 1.0);
             }
             else
             {
                mesh = Mesh::MakeCartesian3D(
-                         ne, ne, ne, Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+                         ne, ne, ne, simplex ? Element::TETRAHEDRON :
+                         Element::HEXAHEDRON, 1.0, 1.0, 1.0);
             }
             FiniteElementCollection *h1_fec = new H1_FECollection(order, dimension);
             FiniteElementSpace h1_fespace(&mesh, h1_fec);
@@ -225,6 +225,33 @@ TEST_CASE("H1 Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
    }
 } // H1 Assembly Levels test case
 
+TEST_CASE("H1 Assembly Levels on Simplices",
+          "[AssemblyLevel], [PartialAssembly]")
+{
+   const bool dg = false;
+   auto pb = GENERATE(Problem::Mass, Problem::Diffusion);
+   auto assembly = GENERATE(AssemblyLevel::PARTIAL,
+                            AssemblyLevel::ELEMENT,
+                            AssemblyLevel::FULL);
+   auto q_order_inc = GENERATE(0, 1);
+
+   SECTION("2D")
+   {
+      auto order = GENERATE(1, 2, 3);
+      test_assembly_level("../../data/inline-tri.mesh",
+                          order, q_order_inc, dg, pb, assembly);
+      test_assembly_level("../../data/square-disc.mesh",
+                          order, q_order_inc, dg, pb, assembly);
+   }
+
+   SECTION("3D")
+   {
+      auto order = GENERATE(1, 2);
+      test_assembly_level("../../data/inline-tet.mesh",
+                          order, q_order_inc, dg, pb, assembly);
+   }
+} // H1 Assembly Levels on Simplices test case
+
 TEST_CASE("L2 Assembly Levels", "[AssemblyLevel], [PartialAssembly]")
 {
    const bool dg = true;
@@ -319,3 +319,364 @@ TEST_CASE("ParaView restart mode", "[ParaView]")
    REQUIRE(remove("ParaView/ParaView.pvd") == 0);
    REQUIRE(rmdir("ParaView") == 0);
 }
+
+// Smooth deformation giving node coordinates that need all 17 digits to be
+// restored exactly from the text format
+static void CheckpointWarp(const Vector &x, Vector &y)
+{
+   y = x;
+   for (int i = 0; i < x.Size(); i++)
+   {
+      y(i) += 0.1*sin(3.0*x((i + 1) % x.Size()));
+   }
+}
+
+TEST_CASE("Checkpoint save and load", "[DataCollection]")
+{
+   auto mesh_type = GENERATE(0, 1, 2);
+   Mesh mesh;
+   if (mesh_type == 0)
+   {
+      mesh = Mesh::MakeCartesian2D(2, 3, Element::QUADRILATERAL, true, 2.0, 3.0);
+   }
+   else if (mesh_type == 1)
+   {
+      // Curved mesh with high-order nodes
+      mesh = Mesh::LoadFromFile("../../data/star-q3.mesh");
+   }
+   else
+   {
+      // Nonconforming mesh
+      mesh = Mesh::MakeCartesian3D(2, 2, 2, Element::HEXAHEDRON);
+      mesh.EnsureNCMesh();
+      Array<int> refs;
+      refs.Append(0);
+      refs.Append(5);
+      mesh.GeneralRefinement(refs);
+      mesh.SetCurvature(2);
+      mesh.Transform(CheckpointWarp);
+   }
+   const int dim = mesh.Dimension();
+
+   H1_FECollection h1_fec(2, dim);
+   ND_FECollection nd_fec(1, dim);
+   FiniteElementSpace h1_fes(&mesh, &h1_fec, dim, Ordering::byVDIM);
+   FiniteElementSpace nd_fes(&mesh, &nd_fec);
+   GridFunction u(&h1_fes), v(&nd_fes);
+   u.Randomize(1);
+   v.Randomize(2);
+
+   QuadratureSpace qspace(&mesh, 3);
+   QuadratureFunction qf(&qspace, 2);
+   qf.Randomize(3);
+
+   // Remove the files even when a check fails
+   struct Cleanup
+   {
+      ~Cleanup()
+      {
+         remove("checkpoint_save_load_000007/checkpoint.000000");
+         rmdir("checkpoint_save_load_000007");
+      }
+   } cleanup;
+
+   CheckpointDataCollection dc("checkpoint_save_load", &mesh);
+   dc.RegisterField("u", &u);
+   dc.RegisterField("v", &v);
+   dc.RegisterQField("qf", &qf);
+   dc.SetState("dt_old", 0.125);
+   dc.SetState("stage", 3.0);
+   dc.SetCycle(7);
+   dc.SetTime(1.0/3.0);
+   dc.SetTimeStep(0.25);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+   CheckpointDataCollection dc_new("checkpoint_save_load");
+   dc_new.Load(7);
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   REQUIRE(dc_new.GetCycle() == 7);
+   REQUIRE(dc_new.GetTime() == dc.GetTime());
+   REQUIRE(dc_new.GetTimeStep() == dc.GetTimeStep());
+   REQUIRE(dc_new.HasState("dt_old"));
+   REQUIRE(dc_new.GetState("dt_old") == 0.125);
+   REQUIRE(dc_new.GetState("stage") == 3.0);
+   REQUIRE(!dc_new.HasState("dt"));
+
+   Mesh *mesh_new = dc_new.GetMesh();
+   REQUIRE(mesh_new);
+   REQUIRE(mesh_new->GetNE() == mesh.GetNE());
+   REQUIRE(mesh_new->GetNBE() == mesh.GetNBE());
+   REQUIRE(mesh_new->GetNV() == mesh.GetNV());
+   REQUIRE(mesh_new->SpaceDimension() == mesh.SpaceDimension());
+   REQUIRE(mesh_new->GetNumGeometries(dim) == mesh.GetNumGeometries(dim));
+
+   // The mesh is saved exactly, so the element data must match bitwise
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      Vector c(dim), c_new(dim);
+      mesh.GetElementCenter(i, c);
+      mesh_new->GetElementCenter(i, c_new);
+      c_new -= c;
+      REQUIRE(c_new.Normlinf() == 0.0);
+   }
+   if (mesh.GetNodes())
+   {
+      REQUIRE(mesh_new->GetNodes());
+      Vector nodes_diff(*mesh_new->GetNodes());
+      nodes_diff -= *mesh.GetNodes();
+      REQUIRE(nodes_diff.Normlinf() == 0.0);
+   }
+
+   GridFunction *u_new = dc_new.GetField("u");
+   GridFunction *v_new = dc_new.GetField("v");
+   QuadratureFunction *qf_new = dc_new.GetQField("qf");
+   REQUIRE(u_new);
+   REQUIRE(v_new);
+   REQUIRE(qf_new);
+   REQUIRE(u_new->FESpace()->GetOrdering() == Ordering::byVDIM);
+   REQUIRE(u_new->FESpace()->GetVDim() == dim);
+   REQUIRE(qf_new->GetVDim() == 2);
+
+   Vector u_diff(*u_new), v_diff(*v_new), qf_diff(*qf_new);
+   u_diff -= u;
+   v_diff -= v;
+   qf_diff -= qf;
+   REQUIRE(u_diff.Normlinf() == 0.0);
+   REQUIRE(v_diff.Normlinf() == 0.0);
+   REQUIRE(qf_diff.Normlinf() == 0.0);
+
+   // Loading a missing cycle reports an error
+   CheckpointDataCollection dc_missing("checkpoint_save_load");
+   dc_missing.Load(8);
+   REQUIRE(dc_missing.Error() != DataCollection::NO_ERROR);
+   REQUIRE(dc_missing.GetMesh() == nullptr);
+}
+
+TEST_CASE("ParaView single file", "[ParaView]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(3, 2, Element::QUADRILATERAL);
+   H1_FECollection fec(1, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   u = 1.0;
+   QuadratureSpace qspace(&mesh, 2);
+   QuadratureFunction q(&qspace);
+   q = 2.0;
+
+   ParaViewDataCollection dc("ParaViewSingle", &mesh);
+   dc.UseSingleFile(true);
+   dc.RegisterField("u", &u);
+   dc.RegisterQField("q", &q);
+   SaveDataCollection(dc, 0, 0.0);
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+   // The VTU files replace the PVTU files in the PVD file
+   using namespace tinyxml2;
+   XMLDocument xml;
+   xml.LoadFile("ParaViewSingle/ParaViewSingle.pvd");
+   REQUIRE(xml.ErrorID() == XML_SUCCESS);
+   const XMLElement *dataset =
+      xml.FirstChildElement()->FirstChildElement()->FirstChildElement();
+   REQUIRE(dataset);
+   REQUIRE(std::string(dataset->Attribute("file")) == "Cycle000000/data.vtu");
+   dataset = dataset->NextSiblingElement();
+   REQUIRE(dataset);
+   REQUIRE(std::string(dataset->Attribute("file")) == "Cycle000000/q.vtu");
+
+   Mesh mesh_vtu = Mesh::LoadFromFile("ParaViewSingle/Cycle000000/data.vtu");
+   REQUIRE(mesh_vtu.GetNE() == mesh.GetNE());
+
+   // Clean up
+   REQUIRE(remove("ParaViewSingle/Cycle000000/data.vtu") == 0);
+   REQUIRE(remove("ParaViewSingle/Cycle000000/q.vtu") == 0);
+   REQUIRE(rmdir("ParaViewSingle/Cycle000000") == 0);
+   REQUIRE(remove("ParaViewSingle/ParaViewSingle.pvd") == 0);
+   REQUIRE(rmdir("ParaViewSingle") == 0);
+}
+
+#ifdef MFEM_USE_THREADS
+
+TEST_CASE("Asynchronous save", "[DataCollection]")
+{
+   auto nonconforming = GENERATE(false, true);
+   Mesh mesh = Mesh::MakeCartesian2D(2, 3, Element::QUADRILATERAL, true);
+   if (nonconforming) { mesh.EnsureNCMesh(); }
+   mesh.SetCurvature(2);
+
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   std::unique_ptr<QuadratureSpace> qspace(new QuadratureSpace(&mesh, 2));
+   std::unique_ptr<QuadratureFunction> qf(new QuadratureFunction(qspace.get()));
+
+   CheckpointDataCollection dc("async");
+   std::vector<Vector> u_saved, qf_saved, nodes_saved;
+   {
+      AsyncDataCollection adc(dc, &mesh, 2);
+      adc.RegisterField("u", &u);
+      adc.RegisterQField("qf", qf.get());
+      for (int cycle = 0; cycle < 4; cycle++)
+      {
+         if (cycle == 2)
+         {
+            // The copies of the mesh and of the spaces are updated
+            Array<int> refs({0});
+            mesh.GeneralRefinement(refs);
+            fes.Update();
+            u.Update();
+            qf.reset(new QuadratureFunction(new QuadratureSpace(&mesh, 2)));
+            qspace.reset(qf->GetSpace());
+            adc.RegisterQField("qf", qf.get());
+         }
+         u.Randomize(cycle+1);
+         qf->Randomize(cycle+1);
+         adc.SetCycle(cycle);
+         adc.SetTime(0.5*cycle);
+         adc.Save();
+         REQUIRE(adc.GetNumPending() <= 2);
+         u_saved.push_back(u);
+         qf_saved.push_back(*qf);
+         nodes_saved.push_back(*mesh.GetNodes());
+
+         // Modify the data while it is written
+         u = 0.0;
+         *qf = 0.0;
+         *mesh.GetNodes() *= 2.0;
+      }
+      adc.WaitForSave();
+      REQUIRE(adc.GetNumPending() == 0);
+      REQUIRE(adc.Error() == DataCollection::NO_ERROR);
+   }
+
+   for (int cycle = 0; cycle < 4; cycle++)
+   {
+      CheckpointDataCollection dc_new("async");
+      dc_new.Load(cycle);
+      REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+      REQUIRE(dc_new.GetTime() == 0.5*cycle);
+
+      Vector u_diff(*dc_new.GetField("u"));
+      Vector qf_diff(*dc_new.GetQField("qf"));
+      Vector nodes_diff(*dc_new.GetMesh()->GetNodes());
+      u_diff -= u_saved[cycle];
+      qf_diff -= qf_saved[cycle];
+      nodes_diff -= nodes_saved[cycle];
+      REQUIRE(u_diff.Normlinf() == 0.0);
+      REQUIRE(qf_diff.Normlinf() == 0.0);
+      REQUIRE(nodes_diff.Normlinf() == 0.0);
+   }
+
+   // Cleanup all the files
+   for (int cycle = 0; cycle < 4; cycle++)
+   {
+      const std::string dir = "async_00000" + std::to_string(cycle);
+      REQUIRE(remove((dir + "/checkpoint.000000").c_str()) == 0);
+      REQUIRE(rmdir(dir.c_str()) == 0);
+   }
+}
+
+#endif // MFEM_USE_THREADS
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Checkpoint shared files", "[Parallel], [DataCollection]")
+{
+   int rank, nranks;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+   // One file per rank, all ranks in one file, and two ranks per file
+   auto nfiles = GENERATE(0, 1, 2);
+
+   Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(2, pmesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction u(&fes);
+   u.Randomize(rank + 1);
+
+   CheckpointDataCollection dc(MPI_COMM_WORLD, "pcheckpoint", &pmesh);
+   dc.SetNumFiles(nfiles);
+   dc.RegisterField("u", &u);
+   dc.SetTime(0.5);
+   dc.Save();
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+
+   CheckpointDataCollection dc_new(MPI_COMM_WORLD, "pcheckpoint");
+   dc_new.SetNumFiles(nfiles);
+   dc_new.Load(0);
+   REQUIRE(dc_new.Error() == DataCollection::NO_ERROR);
+   REQUIRE(dc_new.GetTime() == 0.5);
+   ParMesh *pmesh_new = dynamic_cast<ParMesh*>(dc_new.GetMesh());
+   REQUIRE(pmesh_new);
+   REQUIRE(pmesh_new->GetNE() == pmesh.GetNE());
+   REQUIRE(pmesh_new->GetGlobalNE() == pmesh.GetGlobalNE());
+
+   GridFunction *u_new = dc_new.GetField("u");
+   REQUIRE(u_new);
+   Vector u_diff(*u_new);
+   u_diff -= u;
+   REQUIRE(u_diff.Normlinf() == 0.0);
+
+   // Clean up
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0)
+   {
+      const int count = (nfiles == 0) ? nranks : std::min(nfiles, nranks);
+      for (int f = 0; f < count; f++)
+      {
+         std::string file = "pcheckpoint_000000/checkpoint." +
+                            to_padded_string(f, 6);
+         REQUIRE(remove(file.c_str()) == 0);
+      }
+      REQUIRE(rmdir("pcheckpoint_000000") == 0);
+   }
+}
+
+TEST_CASE("ParaView single file in parallel", "[Parallel], [ParaView]")
+{
+   int rank, nranks;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+   Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(1, pmesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction u(&fes);
+   u = 1.0;
+
+   ParaViewDataCollection dc("ParaViewShared", &pmesh);
+   dc.UseSingleFile(true);
+   dc.RegisterField("u", &u);
+   SaveDataCollection(dc, 0, 0.0);
+   REQUIRE(dc.Error() == DataCollection::NO_ERROR);
+   MPI_Barrier(MPI_COMM_WORLD);
+
+   if (rank == 0)
+   {
+      // One piece per rank, with all the elements of the rank
+      using namespace tinyxml2;
+      XMLDocument xml;
+      xml.LoadFile("ParaViewShared/Cycle000000/data.vtu");
+      REQUIRE(xml.ErrorID() == XML_SUCCESS);
+      const XMLElement *grid = xml.FirstChildElement()->FirstChildElement();
+      int pieces = 0, cells = 0;
+      for (const XMLElement *piece = grid->FirstChildElement("Piece"); piece;
+           piece = piece->NextSiblingElement("Piece"))
+      {
+         pieces++;
+         cells += piece->IntAttribute("NumberOfCells");
+      }
+      REQUIRE(pieces == nranks);
+      REQUIRE(cells == mesh.GetNE());
+
+      REQUIRE(remove("ParaViewShared/Cycle000000/data.vtu") == 0);
+      REQUIRE(rmdir("ParaViewShared/Cycle000000") == 0);
+      REQUIRE(remove("ParaViewShared/ParaViewShared.pvd") == 0);
+      REQUIRE(rmdir("ParaViewShared") == 0);
+   }
+}
+
+#endif // MFEM_USE_MPI
@@ -169,3 +169,149 @@ TEST_CASE("InverseElementTransformation",
       REQUIRE( max_err <= tol );
    }
 }
+
+// Check the batched transformation of random points of the mesh, in the given
+// ordering, against InverseElementTransformation
+static void CheckBatchTransform(Mesh &mesh, bool tensor,
+                                Ordering::Type ordering)
+{
+   typedef InverseElementTransformation InvTransform;
+
+   const int dim = mesh.Dimension();
+   const int sdim = mesh.SpaceDimension();
+   const int ne = mesh.GetNE();
+
+   BatchInverseElementTransformation batch(mesh);
+   REQUIRE(batch.UsesTensorKernels() == tensor);
+
+   // Random points in random elements, followed by the same points in the
+   // next element, which are mostly outside of it
+   const int npts = 100;
+   srand(1);
+   Array<int> elems(2*npts);
+   Array<IntegrationPoint> ips(npts);
+   Vector pts(2*npts*sdim), x(sdim);
+   for (int k = 0; k < npts; k++)
+   {
+      elems[k] = rand() % ne;
+      elems[npts + k] = (elems[k] + 1) % ne;
+      Geometry::GetRandomPoint(mesh.GetElementBaseGeometry(elems[k]), ips[k]);
+      mesh.GetElementTransformation(elems[k])->Transform(ips[k], x);
+      for (int c = 0; c < sdim; c++)
+      {
+         for (int j = k; j < 2*npts; j += npts)
+         {
+            pts(ordering == Ordering::byNODES ? j + 2*npts*c : sdim*j + c) = x(c);
+         }
+      }
+   }
+
+   Array<int> types;
+   Vector refs;
+   batch.Transform(pts, elems, ordering, types, refs);
+   REQUIRE(types.Size() == 2*npts);
+   REQUIRE(refs.Size() == 2*npts*dim);
+   types.HostRead();
+   refs.HostRead();
+
+   auto ref = [&](int j, int d)
+   {
+      return refs(ordering == Ordering::byNODES ? j + 2*npts*d : dim*j + d);
+   };
+
+   // The points are found in their elements
+   double ref_pt[3];
+   for (int k = 0; k < npts; k++)
+   {
+      REQUIRE(types[k] == InvTransform::Inside);
+      ips[k].Get(ref_pt, dim);
+      for (int d = 0; d < dim; d++)
+      {
+         REQUIRE(ref(k, d) == MFEM_Approx(ref_pt[d], 1e-10));
+      }
+   }
+
+   // All the results are the same as with InverseElementTransformation, which
+   // does not return the reference point of the points outside
+   InvTransform inv_tr;
+   IntegrationPoint ip;
+   for (int j = 0; j < 2*npts; j++)
+   {
+      for (int c = 0; c < sdim; c++)
+      {
+         x(c) = pts(ordering == Ordering::byNODES ? j + 2*npts*c : sdim*j + c);
+      }
+      inv_tr.SetTransformation(*mesh.GetElementTransformation(elems[j]));
+      REQUIRE(inv_tr.Transform(x, ip) == types[j]);
+      if (types[j] != InvTransform::Inside) { continue; }
+      ip.Get(ref_pt, dim);
+      for (int d = 0; d < dim; d++)
+      {
+         REQUIRE(ref(j, d) == MFEM_Approx(ref_pt[d], 1e-10));
+      }
+   }
+
+   // After mesh motion, the node data is updated
+   mesh.Transform([](const Vector &x, Vector &y) { y = x; y *= 2.0; });
+   pts *= 2.0;
+   batch.Update();
+   batch.Transform(pts, elems, ordering, types, refs);
+   types.HostRead();
+   refs.HostRead();
+   for (int k = 0; k < npts; k++)
+   {
+      REQUIRE(types[k] == InvTransform::Inside);
+      ips[k].Get(ref_pt, dim);
+      for (int d = 0; d < dim; d++)
+      {
+         REQUIRE(ref(k, d) == MFEM_Approx(ref_pt[d], 1e-10));
+      }
+   }
+}
+
+TEST_CASE("BatchInverseElementTransformation",
+          "[InverseElementTransformation]")
+{
+   auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+   CAPTURE(ordering);
+
+   SECTION("{ Cartesian Quad }")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(5, 4, Element::QUADRILATERAL);
+      CheckBatchTransform(mesh, true, ordering);
+   }
+
+   SECTION("{ Star Q3 Quad }")
+   {
+      // Convert the nodes to a tensor product H1 space
+      Mesh mesh = Mesh::LoadFromFile("../../data/star-q3.mesh");
+      mesh.SetCurvature(3);
+      CheckBatchTransform(mesh, true, ordering);
+   }
+
+   SECTION("{ Fichera Q2 Hex }")
+   {
+      Mesh mesh = Mesh::LoadFromFile("../../data/fichera-q2.mesh");
+      mesh.SetCurvature(2);
+      CheckBatchTransform(mesh, true, ordering);
+   }
+
+   SECTION("{ Q2 Quad Surface in 3D }")
+   {
+      Mesh mesh = Mesh::MakeCartesian2D(4, 4, Element::QUADRILATERAL);
+      mesh.SetCurvature(2, false, 3);
+      mesh.Transform([](const Vector &x, Vector &y)
+      {
+         y = x;
+         y(2) = 0.3*sin(x(0) + 2.0*x(1));
+      });
+      CheckBatchTransform(mesh, true, ordering);
+   }
+
+   SECTION("{ Triangles }")
+   {
+      // Not a tensor product mesh, uses the host fallback
+      Mesh mesh = Mesh::MakeCartesian2D(3, 3, Element::TRIANGLE);
+      CheckBatchTransform(mesh, false, ordering);
+   }
+}
@@ -501,7 +501,9 @@ static void test_pa_integrator()
    const bool all_tests = launch_all_non_regression_tests;
 
    auto fname = GENERATE("../../data/star.mesh", "../../data/star-q3.mesh",
-                         "../../data/fichera.mesh", "../../data/fichera-q3.mesh");
+                         "../../data/fichera.mesh", "../../data/fichera-q3.mesh",
+                         "../../data/square-disc-p2.mesh",
+                         "../../data/escher-p2.mesh");
    auto map_type = GENERATE(FiniteElement::VALUE, FiniteElement::INTEGRAL);
 
    auto order = !all_tests ? 2 : GENERATE(1, 2, 3);
@@ -550,4 +552,163 @@ TEST_CASE("PA Diffusion", "[PartialAssembly], [CUDA]")
    test_pa_integrator<DiffusionIntegrator>();
 } // PA Diffusion test case
 
+TEST_CASE("PA Fused Mass Diffusion", "[PartialAssembly]")
+{
+   auto fname = GENERATE("../../data/star-q3.mesh",
+                         "../../data/fichera-q3.mesh");
+   auto order = GENERATE(1, 2, 3);
+   // 0: mass, 1: diffusion, 2: mass and diffusion, 3: with different rules
+   auto integs = GENERATE(0, 1, 2, 3);
+
+   Mesh mesh(fname);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(order, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   const IntegrationRule &ir =
+      IntRules.Get(mesh.GetElementGeometry(0), 2*order + 3);
+
+   ConstantCoefficient pi(M_PI);
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x*x; });
+
+   GridFunction x(&fes), y(&fes), y_fused(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf(&fes), blf_fused(&fes);
+   for (BilinearForm *f : {&blf, &blf_fused})
+   {
+      f->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      if (integs != 1)
+      {
+         f->AddDomainIntegrator(new MassIntegrator(coeff));
+      }
+      if (integs != 0)
+      {
+         f->AddDomainIntegrator(integs == 3 ?
+                                new DiffusionIntegrator(pi, &ir) :
+                                new DiffusionIntegrator(pi));
+      }
+   }
+   blf_fused.EnableFusedPA();
+   blf.Assemble();
+   blf_fused.Assemble();
+
+   blf.Mult(x, y);
+   blf_fused.Mult(x, y_fused);
+   y -= y_fused;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   blf.MultTranspose(x, y);
+   blf_fused.MultTranspose(x, y_fused);
+   y -= y_fused;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
+
+TEST_CASE("PA Single Precision", "[PartialAssembly], [CUDA]")
+{
+   auto fname = GENERATE("../../data/star-q3.mesh",
+                         "../../data/fichera-q3.mesh",
+                         "../../data/inline-tri.mesh",
+                         "../../data/inline-tet.mesh");
+   auto order = GENERATE(1, 3);
+   // 0: mass, 1: diffusion, 2: mass and diffusion
+   auto integs = GENERATE(0, 1, 2);
+   // Element and full assembly ignore the single precision request
+   auto assembly = GENERATE(AssemblyLevel::PARTIAL, AssemblyLevel::ELEMENT,
+                            AssemblyLevel::FULL);
+   CAPTURE(fname, order, integs, assembly);
+
+   Mesh mesh(fname);
+   H1_FECollection fec(order, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+
+   FunctionCoefficient coeff([](const Vector &x) { return 1.0 + x*x; });
+
+   GridFunction x(&fes), y(&fes), y_sp(&fes);
+   x.Randomize(1);
+
+   BilinearForm blf(&fes), blf_sp(&fes);
+   for (BilinearForm *f : {&blf, &blf_sp})
+   {
+      f->SetAssemblyLevel(assembly);
+      if (integs != 1) { f->AddDomainIntegrator(new MassIntegrator(coeff)); }
+      if (integs != 0)
+      {
+         f->AddDomainIntegrator(new DiffusionIntegrator(coeff));
+      }
+   }
+   for (BilinearFormIntegrator *integ : *blf_sp.GetDBFI())
+   {
+      integ->SetPASinglePrecision();
+   }
+   blf.Assemble();
+   blf_sp.Assemble();
+
+   // The single precision data is accurate to about 6e-8 relative
+   const double tol = 1e-6;
+
+   blf.Mult(x, y);
+   blf_sp.Mult(x, y_sp);
+   REQUIRE(y.Normlinf() > 0.0);
+   y_sp -= y;
+   REQUIRE(y_sp.Normlinf() <= tol * y.Normlinf());
+
+   Vector diag(fes.GetTrueVSize()), diag_sp(fes.GetTrueVSize());
+   blf.AssembleDiagonal(diag);
+   blf_sp.AssembleDiagonal(diag_sp);
+   diag_sp -= diag;
+   REQUIRE(diag_sp.Normlinf() <= tol * diag.Normlinf());
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel PA Fused Mass Diffusion", "[Parallel], [PartialAssembly]")
+{
+   auto dim = GENERATE(2, 3);
+   auto order = GENERATE(1, 2, 3);
+
+   Mesh smesh = (dim == 2) ?
+                Mesh::MakeCartesian2D(6, 6, Element::QUADRILATERAL) :
+                Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   ParMesh mesh(MPI_COMM_WORLD, smesh);
+   smesh.Clear();
+   H1_FECollection fec(order, dim);
+   ParFiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list, ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 0;
+   ess_bdr[0] = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   ParBilinearForm blf(&fes), blf_fused(&fes);
+   for (ParBilinearForm *f : {&blf, &blf_fused})
+   {
+      f->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      f->AddDomainIntegrator(new MassIntegrator(one));
+      f->AddDomainIntegrator(new DiffusionIntegrator(one));
+   }
+   blf_fused.EnableFusedPA();
+   blf.Assemble();
+   blf_fused.Assemble();
+
+   // With several ranks, the fused operator overlaps the communication
+   OperatorPtr A, A_fused;
+   blf.FormSystemMatrix(ess_tdof_list, A);
+   blf_fused.FormSystemMatrix(ess_tdof_list, A_fused);
+
+   Vector x(fes.GetTrueVSize()), y(x.Size()), y_fused(x.Size());
+   x.Randomize(1);
+   A->Mult(x, y);
+   A_fused->Mult(x, y_fused);
+   y -= y_fused;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+
+   A->MultTranspose(x, y);
+   A_fused->MultTranspose(x, y_fused);
+   y -= y_fused;
+   REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+}
+
+#endif // MFEM_USE_MPI
+
 } // namespace pa_kernels
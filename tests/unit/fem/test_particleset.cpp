@@ -0,0 +1,264 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "unit_tests.hpp"
+
+namespace particleset_test
+{
+
+// Mesh of the unit square or cube. The quadrilateral and hexahedral meshes are
+// curved inside, keeping their boundary, so that the particles are located in
+// curved elements
+static Mesh UnitMesh(Element::Type type)
+{
+   Mesh mesh = (type == Element::QUADRILATERAL) ?
+               Mesh::MakeCartesian2D(6, 5, type) :
+               Mesh::MakeCartesian3D(3, 4, 3, type);
+   if (type != Element::TETRAHEDRON)
+   {
+      mesh.SetCurvature(2);
+      mesh.Transform([](const Vector &x, Vector &y)
+      {
+         y = x;
+         double b = 1.0;
+         for (int d = 0; d < x.Size(); d++) { b *= sin(M_PI*x(d)); }
+         y(0) += 0.1*b;
+      });
+   }
+   return mesh;
+}
+
+// Field interpolated exactly by the quadratic spaces
+static double Field(const Vector &x)
+{
+   return 1.0 + 2.0*x(0) - x(1)*x(1);
+}
+
+// Check that the particles are at the given reference points
+static void CheckLocation(ParticleSet &ps)
+{
+   Mesh &mesh = *ps.GetMesh();
+   const int np = ps.GetNumParticles();
+   const int dim = mesh.Dimension(), sdim = mesh.SpaceDimension();
+   const Vector &x = ps.GetCoordinates(), &r = ps.GetReferenceCoordinates();
+   Vector y(sdim);
+   double ref[3];
+   IntegrationPoint ip;
+   for (int i = 0; i < np; i++)
+   {
+      REQUIRE(ps.GetElements()[i] >= 0);
+      for (int d = 0; d < dim; d++) { ref[d] = r(i + np*d); }
+      ip.Set(ref, dim);
+      mesh.GetElementTransformation(ps.GetElements()[i])->Transform(ip, y);
+      for (int c = 0; c < sdim; c++)
+      {
+         REQUIRE(y(c) == MFEM_Approx(x(i + np*c)));
+      }
+   }
+}
+
+// Check that the fields follow the particles, the first one is the id and the
+// second one the initial position
+static void CheckFields(ParticleSet &ps, const Vector &x0)
+{
+   const int np = ps.GetNumParticles();
+   const int sdim = ps.GetMesh()->SpaceDimension(), n0 = x0.Size()/sdim;
+   for (int i = 0; i < np; i++)
+   {
+      const long long id = ps.GetIds()[i];
+      REQUIRE(ps.GetField(0)(i) == (double) id);
+      for (int c = 0; c < sdim; c++)
+      {
+         REQUIRE(ps.GetField(1)(i + np*c) == x0(id + n0*c));
+      }
+   }
+}
+
+}
+
+using namespace particleset_test;
+
+TEST_CASE("ParticleSet", "[ParticleSet]")
+{
+   auto type = GENERATE(Element::QUADRILATERAL, Element::HEXAHEDRON,
+                        Element::TETRAHEDRON);
+   Mesh mesh = UnitMesh(type);
+   const int sdim = mesh.SpaceDimension();
+   ParticleSet ps(mesh);
+   const int id_field = ps.AddField("id");
+   const int x0_field = ps.AddField("x0", sdim);
+   REQUIRE(ps.GetFieldIndex("x0") == x0_field);
+   REQUIRE(ps.GetFieldVDim(x0_field) == sdim);
+
+   // Random particles, ordered by nodes
+   const int npts = 200;
+   Vector x0(sdim*npts);
+   x0.Randomize(1);
+   REQUIRE(ps.AddParticles(x0) == 0);
+   REQUIRE(ps.GetNumParticles() == npts);
+   for (int i = 0; i < npts; i++)
+   {
+      ps.GetField(id_field)(i) = ps.GetIds()[i];
+      for (int c = 0; c < sdim; c++)
+      {
+         ps.GetField(x0_field)(i + npts*c) = x0(i + npts*c);
+      }
+   }
+   REQUIRE(ps.Redistribute() == 0);
+   REQUIRE(ps.GetNumParticles() == npts);
+   CheckLocation(ps);
+   CheckFields(ps, x0);
+
+   SECTION("Interpolation")
+   {
+      auto ordering = GENERATE(Ordering::byNODES, Ordering::byVDIM);
+      H1_FECollection fec(2, mesh.Dimension());
+      FiniteElementSpace fes(&mesh, &fec), vfes(&mesh, &fec, sdim);
+      GridFunction u(&fes), v(&vfes);
+      FunctionCoefficient f(Field);
+      // The components of the vector field are the coordinates
+      VectorFunctionCoefficient vf(sdim, [](const Vector &x, Vector &y)
+      { y = x; });
+      u.ProjectCoefficient(f);
+      v.ProjectCoefficient(vf);
+
+      Vector uvals, vvals, x(sdim);
+      ps.Interpolate(u, uvals);
+      ps.Interpolate(v, vvals, ordering);
+      const int np = ps.GetNumParticles();
+      const Vector &xp = ps.GetCoordinates();
+      for (int i = 0; i < np; i++)
+      {
+         for (int c = 0; c < sdim; c++) { x(c) = xp(i + np*c); }
+         REQUIRE(uvals(i) == MFEM_Approx(Field(x)));
+         for (int c = 0; c < sdim; c++)
+         {
+            const bool by_nodes = (ordering == Ordering::byNODES);
+            const int k = by_nodes ? i + np*c : sdim*i + c;
+            REQUIRE(vvals(k) == MFEM_Approx(x(c)));
+         }
+      }
+   }
+
+   SECTION("Motion")
+   {
+      // Move the particles, some of them leave the domain
+      Vector &x = ps.GetCoordinates();
+      int outside = 0;
+      for (int i = 0; i < npts; i++)
+      {
+         x(i) += 0.2;
+         if (x(i) > 1.0) { outside++; }
+      }
+      REQUIRE(ps.Redistribute() == outside);
+      REQUIRE(ps.GetNumParticles() == npts - outside);
+      CheckLocation(ps);
+      CheckFields(ps, x0);
+
+      // Remove some particles
+      Array<int> idx;
+      for (int i = 0; i < ps.GetNumParticles(); i += 3) { idx.Append(i); }
+      ps.RemoveParticles(idx);
+      REQUIRE(ps.GetNumParticles() == npts - outside - idx.Size());
+      CheckFields(ps, x0);
+   }
+
+   SECTION("Refinement")
+   {
+      mesh.UniformRefinement();
+      ps.UpdateMesh();
+      REQUIRE(ps.Redistribute() == 0);
+      REQUIRE(ps.GetNumParticles() == npts);
+      CheckLocation(ps);
+      CheckFields(ps, x0);
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("ParParticleSet", "[Parallel], [ParticleSet]")
+{
+   int rank, nranks;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+   auto type = GENERATE(Element::QUADRILATERAL, Element::HEXAHEDRON);
+   Mesh mesh = UnitMesh(type);
+   const int sdim = mesh.SpaceDimension();
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   mesh.Clear();
+   ParParticleSet ps(pmesh);
+   ps.AddField("id");
+   ps.AddField("x0", sdim);
+
+   // All the particles start on rank 0, the same points as in serial
+   const int npts = 200;
+   Vector x0(sdim*npts), x;
+   x0.Randomize(1);
+   if (rank == 0) { x = x0; }
+   ps.AddParticles(x);
+   for (int i = 0; i < ps.GetNumParticles(); i++)
+   {
+      ps.GetField(0)(i) = ps.GetIds()[i];
+      for (int c = 0; c < sdim; c++)
+      {
+         ps.GetField(1)(i + npts*c) = x0(i + npts*c);
+      }
+   }
+   REQUIRE(ps.GetGlobalNumParticles() == npts);
+
+   REQUIRE(ps.Redistribute() == 0);
+   REQUIRE(ps.GetGlobalNumParticles() == npts);
+   CheckLocation(ps);
+   CheckFields(ps, x0);
+
+   // Each particle is on exactly one rank
+   long long loc_sum = 0, sum = 0;
+   for (int i = 0; i < ps.GetNumParticles(); i++) { loc_sum += ps.GetIds()[i]; }
+   MPI_Allreduce(&loc_sum, &sum, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+   REQUIRE(sum == (long long) npts*(npts - 1)/2);
+
+   // Move the particles across the ranks, some of them leave the domain
+   const int np = ps.GetNumParticles();
+   int loc_outside = 0, outside = 0;
+   for (int i = 0; i < np; i++)
+   {
+      ps.GetCoordinates()(i) += 0.3;
+      if (ps.GetCoordinates()(i) > 1.0) { loc_outside++; }
+   }
+   MPI_Allreduce(&loc_outside, &outside, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+   REQUIRE(ps.Redistribute() == outside);
+   REQUIRE(ps.GetGlobalNumParticles() == npts - outside);
+   CheckLocation(ps);
+   CheckFields(ps, x0);
+
+   // Interpolation of a ParGridFunction
+   H1_FECollection fec(2, pmesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction u(&fes);
+   FunctionCoefficient f(Field);
+   u.ProjectCoefficient(f);
+   Vector vals, xi(sdim);
+   ps.Interpolate(u, vals);
+   for (int i = 0; i < ps.GetNumParticles(); i++)
+   {
+      for (int c = 0; c < sdim; c++)
+      {
+         xi(c) = ps.GetCoordinates()(i + ps.GetNumParticles()*c);
+      }
+      REQUIRE(vals(i) == MFEM_Approx(Field(xi)));
+   }
+}
+
+#endif // MFEM_USE_MPI
@@ -0,0 +1,112 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+#ifndef MFEM_USE_CALIPER
+
+static void PerfInner()
+{
+   MFEM_PERF_FUNCTION;
+   tic();
+   while (toc() < 1e-3) { }
+}
+
+static void PerfOuter()
+{
+   MFEM_PERF_FUNCTION;
+   for (int i = 0; i < 3; i++) { PerfInner(); }
+   MFEM_PERF_BEGIN("Region");
+   PerfInner();
+   MFEM_PERF_END("Region");
+}
+
+TEST_CASE("PerfRegistry", "[PerfRegistry]")
+{
+   PerfRegistry::Reset();
+   PerfOuter(); // disabled: not recorded
+   REQUIRE(PerfRegistry::GetCount("PerfOuter") == 0);
+
+   PerfRegistry::Enable();
+   PerfOuter();
+   PerfOuter();
+   PerfRegistry::Enable(false);
+
+   REQUIRE(PerfRegistry::GetCount("PerfOuter") == 2);
+   REQUIRE(PerfRegistry::GetCount("PerfOuter/PerfInner") == 6);
+   REQUIRE(PerfRegistry::GetCount("PerfOuter/Region") == 2);
+   REQUIRE(PerfRegistry::GetCount("PerfOuter/Region/PerfInner") == 2);
+   REQUIRE(PerfRegistry::GetCount("PerfInner") == 0);
+
+   const double outer = PerfRegistry::GetTime("PerfOuter");
+   const double inner = PerfRegistry::GetTime("PerfOuter/PerfInner");
+   const double region = PerfRegistry::GetTime("PerfOuter/Region");
+   REQUIRE(inner >= 6e-3);
+   REQUIRE(region >= 2e-3);
+   REQUIRE(outer >= inner + region);
+
+   std::ostringstream os;
+   PerfRegistry::Print(os);
+   REQUIRE(os.str().find("PerfOuter") != std::string::npos);
+   REQUIRE(os.str().find("    PerfInner") != std::string::npos);
+
+   PerfRegistry::Reset();
+   REQUIRE(PerfRegistry::GetCount("PerfOuter") == 0);
+}
+
+TEST_CASE("PerfRegistry toggled", "[PerfRegistry]")
+{
+   PerfRegistry::Reset();
+   PerfRegistry::Enable();
+   {
+      MFEM_PERF_SCOPE("Outer");
+      // BEGIN while disabled, END while enabled: the region was not opened,
+      // so END must not close "Outer"
+      PerfRegistry::Enable(false);
+      MFEM_PERF_BEGIN("Skipped");
+      PerfRegistry::Enable();
+      MFEM_PERF_END("Skipped");
+      MFEM_PERF_BEGIN("Inner");
+      MFEM_PERF_END("Inner");
+      {
+         MFEM_PERF_SCOPE(std::string("Scope"));
+      }
+   }
+   PerfRegistry::Enable(false);
+
+   REQUIRE(PerfRegistry::GetCount("Outer") == 1);
+   REQUIRE(PerfRegistry::GetCount("Outer/Inner") == 1);
+   REQUIRE(PerfRegistry::GetCount("Outer/Scope") == 1);
+   REQUIRE(PerfRegistry::GetCount("Skipped") == 0);
+   REQUIRE(PerfRegistry::GetCount("Outer/Skipped") == 0);
+   PerfRegistry::Reset();
+}
+
+#ifdef MFEM_USE_OPENMP
+TEST_CASE("PerfRegistry threads", "[PerfRegistry]")
+{
+   PerfRegistry::Reset();
+   PerfRegistry::Enable();
+   // Only the regions of the thread that enabled the registry are recorded
+   #pragma omp parallel num_threads(4)
+   {
+      PerfInner();
+   }
+   PerfRegistry::Enable(false);
+   REQUIRE(PerfRegistry::GetCount("PerfInner") == 1);
+   PerfRegistry::Reset();
+}
+#endif
+
+#endif // MFEM_USE_CALIPER
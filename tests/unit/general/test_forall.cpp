@@ -0,0 +1,78 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+#include "general/forall.hpp"
+
+#include <memory>
+
+using namespace mfem;
+
+TEST_CASE("OmpSchedule", "[Forall]")
+{
+#ifdef MFEM_USE_OPENMP
+   // Run MFEM_FORALL on the OpenMP backend, unless a device was configured.
+   // Destroying the Device also destroys the MemoryManager, so it is
+   // initialized again for the other tests.
+   struct OmpDevice
+   {
+      std::unique_ptr<Device> device;
+      OmpDevice()
+      {
+         if (!Device::IsConfigured()) { device.reset(new Device("omp")); }
+      }
+      ~OmpDevice() { if (device) { device.reset(); mm.Init(); } }
+   } omp_device;
+   REQUIRE((!omp_device.device || Device::Allows(Backend::OMP)));
+#endif
+   const int N = 1000;
+   const auto type = GENERATE(OmpSchedule::STATIC, OmpSchedule::DYNAMIC,
+                              OmpSchedule::GUIDED, OmpSchedule::RUNTIME,
+                              OmpSchedule::TASKS);
+   const int chunk = GENERATE(0, 1, 7);
+   OmpSchedule::Set(type, chunk);
+   REQUIRE(OmpSchedule::GetType() == type);
+   REQUIRE(OmpSchedule::GetChunk(N) >= 1);
+
+   Vector x(N);
+   x.UseDevice(true);
+   auto d_x = x.Write();
+   MFEM_FORALL(i, N, d_x[i] = i;);
+   x.HostRead();
+   for (int i = 0; i < N; i++) { REQUIRE(x(i) == i); }
+
+   OmpSchedule::Set(OmpSchedule::STATIC);
+}
+
+TEST_CASE("ForallScratch", "[Forall]")
+{
+   const int N = 100, M = 50;
+   Vector y(N);
+   double *h_y = y.HostWrite();
+   // The scratch buffer is host-only, so use a host loop.
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < N; i++)
+   {
+      double *w = ForallScratch::Get(M);
+      for (int j = 0; j < M; j++) { w[j] = i + j; }
+      double s = 0.0;
+      for (int j = 0; j < M; j++) { s += w[j]; }
+      h_y[i] = s;
+   }
+   for (int i = 0; i < N; i++) { REQUIRE(y(i) == M*i + M*(M-1)/2); }
+   REQUIRE(ForallScratch::Capacity() >= (std::size_t) M);
+
+   ForallScratch::Clear();
+   REQUIRE(ForallScratch::Capacity() == 0);
+}
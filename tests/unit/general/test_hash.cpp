@@ -0,0 +1,121 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace hash_test
+{
+
+struct Item2 : public Hashed2 { };
+struct Item4 : public Hashed4 { };
+
+// Check that all the items of t are found under their keys, and that the
+// iterators visit them all
+template <typename Table>
+static void CheckItems2(Table &t)
+{
+   int n = 0;
+   for (auto it = t.begin(); it != t.end(); ++it, n++)
+   {
+      REQUIRE(t.IdExists(it.index()));
+      REQUIRE(t.FindId(it->p2, it->p1) == it.index());
+   }
+   REQUIRE(n == t.Size());
+}
+
+}
+
+using namespace hash_test;
+
+// OpenHashTable must give the same ids as HashTable for the same sequence of
+// operations, including the reuse of the ids of the deleted items
+TEST_CASE("OpenHashTable", "[HashTable]")
+{
+   auto init_size = GENERATE(1, 16, 1024);
+   CAPTURE(init_size);
+   HashTable<Item2> h2(64, init_size);
+   OpenHashTable<Item2> o2(64, init_size);
+   HashTable<Item4> h4(64, init_size);
+   OpenHashTable<Item4> o4(64, init_size);
+
+   srand(1);
+   for (int it = 0; it < 50000; it++)
+   {
+      const int op = rand() % 4;
+      const int p1 = rand() % 200, p2 = rand() % 200, p3 = rand() % 20;
+      if (op < 2)
+      {
+         REQUIRE(o2.GetId(p1, p2) == h2.GetId(p1, p2));
+         REQUIRE(o4.GetId(p1, p2, p3) == h4.GetId(p1, p2, p3));
+      }
+      else if (op == 2)
+      {
+         const int id2 = h2.FindId(p1, p2), id4 = h4.FindId(p1, p2, p3);
+         REQUIRE(o2.FindId(p2, p1) == id2);
+         REQUIRE(o4.FindId(p3, p1, p2) == id4);
+         if (id2 >= 0) { h2.Delete(id2); o2.Delete(id2); }
+         if (id4 >= 0) { h4.Delete(id4); o4.Delete(id4); }
+      }
+      else
+      {
+         const int id2 = h2.FindId(p1, p2), id4 = h4.FindId(p1, p2, p3);
+         const int q = 200 + rand() % 200;
+         if (id2 >= 0 && h2.FindId(q, p2) < 0)
+         {
+            h2.Reparent(id2, q, p2);
+            o2.Reparent(id2, p2, q);
+         }
+         if (id4 >= 0 && h4.FindId(q, p2, p3) < 0)
+         {
+            h4.Reparent(id4, q, p2, p3);
+            o4.Reparent(id4, p3, q, p2);
+         }
+         REQUIRE(o2.Find(q, p2) == o2.Find(p2, q));
+      }
+      REQUIRE(o2.Size() == h2.Size());
+      REQUIRE(o4.Size() == h4.Size());
+      REQUIRE(o2.NumIds() == h2.NumIds());
+   }
+   CheckItems2(o2);
+
+   OpenHashTable<Item2> copy(o2);
+   CheckItems2(copy);
+   REQUIRE(copy.GetId(1000, 1001) == h2.GetId(1000, 1001));
+
+   o2.DeleteAll();
+   REQUIRE(o2.Size() == 0);
+   REQUIRE(o2.FindId(1000, 1001) < 0);
+}
+
+TEST_CASE("OpenHashTable Alloc", "[HashTable]")
+{
+   OpenHashTable<Item2> t(16, 4);
+   for (int id = 0; id < 100; id += 3) { t.Alloc(id, id, id + 1); }
+   t.Alloc(3, 0, 0); // already allocated, does nothing
+   t.UpdateUnused();
+   REQUIRE(t.NumIds() == 100);
+   REQUIRE(t.Size() == 34);
+   REQUIRE(t.NumFreeIds() == 66);
+   for (int id = 0; id < 100; id++)
+   {
+      REQUIRE(t.IdExists(id) == (id % 3 == 0));
+      if (id % 3 == 0) { REQUIRE(t.FindId(id, id + 1) == id); }
+   }
+   CheckItems2(t);
+
+   // the ids of the unused items are reused first
+   const int id = t.GetId(-1, -2);
+   REQUIRE(id < 100);
+   REQUIRE(id % 3 != 0);
+}
@@ -67,3 +67,139 @@ TEST_CASE("MemoryManager/Scopes",
       REQUIRE((x_data == x.HostRead()));
    }
 }
+
+TEST_CASE("MemoryManager/HostPool",
+          "[MemoryManager]")
+{
+   MemoryManager::ReleaseHostPool();
+   MemoryManager::ResetHostPoolStats();
+   const MemoryManager::HostPoolStats s0 = MemoryManager::GetHostPoolStats();
+   REQUIRE(s0.requests == 0);
+   REQUIRE(s0.bytes_cached == 0);
+
+   const int n = 1000;
+   const double *first = nullptr;
+   for (int i = 0; i < 10; i++)
+   {
+      Vector x(n, MemoryType::HOST_POOL);
+      REQUIRE(x.GetMemory().GetMemoryType() == MemoryType::HOST_POOL);
+      REQUIRE(reinterpret_cast<uintptr_t>(x.GetData()) % 64 == 0);
+      x = (double) i;
+      REQUIRE(x.Sum() == (double) i * n);
+      // The same block is recycled
+      if (i == 0) { first = x.GetData(); }
+      REQUIRE(x.GetData() == first);
+   }
+
+   // Sizes in the same class share the blocks
+   {
+      Vector y(n - 1, MemoryType::HOST_POOL);
+      REQUIRE(y.GetData() == first);
+      Vector z(n - 1, MemoryType::HOST_POOL);
+      REQUIRE(z.GetData() != first);
+   }
+
+   const MemoryManager::HostPoolStats s = MemoryManager::GetHostPoolStats();
+   REQUIRE(s.requests == 12);
+   REQUIRE(s.hits == 10);
+   REQUIRE(s.HitRate() == Approx(10.0/12.0));
+   REQUIRE(s.bytes_in_use == s0.bytes_in_use);
+   REQUIRE(s.peak_bytes >= s0.bytes_in_use + 2*n*sizeof(double));
+   REQUIRE(s.peak_bytes <= s0.bytes_in_use + 2*n*sizeof(double)*5/4);
+   REQUIRE(s.bytes_cached >= 2*n*sizeof(double));
+
+   MemoryManager::ReleaseHostPool();
+   REQUIRE(MemoryManager::GetHostPoolStats().bytes_cached == 0);
+}
+
+TEST_CASE("MemoryManager/HostPoolWrap",
+          "[MemoryManager]")
+{
+   // Pointers not allocated by the pool are deleted by their Memory object,
+   // without going through the pool
+   const MemoryManager::HostPoolStats s0 = MemoryManager::GetHostPoolStats();
+   const int n = 100;
+   for (int i = 0; i < 3; i++)
+   {
+      Memory<double> mem;
+      mem.Wrap(new double[n], n, MemoryType::HOST_POOL, true);
+      REQUIRE(mem.GetMemoryType() == MemoryType::HOST_POOL);
+      for (int j = 0; j < n; j++) { mem[j] = j; }
+      mem.Delete();
+   }
+   const MemoryManager::HostPoolStats s = MemoryManager::GetHostPoolStats();
+   REQUIRE(s.requests == s0.requests);
+   REQUIRE(s.bytes_in_use == s0.bytes_in_use);
+   REQUIRE(s.bytes_cached == s0.bytes_cached);
+}
+
+TEST_CASE("MemoryManager/HostPoolSlabs",
+          "[MemoryManager]")
+{
+   // Small blocks are carved from shared slabs, which are released once all
+   // their blocks are free
+   MemoryManager::ReleaseHostPool();
+   const MemoryManager::HostPoolStats s0 = MemoryManager::GetHostPoolStats();
+   const int nb = 3000, n = 5;
+   std::vector<Memory<double>> mem(nb);
+   for (int i = 0; i < nb; i++)
+   {
+      mem[i].New(n, MemoryType::HOST_POOL);
+      REQUIRE(reinterpret_cast<uintptr_t>(mem[i].Write(MemoryClass::HOST, n))
+              % 64 == 0);
+      for (int j = 0; j < n; j++) { mem[i][j] = i; }
+   }
+   for (int i = 0; i < nb; i++) { REQUIRE(mem[i][n-1] == i); }
+   for (int i = 0; i < nb; i += 2) { mem[i].Delete(); }
+   MemoryManager::ReleaseHostPool();
+   const size_t cached = MemoryManager::GetHostPoolStats().bytes_cached;
+   REQUIRE(cached >= (nb/2)*64);
+   // The freed blocks are reused
+   for (int i = 0; i < nb; i += 2) { mem[i].New(n, MemoryType::HOST_POOL); }
+   REQUIRE(MemoryManager::GetHostPoolStats().bytes_cached == cached - (nb/2)*64);
+   for (int i = 0; i < nb; i++) { mem[i].Delete(); }
+   MemoryManager::ReleaseHostPool();
+   const MemoryManager::HostPoolStats s = MemoryManager::GetHostPoolStats();
+   REQUIRE(s.bytes_in_use == s0.bytes_in_use);
+   REQUIRE(s.bytes_cached == 0);
+}
+
+TEST_CASE("MemoryManager/Tracing",
+          "[MemoryManager]")
+{
+   MemoryManager::EnableTracing();
+   MemoryManager::ResetTracing();
+   const int n = 100;
+   const size_t bytes = n*sizeof(double);
+   {
+      MemoryTraceScope scope("Test");
+      Vector x(n), y(n, MemoryType::HOST_64);
+      DenseTensor t(2, 3, 4);
+      REQUIRE(MemoryManager::GetTracedBytes(MemoryType::HOST) ==
+              bytes + 24*sizeof(double));
+      REQUIRE(MemoryManager::GetTracedBytes(MemoryType::HOST_64) == bytes);
+
+      std::ostringstream json;
+      MemoryManager::PrintTraceJSON(json);
+      REQUIRE(json.str().find("\"Test/Vector\": {\"bytes\": 1600") !=
+              std::string::npos);
+      REQUIRE(json.str().find("\"Test/DenseTensor\": {\"bytes\": 192") !=
+              std::string::npos);
+   }
+   REQUIRE(MemoryManager::GetTracedBytes(MemoryType::HOST) == 0);
+   REQUIRE(MemoryManager::GetTracedBytes(MemoryType::HOST_64) == 0);
+   REQUIRE(MemoryManager::GetTracedPeakBytes() == 2*bytes + 24*sizeof(double));
+
+   std::ostringstream report;
+   MemoryManager::PrintTrace(report);
+   REQUIRE(report.str().find("Test/Vector") != std::string::npos);
+
+   MemoryManager::EnableTracing(false);
+   {
+      Vector z(n);
+      REQUIRE(MemoryManager::GetTracedPeakBytes() ==
+              2*bytes + 24*sizeof(double));
+   }
+   MemoryManager::ResetTracing();
+   REQUIRE(MemoryManager::GetTracedPeakBytes() == 0);
+}
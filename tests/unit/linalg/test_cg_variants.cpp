@@ -0,0 +1,156 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+#include "unit_tests.hpp"
+
+using namespace mfem;
+
+namespace cg_variants
+{
+
+// Count the calls to the monitor, which should be the same as for CGSolver
+struct CountingMonitor : IterativeSolverMonitor
+{
+   int calls = 0, last_it = -1;
+   bool final_seen = false;
+   void MonitorResidual(int it, double norm, const Vector &r, bool final)
+   {
+      calls++;
+      last_it = it;
+      final_seen = final_seen || final;
+   }
+};
+
+// Solve A x = b with the given solver, returning the number of iterations
+static int Solve(IterativeSolver &solver, const Operator &A, Solver *B,
+                 const Vector &b, Vector &x)
+{
+   CountingMonitor monitor;
+   solver.SetRelTol(1e-10);
+   solver.SetAbsTol(0.0);
+   solver.SetMaxIter(1000);
+   if (B) { solver.SetPreconditioner(*B); }
+   solver.SetOperator(A);
+   solver.SetMonitor(monitor);
+   x = 0.0;
+   solver.Mult(b, x);
+   const int it = solver.GetNumIterations();
+   REQUIRE(solver.GetConverged());
+   REQUIRE(monitor.final_seen);
+   REQUIRE(monitor.last_it == it);
+   return it;
+}
+
+} // namespace cg_variants
+
+TEST_CASE("CG Variants", "[CGSolver]")
+{
+   using namespace cg_variants;
+
+   const int order = GENERATE(1, 3);
+   const bool jacobi = GENERATE(false, true);
+   CAPTURE(order, jacobi);
+
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   H1_FECollection fec(order, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   LinearForm f(&fes);
+   f.AddDomainIntegrator(new DomainLFIntegrator(one));
+   f.Assemble();
+   GridFunction u(&fes);
+   u = 0.0;
+
+   SparseMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, u, f, A, X, B);
+   DSmoother jacobi_prec(A);
+   Solver *prec = jacobi ? &jacobi_prec : nullptr;
+
+   CGSolver cg;
+   Vector x_cg(B.Size());
+   const int it_cg = Solve(cg, A, prec, B, x_cg);
+
+   Vector x(B.Size());
+   SECTION("Pipelined")
+   {
+      PipelinedCGSolver pcg;
+      const int it = Solve(pcg, A, prec, B, x);
+      REQUIRE(std::abs(it - it_cg) <= 2);
+      x -= x_cg;
+      REQUIRE(x.Normlinf() < 1e-8 * x_cg.Normlinf());
+   }
+
+   SECTION("s-step")
+   {
+      const int s = GENERATE(1, 2, 4);
+      CAPTURE(s);
+      SStepCGSolver scg(s);
+      const int it = Solve(scg, A, prec, B, x);
+      REQUIRE(it % s == 0);
+      REQUIRE(it >= it_cg - s);
+      REQUIRE(it <= it_cg + 2*s);
+      x -= x_cg;
+      REQUIRE(x.Normlinf() < 1e-8 * x_cg.Normlinf());
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel CG Variants", "[Parallel], [CGSolver]")
+{
+   using namespace cg_variants;
+
+   Mesh mesh = Mesh::MakeCartesian3D(8, 8, 8, Element::HEXAHEDRON);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   mesh.Clear();
+   H1_FECollection fec(2, 3);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   Array<int> ess_tdof_list;
+   fes.GetBoundaryTrueDofs(ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   ParBilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.Assemble();
+   ParLinearForm f(&fes);
+   f.AddDomainIntegrator(new DomainLFIntegrator(one));
+   f.Assemble();
+   ParGridFunction u(&fes);
+   u = 0.0;
+
+   HypreParMatrix A;
+   Vector B, X;
+   a.FormLinearSystem(ess_tdof_list, u, f, A, X, B);
+   HypreSmoother jacobi(A, HypreSmoother::Jacobi);
+
+   CGSolver cg(MPI_COMM_WORLD);
+   Vector x_cg(B.Size());
+   const int it_cg = Solve(cg, A, &jacobi, B, x_cg);
+
+   Vector x(B.Size());
+   PipelinedCGSolver pcg(MPI_COMM_WORLD);
+   const int it_p = Solve(pcg, A, &jacobi, B, x);
+   REQUIRE(std::abs(it_p - it_cg) <= 2);
+
+   SStepCGSolver scg(MPI_COMM_WORLD, 4);
+   const int it_s = Solve(scg, A, &jacobi, B, x);
+   REQUIRE(it_s <= it_cg + 8);
+}
+
+#endif // MFEM_USE_MPI
@@ -63,3 +63,81 @@ TEST_CASE("OperatorChebyshevSmoother", "[Chebyshev symmetry]")
       delete smoother;
    }
 }
+
+TEST_CASE("Single precision smoothers", "[Smoothers]")
+{
+   // A double precision PCG solve preconditioned with smoothers that use a
+   // single precision diagonal and a single precision PA operator converges
+   // to the same tolerance as with a double precision preconditioner.
+   const int order = 3;
+   Mesh mesh = Mesh::MakeCartesian3D(4, 4, 4, Element::HEXAHEDRON);
+   H1_FECollection fec(order, 3);
+   FiniteElementSpace fespace(&mesh, &fec);
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   Array<int> ess_tdof_list;
+   fespace.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   BilinearForm aform(&fespace), aform_sp(&fespace);
+   for (BilinearForm *a : {&aform, &aform_sp})
+   {
+      a->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a->AddDomainIntegrator(new DiffusionIntegrator);
+   }
+   (*aform_sp.GetDBFI())[0]->SetPASinglePrecision();
+   aform.Assemble();
+   aform_sp.Assemble();
+   OperatorPtr A, A_sp;
+   aform.FormSystemMatrix(ess_tdof_list, A);
+   aform_sp.FormSystemMatrix(ess_tdof_list, A_sp);
+
+   const int n = A->Height();
+   Vector diag(n), diag_sp(n);
+   aform.AssembleDiagonal(diag);
+   aform_sp.AssembleDiagonal(diag_sp);
+
+   Vector b(n), x(n), r(n);
+   b.Randomize(1);
+   b.SetSubVector(ess_tdof_list, 0.0);
+
+   for (int smoother = 0; smoother < 2; smoother++)
+   {
+      std::unique_ptr<Solver> S, S_sp;
+      if (smoother == 0)
+      {
+         OperatorJacobiSmoother *J = new OperatorJacobiSmoother(aform,
+                                                                ess_tdof_list);
+         S.reset(J);
+         J = new OperatorJacobiSmoother(aform_sp, ess_tdof_list);
+         J->SetSinglePrecision();
+         S_sp.reset(J);
+      }
+      else
+      {
+         S.reset(new OperatorChebyshevSmoother(*A, diag, ess_tdof_list, 3));
+         OperatorChebyshevSmoother *C =
+            new OperatorChebyshevSmoother(*A_sp, diag_sp, ess_tdof_list, 3);
+         C->SetSinglePrecision();
+         S_sp.reset(C);
+      }
+
+      int its[2];
+      for (int sp = 0; sp < 2; sp++)
+      {
+         CGSolver cg;
+         cg.SetRelTol(1e-12);
+         cg.SetMaxIter(500);
+         cg.SetOperator(*A);
+         cg.SetPreconditioner(sp ? *S_sp : *S);
+         x = 0.0;
+         cg.Mult(b, x);
+         REQUIRE(cg.GetConverged());
+         its[sp] = cg.GetNumIterations();
+
+         A->Mult(x, r);
+         r -= b;
+         REQUIRE(r.Norml2() <= 1e-10 * b.Norml2());
+      }
+      REQUIRE(its[1] <= its[0] + 2);
+   }
+}
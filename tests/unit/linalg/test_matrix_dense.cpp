@@ -314,6 +314,72 @@ TEST_CASE("DenseTensor LinearSolve methods",
    }
 }
 
+TEST_CASE("DenseTensor batched methods",
+          "[DenseMatrix][DenseTensor]")
+{
+   const int N = 4, K = 3, NE = 7;
+   const double tol = 1e-12;
+
+   // Batch of SPD matrices A_e = M_e^t M_e + N I and rectangular matrices B_e
+   DenseTensor A(N,N,NE), B(N,K,NE);
+   Vector X(N*NE);
+   X.Randomize(1);
+   for (int e = 0; e < NE; e++)
+   {
+      DenseMatrix M(N);
+      for (int i = 0; i < N; i++)
+      {
+         for (int j = 0; j < N; j++) { M(i,j) = sin(1.0 + i + 2*j + 3*e); }
+         for (int j = 0; j < K; j++) { B(i,j,e) = cos(1.0 + i*j + e); }
+      }
+      MultAtB(M, M, A(e));
+      for (int i = 0; i < N; i++) { A(i,i,e) += N; }
+   }
+
+   SECTION("Inverse")
+   {
+      DenseTensor LU(A), Ainv;
+      Array<int> P;
+      BatchLUFactor(LU, P);
+      BatchInverseMatrix(LU, P, Ainv);
+      for (int e = 0; e < NE; e++)
+      {
+         DenseMatrix AinvA(N);
+         Mult(Ainv(e), A(e), AinvA);
+         for (int i = 0; i < N; i++) { AinvA(i,i) -= 1.0; }
+         REQUIRE(AinvA.MaxMaxNorm() < tol);
+      }
+   }
+
+   SECTION("Cholesky")
+   {
+      DenseTensor L(A);
+      Vector Y(X);
+      BatchCholeskyFactor(L);
+      BatchCholeskySolve(L, Y);
+      Vector AY;
+      BatchMult(A, Y, AY);
+      AY -= X;
+      REQUIRE(AY.Normlinf() < tol);
+   }
+
+   SECTION("Mult")
+   {
+      DenseTensor AB;
+      BatchMult(A, B, AB);
+      REQUIRE(AB.SizeI() == N);
+      REQUIRE(AB.SizeJ() == K);
+      REQUIRE(AB.SizeK() == NE);
+      for (int e = 0; e < NE; e++)
+      {
+         DenseMatrix AB_e(N,K);
+         Mult(A(e), B(e), AB_e);
+         AB_e -= AB(e);
+         REQUIRE(AB_e.MaxMaxNorm() < tol);
+      }
+   }
+}
+
 TEST_CASE("DenseTensor copy", "[DenseMatrix][DenseTensor]")
 {
    DenseTensor t1(2,3,4);
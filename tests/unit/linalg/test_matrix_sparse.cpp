@@ -12,6 +12,10 @@
 #include "mfem.hpp"
 #include "unit_tests.hpp"
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -83,4 +87,139 @@ TEST_CASE("SparseMatrixAbsMult", "[SparseMatrixAbsMult]")
    }
 }
 
+TEST_CASE("SparseMatrixSELL", "[SparseMatrixSELL]")
+{
+   const int dim = 2, ne = 5, vdim = 2;
+   for (int order = 1; order <= 3; ++order)
+   {
+      // Local refinement gives rows of different lengths.
+      Mesh mesh = Mesh::MakeCartesian2D(ne, ne, Element::TRIANGLE, 1, 1.0, 1.0);
+      mesh.EnsureNCMesh();
+      Array<int> refs;
+      refs.Append(0); refs.Append(7);
+      mesh.GeneralRefinement(refs);
+      H1_FECollection fec(order, dim);
+      FiniteElementSpace fes(&mesh, &fec, vdim);
+
+      BilinearForm a(&fes);
+      ConstantCoefficient one(1.0);
+      a.AddDomainIntegrator(new VectorDiffusionIntegrator(one));
+      a.AddDomainIntegrator(new VectorMassIntegrator(one));
+      a.Assemble();
+      a.Finalize();
+      SparseMatrix &A = a.SpMat();
+
+      const int n = A.Height();
+      Vector x(n), y0(n), y1(n);
+      x.Randomize(1);
+      A.Mult(x, y0);
+
+      for (int sigma : {1, 8, 64})
+      {
+         A.BuildSELL(sigma);
+         REQUIRE(A.GetSELL() != nullptr);
+         REQUIRE(A.GetSELL()->NumStoredEntries() >= A.NumNonZeroElems());
+
+         A.Mult(x, y1);
+         y1 -= y0;
+         REQUIRE(y1.Normlinf() == MFEM_Approx(0.0));
+
+         y1 = y0;
+         A.AddMult(x, y1, -1.0);
+         REQUIRE(y1.Normlinf() == MFEM_Approx(0.0));
+
+         A.ResetSELL();
+         REQUIRE(A.GetSELL() == nullptr);
+      }
+   }
+}
+
+#ifdef MFEM_USE_OPENMP
+
+// Gives access to the threaded host kernels used with the OpenMP backend
+class OmpSparseMatrix : public SparseMatrix
+{
+public:
+   OmpSparseMatrix(const SparseMatrix &A) : SparseMatrix(A) { }
+   using SparseMatrix::OmpAddMult;
+   using SparseMatrix::OmpAddMultTranspose;
+   using SparseMatrix::omp_rows;
+};
+
+TEST_CASE("SparseMatrixOmp", "[SparseMatrixOmp]")
+{
+   const int dim = 2, ne = 6;
+   const int nthreads = omp_get_max_threads();
+   for (int order = 1; order <= 3; ++order)
+   {
+      // Local refinement gives rows of different lengths, the mixed form a
+      // rectangular matrix.
+      Mesh mesh = Mesh::MakeCartesian2D(ne, ne, Element::QUADRILATERAL);
+      mesh.EnsureNCMesh();
+      Array<int> refs;
+      refs.Append(0); refs.Append(20);
+      mesh.GeneralRefinement(refs);
+      RT_FECollection hdiv_coll(order, dim);
+      L2_FECollection l2_coll(order, dim);
+      FiniteElementSpace R_space(&mesh, &hdiv_coll);
+      FiniteElementSpace W_space(&mesh, &l2_coll);
+
+      MixedBilinearForm a(&R_space, &W_space);
+      a.AddDomainIntegrator(new VectorFEDivergenceIntegrator);
+      a.Assemble();
+      a.Finalize();
+      OmpSparseMatrix A(a.SpMat());
+
+      const int n = A.Width(), m = A.Height();
+      Vector x(n), y(m), Ax(m), Aty(n), Ax0(m), Aty0(n);
+      x.Randomize(1);
+      y.Randomize(2);
+      A.SparseMatrix::Mult(x, Ax0);
+      A.SparseMatrix::MultTranspose(y, Aty0);
+
+      for (int nt : {1, 3, 8})
+      {
+         omp_set_num_threads(nt);
+         Ax.Randomize(3);
+         Aty.Randomize(4);
+         Vector Ax1(Ax), Aty1(Aty);
+
+         // y += a A x, compared with the serial result
+         A.OmpAddMult(x, Ax, 0.5);
+         Ax1.Add(0.5, Ax0);
+         Ax -= Ax1;
+         REQUIRE(Ax.Normlinf() == MFEM_Approx(0.0));
+
+         A.OmpAddMultTranspose(y, Aty, -2.0);
+         Aty1.Add(-2.0, Aty0);
+         Aty -= Aty1;
+         REQUIRE(Aty.Normlinf() == MFEM_Approx(0.0));
+      }
+
+      // The partition is discarded together with the data it was built for
+      omp_set_num_threads(3);
+      OmpSparseMatrix B(A);
+      B.OmpAddMult(x, Ax, 1.0);
+      REQUIRE(B.omp_rows.Size() == 4);
+      B.Clear();
+      REQUIRE(B.omp_rows.Size() == 0);
+      B.MakeRef(A);
+      Ax = 0.0;
+      B.OmpAddMult(x, Ax, 1.0);
+      Ax -= Ax0;
+      REQUIRE(Ax.Normlinf() == MFEM_Approx(0.0));
+      SparseMatrix *At = Transpose(A);
+      B.Swap(*At);
+      REQUIRE(B.omp_rows.Size() == 0);
+      Aty = 0.0;
+      B.OmpAddMult(y, Aty, 1.0);
+      Aty -= Aty0;
+      REQUIRE(Aty.Normlinf() == MFEM_Approx(0.0));
+      delete At;
+      omp_set_num_threads(nthreads);
+   }
+}
+
+#endif // MFEM_USE_OPENMP
+
 } // namespace mfem
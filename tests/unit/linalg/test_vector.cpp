@@ -225,3 +225,67 @@ TEST_CASE("Vector Tests", "[Vector]")
       REQUIRE(diff.Norml2() < tol);
    }
 }
+
+TEST_CASE("Vector fused operations", "[Vector], [CUDA]")
+{
+   const double tol = 1e-12;
+   const int N = GENERATE(3, 1000);
+   const int n = GENERATE(1, 3, 10);
+   CAPTURE(N, n);
+
+   std::vector<Vector> v(n);
+   Array<Vector*> vp(n);
+   for (int k = 0; k < n; k++)
+   {
+      v[k].SetSize(N);
+      v[k].UseDevice(true);
+      v[k].Randomize(k+1);
+      vp[k] = &v[k];
+   }
+   Vector x(N), y(N), w(N), z(N), z_ref(N);
+   x.UseDevice(true); y.UseDevice(true); w.UseDevice(true); z.UseDevice(true);
+   x.Randomize(100);
+   y.Randomize(101);
+   w.Randomize(102);
+
+   SECTION("AXPBYDot")
+   {
+      add(0.5, x, -2.0, y, z_ref);
+      const double dot_ref = z_ref * w;
+
+      double dot = AXPBYDot(0.5, x, -2.0, y, z, w);
+      REQUIRE(dot == MFEM_Approx(dot_ref, tol));
+      z -= z_ref;
+      REQUIRE(z.Normlinf() < tol);
+
+      // In place update, with the inner product of the result with itself
+      dot = AXPBYDot(0.5, x, -2.0, y, y, y);
+      REQUIRE(dot == MFEM_Approx(z_ref * z_ref, tol));
+      y -= z_ref;
+      REQUIRE(y.Normlinf() < tol);
+   }
+
+   SECTION("MultiDot")
+   {
+      std::vector<double> dots(n);
+      MultiDot(n, vp.GetData(), w, dots.data());
+      for (int k = 0; k < n; k++)
+      {
+         REQUIRE(dots[k] == MFEM_Approx(v[k] * w, tol));
+      }
+   }
+
+   SECTION("MultiAdd")
+   {
+      std::vector<double> a(n);
+      z_ref = w;
+      for (int k = 0; k < n; k++)
+      {
+         a[k] = 1.0 - 0.25*k;
+         z_ref.Add(a[k], v[k]);
+      }
+      MultiAdd(n, a.data(), vp.GetData(), w);
+      w -= z_ref;
+      REQUIRE(w.Normlinf() < tol);
+   }
+}
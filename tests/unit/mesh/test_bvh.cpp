@@ -0,0 +1,252 @@
+// Copyright (c) 2010-2022, Lawrence Livermore National Security, LLC. Produced
+// at the Lawrence Livermore National Laboratory. All Rights reserved. See files
+// LICENSE and NOTICE for details. LLNL-CODE-806117.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability visit https://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the BSD-3 license. We welcome feedback and contributions, see file
+// CONTRIBUTING.md for details.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "unit_tests.hpp"
+
+namespace bvh_test
+{
+
+static Mesh MakeMesh(int type)
+{
+   switch (type)
+   {
+      case 0: return Mesh::MakeCartesian2D(7, 5, Element::QUADRILATERAL);
+      case 1: return Mesh::MakeCartesian3D(4, 3, 5, Element::TETRAHEDRON);
+      case 2: return Mesh::LoadFromFile("../../data/star-q3.mesh");
+      default: return Mesh::LoadFromFile("../../data/fichera-q2.mesh");
+   }
+}
+
+// Return points inside random elements, and the elements, the same on all
+// the ranks
+static void RandomPoints(Mesh &mesh, int npts, DenseMatrix &points,
+                         Array<int> &elems)
+{
+   const int sdim = mesh.SpaceDimension();
+   srand(1);
+   points.SetSize(sdim, npts);
+   elems.SetSize(npts);
+   Vector x, r(3);
+   for (int k = 0; k < npts; k++)
+   {
+      elems[k] = rand() % mesh.GetNE();
+      const Geometry::Type geom = mesh.GetElementBaseGeometry(elems[k]);
+      // Random point in the reference element
+      IntegrationPoint ip;
+      do
+      {
+         for (int d = 0; d < 3; d++) { r(d) = rand()/(RAND_MAX + 1.0); }
+         ip.Set(r.GetData(), mesh.Dimension());
+      }
+      while (!Geometry::CheckPoint(geom, ip));
+      points.GetColumnReference(k, x);
+      mesh.GetElementTransformation(elems[k])->Transform(ip, x);
+   }
+}
+
+static void Deform(const Vector &x, Vector &y)
+{
+   y = x;
+   y(0) += 0.1*sin(3.0*x(1));
+   y(1) += 0.1*cos(2.0*x(0));
+}
+
+static double Linear(const Vector &x)
+{
+   double f = 1.0;
+   for (int d = 0; d < x.Size(); d++) { f += (d + 2)*x(d); }
+   return f;
+}
+
+}
+
+using namespace bvh_test;
+
+TEST_CASE("ElementBVH candidates", "[Mesh]")
+{
+   auto type = GENERATE(0, 1, 2, 3);
+   Mesh mesh = MakeMesh(type);
+   ElementBVH bvh(mesh);
+   REQUIRE(!bvh.IsOutdated());
+
+   DenseMatrix points;
+   Array<int> elems, found;
+   RandomPoints(mesh, 100, points, elems);
+   Vector x, min, max;
+   for (int k = 0; k < points.Width(); k++)
+   {
+      points.GetColumnReference(k, x);
+      bvh.FindElements(x, found);
+      // The element of the point is a candidate
+      REQUIRE(found.Find(elems[k]) >= 0);
+
+      // The candidates are exactly the elements whose boxes contain the point
+      int count = 0;
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         bvh.GetElementBox(i, min, max);
+         bool inside = true;
+         for (int d = 0; d < x.Size(); d++)
+         {
+            inside = inside && x(d) >= min(d) && x(d) <= max(d);
+         }
+         if (inside)
+         {
+            count++;
+            REQUIRE(found.Find(i) >= 0);
+         }
+      }
+      REQUIRE(found.Size() == count);
+   }
+
+   // A point outside of the mesh has no candidates
+   Vector far(mesh.SpaceDimension());
+   far = 100.0;
+   bvh.FindElements(far, found);
+   REQUIRE(found.Size() == 0);
+}
+
+TEST_CASE("FindPoints with ElementBVH", "[Mesh]")
+{
+   auto type = GENERATE(0, 2, 3);
+   Mesh mesh = MakeMesh(type);
+   mesh.EnsureNodes();
+   ElementBVH bvh(mesh);
+
+   DenseMatrix points;
+   Array<int> elems, elem_ids;
+   Array<IntegrationPoint> ips;
+   RandomPoints(mesh, 200, points, elems);
+   REQUIRE(mesh.FindPoints(points, elem_ids, ips, true, NULL, &bvh) == 200);
+
+   // Without a given index, the result is the same
+   Array<int> elem_ids2;
+   REQUIRE(mesh.FindPoints(points, elem_ids2, ips) == 200);
+   for (int k = 0; k < elem_ids.Size(); k++)
+   {
+      REQUIRE(elem_ids[k] == elem_ids2[k]);
+   }
+
+   // After mesh motion, the index is updated
+   mesh.Transform(Deform);
+   bvh.Update();
+   RandomPoints(mesh, 200, points, elems);
+   REQUIRE(mesh.FindPoints(points, elem_ids, ips, true, NULL, &bvh) == 200);
+   Vector x, y;
+   for (int k = 0; k < points.Width(); k++)
+   {
+      points.GetColumnReference(k, x);
+      mesh.GetElementTransformation(elem_ids[k])->Transform(ips[k], y);
+      y -= x;
+      REQUIRE(y.Normlinf() == MFEM_Approx(0.0));
+   }
+
+   // After refinement, the index must be rebuilt
+   mesh.UniformRefinement();
+   REQUIRE(bvh.IsOutdated());
+   bvh.Rebuild();
+   REQUIRE(!bvh.IsOutdated());
+   RandomPoints(mesh, 200, points, elems);
+   REQUIRE(mesh.FindPoints(points, elem_ids, ips, true, NULL, &bvh) == 200);
+}
+
+TEST_CASE("FindPoints outside of the curved boxes", "[Mesh]")
+{
+   auto type = GENERATE(2, 3);
+   Mesh mesh = MakeMesh(type);
+   ElementBVH bvh(mesh);
+
+   // Shrink the boxes of the curved elements, so that they miss parts of them
+   Vector min, max, min2, max2;
+   bvh.GetElementBox(0, min, max);
+   bvh.SetCurvedPadding(-0.1);
+   bvh.GetElementBox(0, min2, max2);
+   REQUIRE(min2(0) > min(0));
+   REQUIRE(max2(0) < max(0));
+
+   DenseMatrix points;
+   Array<int> elems, elem_ids, found;
+   Array<IntegrationPoint> ips;
+   RandomPoints(mesh, 200, points, elems);
+   int missed = 0;
+   Vector x;
+   for (int k = 0; k < points.Width(); k++)
+   {
+      points.GetColumnReference(k, x);
+      bvh.FindElements(x, found);
+      if (found.Find(elems[k]) < 0) { missed++; }
+      // The closest box contains the point, if any box does
+      const int e = bvh.FindClosestElement(x.GetData());
+      REQUIRE(e >= 0);
+      if (found.Size() > 0) { REQUIRE(found.Find(e) >= 0); }
+   }
+   REQUIRE(missed > 0);
+
+   // The neighbors of the closest elements contain the missed points
+   REQUIRE(mesh.FindPoints(points, elem_ids, ips, true, NULL, &bvh) == 200);
+}
+
+TEST_CASE("GridFunction point values", "[Mesh], [GridFunction]")
+{
+   auto type = GENERATE(0, 1, 3);
+   Mesh mesh = MakeMesh(type);
+   const int dim = mesh.Dimension();
+   H1_FECollection fec(2, dim);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction u(&fes);
+   FunctionCoefficient f(Linear);
+   u.ProjectCoefficient(f);
+
+   DenseMatrix points, vals;
+   Array<int> elems;
+   RandomPoints(mesh, 50, points, elems);
+   ElementBVH bvh(mesh);
+   REQUIRE(u.GetPointValues(points, vals, &bvh) == 50);
+   REQUIRE(vals.Height() == 1);
+   Vector x;
+   for (int k = 0; k < points.Width(); k++)
+   {
+      points.GetColumnReference(k, x);
+      REQUIRE(vals(0,k) == MFEM_Approx(Linear(x)));
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("ParGridFunction point values", "[Parallel], [Mesh]")
+{
+   Mesh mesh = MakeMesh(1);
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   H1_FECollection fec(2, 3);
+   ParFiniteElementSpace fes(&pmesh, &fec);
+   ParGridFunction u(&fes);
+   FunctionCoefficient f(Linear);
+   u.ProjectCoefficient(f);
+
+   DenseMatrix points;
+   Array<int> elems;
+   RandomPoints(mesh, 50, points, elems);
+
+   ElementBVH bvh(pmesh);
+   DenseMatrix vals;
+   REQUIRE(u.GetPointValues(points, vals, &bvh) == 50);
+   Vector x;
+   for (int k = 0; k < points.Width(); k++)
+   {
+      points.GetColumnReference(k, x);
+      REQUIRE(vals(0,k) == MFEM_Approx(Linear(x)));
+   }
+}
+
+#endif
@@ -180,3 +180,46 @@ TEST_CASE("MakeSimplicial", "[Mesh]")
    // on the original mesh, but it doesn't happen for these test cases.
    REQUIRE(simplex_mesh.GetNE() == orig_mesh.GetNE()*factor);
 }
+
+TEST_CASE("SFC partitioning", "[Mesh]")
+{
+   auto mesh_fname = GENERATE("../../data/star.mesh",
+                              "../../data/fichera.mesh",
+                              "../../data/beam-tet.mesh",
+                              "../../data/inline-segment.mesh");
+   Mesh mesh(mesh_fname, 1, 1);
+   mesh.UniformRefinement();
+   mesh.UniformRefinement();
+   const int ne = mesh.GetNE(), nparts = 7;
+
+   SECTION("Uniform weights")
+   {
+      int *partitioning = mesh.GeneratePartitioning(nparts, 6);
+      Array<int> psize(nparts);
+      psize = 0;
+      for (int i = 0; i < ne; i++) { psize[partitioning[i]]++; }
+      REQUIRE(psize.Max() - psize.Min() <= 1);
+
+      // The parts are contiguous pieces of the Hilbert ordering
+      Array<int> ordering;
+      mesh.GetHilbertElementOrdering(ordering);
+      Array<int> sfc_part(ne);
+      for (int i = 0; i < ne; i++) { sfc_part[ordering[i]] = partitioning[i]; }
+      for (int k = 1; k < ne; k++) { REQUIRE(sfc_part[k-1] <= sfc_part[k]); }
+      delete [] partitioning;
+   }
+
+   SECTION("Element weights")
+   {
+      // Weight the elements of the first half of the mesh 8 times more, as
+      // for a local p-refinement by one order in 3D
+      Vector weights(ne);
+      for (int i = 0; i < ne; i++) { weights(i) = (2*i < ne) ? 8.0 : 1.0; }
+      int *partitioning = mesh.GenerateSFCPartitioning(nparts, &weights);
+      Vector pweight(nparts);
+      pweight = 0.0;
+      for (int i = 0; i < ne; i++) { pweight(partitioning[i]) += weights(i); }
+      REQUIRE(pweight.Max() - pweight.Min() <= 2*weights.Max());
+      delete [] partitioning;
+   }
+}
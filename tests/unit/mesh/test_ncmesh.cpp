@@ -12,6 +12,10 @@
 #include "mfem.hpp"
 #include "unit_tests.hpp"
 
+#ifdef MFEM_USE_OPENMP
+#include <omp.h>
+#endif
+
 namespace mfem
 {
 
@@ -115,6 +119,162 @@ TEST_CASE("NCMesh PA diagonal", "[NCMesh]")
 
 } // test case
 
+static double TotalVolume(Mesh &mesh)
+{
+   double volume = 0.0;
+   for (int i = 0; i < mesh.GetNE(); i++) { volume += mesh.GetElementVolume(i); }
+   return volume;
+}
+
+// Test case: Verify that a uniform nonconforming refinement, which refines all
+//            elements in one isotropic batch, yields the same mesh entities as
+//            the conforming refinement, and that random isotropic refinements
+//            keep the volume and the nonconforming interfaces consistent.
+TEST_CASE("NCMesh isotropic refinement", "[NCMesh]")
+{
+   auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE,
+                        Element::HEXAHEDRON, Element::TETRAHEDRON,
+                        Element::WEDGE);
+   const bool is2D = (type == Element::QUADRILATERAL ||
+                      type == Element::TRIANGLE);
+
+   Mesh mesh = is2D ? Mesh::MakeCartesian2D(4, 3, type) :
+               Mesh::MakeCartesian3D(3, 2, 2, type);
+   Mesh nc_mesh(mesh);
+   nc_mesh.EnsureNCMesh(true);
+
+   mesh.UniformRefinement();
+   nc_mesh.UniformRefinement();
+
+   REQUIRE(nc_mesh.GetNE() == mesh.GetNE());
+   REQUIRE(nc_mesh.GetNBE() == mesh.GetNBE());
+   REQUIRE(nc_mesh.GetNV() == mesh.GetNV());
+   REQUIRE(nc_mesh.GetNEdges() == mesh.GetNEdges());
+   REQUIRE(nc_mesh.GetNFaces() == mesh.GetNFaces());
+   REQUIRE(nc_mesh.ncmesh->GetFaceList().masters.Size() == 0);
+   REQUIRE(nc_mesh.ncmesh->GetEdgeList().masters.Size() == 0);
+   REQUIRE(TotalVolume(nc_mesh) == MFEM_Approx(1.0));
+
+   srand(1);
+   for (int it = 0; it < 2; it++)
+   {
+      Array<int> refs;
+      for (int i = 0; i < nc_mesh.GetNE(); i++)
+      {
+         if (rand() % 3 == 0) { refs.Append(i); }
+      }
+      const int ne = nc_mesh.GetNE();
+      nc_mesh.GeneralRefinement(refs, 1);
+
+      const int nchildren = is2D ? 4 : 8;
+      REQUIRE(nc_mesh.GetNE() == ne + (nchildren - 1)*refs.Size());
+      REQUIRE(TotalVolume(nc_mesh) == MFEM_Approx(1.0));
+   }
+
+   // every slave face or edge lies on a master of the lists
+   const NCMesh::NCList &faces = nc_mesh.ncmesh->GetNCList(is2D ? 1 : 2);
+   REQUIRE(faces.masters.Size() > 0);
+   for (int i = 0; i < faces.slaves.Size(); i++)
+   {
+      REQUIRE(faces.slaves[i].master >= 0);
+   }
+}
+
+#ifdef MFEM_USE_OPENMP
+
+static void RefineRandomly(Mesh &mesh, int seed)
+{
+   srand(seed);
+   for (int it = 0; it < 3; it++)
+   {
+      Array<int> refs;
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         if (rand() % 3 == 0) { refs.Append(i); }
+      }
+      mesh.GeneralRefinement(refs, 1);
+   }
+}
+
+static void CompareLists(const NCMesh::NCList &l1, const NCMesh::NCList &l2)
+{
+   REQUIRE(l1.conforming.Size() == l2.conforming.Size());
+   REQUIRE(l1.masters.Size() == l2.masters.Size());
+   REQUIRE(l1.slaves.Size() == l2.slaves.Size());
+   for (int i = 0; i < l1.conforming.Size(); i++)
+   {
+      REQUIRE(l1.conforming[i].index == l2.conforming[i].index);
+      REQUIRE(l1.conforming[i].element == l2.conforming[i].element);
+      REQUIRE(l1.conforming[i].local == l2.conforming[i].local);
+   }
+   for (int i = 0; i < l1.masters.Size(); i++)
+   {
+      REQUIRE(l1.masters[i].index == l2.masters[i].index);
+      REQUIRE(l1.masters[i].slaves_begin == l2.masters[i].slaves_begin);
+      REQUIRE(l1.masters[i].slaves_end == l2.masters[i].slaves_end);
+   }
+   for (int i = 0; i < l1.slaves.Size(); i++)
+   {
+      REQUIRE(l1.slaves[i].index == l2.slaves[i].index);
+      REQUIRE(l1.slaves[i].master == l2.slaves[i].master);
+      REQUIRE(l1.slaves[i].element == l2.slaves[i].element);
+      REQUIRE(l1.slaves[i].matrix == l2.slaves[i].matrix);
+      REQUIRE(l1.slaves[i].edge_flags == l2.slaves[i].edge_flags);
+   }
+}
+
+// Test case: Verify that the Mesh and the vertex/edge/face lists built with
+//            several OpenMP threads are the same as with one thread.
+TEST_CASE("NCMesh OpenMP", "[NCMesh]")
+{
+   auto type = GENERATE(Element::QUADRILATERAL, Element::TRIANGLE,
+                        Element::HEXAHEDRON, Element::TETRAHEDRON,
+                        Element::WEDGE);
+   const int nthreads = omp_get_max_threads();
+
+   Mesh mesh[2];
+   for (int k = 0; k < 2; k++)
+   {
+      omp_set_num_threads(k ? std::max(nthreads, 4) : 1);
+      mesh[k] = (type == Element::QUADRILATERAL ||
+                 type == Element::TRIANGLE) ?
+                Mesh::MakeCartesian2D(4, 4, type) :
+                Mesh::MakeCartesian3D(3, 3, 3, type);
+      mesh[k].EnsureNCMesh(true);
+      RefineRandomly(mesh[k], 1);
+      mesh[k].ncmesh->GetVertexList();
+      mesh[k].ncmesh->GetEdgeList();
+      mesh[k].ncmesh->GetFaceList();
+   }
+   omp_set_num_threads(nthreads);
+
+   REQUIRE(mesh[0].GetNE() == mesh[1].GetNE());
+   REQUIRE(mesh[0].GetNBE() == mesh[1].GetNBE());
+   REQUIRE(mesh[0].GetNEdges() == mesh[1].GetNEdges());
+   REQUIRE(mesh[0].GetNFaces() == mesh[1].GetNFaces());
+   for (int i = 0; i < mesh[0].GetNE(); i++)
+   {
+      Array<int> v0, v1;
+      mesh[0].GetElementVertices(i, v0);
+      mesh[1].GetElementVertices(i, v1);
+      for (int j = 0; j < v0.Size(); j++) { REQUIRE(v0[j] == v1[j]); }
+   }
+   for (int i = 0; i < mesh[0].GetNBE(); i++)
+   {
+      Array<int> v0, v1;
+      mesh[0].GetBdrElementVertices(i, v0);
+      mesh[1].GetBdrElementVertices(i, v1);
+      for (int j = 0; j < v0.Size(); j++) { REQUIRE(v0[j] == v1[j]); }
+   }
+
+   NCMesh &nc0 = *mesh[0].ncmesh, &nc1 = *mesh[1].ncmesh;
+   CompareLists(nc0.GetVertexList(), nc1.GetVertexList());
+   CompareLists(nc0.GetEdgeList(), nc1.GetEdgeList());
+   CompareLists(nc0.GetFaceList(), nc1.GetFaceList());
+}
+
+#endif // MFEM_USE_OPENMP
+
 #ifdef MFEM_USE_MPI
 
 // Test case: Verify that a conforming mesh yields the same norm for the
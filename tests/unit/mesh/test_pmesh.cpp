@@ -191,6 +191,132 @@ TEST_CASE("ParMeshMakeSimplicial", "[Parallel], [ParMesh]")
    REQUIRE(x.Normlinf() == MFEM_Approx(0.0));
 }
 
+static double ParMeshVolume(ParMesh &pmesh)
+{
+   double vol = 0.0;
+   for (int e = 0; e < pmesh.GetNE(); e++) { vol += pmesh.GetElementVolume(e); }
+   MPI_Allreduce(MPI_IN_PLACE, &vol, 1, MPI_DOUBLE, MPI_SUM, pmesh.GetComm());
+   return vol;
+}
+
+TEST_CASE("ParMeshMakeDistributed", "[Parallel], [ParMesh]")
+{
+   // Compare ParMesh::MakeDistributed, with the serial mesh only given on rank
+   // 0, with the ParMesh constructor using the same partitioning.
+   auto mesh_file = GENERATE("../../data/star-q3.mesh",
+                             "../../data/fichera.mesh",
+                             "../../data/beam-tet.mesh",
+                             "../../data/beam-wedge.mesh",
+                             "../../data/periodic-square.mesh");
+   int rank, nranks;
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+   MPI_Comm_size(MPI_COMM_WORLD, &nranks);
+
+   Mesh mesh = Mesh::LoadFromFile(mesh_file, 1, 1);
+   mesh.UniformRefinement();
+   int *partitioning = mesh.GeneratePartitioning(nranks);
+
+   ParMesh pmesh(MPI_COMM_WORLD, mesh, partitioning);
+   ParMesh pmesh_dist = ParMesh::MakeDistributed(MPI_COMM_WORLD,
+                                                 rank == 0 ? &mesh : NULL, 0,
+                                                 partitioning);
+   delete [] partitioning;
+
+   REQUIRE(pmesh_dist.GetNE() == pmesh.GetNE());
+   REQUIRE(pmesh_dist.GetNV() == pmesh.GetNV());
+   REQUIRE(pmesh_dist.GetNBE() == pmesh.GetNBE());
+   REQUIRE(pmesh_dist.GetNGroups() == pmesh.GetNGroups());
+   REQUIRE(ParMeshVolume(pmesh_dist) == MFEM_Approx(ParMeshVolume(pmesh)));
+
+   H1_FECollection fec(2, mesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec), fes_dist(&pmesh_dist, &fec);
+   REQUIRE(fes_dist.GlobalTrueVSize() == fes.GlobalTrueVSize());
+
+   // The meshes can be refined and used as usual
+   pmesh_dist.UniformRefinement();
+   REQUIRE(pmesh_dist.GetGlobalNE() == (1 << mesh.Dimension())*mesh.GetNE());
+}
+
+static void RebalanceWeights(ParMesh &pmesh, Vector &weights)
+{
+   // Elements in the left half of the domain are four times more expensive
+   Vector center;
+   weights.SetSize(pmesh.GetNE());
+   for (int i = 0; i < pmesh.GetNE(); i++)
+   {
+      pmesh.GetElementCenter(i, center);
+      weights(i) = center(0) < 0.5 ? 4.0 : 1.0;
+   }
+}
+
+TEST_CASE("ParMeshWeightedRebalance", "[Parallel], [ParMesh]")
+{
+   Mesh mesh = Mesh::MakeCartesian2D(16, 16, Element::QUADRILATERAL);
+   mesh.EnsureNCMesh();
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   const long global_ne = pmesh.GetGlobalNE();
+
+   Vector weights;
+   RebalanceWeights(pmesh, weights);
+   pmesh.Rebalance(weights);
+   REQUIRE(pmesh.GetGlobalNE() == global_ne);
+
+   RebalanceWeights(pmesh, weights);
+   double local = weights.Sum(), wmin, wmax;
+   MPI_Allreduce(&local, &wmin, 1, MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD);
+   MPI_Allreduce(&local, &wmax, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+   REQUIRE(wmax - wmin <= 2*4.0);
+}
+
+// Smooth deformation giving node coordinates that need all 17 digits to be
+// restored exactly from the text format
+static void BinaryWarp(const Vector &x, Vector &y)
+{
+   y = x;
+   for (int i = 0; i < x.Size(); i++)
+   {
+      y(i) += 0.1*sin(3.0*x((i + 1) % x.Size()));
+   }
+}
+
+TEST_CASE("ParMeshBinary", "[Parallel], [ParMesh]")
+{
+   // Round trip of ParMesh::PrintBinary and ParMesh::LoadBinary, which must
+   // reproduce the local mesh and the shared entities of each rank.
+   auto nc = GENERATE(false, true);
+   Mesh mesh = Mesh::LoadFromFile("../../data/fichera.mesh");
+   if (nc) { mesh.EnsureNCMesh(); }
+   ParMesh pmesh(MPI_COMM_WORLD, mesh);
+   pmesh.SetCurvature(2);
+   pmesh.Transform(BinaryWarp);
+
+   std::stringstream buffer;
+   pmesh.PrintBinary(buffer);
+   ParMesh pmesh_new = ParMesh::LoadBinary(MPI_COMM_WORLD, buffer);
+
+   REQUIRE(pmesh_new.GetNE() == pmesh.GetNE());
+   REQUIRE(pmesh_new.GetNV() == pmesh.GetNV());
+   REQUIRE(pmesh_new.GetNBE() == pmesh.GetNBE());
+   REQUIRE(pmesh_new.GetNGroups() == pmesh.GetNGroups());
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      REQUIRE(pmesh_new.GroupNVertices(g) == pmesh.GroupNVertices(g));
+      REQUIRE(pmesh_new.GroupNEdges(g) == pmesh.GroupNEdges(g));
+   }
+   REQUIRE(ParMeshVolume(pmesh_new) == MFEM_Approx(ParMeshVolume(pmesh)));
+
+   // The nodes are restored exactly, from the binary data of conforming meshes
+   // and from the embedded text of nonconforming ones
+   Vector nodes_diff(*pmesh_new.GetNodes());
+   nodes_diff -= *pmesh.GetNodes();
+   REQUIRE(nodes_diff.Normlinf() == 0.0);
+
+   H1_FECollection fec(3, mesh.Dimension());
+   ParFiniteElementSpace fes(&pmesh, &fec), fes_new(&pmesh_new, &fec);
+   REQUIRE(fes_new.GlobalTrueVSize() == fes.GlobalTrueVSize());
+   REQUIRE(fes_new.GetTrueVSize() == fes.GetTrueVSize());
+}
+
 #endif // MFEM_USE_MPI
 
 } // namespace mfem